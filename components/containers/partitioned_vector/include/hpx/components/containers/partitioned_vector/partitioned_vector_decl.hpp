@@ -17,6 +17,7 @@
 #include <hpx/async_combinators/when_all.hpp>
 #include <hpx/components/client_base.hpp>
 #include <hpx/components/get_ptr.hpp>
+#include <hpx/components_base/agas_interface.hpp>
 #include <hpx/distribution_policies/container_distribution_policy.hpp>
 #include <hpx/functional/bind.hpp>
 #include <hpx/modules/errors.hpp>
@@ -343,7 +344,9 @@ namespace hpx {
             DistPolicy const& policy, std::size_t count, std::size_t size,
             T const& val);
 
-        struct get_ptr_helper;
+        // Resolve the addresses of all given partitions at once and store
+        // the pointers to the local ones.
+        static void resolve_partitions(partitions_vector_type& partitions);
 
         // This function is called when we are creating the vector. It
         // initializes the partitions based on the give parameters.
@@ -15,6 +15,7 @@
 #include <hpx/async_combinators/when_all.hpp>
 #include <hpx/components/client_base.hpp>
 #include <hpx/components/get_ptr.hpp>
+#include <hpx/components_base/agas_interface.hpp>
 #include <hpx/distribution_policies/container_distribution_policy.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/modules/async_distributed.hpp>
@@ -71,23 +72,7 @@ namespace hpx {
         std::move(data.partitions_.begin(), data.partitions_.end(),
             std::back_inserter(partitions_));
 
-        std::uint32_t this_locality = get_locality_id();
-        std::vector<future<void>> ptrs;
-
-        typedef typename partitions_vector_type::const_iterator const_iterator;
-
-        std::size_t l = 0;
-        const_iterator end = partitions_.cend();
-        for (const_iterator it = partitions_.cbegin(); it != end; ++it, ++l)
-        {
-            if (it->locality_id_ == this_locality)
-            {
-                ptrs.push_back(
-                    get_ptr<partitioned_vector_partition_server>(it->partition_)
-                        .then(get_ptr_helper{l, partitions_}));
-            }
-        }
-        hpx::wait_all(ptrs);
+        resolve_partitions(partitions_);
 
         partition_size_ = get_partition_size();
         this->base_type::reset(HPX_MOVE(id));
@@ -317,18 +302,33 @@ namespace hpx {
     }
 
     template <typename T, typename Data /*= std::vector<T> */>
-    struct partitioned_vector<T, Data>::get_ptr_helper
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::resolve_partitions(
+        partitions_vector_type& partitions)
     {
-        std::size_t loc;
-        partitions_vector_type& partitions;
+        std::vector<hpx::id_type> ids;
+        ids.reserve(partitions.size());
+        for (partition_data const& p : partitions)
+        {
+            ids.push_back(p.partition_);
+        }
+
+        // A single bulk request resolves all partitions, this also fills the
+        // AGAS cache for the remote partitions which are subsequently
+        // accessed by the segmented algorithms.
+        std::vector<naming::address> addrs = agas::resolve(ids).get();
 
-        void operator()(
-            future<std::shared_ptr<partitioned_vector_partition_server>>&& f)
-            const
+        std::uint32_t this_locality = get_locality_id();
+        for (std::size_t i = 0; i != partitions.size(); ++i)
         {
-            partitions[loc].local_data_ = f.get();
+            if (partitions[i].locality_id_ == this_locality)
+            {
+                partitions[i].local_data_ = hpx::detail::get_ptr_postproc<
+                    partitioned_vector_partition_server,
+                    hpx::detail::get_ptr_deleter>(addrs[i], ids[i]);
+            }
         }
-    };
+    }
 
     template <typename T, typename Data /*= std::vector<T> */>
     template <typename DistPolicy, typename Create>
@@ -344,17 +344,11 @@ namespace hpx {
             creator(policy, num_parts, part_size);
 
         // now initialize our data structures
-        std::uint32_t this_locality = get_locality_id();
-        std::vector<future<void>> ptrs;
-
         std::size_t num_part = 0;
         std::size_t allocated_size = 0;
 
         std::size_t l = 0;
 
-        // Fixing the size of partitions to avoid race conditions between
-        // possible reallocations during push back and the continuation
-        // to set the local partition data
         partitions_.resize(num_parts);
         for (bulk_locality_result const& r : f.get())
         {
@@ -365,13 +359,6 @@ namespace hpx {
                 std::size_t size =
                     (std::min)(part_size, size_ - allocated_size);
                 partitions_[l] = partition_data(id, size, locality);
-
-                if (locality == this_locality)
-                {
-                    ptrs.push_back(
-                        get_ptr<partitioned_vector_partition_server>(id).then(
-                            get_ptr_helper{l, partitions_}));
-                }
                 ++l;
 
                 allocated_size += size;
@@ -397,7 +384,7 @@ namespace hpx {
         }
         HPX_ASSERT(l == num_parts);
 
-        hpx::when_all(ptrs).get();
+        resolve_partitions(partitions_);
 
         // cache our partition size
         partition_size_ = get_partition_size();
@@ -438,30 +425,15 @@ namespace hpx {
         }
         hpx::wait_all(objs);
 
-        std::uint32_t this_locality = get_locality_id();
-        std::vector<future<void>> ptrs;
-
         partitions_vector_type partitions;
-        // Fixing the size of partitions to avoid race conditions between
-        // possible reallocations during push back and the continuation
-        // to set the local partition data
-        partitions.resize(rhs.partitions_.size());
+        partitions.reserve(rhs.partitions_.size());
         for (std::size_t i = 0; i != rhs.partitions_.size(); ++i)
         {
-            std::uint32_t locality = rhs.partitions_[i].locality_id_;
-
-            partitions[i] = partition_data(
-                objs[i].get(), rhs.partitions_[i].size_, locality);
-
-            if (locality == this_locality)
-            {
-                ptrs.push_back(get_ptr<partitioned_vector_partition_server>(
-                    partitions[i].partition_)
-                                   .then(get_ptr_helper{i, partitions}));
-            }
+            partitions.emplace_back(objs[i].get(), rhs.partitions_[i].size_,
+                rhs.partitions_[i].locality_id_);
         }
 
-        hpx::when_all(ptrs).get();
+        resolve_partitions(partitions);
 
         size_ = rhs.size_;
         partition_size_ = rhs.partition_size_;
@@ -0,0 +1,72 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ADAPTIVE)
+#include <hpx/serialization/binary_filter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx::plugins::compression {
+
+    // Estimate the ratio of compressed to uncompressed size of the given
+    // data from the byte entropy of evenly spaced samples of it.
+    double estimate_compression_ratio(
+        char const* data, std::size_t size) noexcept;
+
+    // The cost model the adaptive serialization filters use to decide
+    // whether compressing a message with a given codec pays off. There is
+    // one instance per codec, it is updated with the measured time of each
+    // compression and decompression and the achieved compression ratio.
+    class adaptive_compression_statistics
+    {
+    public:
+        adaptive_compression_statistics() noexcept;
+
+        // Return the statistics of the given codec
+        static adaptive_compression_statistics& get(
+            serialization::binary_filter const& codec);
+
+        // Return whether a message of the given size and estimated
+        // compression ratio should be compressed
+        bool should_compress(std::size_t size, double estimated_ratio) noexcept;
+
+        void compressed(std::size_t size, std::size_t compressed_size,
+            double estimated_ratio, std::int64_t time) noexcept;
+        void decompressed(std::size_t size, std::int64_t time) noexcept;
+
+    private:
+        // average cost of compressing and decompressing one byte [ns]
+        std::atomic<double> compression_cost_;
+        std::atomic<double> decompression_cost_;
+
+        // average ratio of the achieved to the estimated compression ratio
+        std::atomic<double> ratio_correction_;
+
+        // the number of messages skipped since the last one compressed
+        std::atomic<std::size_t> num_skipped_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Values of the performance counters, for all codecs
+    std::int64_t get_bytes_saved(bool reset);
+    std::int64_t get_num_compressed_messages(bool reset);
+    std::int64_t get_num_skipped_messages(bool reset);
+    std::int64_t get_compression_time(bool reset);
+    std::int64_t get_decompression_time(bool reset);
+}    // namespace hpx::plugins::compression
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
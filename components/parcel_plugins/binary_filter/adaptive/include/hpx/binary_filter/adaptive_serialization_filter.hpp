@@ -0,0 +1,96 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/binary_filter/adaptive_serialization_filter_registration.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ADAPTIVE)
+#include <hpx/modules/serialization.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx::plugins::compression {
+
+    // The adaptive filter wraps another binary filter (the codec) and decides
+    // for each message whether compressing it pays off. Small messages and
+    // messages which are estimated to compress badly (based on a sample of
+    // their content) are sent as they are whenever the time needed to
+    // compress and decompress them is larger than the time saved on the
+    // link. The first byte of the data written by this filter tells the
+    // receiver whether the codec has been applied.
+    struct HPX_LIBRARY_EXPORT adaptive_serialization_filter
+      : public serialization::binary_filter
+    {
+        explicit adaptive_serialization_filter(bool compress = false,
+            serialization::binary_filter* next_filter = nullptr) noexcept;
+        ~adaptive_serialization_filter() override;
+
+        adaptive_serialization_filter(
+            adaptive_serialization_filter const&) = delete;
+        adaptive_serialization_filter& operator=(
+            adaptive_serialization_filter const&) = delete;
+
+        void load(void* dst, std::size_t dst_count) override;
+        void save(void const* src, std::size_t src_count) override;
+        bool flush(
+            void* dst, std::size_t dst_count, std::size_t& written) override;
+
+        void set_max_length(std::size_t size) override;
+        std::size_t init_data(void const* buffer, std::size_t size,
+            std::size_t buffer_size) override;
+
+    private:
+        enum class method : std::uint8_t
+        {
+            unknown = 0xff,
+            stored = 0,
+            compressed = 1
+        };
+
+        method select_method();
+
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int)
+        {
+            // the codec is created on the receiving end from this
+            ar& hpx::serialization::detail::raw_ptr(codec_);
+        }
+
+        HPX_SERIALIZATION_POLYMORPHIC(adaptive_serialization_filter, override);
+
+        serialization::binary_filter* codec_;
+
+        // the message data, if it is not handled by the codec
+        std::vector<char> buffer_;
+        char const* data_;
+        std::size_t size_;
+        std::size_t current_;
+
+        method method_;
+        double estimated_ratio_;
+        std::int64_t compression_time_;
+
+        // state of a compressed flush spanning more than one call
+        std::size_t compressed_size_;
+        bool header_written_;
+
+        bool compress_;
+    };
+}    // namespace hpx::plugins::compression
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
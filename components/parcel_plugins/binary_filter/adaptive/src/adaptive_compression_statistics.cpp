@@ -0,0 +1,396 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ADAPTIVE)
+#include <hpx/components_base/component_startup_shutdown.hpp>
+#include <hpx/modules/runtime_local.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/util/from_string.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <hpx/binary_filter/adaptive_compression_statistics.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+#include <hpx/parcelset/parcelhandler.hpp>
+#include <hpx/runtime_distributed.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+namespace hpx::plugins::compression {
+
+    namespace {
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t get_min_size()
+        {
+            return hpx::util::from_string<std::size_t>(
+                hpx::get_config_entry(
+                    "hpx.plugins.adaptive_serialization_filter.min_size",
+                    "4096"),
+                4096);
+        }
+
+        // the bandwidth is specified in [MB/s], returned in [bytes/ns]
+        double get_bandwidth()
+        {
+            double const bandwidth = hpx::util::from_string<double>(
+                hpx::get_config_entry(
+                    "hpx.plugins.adaptive_serialization_filter.bandwidth",
+                    "1000"),
+                1000.0);
+            return bandwidth > 0 ? bandwidth / 1000 : 1.0;
+        }
+
+        std::size_t get_probe_interval()
+        {
+            return hpx::util::from_string<std::size_t>(
+                hpx::get_config_entry(
+                    "hpx.plugins.adaptive_serialization_filter.probe_interval",
+                    "64"),
+                64);
+        }
+
+        struct configuration
+        {
+            std::size_t min_size = get_min_size();
+            double bandwidth = get_bandwidth();
+            std::size_t probe_interval = get_probe_interval();
+        };
+
+        configuration const& get_configuration()
+        {
+            static configuration const cfg;
+            return cfg;
+        }
+
+        void update_average(std::atomic<double>& average, double value) noexcept
+        {
+            double const avg = average.load(std::memory_order_relaxed);
+            average.store(avg == 0 ? value : avg + (value - avg) / 8,
+                std::memory_order_relaxed);
+        }
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+        // Measure the bandwidth from the statistics the parcelports keep
+        // about the messages sent, at most every 100ms
+        void update_link_bandwidth(std::atomic<double>& bandwidth)
+        {
+            constexpr std::int64_t update_interval = 100000000;    // [ns]
+            constexpr std::int64_t min_data_sent = 1 << 20;
+
+            static std::atomic<bool> updating(false);
+            static std::atomic<std::int64_t> last_update(0);
+            static std::int64_t last_data_sent = 0;
+            static std::int64_t last_sending_time = 0;
+
+            std::int64_t const now = hpx::chrono::high_resolution_clock::now();
+            if (now - last_update.load(std::memory_order_relaxed) <
+                    update_interval ||
+                updating.exchange(true, std::memory_order_acquire))
+            {
+                return;
+            }
+
+            last_update.store(now, std::memory_order_relaxed);
+
+            runtime_distributed* rt = get_runtime_distributed_ptr();
+            if (rt != nullptr)
+            {
+                parcelset::parcelhandler& ph = rt->get_parcel_handler();
+
+                std::int64_t data_sent = 0;
+                std::int64_t sending_time = 0;
+                ph.enum_parcelports([&](std::string const& type) {
+                    data_sent += ph.get_data_sent(type, false);
+                    sending_time += ph.get_sending_time(type, false);
+                    return true;
+                });
+
+                std::int64_t const data = data_sent - last_data_sent;
+                std::int64_t const time = sending_time - last_sending_time;
+                if (data < 0 || time < 0)
+                {
+                    // the parcelport counters were reset
+                    last_data_sent = data_sent;
+                    last_sending_time = sending_time;
+                }
+                else if (data >= min_data_sent && time > 0)
+                {
+                    update_average(
+                        bandwidth, static_cast<double>(data) / time);
+                    last_data_sent = data_sent;
+                    last_sending_time = sending_time;
+                }
+            }
+
+            updating.store(false, std::memory_order_release);
+        }
+#endif
+
+        // The bandwidth of the links to other localities [bytes/ns]
+        double get_link_bandwidth()
+        {
+            static std::atomic<double> bandwidth(
+                get_configuration().bandwidth);
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            update_link_bandwidth(bandwidth);
+#endif
+            return bandwidth.load(std::memory_order_relaxed);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // counter values
+        std::atomic<std::int64_t> bytes_saved(0);
+        std::atomic<std::int64_t> num_compressed_messages(0);
+        std::atomic<std::int64_t> num_skipped_messages(0);
+        std::atomic<std::int64_t> compression_time(0);
+        std::atomic<std::int64_t> decompression_time(0);
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    double estimate_compression_ratio(
+        char const* data, std::size_t size) noexcept
+    {
+        constexpr std::size_t sample_length = 64;
+        constexpr std::size_t num_samples = 64;
+
+        if (size == 0)
+        {
+            return 1.0;
+        }
+
+        std::size_t histogram[256] = {};
+        std::size_t count = 0;
+
+        if (size <= sample_length * num_samples)
+        {
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                ++histogram[static_cast<unsigned char>(data[i])];
+            }
+            count = size;
+        }
+        else
+        {
+            std::size_t const stride = size / num_samples;
+            for (std::size_t i = 0; i != num_samples; ++i)
+            {
+                char const* sample = data + i * stride;
+                for (std::size_t j = 0; j != sample_length; ++j)
+                {
+                    ++histogram[static_cast<unsigned char>(sample[j])];
+                }
+            }
+            count = sample_length * num_samples;
+        }
+
+        double entropy = 0;
+        for (std::size_t h : histogram)
+        {
+            if (h != 0)
+            {
+                double const p = static_cast<double>(h) / count;
+                entropy -= p * std::log2(p);
+            }
+        }
+        return entropy / 8;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    adaptive_compression_statistics::adaptive_compression_statistics() noexcept
+      : compression_cost_(0)
+      , decompression_cost_(0)
+      , ratio_correction_(1.0)
+      , num_skipped_(0)
+    {
+    }
+
+    adaptive_compression_statistics& adaptive_compression_statistics::get(
+        serialization::binary_filter const& codec)
+    {
+        using statistics_map = std::map<std::type_index,
+            std::unique_ptr<adaptive_compression_statistics>>;
+
+        static hpx::spinlock mtx;
+        static statistics_map statistics;
+
+        std::lock_guard<hpx::spinlock> l(mtx);
+        std::unique_ptr<adaptive_compression_statistics>& stats =
+            statistics[std::type_index(typeid(codec))];
+        if (!stats)
+        {
+            stats = std::make_unique<adaptive_compression_statistics>();
+        }
+        return *stats;
+    }
+
+    bool adaptive_compression_statistics::should_compress(
+        std::size_t size, double estimated_ratio) noexcept
+    {
+        configuration const& cfg = get_configuration();
+        if (size >= cfg.min_size)
+        {
+            // Compress a message from time to time even if that does not pay
+            // off according to the model. This keeps the model up to date.
+            if (num_skipped_.fetch_add(1, std::memory_order_relaxed) + 1 >=
+                cfg.probe_interval)
+            {
+                num_skipped_.store(0, std::memory_order_relaxed);
+                return true;
+            }
+
+            // nothing has been measured yet
+            double const compression_cost =
+                compression_cost_.load(std::memory_order_relaxed);
+            if (compression_cost == 0)
+            {
+                return true;
+            }
+
+            double const ratio = (std::min)(estimated_ratio *
+                    ratio_correction_.load(std::memory_order_relaxed),
+                1.0);
+
+            // the time saved on the link and the time needed to compress and
+            // decompress the message [ns]
+            double const time_saved = size * (1 - ratio) / get_link_bandwidth();
+            double const time_needed = size *
+                (compression_cost +
+                    decompression_cost_.load(std::memory_order_relaxed));
+
+            if (time_saved > time_needed)
+            {
+                num_skipped_.store(0, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        num_skipped_messages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void adaptive_compression_statistics::compressed(std::size_t size,
+        std::size_t compressed_size, double estimated_ratio,
+        std::int64_t time) noexcept
+    {
+        if (size != 0)
+        {
+            update_average(compression_cost_, static_cast<double>(time) / size);
+
+            // the estimate is based on the byte entropy only, the codecs
+            // usually do better than that
+            double const ratio = static_cast<double>(compressed_size) / size;
+            update_average(ratio_correction_,
+                ratio / (std::max)(estimated_ratio, 1.0 / 64));
+        }
+
+        bytes_saved.fetch_add(static_cast<std::int64_t>(size) -
+                static_cast<std::int64_t>(compressed_size),
+            std::memory_order_relaxed);
+        num_compressed_messages.fetch_add(1, std::memory_order_relaxed);
+        compression_time.fetch_add(time, std::memory_order_relaxed);
+    }
+
+    void adaptive_compression_statistics::decompressed(
+        std::size_t size, std::int64_t time) noexcept
+    {
+        if (size != 0)
+        {
+            update_average(
+                decompression_cost_, static_cast<double>(time) / size);
+        }
+        decompression_time.fetch_add(time, std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t get_bytes_saved(bool reset)
+    {
+        return hpx::util::get_and_reset_value(bytes_saved, reset);
+    }
+
+    std::int64_t get_num_compressed_messages(bool reset)
+    {
+        return hpx::util::get_and_reset_value(num_compressed_messages, reset);
+    }
+
+    std::int64_t get_num_skipped_messages(bool reset)
+    {
+        return hpx::util::get_and_reset_value(num_skipped_messages, reset);
+    }
+
+    std::int64_t get_compression_time(bool reset)
+    {
+        return hpx::util::get_and_reset_value(compression_time, reset);
+    }
+
+    std::int64_t get_decompression_time(bool reset)
+    {
+        return hpx::util::get_and_reset_value(decompression_time, reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void register_counter_types()
+    {
+        namespace pc = hpx::performance_counters;
+
+        pc::install_counter_type("/compression/count/bytes-saved",
+            &get_bytes_saved,
+            "returns the number of bytes the adaptive serialization filter "
+            "saved by compressing messages",
+            "bytes", pc::counter_type::monotonically_increasing);
+        pc::install_counter_type("/compression/count/compressed",
+            &get_num_compressed_messages,
+            "returns the number of messages the adaptive serialization "
+            "filter has compressed",
+            "", pc::counter_type::monotonically_increasing);
+        pc::install_counter_type("/compression/count/skipped",
+            &get_num_skipped_messages,
+            "returns the number of messages the adaptive serialization "
+            "filter has sent without compressing them",
+            "", pc::counter_type::monotonically_increasing);
+        pc::install_counter_type("/compression/time/compress",
+            &get_compression_time,
+            "returns the time the adaptive serialization filter has spent "
+            "compressing messages",
+            "ns", pc::counter_type::monotonically_increasing);
+        pc::install_counter_type("/compression/time/decompress",
+            &get_decompression_time,
+            "returns the time the adaptive serialization filter has spent "
+            "decompressing messages",
+            "ns", pc::counter_type::monotonically_increasing);
+    }
+
+    bool get_startup(
+        hpx::startup_function_type& startup_func, bool& pre_startup)
+    {
+        startup_func = register_counter_types;
+        pre_startup = true;
+        return true;
+    }
+}    // namespace hpx::plugins::compression
+
+///////////////////////////////////////////////////////////////////////////////
+// Register a startup function which will be called as a HPX-thread during
+// runtime startup. We use this function to register our performance counter
+// types.
+HPX_REGISTER_STARTUP_MODULE_DYNAMIC(hpx::plugins::compression::get_startup)
+
+#endif
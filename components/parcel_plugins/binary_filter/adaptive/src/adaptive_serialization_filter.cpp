@@ -0,0 +1,258 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ADAPTIVE)
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/plugin/traits/plugin_config_data.hpp>
+
+#include <hpx/binary_filter/adaptive_compression_statistics.hpp>
+#include <hpx/binary_filter/adaptive_serialization_filter.hpp>
+#include <hpx/plugin_factories/binary_filter_factory.hpp>
+#include <hpx/plugin_factories/plugin_registry.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace hpx::traits {
+
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.plugins.adaptive_serialization_filter]
+    //      ...
+    //      min_size = 4096
+    //      bandwidth = 1000
+    //      probe_interval = 64
+    //
+    template <>
+    struct plugin_config_data<
+        hpx::plugins::compression::adaptive_serialization_filter>
+    {
+        static constexpr char const* call() noexcept
+        {
+            return "min_size = 4096\n"
+                   "bandwidth = 1000\n"
+                   "probe_interval = 64";
+        }
+    };
+}    // namespace hpx::traits
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE_DYNAMIC()
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::adaptive_serialization_filter,
+    adaptive_serialization_filter)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx::plugins::compression {
+
+    adaptive_serialization_filter::adaptive_serialization_filter(
+        bool compress, serialization::binary_filter* next_filter) noexcept
+      : codec_(next_filter)
+      , data_(nullptr)
+      , size_(0)
+      , current_(0)
+      , method_(method::unknown)
+      , estimated_ratio_(1.0)
+      , compression_time_(0)
+      , compressed_size_(0)
+      , header_written_(false)
+      , compress_(compress)
+    {
+    }
+
+    adaptive_serialization_filter::~adaptive_serialization_filter()
+    {
+        delete codec_;
+    }
+
+    void adaptive_serialization_filter::set_max_length(std::size_t size)
+    {
+        buffer_.reserve(size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t adaptive_serialization_filter::init_data(
+        void const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        char const* data = static_cast<char const*>(buffer);
+        if (size == 0 ||
+            (data[0] != static_cast<char>(method::stored) &&
+                (data[0] != static_cast<char>(method::compressed) ||
+                    codec_ == nullptr)))
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "adaptive_serialization_filter::init_data",
+                "archive data is corrupted");
+            return 0;
+        }
+
+        method_ = static_cast<method>(data[0]);
+        if (method_ == method::compressed)
+        {
+            std::int64_t const started_at =
+                hpx::chrono::high_resolution_clock::now();
+
+            std::size_t const result =
+                codec_->init_data(data + 1, size - 1, buffer_size);
+
+            adaptive_compression_statistics::get(*codec_).decompressed(
+                buffer_size,
+                hpx::chrono::high_resolution_clock::now() - started_at);
+
+            return result;
+        }
+
+        // the message data is read directly from the received buffer
+        data_ = data + 1;
+        size_ = size - 1;
+        current_ = 0;
+
+        if (size_ != buffer_size)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "adaptive_serialization_filter::init_data",
+                "archive data bstream is too short");
+            return 0;
+        }
+        return size_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void adaptive_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (method_ == method::compressed)
+        {
+            codec_->load(dst, dst_count);
+            return;
+        }
+
+        if (current_ + dst_count > size_)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "adaptive_serialization_filter::load",
+                "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, data_ + current_, dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void adaptive_serialization_filter::save(
+        void const* src, std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        std::copy(
+            src_begin, src_begin + src_count, std::back_inserter(buffer_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    adaptive_serialization_filter::method
+    adaptive_serialization_filter::select_method()
+    {
+        if (!compress_ || codec_ == nullptr)
+        {
+            return method::stored;
+        }
+
+        adaptive_compression_statistics& stats =
+            adaptive_compression_statistics::get(*codec_);
+
+        estimated_ratio_ =
+            estimate_compression_ratio(buffer_.data(), buffer_.size());
+        if (!stats.should_compress(buffer_.size(), estimated_ratio_))
+        {
+            return method::stored;
+        }
+
+        // hand the data to the codec, it is compressed while flushing
+        std::int64_t const started_at =
+            hpx::chrono::high_resolution_clock::now();
+
+        codec_->set_max_length(buffer_.size());
+        codec_->save(buffer_.data(), buffer_.size());
+
+        compression_time_ =
+            hpx::chrono::high_resolution_clock::now() - started_at;
+        return method::compressed;
+    }
+
+    bool adaptive_serialization_filter::flush(
+        void* dst, std::size_t dst_count, std::size_t& written)
+    {
+        // this may be invoked more than once if dst is too small
+        if (method_ == method::unknown)
+        {
+            method_ = select_method();
+        }
+
+        written = 0;
+        char* dst_begin = static_cast<char*>(dst);
+
+        if (method_ == method::stored)
+        {
+            // make sure we have enough memory
+            if (buffer_.size() + 1 > dst_count)
+            {
+                return false;
+            }
+
+            dst_begin[0] = static_cast<char>(method_);
+            std::memcpy(dst_begin + 1, buffer_.data(), buffer_.size());
+            written = buffer_.size() + 1;
+            return true;
+        }
+
+        // The codec may need more than one call to write all of its output,
+        // every call continues where the previous one stopped. The method
+        // byte is written only in front of the first part.
+        std::size_t header_size = 0;
+        if (!header_written_)
+        {
+            if (dst_count == 0)
+            {
+                return false;
+            }
+
+            dst_begin[0] = static_cast<char>(method_);
+            header_written_ = true;
+            header_size = 1;
+        }
+
+        std::int64_t const started_at =
+            hpx::chrono::high_resolution_clock::now();
+
+        std::size_t compressed_size = 0;
+        bool const flushed = codec_->flush(dst_begin + header_size,
+            dst_count - header_size, compressed_size);
+
+        compression_time_ +=
+            hpx::chrono::high_resolution_clock::now() - started_at;
+        compressed_size_ += compressed_size;
+        written = compressed_size + header_size;
+
+        if (!flushed)
+        {
+            return false;
+        }
+
+        adaptive_compression_statistics::get(*codec_).compressed(
+            buffer_.size(), compressed_size_ + 1, estimated_ratio_,
+            compression_time_);
+        return true;
+    }
+}    // namespace hpx::plugins::compression
+
+#endif
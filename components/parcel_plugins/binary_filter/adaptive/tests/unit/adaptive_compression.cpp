@@ -0,0 +1,219 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE) && defined(HPX_HAVE_COMPRESSION_ADAPTIVE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/compression_adaptive.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// use any of the available codecs
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+#define HPX_TEST_CODEC "lz4_serialization_filter"
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+#define HPX_TEST_CODEC "zstd_serialization_filter"
+#elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
+#define HPX_TEST_CODEC "snappy_serialization_filter"
+#elif defined(HPX_HAVE_COMPRESSION_ZLIB)
+#define HPX_TEST_CODEC "zlib_serialization_filter"
+#else
+#define HPX_TEST_CODEC "bzip2_serialization_filter"
+#endif
+
+using hpx::plugins::compression::adaptive_serialization_filter;
+
+///////////////////////////////////////////////////////////////////////////////
+// A codec which stores the data as it is, but writes at most chunk_size
+// bytes per call to flush, like the zlib and bzip2 filters do when they run
+// out of space.
+struct chunked_copy_filter : hpx::serialization::binary_filter
+{
+    static constexpr std::size_t chunk_size = 64;
+
+    void set_max_length(std::size_t size) override
+    {
+        buffer_.reserve(size);
+    }
+
+    void save(void const* src, std::size_t src_count) override
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        buffer_.insert(buffer_.end(), src_begin, src_begin + src_count);
+    }
+
+    bool flush(void* dst, std::size_t dst_count, std::size_t& written) override
+    {
+        written = (std::min)(
+            (std::min)(dst_count, chunk_size), buffer_.size() - current_);
+        std::memcpy(dst, buffer_.data() + current_, written);
+        current_ += written;
+        ++num_flushes_;
+        return current_ == buffer_.size();
+    }
+
+    std::size_t init_data(void const* buffer, std::size_t size,
+        std::size_t buffer_size) override
+    {
+        HPX_TEST_EQ(size, buffer_size);
+
+        char const* data = static_cast<char const*>(buffer);
+        buffer_.assign(data, data + size);
+        current_ = 0;
+        return size;
+    }
+
+    void load(void* dst, std::size_t dst_count) override
+    {
+        HPX_TEST_LTE(current_ + dst_count, buffer_.size());
+
+        std::memcpy(dst, buffer_.data() + current_, dst_count);
+        current_ += dst_count;
+    }
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned)
+    {
+    }
+    HPX_SERIALIZATION_POLYMORPHIC(chunked_copy_filter, override);
+
+    std::vector<char> buffer_;
+    std::size_t current_ = 0;
+    std::size_t num_flushes_ = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t large_size = 64 * 1024;
+constexpr std::size_t small_size = 64;
+
+std::vector<char> make_compressible_data(std::size_t size)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        data[i] = static_cast<char>('a' + i % 4);
+    }
+    return data;
+}
+
+std::vector<char> make_random_data(std::size_t size)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<char> data(size);
+    for (char& c : data)
+    {
+        c = static_cast<char>(dist(gen));
+    }
+    return data;
+}
+
+// The codec may need several calls to flush its output, the method byte has
+// to be written only once in front of all of it.
+void test_partial_flush()
+{
+    std::vector<char> const data = make_compressible_data(large_size);
+
+    chunked_copy_filter* codec = new chunked_copy_filter;
+    adaptive_serialization_filter compressor(true, codec);
+    compressor.set_max_length(data.size());
+    compressor.save(data.data(), data.size());
+
+    // grow the output like filtered_output_container does
+    std::vector<char> out(16);
+    std::size_t current = 0;
+    while (true)
+    {
+        std::size_t written = 0;
+        bool const flushed = compressor.flush(
+            out.data() + current, out.size() - current, written);
+
+        current += written;
+        if (flushed)
+        {
+            break;
+        }
+        out.resize(2 * out.size());
+    }
+
+    // the first message of a codec is always compressed
+    HPX_TEST_LT(std::size_t(1), codec->num_flushes_);
+    HPX_TEST_EQ(current, data.size() + 1);
+    HPX_TEST_EQ(out[0], char(1));
+
+    adaptive_serialization_filter decompressor(false, new chunked_copy_filter);
+    HPX_TEST_EQ(decompressor.init_data(out.data(), current, data.size()),
+        data.size());
+
+    std::vector<char> result(data.size());
+    decompressor.load(result.data(), result.size());
+    HPX_TEST(result == data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> echo(std::vector<char> const& data)
+{
+    return data;
+}
+
+HPX_PLAIN_ACTION(echo, echo_action)
+HPX_ACTION_USES_ADAPTIVE_COMPRESSION(echo_action, HPX_TEST_CODEC)
+
+std::int64_t get_counter_value(char const* name)
+{
+    hpx::performance_counters::performance_counter counter(name);
+    return counter.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+void test_parcels(hpx::id_type const& dest)
+{
+    std::vector<std::vector<char>> messages = {
+        make_compressible_data(large_size), make_random_data(large_size),
+        make_compressible_data(small_size)};
+
+    for (std::vector<char> const& data : messages)
+    {
+        HPX_TEST(echo_action()(dest, data) == data);
+    }
+
+    // the first large message is always compressed, small ones never
+    HPX_TEST_LT(std::int64_t(0),
+        get_counter_value("/compression{locality#0/total}/count/compressed"));
+    HPX_TEST_LT(std::int64_t(0),
+        get_counter_value("/compression{locality#0/total}/count/skipped"));
+}
+
+int hpx_main()
+{
+    test_partial_flush();
+
+    for (hpx::id_type const& dest : hpx::find_remote_localities())
+    {
+        test_parcels(dest);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
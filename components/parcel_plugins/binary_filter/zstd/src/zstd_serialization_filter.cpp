@@ -0,0 +1,184 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ZSTD)
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/runtime_local.hpp>
+#include <hpx/plugin/traits/plugin_config_data.hpp>
+#include <hpx/util/from_string.hpp>
+
+#include <hpx/binary_filter/zstd_serialization_filter.hpp>
+#include <hpx/plugin_factories/binary_filter_factory.hpp>
+#include <hpx/plugin_factories/plugin_registry.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+#include <zstd.h>
+
+namespace hpx::traits {
+
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.plugins.zstd_serialization_filter]
+    //      ...
+    //      level = 1
+    //
+    template <>
+    struct plugin_config_data<
+        hpx::plugins::compression::zstd_serialization_filter>
+    {
+        static constexpr char const* call() noexcept
+        {
+            return "level = 1";
+        }
+    };
+}    // namespace hpx::traits
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::zstd_serialization_filter,
+    zstd_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx::plugins::compression {
+
+    namespace detail {
+
+        int get_compression_level()
+        {
+            static int const level = hpx::util::from_string<int>(
+                hpx::get_config_entry(
+                    "hpx.plugins.zstd_serialization_filter.level", "1"),
+                1);
+            return level;
+        }
+
+        // The contexts are expensive to create, each thread reuses its own
+        struct cctx_deleter
+        {
+            void operator()(ZSTD_CCtx* ctx) const noexcept
+            {
+                ZSTD_freeCCtx(ctx);
+            }
+        };
+
+        struct dctx_deleter
+        {
+            void operator()(ZSTD_DCtx* ctx) const noexcept
+            {
+                ZSTD_freeDCtx(ctx);
+            }
+        };
+
+        ZSTD_CCtx* get_compression_context()
+        {
+            static thread_local std::unique_ptr<ZSTD_CCtx, cctx_deleter> ctx(
+                ZSTD_createCCtx());
+            return ctx.get();
+        }
+
+        ZSTD_DCtx* get_decompression_context()
+        {
+            static thread_local std::unique_ptr<ZSTD_DCtx, dctx_deleter> ctx(
+                ZSTD_createDCtx());
+            return ctx.get();
+        }
+    }    // namespace detail
+
+    void zstd_serialization_filter::set_max_length(std::size_t size)
+    {
+        buffer_.reserve(size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t zstd_serialization_filter::init_data(
+        void const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        buffer_.resize(buffer_size);
+
+        std::size_t const decompressed_length =
+            ZSTD_decompressDCtx(detail::get_decompression_context(),
+                buffer_.data(), buffer_size, buffer, size);
+
+        if (ZSTD_isError(decompressed_length) ||
+            decompressed_length != buffer_size)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::init_data",
+                "decompression failure, archive data is corrupted");
+            return 0;
+        }
+
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void zstd_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_ + dst_count > buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::load",
+                "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void zstd_serialization_filter::save(
+        void const* src, std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        std::copy(
+            src_begin, src_begin + src_count, std::back_inserter(buffer_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool zstd_serialization_filter::flush(
+        void* dst, std::size_t dst_count, std::size_t& written)
+    {
+        // make sure we have enough memory
+        std::size_t needed = ZSTD_compressBound(buffer_.size());
+        if (needed > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        // compress everything in one go
+        std::size_t const compressed_length =
+            ZSTD_compressCCtx(detail::get_compression_context(), dst,
+                dst_count, buffer_.data(), buffer_.size(),
+                detail::get_compression_level());
+
+        if (ZSTD_isError(compressed_length))
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::flush",
+                "compression failure: {}",
+                ZSTD_getErrorName(compressed_length));
+            return false;
+        }
+
+        written = compressed_length;
+        return true;
+    }
+}    // namespace hpx::plugins::compression
+
+#endif
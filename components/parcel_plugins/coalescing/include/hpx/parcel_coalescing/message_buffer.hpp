@@ -164,6 +164,18 @@ namespace hpx::plugins::parcel::detail {
             return max_messages_;
         }
 
+        // the new capacity applies to the next appended message
+        void set_capacity(std::size_t max_messages)
+        {
+            max_messages_ = max_messages;
+        }
+
+        parcelset::write_handler_type& front_handler()
+        {
+            HPX_ASSERT(!handlers_.empty());
+            return handlers_.front();
+        }
+
     private:
         parcelset::locality dest_;
         std::vector<parcelset::parcel> messages_;
@@ -56,6 +56,8 @@ namespace hpx::plugins::parcel {
         std::int64_t get_messages_count(bool reset);
         std::int64_t get_parcels_per_message_count(bool reset);
         std::int64_t get_average_time_between_parcels(bool reset);
+        std::int64_t get_buffer_size(bool reset);
+        std::int64_t get_flush_interval(bool reset);
         std::vector<std::int64_t> get_time_between_parcels_histogram(
             bool reset);
         void get_time_between_parcels_histogram_creator(
@@ -75,6 +77,11 @@ namespace hpx::plugins::parcel {
         void update_num_messages();
         void update_interval();
 
+        // adaptive mode: adjust the buffer size and the flush interval
+        void adapt_parameters_locked();
+        void measure_send_time(write_handler_type& f);
+        void send_time_measured(std::int64_t started_at);
+
     private:
         mutable mutex_type mtx_;
         parcelset::parcelport* pp_;
@@ -86,6 +93,14 @@ namespace hpx::plugins::parcel {
         bool allow_background_flush_;
         std::string action_name_;
 
+        // adaptive mode data, all times are in [ns]
+        bool adaptive_;
+        std::int64_t latency_budget_;
+        std::size_t max_num_coalesced_parcels_;
+        std::int64_t average_time_between_parcels_;
+        std::int64_t average_send_time_;
+        bool send_time_measurement_pending_;
+
         // performance counter data
         std::int64_t num_parcels_;
         std::int64_t reset_num_parcels_;
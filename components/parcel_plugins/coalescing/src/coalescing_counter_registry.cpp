@@ -33,6 +33,7 @@ namespace hpx::plugins::parcel {
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type num_parcels_per_message,
         get_counter_type average_time_between_parcels,
+        get_counter_type buffer_size, get_counter_type flush_interval,
         get_counter_values_creator_type time_between_parcels_histogram_creator)
     {
         if (name.empty())
@@ -49,6 +50,7 @@ namespace hpx::plugins::parcel {
         {
             counter_functions data = {num_parcels, num_messages,
                 num_parcels_per_message, average_time_between_parcels,
+                buffer_size, flush_interval,
                 time_between_parcels_histogram_creator, 0, 0, 1};
 
             map_.emplace(name, HPX_MOVE(data));
@@ -61,6 +63,8 @@ namespace hpx::plugins::parcel {
             (*it).second.num_parcels_per_message = num_parcels_per_message;
             (*it).second.average_time_between_parcels =
                 average_time_between_parcels;
+            (*it).second.buffer_size = buffer_size;
+            (*it).second.flush_interval = flush_interval;
             (*it).second.time_between_parcels_histogram_creator =
                 time_between_parcels_histogram_creator;
 
@@ -78,6 +82,8 @@ namespace hpx::plugins::parcel {
             (void) (*it).second.num_messages;
             (void) (*it).second.num_parcels_per_message;
             (void) (*it).second.average_time_between_parcels;
+            (void) (*it).second.buffer_size;
+            (void) (*it).second.flush_interval;
             (void) (*it).second.time_between_parcels_histogram_creator;
         }
     }
@@ -174,6 +180,42 @@ namespace hpx::plugins::parcel {
         return (*it).second.average_time_between_parcels;
     }
 
+    coalescing_counter_registry::get_counter_type
+    coalescing_counter_registry::get_buffer_size_counter(
+        std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_buffer_size_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.buffer_size;
+    }
+
+    coalescing_counter_registry::get_counter_type
+    coalescing_counter_registry::get_flush_interval_counter(
+        std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_flush_interval_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.flush_interval;
+    }
+
     coalescing_counter_registry::get_counter_values_type
     coalescing_counter_registry::get_time_between_parcels_histogram_counter(
         std::string const& name, std::int64_t min_boundary,
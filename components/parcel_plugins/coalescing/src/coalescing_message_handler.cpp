@@ -23,11 +23,13 @@
 
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,9 @@ namespace hpx::traits {
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      adaptive = 0
+    //      latency_budget = 1000
+    //      max_num_messages = 1024
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -49,7 +54,10 @@ namespace hpx::traits {
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0\n"
+                   "latency_budget = 1000\n"
+                   "max_num_messages = 1024";
         }
     };
 }    // namespace hpx::traits
@@ -84,6 +92,30 @@ namespace hpx::plugins::parcel {
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        // the latency budget is specified in [us], returned in [ns]
+        std::int64_t get_latency_budget()
+        {
+            std::int64_t const budget =
+                hpx::util::from_string<std::int64_t>(hpx::get_config_entry(
+                    "hpx.plugins.coalescing_message_handler.latency_budget",
+                    "1000"));
+            return budget * 1000;
+        }
+
+        std::size_t get_max_num_messages()
+        {
+            return hpx::util::from_string<std::size_t>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.max_num_messages",
+                "1024"));
+        }
     }    // namespace detail
 
     void coalescing_message_handler::update_num_messages()
@@ -112,6 +144,14 @@ namespace hpx::plugins::parcel {
       , stopped_(false)
       , allow_background_flush_(detail::get_background_flush())
       , action_name_(action_name)
+      , adaptive_(detail::get_adaptive())
+      , latency_budget_((std::max)(detail::get_latency_budget(),
+            static_cast<std::int64_t>(1000)))
+      , max_num_coalesced_parcels_(
+            (std::max)(detail::get_max_num_messages(), std::size_t(1)))
+      , average_time_between_parcels_(0)
+      , average_send_time_(0)
+      , send_time_measurement_pending_(false)
       , num_parcels_(0)
       , reset_num_parcels_(0)
       , reset_num_parcels_per_message_parcels_(0)
@@ -137,6 +177,10 @@ namespace hpx::plugins::parcel {
             hpx::bind_front(
                 &coalescing_message_handler::get_average_time_between_parcels,
                 this),
+            hpx::bind_front(
+                &coalescing_message_handler::get_buffer_size, this),
+            hpx::bind_front(
+                &coalescing_message_handler::get_flush_interval, this),
             hpx::bind_front(&coalescing_message_handler::
                                 get_time_between_parcels_histogram_creator,
                 this));
@@ -165,6 +209,24 @@ namespace hpx::plugins::parcel {
         if (time_between_parcels_)
             (*time_between_parcels_)(time_since_last_parcel);
 
+        if (adaptive_)
+        {
+            // pauses longer than the latency budget are irrelevant for
+            // coalescing, don't let those dominate the average
+            std::int64_t const sample =
+                (std::min)(time_since_last_parcel, latency_budget_);
+            if (average_time_between_parcels_ == 0)
+            {
+                average_time_between_parcels_ = sample;
+            }
+            else
+            {
+                average_time_between_parcels_ +=
+                    (sample - average_time_between_parcels_) / 8;
+            }
+            adapt_parameters_locked();
+        }
+
         std::chrono::microseconds interval(interval_);
 
         // just send parcel if the coalescing was stopped or the buffer is
@@ -174,6 +236,7 @@ namespace hpx::plugins::parcel {
                 std::chrono::nanoseconds(time_since_last_parcel) > interval))
         {
             ++num_messages_;
+            measure_send_time(f);
             l.unlock();
 
             // this instance should not buffer parcels anymore
@@ -276,6 +339,7 @@ namespace hpx::plugins::parcel {
         std::swap(buff, buffer_);
 
         ++num_messages_;
+        measure_send_time(buff.front_handler());
         l.unlock();
 
         HPX_ASSERT(nullptr != pp_);
@@ -284,6 +348,76 @@ namespace hpx::plugins::parcel {
         return true;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Coalescing pays off only if parcels arrive faster than separate
+    // messages could be sent. In this case as many parcels as are expected to
+    // arrive within the latency budget are combined into one message,
+    // otherwise each parcel is sent right away.
+    void coalescing_message_handler::adapt_parameters_locked()
+    {
+        HPX_ASSERT(adaptive_);
+        HPX_ASSERT(average_time_between_parcels_ >= 0);
+
+        std::int64_t const time_between_parcels =
+            (std::max)(average_time_between_parcels_, std::int64_t(1));
+
+        std::size_t num_parcels = 1;
+        if (time_between_parcels < average_send_time_)
+        {
+            num_parcels = static_cast<std::size_t>(
+                latency_budget_ / time_between_parcels);
+            num_parcels = (std::min)((std::max)(num_parcels, std::size_t(2)),
+                max_num_coalesced_parcels_);
+        }
+
+        // wait for the last parcel of a message to arrive, but not longer
+        // than the latency budget allows
+        std::int64_t const interval = (std::min)(
+            static_cast<std::int64_t>(num_parcels) * time_between_parcels,
+            latency_budget_);
+
+        num_coalesced_parcels_ = num_parcels;
+        interval_ = static_cast<std::size_t>(
+            (std::max)(interval / 1000, std::int64_t(1)));
+
+        buffer_.set_capacity(num_coalesced_parcels_);
+    }
+
+    // Measure the time it takes to write the message the given handler
+    // belongs to. Only one measurement is in flight at any time.
+    void coalescing_message_handler::measure_send_time(write_handler_type& f)
+    {
+        if (!adaptive_ || send_time_measurement_pending_)
+            return;
+
+        send_time_measurement_pending_ = true;
+        f = [this, started_at = hpx::chrono::high_resolution_clock::now(),
+                f = HPX_MOVE(f)](std::error_code const& ec,
+                parcelset::parcel const& p) {
+            send_time_measured(started_at);
+            if (f)
+                f(ec, p);
+        };
+    }
+
+    void coalescing_message_handler::send_time_measured(
+        std::int64_t started_at)
+    {
+        std::int64_t const sample =
+            hpx::chrono::high_resolution_clock::now() - started_at;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        if (average_send_time_ == 0)
+        {
+            average_send_time_ = sample;
+        }
+        else
+        {
+            average_send_time_ += (sample - average_send_time_) / 8;
+        }
+        send_time_measurement_pending_ = false;
+    }
+
     // performance counter values
     std::int64_t coalescing_message_handler::get_average_time_between_parcels(
         bool reset)
@@ -317,6 +451,19 @@ namespace hpx::plugins::parcel {
         return value;
     }
 
+    std::int64_t coalescing_message_handler::get_buffer_size(bool /* reset */)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return static_cast<std::int64_t>(num_coalesced_parcels_);
+    }
+
+    std::int64_t coalescing_message_handler::get_flush_interval(
+        bool /* reset */)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return static_cast<std::int64_t>(interval_) * 1000;
+    }
+
     std::int64_t coalescing_message_handler::get_parcels_count(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
@@ -0,0 +1,159 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the adaptive coalescing message handler changes the number of
+// coalesced parcels and the flush interval depending on the parcel rate.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/parcel_coalescing.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// the static settings, these are replaced once parcels are sent
+std::int64_t const num_messages = 50;
+std::int64_t const interval = 100;    // [us]
+
+std::int64_t const latency_budget = 2000;    // [us]
+std::int64_t const max_num_messages = 1024;
+
+std::size_t const numparcels_burst = 100;
+std::size_t const numparcels_sparse = 20;
+
+///////////////////////////////////////////////////////////////////////////////
+int echo(int i)
+{
+    return i;
+}
+HPX_DECLARE_PLAIN_ACTION(echo, adaptive_echo_action)
+HPX_ACTION_USES_MESSAGE_COALESCING(adaptive_echo_action)
+HPX_PLAIN_ACTION(echo, adaptive_echo_action)
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::parcelset::parcel generate_parcel(
+    hpx::id_type const& dest_id, hpx::id_type const& cont, int i)
+{
+    hpx::naming::address addr;
+    hpx::naming::gid_type dest = dest_id.get_gid();
+    hpx::naming::detail::strip_credits_from_gid(dest);
+    hpx::parcelset::parcel p(hpx::parcelset::detail::create_parcel::call(
+        std::move(dest), std::move(addr),
+        hpx::actions::typed_continuation<int>(cont), adaptive_echo_action(),
+        hpx::threads::thread_priority::normal, i));
+
+    p.set_source_id(hpx::find_here());
+    return p;
+}
+
+std::int64_t get_counter(char const* name)
+{
+    std::string const counter_name = "/coalescing{locality#" +
+        std::to_string(hpx::get_locality_id()) + "/total}/" + name +
+        "@adaptive_echo_action";
+
+    hpx::performance_counters::performance_counter counter(counter_name);
+    return counter.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Parcels handed to the parcel handler at once arrive faster than they could
+// be sent separately, they are coalesced.
+void test_burst(hpx::id_type const& id)
+{
+    // the time needed to send a message is known after the first burst
+    for (int round = 0; round != 3; ++round)
+    {
+        std::vector<hpx::future<int>> results;
+        std::vector<hpx::parcelset::parcel> parcels;
+        for (std::size_t i = 0; i != numparcels_burst; ++i)
+        {
+            hpx::distributed::promise<int> p;
+            results.push_back(p.get_future());
+            parcels.push_back(generate_parcel(id, p.get_id(), int(i)));
+        }
+
+        hpx::get_runtime_distributed().get_parcel_handler().put_parcels(
+            std::move(parcels));
+
+        for (std::size_t i = 0; i != numparcels_burst; ++i)
+        {
+            HPX_TEST_EQ(results[i].get(), int(i));
+        }
+    }
+
+    std::int64_t const buffer_size = get_counter("count/buffer-size");
+    HPX_TEST_LT(std::int64_t(1), buffer_size);
+    HPX_TEST_LTE(buffer_size, max_num_messages);
+
+    std::int64_t const flush_interval = get_counter("time/flush-interval");
+    HPX_TEST_LT(std::int64_t(0), flush_interval);
+    HPX_TEST_LTE(flush_interval, latency_budget * 1000);
+}
+
+// Parcels arriving less often than the latency budget are sent right away.
+void test_sparse(hpx::id_type const& id)
+{
+    for (std::size_t i = 0; i != numparcels_sparse; ++i)
+    {
+        HPX_TEST_EQ(adaptive_echo_action()(id, int(i)), int(i));
+        hpx::this_thread::sleep_for(
+            std::chrono::microseconds(2 * latency_budget));
+    }
+
+    HPX_TEST_EQ(get_counter("count/buffer-size"), std::int64_t(1));
+
+    std::int64_t const flush_interval = get_counter("time/flush-interval");
+    HPX_TEST_LT(interval * 1000, flush_interval);
+    HPX_TEST_LTE(flush_interval, latency_budget * 1000);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        test_burst(id);
+        test_sparse(id);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // explicitly enable message handlers (parcel coalescing) in adaptive mode
+    std::vector<std::string> const cfg = {"hpx.parcel.message_handlers=1",
+        "hpx.plugins.coalescing_message_handler.adaptive=1",
+        "hpx.plugins.coalescing_message_handler.num_messages=" +
+            std::to_string(num_messages),
+        "hpx.plugins.coalescing_message_handler.interval=" +
+            std::to_string(interval),
+        "hpx.plugins.coalescing_message_handler.latency_budget=" +
+            std::to_string(latency_budget),
+        "hpx.plugins.coalescing_message_handler.max_num_messages=" +
+            std::to_string(max_num_messages)};
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
@@ -253,6 +253,12 @@ int hpx_main(hpx::program_options::variables_map& vm)
     print_counters("/coalescing{locality#0/total}/count/messages@test1_action");
     print_counters("/coalescing{locality#0/total}/count/messages@test2_action");
 
+    // the coalescing parameters are reported even if not adapted at runtime
+    print_counters(
+        "/coalescing{locality#0/total}/count/buffer-size@test1_action");
+    print_counters(
+        "/coalescing{locality#0/total}/time/flush-interval@test1_action");
+
     return hpx::finalize();
 }
 
@@ -859,6 +859,15 @@ namespace hpx {
         /// new thread is executed in a preferred way
         HPX_CORE_EXPORT static const detail::fork_policy fork;
 
+        /// Predefined launch policy representing asynchronous execution of
+        /// tasks that run to completion without ever suspending. The new
+        /// thread is stackless, it runs directly on the stack of the
+        /// scheduling loop without allocating a stack or switching contexts.
+        /// Any attempt of such a task to suspend reports an error of type
+        /// \a hpx::error::invalid_status.
+        HPX_CORE_EXPORT static const detail::async_policy
+            inline_if_nonblocking;
+
         /// Predefined launch policy representing synchronous execution
         HPX_CORE_EXPORT static const detail::sync_policy sync;
 
@@ -69,6 +69,34 @@ namespace hpx { namespace execution { namespace experimental {
     {
     } get_hint{};
 
+    // Executors and launch policies supporting scheduling hints support
+    // deadlines as well, the deadline is carried by the scheduling hint.
+    inline constexpr struct with_deadline_t final
+      : hpx::functional::detail::tag_fallback<with_deadline_t>
+    {
+    private:
+        template <typename Target, typename Deadline>
+        friend HPX_FORCEINLINE constexpr decltype(auto) tag_fallback_invoke(
+            with_deadline_t, Target&& target, Deadline const& deadline)
+        {
+            auto hint = get_hint(target);
+            hint.deadline = deadline;
+            return with_hint(HPX_FORWARD(Target, target), hint);
+        }
+    } with_deadline{};
+
+    inline constexpr struct get_deadline_t final
+      : hpx::functional::detail::tag_fallback<get_deadline_t>
+    {
+    private:
+        template <typename Target>
+        friend HPX_FORCEINLINE constexpr decltype(auto) tag_fallback_invoke(
+            get_deadline_t, Target const& target)
+        {
+            return get_hint(target).deadline;
+        }
+    } get_deadline{};
+
     inline constexpr struct with_annotation_t final
       : detail::property_base<with_annotation_t>
     {
@@ -17,6 +17,9 @@ namespace hpx {
         detail::async_policy{threads::thread_priority::default_};
     const detail::fork_policy launch::fork =
         detail::fork_policy{threads::thread_priority::default_};
+    const detail::async_policy launch::inline_if_nonblocking =
+        detail::async_policy{threads::thread_priority::default_,
+            threads::thread_stacksize::nostack};
     const detail::sync_policy launch::sync = detail::sync_policy{};
     const detail::deferred_policy launch::deferred = detail::deferred_policy{};
     const detail::apply_policy launch::apply = detail::apply_policy{};
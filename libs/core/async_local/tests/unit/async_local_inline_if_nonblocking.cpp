@@ -0,0 +1,120 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+bool is_stackless()
+{
+    return hpx::threads::get_self_id_data()->is_stackless();
+}
+
+std::int32_t increment(std::int32_t i)
+{
+    HPX_TEST(is_stackless());
+    return i + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_async()
+{
+    hpx::future<std::int32_t> f =
+        hpx::async(hpx::launch::inline_if_nonblocking, &increment, 41);
+    HPX_TEST_EQ(f.get(), 42);
+
+    constexpr std::size_t num_tasks = 1000;
+
+    std::atomic<std::size_t> count(0);
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        futures.push_back(
+            hpx::async(hpx::launch::inline_if_nonblocking, [&count]() {
+                HPX_TEST(is_stackless());
+                ++count;
+            }));
+    }
+    hpx::wait_all(futures);
+    HPX_TEST_EQ(count.load(), num_tasks);
+}
+
+void test_apply()
+{
+    constexpr std::size_t num_tasks = 1000;
+
+    // executors created from the launch policy run stackless tasks as well
+    hpx::execution::parallel_executor exec(hpx::launch::inline_if_nonblocking);
+
+    std::atomic<std::size_t> count(0);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        hpx::apply(exec, [&count]() {
+            HPX_TEST(is_stackless());
+            ++count;
+        });
+    }
+
+    while (count.load() != num_tasks)
+    {
+        hpx::this_thread::yield();
+    }
+}
+
+void test_suspension_is_diagnosed()
+{
+    hpx::promise<void> p;
+    hpx::shared_future<void> never_ready = p.get_future();
+
+    hpx::future<void> f =
+        hpx::async(hpx::launch::inline_if_nonblocking, [never_ready]() {
+            // waiting for a future which is not ready requires suspension
+            never_ready.get();
+        });
+
+    bool caught_exception = false;
+    try
+    {
+        f.get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const& e)
+    {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    p.set_value();
+}
+
+int hpx_main()
+{
+    test_async();
+    test_apply();
+    test_suspension_is_diagnosed();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::local::init(hpx_main, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
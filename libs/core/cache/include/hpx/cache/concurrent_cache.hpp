@@ -0,0 +1,719 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/cache/policies/always.hpp>
+#include <hpx/cache/statistics/no_statistics.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/functional/invoke.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/futures/promise.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx::util::cache {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \class concurrent_cache concurrent_cache.hpp hpx/cache/concurrent_cache.hpp
+    ///
+    /// \brief The \a concurrent_cache implements a local (non-distributed)
+    ///        cache which can be accessed concurrently by any number of
+    ///        threads.
+    ///
+    /// The entries are distributed over a number of independently locked
+    /// shards based on the hash of their keys, each shard stores its entries
+    /// in a hash map. Each shard holds an equal part of the overall capacity
+    /// of the cache. Whenever a shard has to free some space, a couple of its
+    /// entries are picked at random and the 'oldest' of those (according to
+    /// the \a UpdatePolicy) is discarded first. This approximates the
+    /// ordering maintained by the \a local_cache without having to reorder
+    /// the entries whenever one of them is touched.
+    ///
+    /// \tparam Key           The type of the keys to use to identify the
+    ///                       entries stored in the cache
+    /// \tparam Entry         The type of the items to be held in the cache,
+    ///                       must model the CacheEntry concept
+    /// \tparam UpdatePolicy  A (optional) type specifying a (binary) function
+    ///                       object used to compare the 'age' of the cache
+    ///                       entries, see \a local_cache. The default is
+    ///                       std::less<Entry>.
+    /// \tparam InsertPolicy  A (optional) type specifying a (unary) function
+    ///                       object used to allow global decisions whether a
+    ///                       particular entry should be added to the cache or
+    ///                       not. The default is \a policies#always.
+    /// \tparam Hash          A (optional) type of the function object used to
+    ///                       hash the keys. The default is std::hash<Key>.
+    /// \tparam KeyEqual      A (optional) type of the function object used to
+    ///                       compare keys for equality. The default is
+    ///                       std::equal_to<Key>.
+    /// \tparam Statistics    A (optional) type allowing to collect some basic
+    ///                       statistics about the operation of the cache
+    ///                       instance. The type must conform to the
+    ///                       CacheStatistics concept. Each shard maintains
+    ///                       its own instance of this type. The default value
+    ///                       is the type \a statistics#no_statistics.
+    template <typename Key, typename Entry,
+        typename UpdatePolicy = std::less<Entry>,
+        typename InsertPolicy = policies::always<Entry>,
+        typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+        typename Statistics = statistics::no_statistics>
+    class concurrent_cache
+    {
+    public:
+        using key_type = Key;
+        using entry_type = Entry;
+        using update_policy_type = UpdatePolicy;
+        using insert_policy_type = InsertPolicy;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using statistics_type = Statistics;
+
+        using value_type = typename entry_type::value_type;
+        using size_type = std::size_t;
+
+    private:
+        using mutex_type = hpx::spinlock;
+        using update_on_exit = typename statistics_type::update_on_exit;
+
+        // the number of entries compared while looking for an entry to evict
+        static constexpr std::size_t num_eviction_samples = 8;
+
+        struct node
+        {
+            template <typename Entry_>
+            node(Entry_&& e, std::size_t slot)
+              : entry_(HPX_FORWARD(Entry_, e))
+              , slot_(slot)
+            {
+            }
+
+            entry_type entry_;
+            std::size_t slot_;    // position in shard_data::slots_
+        };
+
+        using storage_type =
+            std::unordered_map<key_type, node, hasher, key_equal>;
+        using storage_value_type = typename storage_type::value_type;
+        using iterator = typename storage_type::iterator;
+
+        using pending_type = std::unordered_map<key_type,
+            hpx::shared_future<value_type>, hasher, key_equal>;
+
+        struct shard_data
+        {
+            mutable mutex_type mtx_;
+
+            storage_type store_;
+            size_type max_size_ = 0;
+            size_type current_size_ = 0;
+
+            // the stored entries in no particular order, used for picking
+            // entries at random while evicting
+            std::vector<storage_value_type*> slots_;
+            std::uint64_t random_state_ = 0x9e3779b97f4a7c15ull;
+
+            // the entries currently being computed by get_or_compute
+            pending_type pending_;
+
+            update_policy_type update_policy_;
+            insert_policy_type insert_policy_;
+
+            statistics_type statistics_;
+        };
+        using shard = cache_aligned_data_derived<shard_data>;
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Construct an instance of a concurrent_cache.
+        ///
+        /// \param max_size   [in] The maximal size this cache is allowed to
+        ///                   reach any time. The default is zero (no size
+        ///                   limitation). The unit of this value is determined
+        ///                   by the unit of the values returned by the entry's
+        ///                   \a get_size function, which allows to limit the
+        ///                   cache based on the cost (e.g. the number of
+        ///                   bytes) of the held entries.
+        /// \param num_shards [in] The number of independently locked shards,
+        ///                   this is rounded up to the next power of two.
+        /// \param up         [in] An instance of the \a UpdatePolicy to use
+        ///                   for this cache.
+        /// \param ip         [in] An instance of the \a InsertPolicy to use for
+        ///                   this cache.
+        ///
+        explicit concurrent_cache(size_type max_size = 0,
+            std::size_t num_shards = 16,
+            update_policy_type const& up = update_policy_type(),
+            insert_policy_type const& ip = insert_policy_type())
+          : num_shards_(1)
+          , max_size_(max_size)
+        {
+            while (num_shards_ < num_shards)
+            {
+                num_shards_ <<= 1;
+            }
+
+            shards_.reset(new shard[num_shards_]);
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                s.max_size_ = get_shard_capacity(max_size);
+                s.random_state_ += i;
+                s.update_policy_ = up;
+                s.insert_policy_ = ip;
+            }
+        }
+
+        concurrent_cache(concurrent_cache const&) = delete;
+        concurrent_cache& operator=(concurrent_cache const&) = delete;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Return current size of the cache.
+        ///
+        /// \returns The current size of this cache instance, this is the sum
+        ///          of the sizes of all held entries.
+        size_type size() const
+        {
+            size_type size = 0;
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                std::lock_guard<mutex_type> l(shards_[i].mtx_);
+                size += shards_[i].current_size_;
+            }
+            return size;
+        }
+
+        /// \brief Access the maximum size the cache is allowed to grow to.
+        ///
+        /// \returns    The maximum size this cache instance is currently
+        ///             allowed to reach. If this number is zero the cache has
+        ///             no limitation with regard to a maximum size.
+        size_type capacity() const noexcept
+        {
+            return max_size_;
+        }
+
+        /// \brief Return the number of independently locked shards.
+        constexpr std::size_t num_shards() const noexcept
+        {
+            return num_shards_;
+        }
+
+        /// \brief Change the maximum size this cache can grow to
+        ///
+        /// \param max_size    [in] The new maximum size this cache will be
+        ///             allowed to grow to.
+        ///
+        /// \returns    This function returns \a true if successful. It returns
+        ///             \a false if the new \a max_size is smaller than the
+        ///             current limit and the cache could not be shrunk to
+        ///             the new maximum size.
+        bool reserve(size_type max_size)
+        {
+            bool retval = true;
+            size_type const shard_max_size = get_shard_capacity(max_size);
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                if (shard_max_size != 0 && s.current_size_ > shard_max_size &&
+                    !free_space(s, s.current_size_ - shard_max_size))
+                {
+                    retval = false;    // not able to shrink the shard
+                }
+                s.max_size_ = shard_max_size;
+            }
+
+            max_size_ = max_size;
+            return retval;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Check whether the cache currently holds an entry identified
+        ///        by the given key
+        ///
+        /// \note         This function does not call the entry's function
+        ///               \a entry#touch.
+        bool holds_key(key_type const& k) const
+        {
+            shard const& s = get_shard(k);
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return s.store_.find(k) != s.store_.end();
+        }
+
+        /// \brief Get a specific entry identified by the given key.
+        ///
+        /// \param k      [in] The key for the entry which should be retrieved
+        ///               from the cache
+        /// \param val    [out] If the entry indexed by the key is found in the
+        ///               cache this value on successful return will be a copy
+        ///               of the corresponding value.
+        ///
+        /// \note         The function will call the entry's \a entry#touch
+        ///               function if the value corresponding to the provided
+        ///               is found in the cache.
+        ///
+        /// \returns      This function returns \a true if the cache holds the
+        ///               referenced entry, otherwise it returns \a false.
+        bool get_entry(key_type const& k, value_type& val)
+        {
+            shard& s = get_shard(k);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            update_on_exit update(s.statistics_, statistics::method::get_entry);
+
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end())
+            {
+                s.statistics_.got_miss();
+                return false;
+            }
+
+            // touching the entry doesn't require any reordering, the update
+            // policy is consulted only while evicting entries
+            it->second.entry_.touch();
+            s.statistics_.got_hit();
+
+            val = it->second.entry_.get();
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Insert a new element into this cache
+        ///
+        /// \note         See \a local_cache#insert. The insertion fails if
+        ///               the key is already held in the cache or if it was
+        ///               not possible to free enough space in the shard
+        ///               responsible for the given key.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully added to the cache, otherwise it returns
+        ///               \a false.
+        bool insert(key_type const& k, value_type const& val)
+        {
+            return insert(k, entry_type(val));
+        }
+
+        bool insert(key_type const& k, value_type&& val)
+        {
+            return insert(k, entry_type(HPX_MOVE(val)));
+        }
+
+        template <typename Entry_,
+            std::enable_if_t<
+                std::is_convertible_v<std::decay_t<Entry_>, entry_type>, int> =
+                0>
+        bool insert(key_type const& k, Entry_&& e)
+        {
+            shard& s = get_shard(k);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            update_on_exit update(
+                s.statistics_, statistics::method::insert_entry);
+
+            return insert_locked(s, k, HPX_FORWARD(Entry_, e));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Update an existing element in this cache
+        ///
+        /// \param k      [in] The key for the value which should be updated in
+        ///               the cache.
+        /// \param val    [in] The value which should be used as a replacement
+        ///               for the existing value in the cache. Any existing
+        ///               cache entry is not changed except for its value.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               successfully updated, otherwise it returns \a false.
+        ///               If the entry currently is not held by the cache it is
+        ///               added and the return value reflects the outcome of
+        ///               the corresponding insert operation.
+        template <typename Value>
+        bool update(key_type const& k, Value&& val)
+        {
+            shard& s = get_shard(k);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            update_on_exit update(
+                s.statistics_, statistics::method::update_entry);
+
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end())
+            {
+                s.statistics_.got_miss();
+                return insert_locked(
+                    s, k, entry_type(HPX_FORWARD(Value, val)));
+            }
+
+            it->second.entry_.get() = HPX_FORWARD(Value, val);
+            it->second.entry_.touch();
+            s.statistics_.got_hit();
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Get the value identified by the given key, computing it if
+        ///        necessary.
+        ///
+        /// \param k      [in] The key for the value which should be retrieved
+        ///               from the cache.
+        /// \param f      [in] The function computing the value if the key is
+        ///               not held in the cache. It is invoked with the key and
+        ///               has to return either a value or an instance of the
+        ///               entry type (allowing to specify the size of the new
+        ///               entry).
+        ///
+        /// \note         At most one invocation of \a f is in flight for any
+        ///               given key. The first thread requesting a missing key
+        ///               computes the value, all threads requesting the same
+        ///               key meanwhile are handed a future which becomes ready
+        ///               once the value is available. Exceptions thrown by
+        ///               \a f are propagated through this future, nothing is
+        ///               inserted into the cache in this case.
+        ///
+        /// \returns      A future referring to the requested value.
+        template <typename F>
+        hpx::shared_future<value_type> get_or_compute(
+            key_type const& k, F&& f)
+        {
+            shard& s = get_shard(k);
+            hpx::promise<value_type> p;
+
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                update_on_exit update(
+                    s.statistics_, statistics::method::get_entry);
+
+                iterator it = s.store_.find(k);
+                if (it != s.store_.end())
+                {
+                    it->second.entry_.touch();
+                    s.statistics_.got_hit();
+                    return hpx::make_ready_future(it->second.entry_.get())
+                        .share();
+                }
+
+                s.statistics_.got_miss();
+
+                // join the computation of the same value if one is running
+                auto pit = s.pending_.find(k);
+                if (pit != s.pending_.end())
+                {
+                    return pit->second;
+                }
+
+                s.pending_.emplace(k, p.get_future().share());
+            }
+
+            // the future stays valid after the pending entry is removed
+            hpx::shared_future<value_type> result;
+            try
+            {
+                entry_type e(HPX_INVOKE(HPX_FORWARD(F, f), k));
+
+                {
+                    std::lock_guard<mutex_type> l(s.mtx_);
+
+                    update_on_exit update(
+                        s.statistics_, statistics::method::insert_entry);
+
+                    auto pit = s.pending_.find(k);
+                    HPX_ASSERT(pit != s.pending_.end());
+                    result = HPX_MOVE(pit->second);
+                    s.pending_.erase(pit);
+
+                    insert_locked(s, k, e);
+                }
+
+                // make the value available outside of the lock as this may
+                // run continuations attached by waiting threads
+                p.set_value(HPX_MOVE(e.get()));
+            }
+            catch (...)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                auto pit = s.pending_.find(k);
+                if (pit != s.pending_.end())
+                {
+                    result = HPX_MOVE(pit->second);
+                    s.pending_.erase(pit);
+                }
+                p.set_exception(std::current_exception());
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Remove the entry identified by the given key.
+        ///
+        /// \note         The entry is not removed from the cache if its
+        ///               \a entry#remove function returns \a false.
+        ///
+        /// \returns      This function returns \a true if the entry has been
+        ///               removed.
+        bool erase(key_type const& k)
+        {
+            shard& s = get_shard(k);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            update_on_exit update(
+                s.statistics_, statistics::method::erase_entry);
+
+            iterator it = s.store_.find(k);
+            if (it == s.store_.end() || !it->second.entry_.remove())
+            {
+                return false;
+            }
+
+            erase_locked(s, it);
+            return true;
+        }
+
+        /// \brief Remove stored entries from the cache for which the supplied
+        ///        function object returns true.
+        ///
+        /// \param ep     [in] This parameter has to be a (unary) function
+        ///               object invoked with the key and the entry of each of
+        ///               the held entries, see \a local_cache#erase.
+        ///
+        /// \returns      This function returns the overall size of the removed
+        ///               entries.
+        template <typename Func>
+        size_type erase_if(Func&& ep)
+        {
+            size_type erased = 0;
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                update_on_exit update(
+                    s.statistics_, statistics::method::erase_entry);
+
+                for (iterator it = s.store_.begin(); it != s.store_.end();
+                    /**/)
+                {
+                    iterator next = std::next(it);
+                    if (ep(it->first, it->second.entry_) &&
+                        it->second.entry_.remove())
+                    {
+                        erased += erase_locked(s, it);
+                    }
+                    it = next;
+                }
+            }
+            return erased;
+        }
+
+        /// \brief Clear the cache
+        ///
+        /// Unconditionally removes all stored entries from the cache and
+        /// resets the statistics of all shards. Computations of values
+        /// started by \a get_or_compute are not affected.
+        void clear()
+        {
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                shard& s = shards_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                s.store_.clear();
+                s.slots_.clear();
+                s.statistics_.clear();
+                s.current_size_ = 0;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Invoke the given function with the statistics instance of
+        ///        the given shard while holding the shard's lock.
+        ///
+        /// \returns      This function returns the value returned by \a f.
+        template <typename F>
+        decltype(auto) with_statistics(std::size_t shard_index, F&& f)
+        {
+            HPX_ASSERT(shard_index < num_shards_);
+
+            shard& s = shards_[shard_index];
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return HPX_INVOKE(HPX_FORWARD(F, f), s.statistics_);
+        }
+
+        /// \brief Return a copy of the statistics instance of the given
+        ///        shard.
+        statistics_type get_statistics(std::size_t shard_index) const
+        {
+            HPX_ASSERT(shard_index < num_shards_);
+
+            shard const& s = shards_[shard_index];
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return s.statistics_;
+        }
+
+    private:
+        size_type get_shard_capacity(size_type max_size) const noexcept
+        {
+            return (max_size + num_shards_ - 1) / num_shards_;
+        }
+
+        std::size_t get_shard_index(key_type const& k) const
+        {
+            // use the upper bits of the mixed hash value for selecting the
+            // shard, the hash maps use the lower ones for their buckets
+            std::uint64_t const h =
+                static_cast<std::uint64_t>(hasher()(k)) *
+                0x9e3779b97f4a7c15ull;
+            return static_cast<std::size_t>(h >> 32) & (num_shards_ - 1);
+        }
+
+        shard& get_shard(key_type const& k)
+        {
+            return shards_[get_shard_index(k)];
+        }
+        shard const& get_shard(key_type const& k) const
+        {
+            return shards_[get_shard_index(k)];
+        }
+
+        template <typename Entry_>
+        bool insert_locked(shard& s, key_type const& k, Entry_&& e)
+        {
+            // don't evict anything for a key which is already held
+            if (s.store_.find(k) != s.store_.end())
+            {
+                return false;
+            }
+
+            // ask entry if it really wants to be inserted
+            if (!s.insert_policy_(e) || !e.insert())
+            {
+                return false;
+            }
+
+            // make sure the shard doesn't get too large, don't evict
+            // anything for entries which would never fit
+            size_type const entry_size = e.get_size();
+            if (s.max_size_ != 0 &&
+                s.current_size_ + entry_size > s.max_size_ &&
+                (entry_size > s.max_size_ ||
+                    !free_space(
+                        s, s.current_size_ + entry_size - s.max_size_)))
+            {
+                return false;
+            }
+
+            std::pair<iterator, bool> p =
+                s.store_.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(k),
+                    std::forward_as_tuple(
+                        HPX_FORWARD(Entry_, e), s.slots_.size()));
+            HPX_ASSERT(p.second);
+
+            s.slots_.push_back(&*p.first);
+            s.current_size_ += entry_size;
+
+            s.statistics_.got_insertion();
+            return true;
+        }
+
+        size_type erase_locked(shard& s, iterator it)
+        {
+            std::size_t const slot = it->second.slot_;
+            if (slot != s.slots_.size() - 1)
+            {
+                s.slots_[slot] = s.slots_.back();
+                s.slots_[slot]->second.slot_ = slot;
+            }
+            s.slots_.pop_back();
+
+            size_type const entry_size = it->second.entry_.get_size();
+            s.current_size_ -= entry_size;
+            s.store_.erase(it);
+
+            s.statistics_.got_eviction();
+            return entry_size;
+        }
+
+        std::size_t next_random(shard& s) noexcept
+        {
+            // xorshift64
+            std::uint64_t x = s.random_state_;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            s.random_state_ = x;
+            return static_cast<std::size_t>(x);
+        }
+
+        // Free some space in the given shard
+        bool free_space(shard& s, size_type num_free)
+        {
+            while (num_free > 0 && !s.slots_.empty())
+            {
+                // pick the 'oldest' out of a couple of random entries which
+                // are allowed to be removed
+                storage_value_type* victim = nullptr;
+                for (std::size_t i = 0; i != num_eviction_samples; ++i)
+                {
+                    storage_value_type* candidate =
+                        s.slots_[next_random(s) % s.slots_.size()];
+                    if (candidate->second.entry_.remove() &&
+                        (victim == nullptr ||
+                            s.update_policy_(victim->second.entry_,
+                                candidate->second.entry_)))
+                    {
+                        victim = candidate;
+                    }
+                }
+
+                if (victim == nullptr)
+                {
+                    // fall back to looking at all entries
+                    for (storage_value_type* candidate : s.slots_)
+                    {
+                        if (candidate->second.entry_.remove())
+                        {
+                            victim = candidate;
+                            break;
+                        }
+                    }
+                    if (victim == nullptr)
+                    {
+                        return false;    // no entry may be removed
+                    }
+                }
+
+                size_type const entry_size =
+                    erase_locked(s, s.store_.find(victim->first));
+                num_free = entry_size < num_free ? num_free - entry_size : 0;
+            }
+            return num_free == 0;
+        }
+
+    private:
+        std::size_t num_shards_;
+        size_type max_size_;    // cache capacity
+        std::unique_ptr<shard[]> shards_;
+    };
+}    // namespace hpx::util::cache
@@ -0,0 +1,209 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/cache/concurrent_cache.hpp>
+#include <hpx/cache/entries/lru_entry.hpp>
+#include <hpx/cache/entries/size_entry.hpp>
+#include <hpx/cache/statistics/local_statistics.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace hpx::util::cache;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_insert_get_erase()
+{
+    using entry_type = entries::lru_entry<std::string>;
+    using cache_type = concurrent_cache<int, entry_type>;
+
+    cache_type c(0, 3);
+
+    HPX_TEST_EQ(c.capacity(), static_cast<cache_type::size_type>(0));
+    HPX_TEST_EQ(c.num_shards(), static_cast<std::size_t>(4));
+
+    for (int i = 0; i != 50; ++i)
+    {
+        HPX_TEST(c.insert(i, std::to_string(i)));
+    }
+    HPX_TEST(!c.insert(10, "10"));
+
+    std::string value;
+    for (int i = 0; i != 50; ++i)
+    {
+        HPX_TEST(c.holds_key(i));
+        HPX_TEST(c.get_entry(i, value));
+        HPX_TEST_EQ(value, std::to_string(i));
+    }
+    HPX_TEST(!c.get_entry(50, value));
+
+    HPX_TEST(c.update(10, "ten"));
+    HPX_TEST(c.get_entry(10, value));
+    HPX_TEST_EQ(value, std::string("ten"));
+
+    HPX_TEST(c.erase(10));
+    HPX_TEST(!c.erase(10));
+    HPX_TEST(!c.holds_key(10));
+
+    HPX_TEST_EQ(c.erase_if([](int key, entry_type const&) {
+        return key % 2 == 0;
+    }),
+        static_cast<cache_type::size_type>(24));
+    HPX_TEST_EQ(c.size(), static_cast<cache_type::size_type>(25));
+
+    c.clear();
+    HPX_TEST_EQ(c.size(), static_cast<cache_type::size_type>(0));
+}
+
+void test_capacity()
+{
+    using entry_type = entries::lru_entry<int>;
+    using cache_type = concurrent_cache<int, entry_type>;
+
+    cache_type c(64, 4);
+    for (int i = 0; i != 1000; ++i)
+    {
+        HPX_TEST(c.insert(i, i));
+        HPX_TEST_LTE(c.size(), static_cast<cache_type::size_type>(64));
+    }
+
+    HPX_TEST(c.reserve(16));
+    HPX_TEST_LTE(c.size(), static_cast<cache_type::size_type>(16));
+
+    // inserting a key already held by a full cache doesn't evict anything
+    cache_type full(4, 1);
+    for (int i = 0; i != 4; ++i)
+    {
+        HPX_TEST(full.insert(i, i));
+    }
+    HPX_TEST(!full.insert(2, 2));
+    HPX_TEST_EQ(full.size(), static_cast<cache_type::size_type>(4));
+    for (int i = 0; i != 4; ++i)
+    {
+        HPX_TEST(full.holds_key(i));
+    }
+}
+
+void test_cost_based_capacity()
+{
+    using entry_type = entries::size_entry<std::string>;
+    using cache_type = concurrent_cache<int, entry_type>;
+
+    // limit the cache to 1000 bytes held in a single shard
+    cache_type c(1000, 1);
+    for (int i = 0; i != 100; ++i)
+    {
+        std::string value(100 + i, 'x');
+        std::size_t const size = value.size();
+        HPX_TEST(c.insert(i, entry_type(value, size)));
+        HPX_TEST_LTE(c.size(), static_cast<cache_type::size_type>(1000));
+    }
+
+    // entries bigger than the capacity are never held
+    HPX_TEST(!c.insert(1000, entry_type(std::string(), 2000)));
+
+    // size_entry discards the biggest entries first, values computed on
+    // demand may specify their size as well
+    auto f = c.get_or_compute(
+        2000, [](int) { return entry_type(std::string("small"), 5); });
+    HPX_TEST_EQ(f.get(), std::string("small"));
+    HPX_TEST(c.holds_key(2000));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_get_or_compute()
+{
+    using entry_type = entries::lru_entry<int>;
+    using cache_type = concurrent_cache<int, entry_type,
+        std::less<entry_type>, policies::always<entry_type>, std::hash<int>,
+        std::equal_to<int>, statistics::local_statistics>;
+
+    cache_type c(0, 8);
+
+    std::atomic<int> num_computations(0);
+    auto compute = [&](int key) {
+        ++num_computations;
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return 2 * key;
+    };
+
+    // all concurrent requests for the same key share one computation
+    std::vector<hpx::future<int>> results;
+    for (int i = 0; i != 16; ++i)
+    {
+        results.push_back(hpx::async(
+            [&]() { return c.get_or_compute(42, compute).get(); }));
+    }
+    for (auto& f : results)
+    {
+        HPX_TEST_EQ(f.get(), 84);
+    }
+    HPX_TEST_EQ(num_computations.load(), 1);
+
+    // the computed value is cached
+    HPX_TEST_EQ(c.get_or_compute(42, compute).get(), 84);
+    HPX_TEST_EQ(num_computations.load(), 1);
+
+    // failing computations are reported and not cached
+    auto fail = [](int) -> int { throw std::runtime_error("failed"); };
+    bool caught_exception = false;
+    try
+    {
+        c.get_or_compute(43, fail).get();
+        HPX_TEST(false);
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    HPX_TEST(!c.holds_key(43));
+    HPX_TEST_EQ(c.get_or_compute(43, compute).get(), 86);
+    HPX_TEST_EQ(num_computations.load(), 2);
+
+    // each shard gathers its own statistics
+    std::size_t hits = 0;
+    std::size_t insertions = 0;
+    for (std::size_t i = 0; i != c.num_shards(); ++i)
+    {
+        statistics::local_statistics const stats = c.get_statistics(i);
+        hits += stats.hits();
+        insertions += stats.insertions();
+    }
+    HPX_TEST_LTE(static_cast<std::size_t>(1), hits);
+    HPX_TEST_EQ(static_cast<std::size_t>(2), insertions);
+
+    std::size_t const shard_hits = c.with_statistics(0,
+        [](statistics::local_statistics& stats) { return stats.hits(true); });
+    HPX_TEST_EQ(c.get_statistics(0).hits(), static_cast<std::size_t>(0));
+    HPX_TEST_LTE(shard_hits, hits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_insert_get_erase();
+    test_capacity();
+    test_cost_based_capacity();
+    test_get_or_compute();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv), 0);
+    return hpx::util::report_errors();
+}
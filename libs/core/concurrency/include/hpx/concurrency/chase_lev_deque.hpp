@@ -0,0 +1,214 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace concurrency {
+
+    /// \brief A single-owner, multi-thief work-stealing deque.
+    ///
+    /// This is the dynamic circular work-stealing deque described by Chase
+    /// and Lev (SPAA 2005), using the memory orderings given by Le, Pop,
+    /// Cohen and Zappa Nardelli (PPoPP 2013). Exactly one thread (the owner)
+    /// may call \a push and \a pop; these operate on the bottom end of the
+    /// deque and do not use atomic read-modify-write operations unless the
+    /// deque holds a single element. Any thread may call \a steal, which
+    /// takes elements from the top end of the deque using a CAS.
+    ///
+    /// The deque grows on demand. Buffers that were replaced during growth
+    /// are kept alive until the deque is destroyed as concurrent thieves may
+    /// still be reading from them.
+    template <typename T>
+    class chase_lev_deque
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "chase_lev_deque requires a trivially copyable element type");
+
+        struct buffer
+        {
+            explicit buffer(std::int64_t capacity)
+              : mask_(capacity - 1)
+              , data_(new std::atomic<T>[static_cast<std::size_t>(capacity)])
+            {
+                HPX_ASSERT(capacity > 0 && (capacity & mask_) == 0);
+            }
+
+            std::int64_t capacity() const noexcept
+            {
+                return mask_ + 1;
+            }
+
+            T load(std::int64_t i) const noexcept
+            {
+                return data_[i & mask_].load(std::memory_order_relaxed);
+            }
+
+            void store(std::int64_t i, T val) noexcept
+            {
+                data_[i & mask_].store(val, std::memory_order_relaxed);
+            }
+
+            std::int64_t const mask_;
+            std::unique_ptr<std::atomic<T>[]> data_;
+        };
+
+        static std::int64_t round_up_capacity(std::size_t initial_size)
+        {
+            std::int64_t capacity = 32;
+            while (capacity < static_cast<std::int64_t>(initial_size))
+                capacity *= 2;
+            return capacity;
+        }
+
+    public:
+        using value_type = T;
+
+        explicit chase_lev_deque(std::size_t initial_size = 0)
+          : top_()
+          , bottom_()
+          , buffer_()
+        {
+            top_.data_.store(0, std::memory_order_relaxed);
+            bottom_.data_.store(0, std::memory_order_relaxed);
+
+            buffers_.emplace_back(new buffer(round_up_capacity(initial_size)));
+            buffer_.data_.store(
+                buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        chase_lev_deque(chase_lev_deque const&) = delete;
+        chase_lev_deque(chase_lev_deque&&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque const&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque&&) = delete;
+
+        /// Push an element onto the bottom end of the deque. Must only be
+        /// called by the owner.
+        void push(T val)
+        {
+            std::int64_t const b =
+                bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t const t = top_.data_.load(std::memory_order_acquire);
+            buffer* a = buffer_.data_.load(std::memory_order_relaxed);
+
+            if (b - t > a->capacity() - 1)
+            {
+                a = grow(a, t, b);
+            }
+
+            a->store(b, val);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.data_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        /// Pop an element from the bottom end of the deque. Must only be
+        /// called by the owner. Returns false if the deque was empty.
+        bool pop(T& val)
+        {
+            std::int64_t const b =
+                bottom_.data_.load(std::memory_order_relaxed) - 1;
+            buffer* a = buffer_.data_.load(std::memory_order_relaxed);
+            bottom_.data_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // the deque was empty, restore bottom
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            val = a->load(b);
+            if (t == b)
+            {
+                // this is the last element, compete with thieves for it
+                bool const result = top_.data_.compare_exchange_strong(t,
+                    t + 1, std::memory_order_seq_cst,
+                    std::memory_order_relaxed);
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return result;
+            }
+            return true;
+        }
+
+        /// Take an element from the top end of the deque. May be called
+        /// concurrently by any thread. Returns false if the deque was found to
+        /// be empty.
+        bool steal(T& val)
+        {
+            while (true)
+            {
+                std::int64_t t = top_.data_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t const b =
+                    bottom_.data_.load(std::memory_order_acquire);
+
+                if (t >= b)
+                    return false;
+
+                buffer* a = buffer_.data_.load(std::memory_order_acquire);
+                T const x = a->load(t);
+                if (top_.data_.compare_exchange_strong(t, t + 1,
+                        std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    val = x;
+                    return true;
+                }
+                // lost the race against another thief or the owner, retry
+            }
+        }
+
+        /// Return whether the deque is (approximately) empty. May be called
+        /// concurrently by any thread.
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /// Return the (approximate) number of elements in the deque. May be
+        /// called concurrently by any thread.
+        std::size_t size() const noexcept
+        {
+            std::int64_t const b =
+                bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t const t = top_.data_.load(std::memory_order_relaxed);
+            return b > t ? static_cast<std::size_t>(b - t) : 0;
+        }
+
+    private:
+        buffer* grow(buffer* a, std::int64_t t, std::int64_t b)
+        {
+            std::unique_ptr<buffer> new_buffer(new buffer(2 * a->capacity()));
+            for (std::int64_t i = t; i != b; ++i)
+            {
+                new_buffer->store(i, a->load(i));
+            }
+
+            buffer* result = new_buffer.get();
+            buffers_.push_back(HPX_MOVE(new_buffer));
+            buffer_.data_.store(result, std::memory_order_release);
+            return result;
+        }
+
+        util::cache_line_data<std::atomic<std::int64_t>> top_;
+        util::cache_line_data<std::atomic<std::int64_t>> bottom_;
+        util::cache_line_data<std::atomic<buffer*>> buffer_;
+
+        // all buffers ever used by this deque, only accessed by the owner
+        std::vector<std::unique_ptr<buffer>> buffers_;
+    };
+}}    // namespace hpx::concurrency
@@ -0,0 +1,110 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/chase_lev_deque.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using deque_type = hpx::concurrency::chase_lev_deque<std::uint64_t>;
+
+void test_basic()
+{
+    deque_type q;
+    std::uint64_t val = 0;
+
+    HPX_TEST(q.empty());
+    HPX_TEST(!q.pop(val));
+    HPX_TEST(!q.steal(val));
+
+    // more items than the initial capacity to force the deque to grow
+    constexpr std::uint64_t count = 1000;
+    for (std::uint64_t i = 0; i != count; ++i)
+    {
+        q.push(i);
+    }
+    HPX_TEST_EQ(q.size(), std::size_t(count));
+
+    // thieves take the oldest item
+    HPX_TEST(q.steal(val));
+    HPX_TEST_EQ(val, std::uint64_t(0));
+
+    // the owner takes the newest items
+    for (std::uint64_t i = count - 1; i != 0; --i)
+    {
+        HPX_TEST(q.pop(val));
+        HPX_TEST_EQ(val, i);
+    }
+
+    HPX_TEST(q.empty());
+    HPX_TEST(!q.pop(val));
+    HPX_TEST(!q.steal(val));
+}
+
+void test_concurrent(std::size_t num_thieves, std::uint64_t count)
+{
+    deque_type q;
+    std::vector<std::atomic<int>> seen(count);
+    for (auto& s : seen)
+    {
+        s.store(0);
+    }
+
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (std::size_t i = 0; i != num_thieves; ++i)
+    {
+        thieves.emplace_back([&]() {
+            std::uint64_t val = 0;
+            while (!done.load())
+            {
+                if (q.steal(val))
+                    ++seen[val];
+            }
+            while (q.steal(val))
+                ++seen[val];
+        });
+    }
+
+    // the owner pushes all items and pops some of them back, racing with
+    // the thieves
+    std::uint64_t val = 0;
+    for (std::uint64_t i = 0; i != count; ++i)
+    {
+        q.push(i);
+        if (i % 3 == 0 && q.pop(val))
+            ++seen[val];
+    }
+    while (q.pop(val))
+        ++seen[val];
+
+    done.store(true);
+    for (auto& t : thieves)
+    {
+        t.join();
+    }
+
+    // every item must have been taken exactly once
+    for (auto const& s : seen)
+    {
+        HPX_TEST_EQ(s.load(), 1);
+    }
+}
+
+int main()
+{
+    test_basic();
+    test_concurrent(1, 100000);
+    test_concurrent(4, 100000);
+
+    return hpx::util::report_errors();
+}
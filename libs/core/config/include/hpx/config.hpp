@@ -128,6 +128,79 @@
 #  define HPX_HAVE_PARCELPORT_MPI_BACKGROUND_THREADS std::size_t(-1)
 #endif
 
+/// This defines the number of rings in the shared memory segment each locality
+/// receives parcels through, which limits the number of localities on the same
+/// node sending parcels to it through the shared memory parcelport.
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.shmem.num_rings = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_NUM_RINGS).
+#if !defined(HPX_PARCEL_SHMEM_NUM_RINGS)
+#  define HPX_PARCEL_SHMEM_NUM_RINGS 64
+#endif
+
+/// This defines the size (in bytes, a power of two) of each of the rings used
+/// by the shared memory parcelport.
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.shmem.ring_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_RING_SIZE).
+#if !defined(HPX_PARCEL_SHMEM_RING_SIZE)
+#  define HPX_PARCEL_SHMEM_RING_SIZE 262144
+#endif
+
+/// This defines the number of cores that perform background work for the
+/// shared memory parcelport
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.shmem.background_threads = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_HAVE_PARCELPORT_SHMEM_BACKGROUND_THREADS).
+#if !defined(HPX_HAVE_PARCELPORT_SHMEM_BACKGROUND_THREADS)
+#  define HPX_HAVE_PARCELPORT_SHMEM_BACKGROUND_THREADS std::size_t(-1)
+#endif
+
+/// This defines the number of submission queue entries of the io_uring
+/// instance used by the TCP parcelport.
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.tcp.io_uring_entries = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_TCP_IO_URING_ENTRIES).
+#if !defined(HPX_PARCEL_TCP_IO_URING_ENTRIES)
+#  define HPX_PARCEL_TCP_IO_URING_ENTRIES 256
+#endif
+
+/// This defines the number of receive buffers registered with the io_uring
+/// instance used by the TCP parcelport (a power of two).
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.tcp.io_uring_buffers = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_TCP_IO_URING_BUFFERS).
+#if !defined(HPX_PARCEL_TCP_IO_URING_BUFFERS)
+#  define HPX_PARCEL_TCP_IO_URING_BUFFERS 256
+#endif
+
+/// This defines the size (in bytes) of each of the receive buffers registered
+/// with the io_uring instance used by the TCP parcelport.
+/// This value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.tcp.io_uring_buffer_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE).
+#if !defined(HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE)
+#  define HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE 16384
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the number of outgoing (parcel-) connections kept alive (to
 /// each of the other localities). This value can be changed at runtime by
@@ -55,6 +55,8 @@
 #include <sys/param.h>
 
 #include <stdexcept>
+
+#include <hpx/coroutines/detail/stack_arena.hpp>
 #endif
 
 #if defined(__FreeBSD__)
@@ -79,6 +81,11 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
 
         inline void* alloc_stack(std::size_t size)
         {
+            if (use_stack_arena)
+            {
+                return arena_alloc_stack(size);
+            }
+
             void* real_stack = ::mmap(nullptr, size + EXEC_PAGESIZE,
                 PROT_EXEC | PROT_READ | PROT_WRITE,
 #if defined(__APPLE__)
@@ -151,6 +158,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
 
         inline void free_stack(void* stack, std::size_t size)
         {
+            if (use_stack_arena)
+            {
+                arena_free_stack(stack, size);
+                return;
+            }
+
 #if defined(HPX_HAVE_THREAD_GUARD_PAGE)
             if (use_guard_pages)
             {
@@ -0,0 +1,41 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+    namespace posix {
+
+        // The stack arena caches coroutine stacks per NUMA domain. Stacks are
+        // carved out of large regions of address space which are reserved
+        // once, the guard page of each stack is installed only when it is
+        // carved out for the first time. Released stacks are kept in LIFO
+        // order for reuse, their pages are handed back to the operating
+        // system (using MADV_FREE, where available) only once the amount of
+        // cached stack memory of a NUMA domain exceeds the high-water mark.
+        HPX_CORE_EXPORT extern bool use_stack_arena;
+        HPX_CORE_EXPORT extern std::size_t stack_arena_high_water_mark;
+
+        HPX_CORE_EXPORT void* arena_alloc_stack(std::size_t size);
+        HPX_CORE_EXPORT void arena_free_stack(
+            void* stack, std::size_t size) noexcept;
+
+        // Return the number of bytes of address space reserved for stacks
+        // (including guard pages and cached stacks). The value can't be reset.
+        HPX_CORE_EXPORT std::int64_t get_stack_bytes_committed(bool reset);
+
+        // Return the number of bytes of stack memory which may be backed by
+        // physical memory, i.e. the stacks in use and the cached stacks which
+        // have not been handed back to the operating system yet. This is an
+        // upper bound as not all pages of a stack are necessarily touched.
+        // The value can't be reset.
+        HPX_CORE_EXPORT std::int64_t get_stack_bytes_resident(bool reset);
+}}}}}    // namespace hpx::threads::coroutines::detail::posix
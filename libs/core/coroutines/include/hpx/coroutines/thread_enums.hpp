@@ -11,6 +11,7 @@
 #include <hpx/config.hpp>
 #include <hpx/coroutines/detail/combined_tagged_state.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
@@ -223,10 +224,14 @@ namespace hpx { namespace threads {
     /// resources available to the scheduler.
     struct thread_schedule_hint
     {
+        /// The type of the (absolute) deadline associated with a hint.
+        using deadline_type = std::chrono::steady_clock::time_point;
+
         /// Construct a default hint with mode thread_schedule_hint_mode::none.
         constexpr thread_schedule_hint() noexcept
           : hint(-1)
           , mode(thread_schedule_hint_mode::none)
+          , deadline(no_deadline())
         {
         }
 
@@ -236,6 +241,7 @@ namespace hpx { namespace threads {
             std::int16_t thread_hint) noexcept
           : hint(thread_hint)
           , mode(thread_schedule_hint_mode::thread)
+          , deadline(no_deadline())
         {
         }
 
@@ -245,13 +251,36 @@ namespace hpx { namespace threads {
             thread_schedule_hint_mode mode, std::int16_t hint) noexcept
           : hint(hint)
           , mode(mode)
+          , deadline(no_deadline())
         {
         }
 
+        /// Construct a hint with mode thread_schedule_hint_mode::none and the
+        /// given absolute deadline.
+        constexpr explicit thread_schedule_hint(deadline_type d) noexcept
+          : hint(-1)
+          , mode(thread_schedule_hint_mode::none)
+          , deadline(d)
+        {
+        }
+
+        /// Return the value used for hints not associated with a deadline.
+        static constexpr deadline_type no_deadline() noexcept
+        {
+            return (deadline_type::max)();
+        }
+
+        /// Return whether this hint carries a deadline.
+        constexpr bool has_deadline() const noexcept
+        {
+            return deadline != no_deadline();
+        }
+
         /// \cond NOINTERNAL
         bool operator==(thread_schedule_hint const& rhs) const noexcept
         {
-            return mode == rhs.mode && hint == rhs.hint;
+            return mode == rhs.mode && hint == rhs.hint &&
+                deadline == rhs.deadline;
         }
 
         bool operator!=(thread_schedule_hint const& rhs) const noexcept
@@ -266,5 +295,10 @@ namespace hpx { namespace threads {
 
         /// The mode of the scheduling hint.
         thread_schedule_hint_mode mode;
+
+        /// The absolute deadline of the task. Schedulers supporting deadlines
+        /// run the task with the earliest deadline first, other schedulers
+        /// ignore the deadline.
+        deadline_type deadline;
     };
 }}    // namespace hpx::threads
@@ -0,0 +1,292 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#if defined(__linux) || defined(linux) || defined(__linux__) ||                \
+    defined(__FreeBSD__) || defined(__APPLE__)
+#include <hpx/assert.hpp>
+#include <hpx/coroutines/detail/posix_utility.hpp>
+#include <hpx/coroutines/detail/stack_arena.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&     \
+    _POSIX_MAPPED_FILES > 0
+#include <hpx/thread_support/spinlock.hpp>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <errno.h>
+#include <sys/mman.h>
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+    namespace posix {
+
+        HPX_CORE_EXPORT bool use_stack_arena = true;
+
+        // 64MB of cached (resident) stacks per NUMA domain
+        HPX_CORE_EXPORT std::size_t stack_arena_high_water_mark =
+            std::size_t(64) * 1024 * 1024;
+
+        namespace {
+
+            std::atomic<std::int64_t> stack_bytes_committed(0);
+            std::atomic<std::int64_t> stack_bytes_resident(0);
+        }    // namespace
+
+        std::int64_t get_stack_bytes_committed(bool)
+        {
+            return stack_bytes_committed.load(std::memory_order_relaxed);
+        }
+
+        std::int64_t get_stack_bytes_resident(bool)
+        {
+            return stack_bytes_resident.load(std::memory_order_relaxed);
+        }
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&     \
+    _POSIX_MAPPED_FILES > 0
+        namespace {
+
+            // size of the regions of address space reserved at once
+            constexpr std::size_t region_size = std::size_t(16) * 1024 * 1024;
+
+            // all stacks of the same size are managed together
+            struct size_class
+            {
+                explicit size_class(std::size_t size) noexcept
+                  : size_(size)
+                  , next_(nullptr)
+                  , end_(nullptr)
+                {
+                }
+
+                std::size_t size_;
+
+                // cached stacks whose pages are (most likely) still resident,
+                // most recently released stacks are reused first
+                std::vector<void*> hot_;
+
+                // cached stacks whose pages were handed back to the system
+                std::vector<void*> cold_;
+
+                // not yet used part of the most recently reserved region
+                char* next_;
+                char* end_;
+            };
+
+            struct stack_arena
+            {
+                using mutex_type = hpx::util::detail::spinlock;
+
+                stack_arena() noexcept
+                  : hot_bytes_(0)
+                {
+                }
+
+                size_class& get_size_class(std::size_t size)
+                {
+                    for (size_class& c : classes_)
+                    {
+                        if (c.size_ == size)
+                            return c;
+                    }
+                    classes_.emplace_back(size);
+                    return classes_.back();
+                }
+
+                mutex_type mtx_;
+                std::size_t hot_bytes_;
+
+                // there is only a handful of different stack sizes
+                std::vector<size_class> classes_;
+            };
+
+            // The arenas are intentionally leaked, stacks might be released
+            // during static destruction.
+            stack_arena& get_arena(std::size_t domain)
+            {
+                static std::array<stack_arena*, HPX_HAVE_MAX_NUMA_DOMAIN_COUNT>
+                    arenas = []() {
+                        std::array<stack_arena*,
+                            HPX_HAVE_MAX_NUMA_DOMAIN_COUNT>
+                            result;
+                        for (stack_arena*& arena : result)
+                        {
+                            arena = new stack_arena;
+                        }
+                        return result;
+                    }();
+                return *arenas[domain % HPX_HAVE_MAX_NUMA_DOMAIN_COUNT];
+            }
+
+            // Return the NUMA domain of the core the calling thread currently
+            // runs on. Worker threads are usually bound to a core, thus
+            // (because of the first-touch policy) the pages of stacks used on
+            // this core are most likely located in this NUMA domain.
+            std::size_t get_current_domain() noexcept
+            {
+#if (defined(__linux) || defined(linux) || defined(__linux__)) &&              \
+    defined(SYS_getcpu)
+                unsigned cpu = 0;
+                unsigned node = 0;
+                if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+                {
+                    return node;
+                }
+#endif
+                return 0;
+            }
+
+            void throw_alloc_error()
+            {
+                char const* error_message =
+                    "mmap() failed to allocate thread stack";
+                if (ENOMEM == errno && use_guard_pages)
+                {
+                    error_message =
+                        "mmap() failed to allocate thread stack due to "
+                        "insufficient resources, increase "
+                        "/proc/sys/vm/max_map_count or add "
+                        "-Ihpx.stacks.use_guard_pages=0 to the command line";
+                }
+                throw std::runtime_error(error_message);
+            }
+
+            // reserve a new region of address space for stacks of the given
+            // size, the caller has to hold the lock of the arena
+            void reserve_region(size_class& c)
+            {
+                std::size_t const slot_size = c.size_ + EXEC_PAGESIZE;
+                std::size_t const size =
+                    (std::max)(slot_size, region_size / slot_size * slot_size);
+
+                void* region = ::mmap(nullptr, size,
+                    PROT_EXEC | PROT_READ | PROT_WRITE,
+#if defined(__APPLE__)
+                    MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+#elif defined(__FreeBSD__)
+                    MAP_PRIVATE | MAP_ANON,
+#else
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+#endif
+                    -1, 0);
+
+                if (region == MAP_FAILED)
+                {
+                    throw_alloc_error();
+                }
+
+                c.next_ = static_cast<char*>(region);
+                c.end_ = c.next_ + size;
+
+                stack_bytes_committed.fetch_add(
+                    static_cast<std::int64_t>(size), std::memory_order_relaxed);
+            }
+
+            void release_pages(void* stack, std::size_t size) noexcept
+            {
+#if defined(MADV_FREE)
+                // MADV_FREE is cheap as the pages are reclaimed lazily, it
+                // is not supported by older kernels, though
+                if (::madvise(stack, size, MADV_FREE) == 0)
+                {
+                    return;
+                }
+#endif
+                ::madvise(stack, size, MADV_DONTNEED);
+            }
+        }    // namespace
+
+        void* arena_alloc_stack(std::size_t size)
+        {
+            stack_arena& arena = get_arena(get_current_domain());
+
+            char* slot = nullptr;
+            {
+                std::lock_guard<stack_arena::mutex_type> l(arena.mtx_);
+                size_class& c = arena.get_size_class(size);
+
+                if (!c.hot_.empty())
+                {
+                    void* stack = c.hot_.back();
+                    c.hot_.pop_back();
+                    arena.hot_bytes_ -= size;
+                    return stack;
+                }
+
+                if (!c.cold_.empty())
+                {
+                    void* stack = c.cold_.back();
+                    c.cold_.pop_back();
+                    stack_bytes_resident.fetch_add(
+                        static_cast<std::int64_t>(size),
+                        std::memory_order_relaxed);
+                    return stack;
+                }
+
+                if (c.next_ == c.end_)
+                {
+                    reserve_region(c);
+                }
+
+                slot = c.next_;
+                c.next_ += size + EXEC_PAGESIZE;
+                HPX_ASSERT(c.next_ <= c.end_);
+            }
+
+            // the guard page is installed once, it stays in place as long as
+            // the stack is cached by the arena
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+            if (use_guard_pages)
+            {
+                ::mprotect(slot, EXEC_PAGESIZE, PROT_NONE);
+            }
+#endif
+            stack_bytes_resident.fetch_add(
+                static_cast<std::int64_t>(size), std::memory_order_relaxed);
+
+            return slot + EXEC_PAGESIZE;
+        }
+
+        void arena_free_stack(void* stack, std::size_t size) noexcept
+        {
+            // the stack is cached in the arena of the NUMA domain it was
+            // last used in
+            stack_arena& arena = get_arena(get_current_domain());
+
+            {
+                std::lock_guard<stack_arena::mutex_type> l(arena.mtx_);
+                if (arena.hot_bytes_ + size <= stack_arena_high_water_mark)
+                {
+                    arena.get_size_class(size).hot_.push_back(stack);
+                    arena.hot_bytes_ += size;
+                    return;
+                }
+            }
+
+            // the pages have to be released before the stack can be reused
+            release_pages(stack, size);
+            stack_bytes_resident.fetch_sub(
+                static_cast<std::int64_t>(size), std::memory_order_relaxed);
+
+            std::lock_guard<stack_arena::mutex_type> l(arena.mtx_);
+            arena.get_size_class(size).cold_.push_back(stack);
+        }
+#endif
+}}}}}    // namespace hpx::threads::coroutines::detail::posix
+#endif
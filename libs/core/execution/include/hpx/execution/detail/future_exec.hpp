@@ -150,20 +150,35 @@ namespace hpx { namespace lcos { namespace detail {
     struct post_policy_spawner
     {
         template <typename F>
-        void operator()(F&& f, hpx::util::thread_description desc)
+        void operator()(F&& f, hpx::util::thread_description desc,
+            threads::thread_schedule_hint hint = {})
         {
+            if (hint.mode == threads::thread_schedule_hint_mode::thread)
+            {
+                hpx::launch::async_policy policy;
+                policy.set_hint(hint);
+
+                hpx::detail::post_policy_dispatch<hpx::launch::async_policy>::
+                    call(policy, desc,
+                        placed_continuation<std::decay_t<F>>{
+                            HPX_FORWARD(F, f), hint});
+                return;
+            }
+
             hpx::detail::post_policy_dispatch<hpx::launch::async_policy>::call(
                 hpx::launch::async, desc, HPX_FORWARD(F, f));
         }
     };
 
+    // the placement of continuations is left to the executor
     template <typename Executor>
     struct executor_spawner
     {
         Executor exec;
 
         template <typename F>
-        void operator()(F&& f, hpx::util::thread_description)
+        void operator()(F&& f, hpx::util::thread_description,
+            threads::thread_schedule_hint = {})
         {
             hpx::parallel::execution::post(exec, HPX_FORWARD(F, f));
         }
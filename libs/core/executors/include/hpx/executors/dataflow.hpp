@@ -22,6 +22,7 @@
 #include <hpx/functional/traits/get_function_annotation.hpp>
 #include <hpx/functional/traits/is_action.hpp>
 #include <hpx/futures/detail/future_transforms.hpp>
+#include <hpx/futures/detail/future_data.hpp>
 #include <hpx/futures/future.hpp>
 #include <hpx/futures/traits/acquire_future.hpp>
 #include <hpx/futures/traits/future_access.hpp>
@@ -249,6 +250,28 @@ namespace hpx { namespace lcos { namespace detail {
         {
             detail::dataflow_finalization<dataflow_type> this_f_(this);
 
+            // unless told otherwise, place the continuation on the current
+            // worker thread which has made the last of the futures ready
+            if (policy.hint().mode == threads::thread_schedule_hint_mode::none)
+            {
+                threads::thread_schedule_hint const hint =
+                    lcos::detail::get_continuation_schedule_hint();
+                if (hint.mode == threads::thread_schedule_hint_mode::thread)
+                {
+                    policy.set_hint(hint);
+
+                    hpx::execution::parallel_policy_executor<
+                        launch::async_policy>
+                        exec{policy};
+
+                    exec.post(lcos::detail::placed_continuation<
+                                  detail::dataflow_finalization<dataflow_type>>{
+                                  HPX_MOVE(this_f_), hint},
+                        HPX_FORWARD(Futures_, futures));
+                    return;
+                }
+            }
+
             hpx::execution::parallel_policy_executor<launch::async_policy> exec{
                 policy};
 
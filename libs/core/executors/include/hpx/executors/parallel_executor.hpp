@@ -162,8 +162,9 @@ namespace hpx { namespace execution {
             hpx::threads::thread_schedule_hint hint)
         {
             auto exec_with_hint = exec;
-            hpx::execution::experimental::with_hint(
-                exec_with_hint.policy_, hint);
+            exec_with_hint.policy_ =
+                hpx::execution::experimental::with_hint(
+                    exec_with_hint.policy_, hint);
             return exec_with_hint;
         }
 
@@ -180,8 +181,9 @@ namespace hpx { namespace execution {
             hpx::threads::thread_priority priority)
         {
             auto exec_with_priority = exec;
-            hpx::execution::experimental::with_priority(
-                exec_with_priority.policy_, priority);
+            exec_with_priority.policy_ =
+                hpx::execution::experimental::with_priority(
+                    exec_with_priority.policy_, priority);
             return exec_with_priority;
         }
 
@@ -198,8 +200,9 @@ namespace hpx { namespace execution {
             hpx::threads::thread_stacksize stacksize)
         {
             auto exec_with_stacksize = exec;
-            hpx::execution::experimental::with_stacksize(
-                exec_with_stacksize.policy_, stacksize);
+            exec_with_stacksize.policy_ =
+                hpx::execution::experimental::with_stacksize(
+                    exec_with_stacksize.policy_, stacksize);
             return exec_with_stacksize;
         }
 
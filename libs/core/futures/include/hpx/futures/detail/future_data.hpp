@@ -13,6 +13,7 @@
 #include <hpx/datastructures/detail/small_vector.hpp>
 #include <hpx/errors/try_catch_exception_ptr.hpp>
 #include <hpx/functional/function.hpp>
+#include <hpx/functional/traits/get_function_annotation.hpp>
 #include <hpx/futures/future_fwd.hpp>
 #include <hpx/futures/traits/future_access.hpp>
 #include <hpx/futures/traits/get_remote_result.hpp>
@@ -24,11 +25,13 @@
 #include <hpx/thread_support/atomic_count.hpp>
 #include <hpx/threading_base/annotated_function.hpp>
 #include <hpx/threading_base/thread_helpers.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
@@ -69,6 +72,51 @@ namespace hpx { namespace lcos { namespace detail {
     HPX_CORE_EXPORT void set_run_on_completed_error_handler(
         run_on_completed_error_handler_type f);
 
+    ///////////////////////////////////////////////////////////////////////
+    // Continuations which are scheduled asynchronously once a future becomes
+    // ready are placed on the worker thread that has made the future ready
+    // (or, if that is not known, on the current worker thread), as that
+    // worker's caches are likely to still hold the data the continuation is
+    // going to consume. Placement can be disabled in favor of load balancing
+    // using the configuration setting hpx.continuation_placement=0.
+    HPX_CORE_EXPORT extern bool continuation_placement_enabled;
+
+    // Return the schedule hint to use for a continuation of a future which
+    // was made ready on the given (local) worker thread (-1 if unknown)
+    HPX_CORE_EXPORT threads::thread_schedule_hint
+    get_continuation_schedule_hint(std::int16_t producer = -1) noexcept;
+
+    // Account for a continuation which was placed using the given hint
+    // starting to run on the current worker thread
+    HPX_CORE_EXPORT void count_continuation_placement(
+        threads::thread_schedule_hint const& hint) noexcept;
+
+    // Return the number of placed continuations which have run, the number
+    // of those which have run on the worker thread they were placed on, and
+    // the ratio of both (in 0.01%)
+    HPX_CORE_EXPORT std::int64_t get_continuation_placement_count(
+        bool reset) noexcept;
+    HPX_CORE_EXPORT std::int64_t get_continuation_placement_hit_count(
+        bool reset) noexcept;
+    HPX_CORE_EXPORT std::int64_t get_continuation_placement_hit_rate(
+        bool reset) noexcept;
+
+    // Wraps a continuation which was placed using the given hint, accounts
+    // for whether it runs on the intended worker thread
+    template <typename F>
+    struct placed_continuation
+    {
+        template <typename... Ts>
+        decltype(auto) operator()(Ts&&... ts)
+        {
+            count_continuation_placement(hint_);
+            return f_(HPX_FORWARD(Ts, ts)...);
+        }
+
+        F f_;
+        threads::thread_schedule_hint hint_;
+    };
+
     ///////////////////////////////////////////////////////////////////////
     template <typename Result>
     struct future_data;
@@ -226,12 +274,14 @@ namespace hpx { namespace lcos { namespace detail {
         using mutex_type = hpx::spinlock;
 
         future_data_base() noexcept
-          : state_(empty)
+          : producer_thread_num_(-1)
+          , state_(empty)
         {
         }
 
         explicit future_data_base(init_no_addref no_addref) noexcept
           : future_data_refcnt_base(no_addref)
+          , producer_thread_num_(-1)
           , state_(empty)
         {
         }
@@ -333,8 +383,26 @@ namespace hpx { namespace lcos { namespace detail {
                 "this future does not support name registration");
         }
 
+        // Return the (local) number of the worker thread which has made this
+        // shared state ready, -1 if not known
+        std::int16_t get_producer_thread_num() const noexcept
+        {
+            return producer_thread_num_;
+        }
+
     protected:
+        // Remember the worker thread making this shared state ready, used as
+        // the placement hint for asynchronous continuations
+        void set_producer_thread_num() noexcept
+        {
+            std::size_t const num = hpx::get_local_worker_thread_num();
+            producer_thread_num_ = num < std::size_t(INT16_MAX) ?
+                static_cast<std::int16_t>(num) :
+                std::int16_t(-1);
+        }
+
         mutable mutex_type mtx_;
+        std::int16_t producer_thread_num_;
         std::atomic<state> state_;    // current state
         completed_callback_vector_type on_completed_;
         local::detail::condition_variable cond_;    // threads waiting in read
@@ -466,6 +534,7 @@ namespace hpx { namespace lcos { namespace detail {
 
             // The value has been set, changing the state to 'value' at this
             // point signals to all other threads that this future is ready.
+            set_producer_thread_num();
             state expected = empty;
             if (!state_.compare_exchange_strong(
                     expected, value, std::memory_order_release))
@@ -526,6 +595,7 @@ namespace hpx { namespace lcos { namespace detail {
 
             // The value has been set, changing the state to 'exception' at this
             // point signals to all other threads that this future is ready.
+            set_producer_thread_num();
             state expected = empty;
             if (!state_.compare_exchange_strong(
                     expected, exception, std::memory_order_release))
@@ -1060,4 +1130,32 @@ namespace hpx { namespace traits { namespace detail {
     };
 }}}    // namespace hpx::traits::detail
 
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+namespace hpx { namespace traits {
+
+    // placed continuations expose the annotation of the wrapped function
+    template <typename F>
+    struct get_function_annotation<lcos::detail::placed_continuation<F>>
+    {
+        static constexpr char const* call(
+            lcos::detail::placed_continuation<F> const& f) noexcept
+        {
+            return get_function_annotation<F>::call(f.f_);
+        }
+    };
+
+#if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
+    template <typename F>
+    struct get_function_annotation_itt<lcos::detail::placed_continuation<F>>
+    {
+        static util::itt::string_handle call(
+            lcos::detail::placed_continuation<F> const& f) noexcept
+        {
+            return get_function_annotation_itt<F>::call(f.f_);
+        }
+    };
+#endif
+}}    // namespace hpx::traits
+#endif
+
 #include <hpx/config/warnings_suffix.hpp>
@@ -281,13 +281,18 @@ namespace hpx { namespace lcos { namespace detail {
                 started_ = true;
             }
 
+            // place the continuation close to the thread that has produced
+            // the value it depends on
+            threads::thread_schedule_hint const hint =
+                get_continuation_schedule_hint(f->get_producer_thread_num());
+
             hpx::intrusive_ptr<continuation> this_(this);
             hpx::util::thread_description desc(f_, "async");
             spawner(
                 [this_ = HPX_MOVE(this_), f = HPX_MOVE(f)]() mutable -> void {
                     this_->async_impl(HPX_MOVE(f));
                 },
-                desc);
+                desc, hint);
 
             if (&ec != &throws)
                 ec = make_success_code();
@@ -311,13 +316,18 @@ namespace hpx { namespace lcos { namespace detail {
                 started_ = true;
             }
 
+            // place the continuation close to the thread that has produced
+            // the value it depends on
+            threads::thread_schedule_hint const hint =
+                get_continuation_schedule_hint(f->get_producer_thread_num());
+
             hpx::intrusive_ptr<continuation> this_(this);
             hpx::util::thread_description desc(f_, "async_nounwrap");
             spawner(
                 [this_ = HPX_MOVE(this_), f = HPX_MOVE(f)]() mutable -> void {
                     this_->async_impl_nounwrap(HPX_MOVE(f));
                 },
-                desc);
+                desc, hint);
 
             if (&ec != &throws)
                 ec = make_success_code();
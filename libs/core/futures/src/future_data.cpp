@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/async_base/launch_policy.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/errors/try_catch_exception_ptr.hpp>
 #include <hpx/execution_base/this_thread.hpp>
 #include <hpx/functional/deferred_call.hpp>
@@ -17,8 +18,12 @@
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/memory.hpp>
 #include <hpx/threading_base/annotated_function.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <mutex>
@@ -34,6 +39,104 @@ namespace hpx { namespace lcos { namespace detail {
         run_on_completed_error_handler = f;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool continuation_placement_enabled = true;
+
+    namespace {
+
+        struct continuation_placement_data
+        {
+            continuation_placement_data() noexcept
+            {
+                count_.store(0, std::memory_order_relaxed);
+                hits_.store(0, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::int64_t> count_;
+            std::atomic<std::int64_t> hits_;
+        };
+
+        // the placement statistics are spread over a fixed number of cache
+        // lines indexed by worker thread to avoid contention
+        constexpr std::size_t continuation_placement_slots = 64;
+
+        util::cache_line_data<continuation_placement_data>
+            continuation_placements[continuation_placement_slots];
+
+        std::int64_t accumulate_continuation_placements(
+            std::atomic<std::int64_t> continuation_placement_data::*member,
+            bool reset) noexcept
+        {
+            std::int64_t result = 0;
+            for (auto& slot : continuation_placements)
+            {
+                auto& value = slot.data_.*member;
+                result += reset ? value.exchange(0, std::memory_order_relaxed) :
+                                  value.load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+    }    // namespace
+
+    threads::thread_schedule_hint get_continuation_schedule_hint(
+        std::int16_t producer) noexcept
+    {
+        if (!continuation_placement_enabled)
+        {
+            return threads::thread_schedule_hint();
+        }
+
+        if (producer < 0)
+        {
+            // the future was made ready by a thread which is not an HPX
+            // worker thread, use the current worker thread instead
+            std::size_t const num = hpx::get_local_worker_thread_num();
+            if (num >= std::size_t(INT16_MAX))
+            {
+                return threads::thread_schedule_hint();
+            }
+            producer = static_cast<std::int16_t>(num);
+        }
+        return threads::thread_schedule_hint(producer);
+    }
+
+    void count_continuation_placement(
+        threads::thread_schedule_hint const& hint) noexcept
+    {
+        std::size_t const num = hpx::get_local_worker_thread_num();
+        auto& slot = continuation_placements[num % continuation_placement_slots]
+                         .data_;
+
+        slot.count_.fetch_add(1, std::memory_order_relaxed);
+        if (num == static_cast<std::size_t>(hint.hint))
+        {
+            slot.hits_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::int64_t get_continuation_placement_count(bool reset) noexcept
+    {
+        return accumulate_continuation_placements(
+            &continuation_placement_data::count_, reset);
+    }
+
+    std::int64_t get_continuation_placement_hit_count(bool reset) noexcept
+    {
+        return accumulate_continuation_placements(
+            &continuation_placement_data::hits_, reset);
+    }
+
+    std::int64_t get_continuation_placement_hit_rate(bool reset) noexcept
+    {
+        std::int64_t const hits = get_continuation_placement_hit_count(reset);
+        std::int64_t const count = get_continuation_placement_count(reset);
+        if (count == 0)
+        {
+            return 0;
+        }
+        return (std::min)(hits, count) * 10000 / count;
+    }
+
     future_data_refcnt_base::~future_data_refcnt_base() = default;
 
     ///////////////////////////////////////////////////////////////////////////
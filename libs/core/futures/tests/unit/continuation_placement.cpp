@@ -0,0 +1,176 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that asynchronous continuations of futures are placed on the worker
+// thread which has made the future ready and that the placements are counted.
+
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
+#include <hpx/modules/futures.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using hpx::lcos::detail::get_continuation_placement_count;
+using hpx::lcos::detail::get_continuation_placement_hit_count;
+using hpx::lcos::detail::get_continuation_placement_hit_rate;
+using hpx::lcos::detail::get_continuation_schedule_hint;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_schedule_hint()
+{
+    hpx::threads::thread_schedule_hint hint =
+        get_continuation_schedule_hint(std::int16_t(1));
+    HPX_TEST(hint.mode == hpx::threads::thread_schedule_hint_mode::thread);
+    HPX_TEST_EQ(hint.hint, std::int16_t(1));
+
+    // an unknown producer falls back to the current worker thread
+    hint = get_continuation_schedule_hint();
+    HPX_TEST(hint.mode == hpx::threads::thread_schedule_hint_mode::thread);
+    HPX_TEST_EQ(static_cast<std::size_t>(hint.hint),
+        hpx::get_local_worker_thread_num());
+
+    hpx::lcos::detail::continuation_placement_enabled = false;
+    hint = get_continuation_schedule_hint(std::int16_t(1));
+    HPX_TEST(hint.mode == hpx::threads::thread_schedule_hint_mode::none);
+    hpx::lcos::detail::continuation_placement_enabled = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t produce(hpx::promise<void>& p)
+{
+    p.set_value();
+    return hpx::get_local_worker_thread_num();
+}
+
+void test_then_placement()
+{
+    std::int64_t const count = get_continuation_placement_count(false);
+
+    std::vector<hpx::future<void>> futures;
+    for (int i = 0; i != 10; ++i)
+    {
+        hpx::promise<void> p;
+        hpx::future<void> f = p.get_future().then(
+            hpx::launch::async, [](hpx::future<void>&& f) { f.get(); });
+
+        HPX_TEST_NEQ(hpx::async(&produce, std::ref(p)).get(),
+            static_cast<std::size_t>(-1));
+        futures.push_back(HPX_MOVE(f));
+    }
+
+    // continuations of futures which are ready already are placed as well
+    futures.push_back(hpx::make_ready_future().then(
+        hpx::launch::async, [](hpx::future<void>&& f) { f.get(); }));
+
+    hpx::wait_all(futures);
+
+    HPX_TEST_LTE(count + 11, get_continuation_placement_count(false));
+}
+
+// a continuation runs on the worker thread which has made its future ready
+void test_continuation_runs_on_producer()
+{
+    // keep all threads on the worker they were placed on
+    hpx::threads::remove_scheduler_mode(
+        hpx::threads::policies::scheduler_mode::enable_stealing);
+
+    std::int64_t const hits = get_continuation_placement_hit_count(false);
+
+    std::size_t const num_threads = hpx::get_num_worker_threads();
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        hpx::promise<void> p;
+        hpx::future<std::size_t> f =
+            p.get_future().then(hpx::launch::async, [](hpx::future<void>&&) {
+                return hpx::get_local_worker_thread_num();
+            });
+
+        auto policy = hpx::execution::experimental::with_hint(
+            hpx::launch::async,
+            hpx::threads::thread_schedule_hint(static_cast<std::int16_t>(i)));
+
+        HPX_TEST_EQ(hpx::async(policy, &produce, std::ref(p)).get(), i);
+        HPX_TEST_EQ(f.get(), i);
+    }
+
+    HPX_TEST_LTE(hits + static_cast<std::int64_t>(num_threads),
+        get_continuation_placement_hit_count(false));
+
+    hpx::threads::add_scheduler_mode(
+        hpx::threads::policies::scheduler_mode::enable_stealing);
+}
+
+void test_dataflow_placement()
+{
+    std::int64_t const count = get_continuation_placement_count(false);
+
+    hpx::future<int> f1 = hpx::async([]() { return 1; });
+    hpx::future<int> f2 = hpx::async([]() { return 2; });
+
+    hpx::future<int> result = hpx::dataflow(
+        hpx::launch::async,
+        [](hpx::future<int>&& f1, hpx::future<int>&& f2) {
+            return f1.get() + f2.get();
+        },
+        f1, f2);
+
+    HPX_TEST_EQ(result.get(), 3);
+    HPX_TEST_LTE(count + 1, get_continuation_placement_count(false));
+}
+
+void test_placement_disabled()
+{
+    hpx::lcos::detail::continuation_placement_enabled = false;
+
+    std::int64_t const count = get_continuation_placement_count(false);
+
+    hpx::make_ready_future()
+        .then(hpx::launch::async, [](hpx::future<void>&& f) { f.get(); })
+        .get();
+
+    HPX_TEST_EQ(count, get_continuation_placement_count(false));
+
+    hpx::lcos::detail::continuation_placement_enabled = true;
+}
+
+void test_hit_rate()
+{
+    std::int64_t const count = get_continuation_placement_count(false);
+    std::int64_t const hits = get_continuation_placement_hit_count(false);
+    HPX_TEST_LTE(hits, count);
+
+    std::int64_t const rate = get_continuation_placement_hit_rate(true);
+    HPX_TEST_LTE(std::int64_t(0), rate);
+    HPX_TEST_LTE(rate, std::int64_t(10000));
+
+    // the counts were reset above
+    HPX_TEST_EQ(get_continuation_placement_count(false), std::int64_t(0));
+}
+
+int hpx_main()
+{
+    test_schedule_hint();
+    test_then_placement();
+    test_continuation_runs_on_producer();
+    test_dataflow_placement();
+    test_placement_disabled();
+    test_hit_rate();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -104,6 +104,10 @@ namespace hpx { namespace util {
         // Enable global lock tracking
         bool enable_global_lock_detection() const;
 
+        // Place asynchronous continuations of futures on the worker thread
+        // which has made the future ready
+        bool use_continuation_placement() const;
+
         // Enable minimal deadlock detection for HPX threads
         bool enable_minimal_deadlock_detection() const;
         bool enable_spinlock_deadlock_detection() const;
@@ -112,6 +116,8 @@ namespace hpx { namespace util {
 #if defined(__linux) || defined(linux) || defined(__linux__) ||                \
     defined(__FreeBSD__)
         bool use_stack_guard_pages() const;
+        bool use_stack_arena() const;
+        std::size_t get_stack_arena_high_water_mark() const;
 #endif
 
         // return trace_depth for stack-backtraces
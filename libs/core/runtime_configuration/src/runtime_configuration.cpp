@@ -120,6 +120,7 @@ namespace hpx { namespace util {
             "finalize_wait_time = ${HPX_FINALIZE_WAIT_TIME:-1.0}",
             "shutdown_timeout = ${HPX_SHUTDOWN_TIMEOUT:-1.0}",
             "shutdown_check_count = ${HPX_SHUTDOWN_CHECK_COUNT:10}",
+            "continuation_placement = ${HPX_CONTINUATION_PLACEMENT:1}",
 #ifdef HPX_HAVE_VERIFY_LOCKS
 #if defined(HPX_DEBUG)
             "lock_detection = ${HPX_LOCK_DETECTION:1}",
@@ -189,6 +190,11 @@ namespace hpx { namespace util {
             "[hpx.lcos.collectives]",
             "arity = ${HPX_LCOS_COLLECTIVES_ARITY:32}",
             "cut_off = ${HPX_LCOS_COLLECTIVES_CUT_OFF:-1}",
+            // payload sizes [bytes] selecting the all_reduce and all_gather
+            // algorithms
+            "chunked_threshold = "
+            "${HPX_LCOS_COLLECTIVES_CHUNKED_THRESHOLD:16384}",
+            "ring_threshold = ${HPX_LCOS_COLLECTIVES_RING_THRESHOLD:1048576}",
 
             // connect back to the given latch if specified
             "[hpx.on_startup]",
@@ -212,6 +218,9 @@ namespace hpx { namespace util {
 #if defined(__linux) || defined(linux) || defined(__linux__) ||                \
     defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "use_arena = ${HPX_USE_STACK_ARENA:1}",
+            "arena_high_water_mark = "
+            "${HPX_STACK_ARENA_HIGH_WATER_MARK:0x4000000}",
 #endif
 
             "[hpx.threadpools]",
@@ -940,6 +949,16 @@ namespace hpx { namespace util {
         return false;
     }
 
+    bool runtime_configuration::use_continuation_placement() const
+    {
+        if (util::section const* sec = get_section("hpx"); nullptr != sec)
+        {
+            return hpx::util::get_entry_as<int>(
+                       *sec, "continuation_placement", 1) != 0;
+        }
+        return true;    // default is true
+    }
+
     // Enable minimal deadlock detection for HPX threads
     bool runtime_configuration::enable_minimal_deadlock_detection() const
     {
@@ -1095,6 +1114,34 @@ namespace hpx { namespace util {
         }
         return true;    // default is true
     }
+
+    bool runtime_configuration::use_stack_arena() const
+    {
+        if (util::section const* sec = get_section("hpx.stacks");
+            nullptr != sec)
+        {
+            return hpx::util::get_entry_as<int>(*sec, "use_arena", 1) != 0;
+        }
+        return true;    // default is true
+    }
+
+    std::size_t runtime_configuration::get_stack_arena_high_water_mark() const
+    {
+        if (util::section const* sec = get_section("hpx.stacks");
+            nullptr != sec)
+        {
+            std::string const entry =
+                sec->get_entry("arena_high_water_mark", "0x4000000");
+            char* endptr = nullptr;
+            std::uint64_t const val =
+                std::strtoull(entry.c_str(), &endptr, /*base:*/ 0);
+            if (endptr != entry.c_str())
+            {
+                return static_cast<std::size_t>(val);
+            }
+        }
+        return 0x4000000;    // default is 64MB
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
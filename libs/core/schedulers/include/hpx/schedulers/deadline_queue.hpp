@@ -0,0 +1,144 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/coroutines/thread_enums.hpp>
+#include <hpx/threading_base/thread_data.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The deadline_queue holds pending threads which have an absolute deadline
+    /// associated (see thread_schedule_hint::deadline). Threads are returned
+    /// in the order of their deadlines (earliest deadline first), threads with
+    /// equal deadlines are returned in the order they were added. The queue
+    /// additionally counts the threads which are returned only after their
+    /// deadline has passed (each thread is counted once).
+    template <typename Mutex = std::mutex>
+    class deadline_queue
+    {
+    public:
+        using mutex_type = Mutex;
+        using deadline_type = thread_schedule_hint::deadline_type;
+
+        deadline_queue()
+          : count_(0)
+          , missed_deadlines_(0)
+          , sequence_(0)
+        {
+        }
+
+        deadline_queue(deadline_queue const&) = delete;
+        deadline_queue& operator=(deadline_queue const&) = delete;
+
+        // Add the given thread, the thread has to be in pending state
+        void push(thread_id_ref_type thrd, deadline_type deadline)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            heap_.push_back(entry{deadline, sequence_++, HPX_MOVE(thrd)});
+            std::push_heap(heap_.begin(), heap_.end(), later{});
+
+            count_.fetch_add(1, std::memory_order_release);
+        }
+
+        // Retrieve the thread with the earliest deadline, don't wait for the
+        // lock if steal is true
+        bool pop(thread_id_ref_type& thrd, bool steal = false)
+        {
+            if (count_.load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+
+            std::unique_lock<mutex_type> l(mtx_, std::defer_lock);
+            if (steal)
+            {
+                if (!l.try_lock())
+                    return false;
+            }
+            else
+            {
+                l.lock();
+            }
+
+            if (heap_.empty())
+            {
+                return false;
+            }
+
+            std::pop_heap(heap_.begin(), heap_.end(), later{});
+            deadline_type const deadline = heap_.back().deadline_;
+            thrd = HPX_MOVE(heap_.back().thrd_);
+            heap_.pop_back();
+
+            count_.fetch_sub(1, std::memory_order_release);
+            l.unlock();
+
+            // a suspended thread is queued again whenever it is resumed,
+            // count each thread at most once
+            if (deadline < deadline_type::clock::now() &&
+                get_thread_id_data(thrd)->set_missed_deadline())
+            {
+                missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        // Return the number of threads held by this queue
+        std::int64_t size(
+            std::memory_order order = std::memory_order_acquire) const noexcept
+        {
+            return count_.load(order);
+        }
+
+        // Return the number of threads which were retrieved from this queue
+        // after their deadline had passed (each thread is counted once)
+        std::int64_t get_num_missed_deadlines(bool reset) noexcept
+        {
+            if (reset)
+            {
+                return missed_deadlines_.exchange(0, std::memory_order_relaxed);
+            }
+            return missed_deadlines_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct entry
+        {
+            deadline_type deadline_;
+            std::uint64_t sequence_;
+            thread_id_ref_type thrd_;
+        };
+
+        // std::push_heap/pop_heap maintain a max-heap, invert the ordering
+        struct later
+        {
+            bool operator()(entry const& lhs, entry const& rhs) const noexcept
+            {
+                return lhs.deadline_ > rhs.deadline_ ||
+                    (lhs.deadline_ == rhs.deadline_ &&
+                        lhs.sequence_ > rhs.sequence_);
+            }
+        };
+
+        mutable mutex_type mtx_;
+        std::vector<entry> heap_;
+        std::atomic<std::int64_t> count_;
+        std::atomic<std::int64_t> missed_deadlines_;
+        std::uint64_t sequence_;
+    };
+}}}    // namespace hpx::threads::policies
@@ -14,6 +14,7 @@
 #include <hpx/functional/function.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/logging.hpp>
+#include <hpx/schedulers/deadline_queue.hpp>
 #include <hpx/schedulers/deadlock_detection.hpp>
 #include <hpx/schedulers/lockfree_queue_backends.hpp>
 #include <hpx/schedulers/thread_queue.hpp>
@@ -57,6 +58,10 @@ namespace hpx { namespace threads { namespace policies {
     /// High priority threads are executed by the first N OS threads before any
     /// other work is executed. Low priority threads are executed by the last
     /// OS thread whenever no other work is available.
+    /// Threads which have a deadline associated (see
+    /// thread_schedule_hint::deadline) are kept in separate per-OS thread
+    /// deadline queues. These threads are executed before any other work,
+    /// earliest deadline first.
     template <typename Mutex = std::mutex,
         typename PendingQueuing = lockfree_fifo,
         typename StagedQueuing = lockfree_fifo,
@@ -71,6 +76,8 @@ namespace hpx { namespace threads { namespace policies {
             TerminatedQueuing>
             thread_queue_type;
 
+        using deadline_queue_type = deadline_queue<Mutex>;
+
         // the scheduler type takes two initialization parameters:
         //    the number of queues
         //    the number of high priority queues
@@ -124,7 +131,10 @@ namespace hpx { namespace threads { namespace policies {
           , queues_(num_queues_)
           , high_priority_queues_(num_queues_)
           , victim_threads_(num_queues_)
+          , deadline_queues_(num_queues_)
         {
+            deadline_thread_count_.data_ = 0;
+
             if (!deferred_initialization)
             {
                 HPX_ASSERT(num_queues_ != 0);
@@ -530,6 +540,14 @@ namespace hpx { namespace threads { namespace policies {
             data.schedulehint.mode = thread_schedule_hint_mode::thread;
             data.schedulehint.hint = static_cast<std::int16_t>(num_thread);
 
+            // threads with a deadline are ordered by their deadlines
+            if (data.schedulehint.has_deadline() &&
+                data.initial_state == thread_schedule_state::pending)
+            {
+                create_deadline_thread(num_thread, data, id, ec);
+                return;
+            }
+
             // now create the thread
             if (data.priority == thread_priority::high_recursive ||
                 data.priority == thread_priority::high ||
@@ -598,6 +616,16 @@ namespace hpx { namespace threads { namespace policies {
             threads::thread_id_ref_type& thrd, bool enable_stealing) override
         {
             HPX_ASSERT(num_thread < num_queues_);
+
+            // threads with a deadline are executed before any other work
+            if (deadline_thread_count_.data_.load(std::memory_order_relaxed) !=
+                    0 &&
+                get_next_deadline_thread(
+                    num_thread, running, thrd, enable_stealing))
+            {
+                return true;
+            }
+
             thread_queue_type* this_high_priority_queue = nullptr;
             thread_queue_type* this_queue = queues_[num_thread].data_;
 
@@ -711,7 +739,21 @@ namespace hpx { namespace threads { namespace policies {
             num_thread = select_active_pu(l, num_thread, allow_fallback);
 
             auto* thrdptr = get_thread_id_data(thrd);
-            (void) thrdptr;
+            if (thrdptr->has_deadline())
+            {
+                LTM_(debug).format(
+                    "local_priority_queue_scheduler::schedule_thread, "
+                    "deadline queue: "
+                    "pool({}), scheduler({}), worker_thread({}), "
+                    "thread({}), description({})",
+                    *this->get_parent_pool(), *this, num_thread,
+                    thrdptr->get_thread_id(), thrdptr->get_description());
+
+                schedule_deadline_thread(
+                    num_thread, HPX_MOVE(thrd), thrdptr->get_deadline());
+                return;
+            }
+
             if (priority == thread_priority::high_recursive ||
                 priority == thread_priority::high ||
                 priority == thread_priority::boost)
@@ -786,6 +828,15 @@ namespace hpx { namespace threads { namespace policies {
             std::unique_lock<pu_mutex_type> l;
             num_thread = select_active_pu(l, num_thread, allow_fallback);
 
+            // the deadline determines the position in the deadline queue
+            auto* thrdptr = get_thread_id_data(thrd);
+            if (thrdptr->has_deadline())
+            {
+                schedule_deadline_thread(
+                    num_thread, HPX_MOVE(thrd), thrdptr->get_deadline());
+                return;
+            }
+
             if (priority == thread_priority::high_recursive ||
                 priority == thread_priority::high ||
                 priority == thread_priority::boost)
@@ -831,7 +882,8 @@ namespace hpx { namespace threads { namespace policies {
                 if (num_thread == num_queues_ - 1)
                     count += low_priority_queue_.get_queue_length();
 
-                return count + queues_[num_thread].data_->get_queue_length();
+                return count + queues_[num_thread].data_->get_queue_length() +
+                    deadline_queues_[num_thread].data_.size();
             }
 
             // Cumulative queue lengths of all queues.
@@ -844,7 +896,8 @@ namespace hpx { namespace threads { namespace policies {
             for (std::size_t i = 0; i != num_queues_; ++i)
                 count += queues_[i].data_->get_queue_length();
 
-            return count;
+            return count +
+                deadline_thread_count_.data_.load(std::memory_order_relaxed);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -972,7 +1025,8 @@ namespace hpx { namespace threads { namespace policies {
         bool is_core_idle(std::size_t num_thread) const override
         {
             if (num_thread < num_queues_ &&
-                queues_[num_thread].data_->get_queue_length() != 0)
+                (queues_[num_thread].data_->get_queue_length() != 0 ||
+                    deadline_queues_[num_thread].data_.size() != 0))
             {
                 return false;
             }
@@ -1230,6 +1284,13 @@ namespace hpx { namespace threads { namespace policies {
                     result;
             }
 
+            // threads with a deadline might still be waiting to be executed
+            if (deadline_queues_[num_thread].data_.size(
+                    std::memory_order_relaxed) != 0)
+            {
+                result = false;
+            }
+
             return result;
         }
 
@@ -1398,7 +1459,112 @@ namespace hpx { namespace threads { namespace policies {
             curr_queue_.store(0, std::memory_order_release);
         }
 
+        std::int64_t get_num_missed_deadlines(
+            std::size_t num_thread, bool reset) override
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                HPX_ASSERT(num_thread < num_queues_);
+                return deadline_queues_[num_thread]
+                    .data_.get_num_missed_deadlines(reset);
+            }
+
+            std::int64_t count = 0;
+            for (std::size_t i = 0; i != num_queues_; ++i)
+            {
+                count += deadline_queues_[i].data_.get_num_missed_deadlines(
+                    reset);
+            }
+            return count;
+        }
+
     protected:
+        ///////////////////////////////////////////////////////////////////////
+        // Threads with a deadline are created right away (instead of being
+        // staged) as they have to be ordered by their deadlines.
+        void create_deadline_thread(std::size_t num_thread,
+            thread_init_data& data, thread_id_ref_type* id, error_code& ec)
+        {
+            if (data.priority == thread_priority::boost)
+            {
+                data.priority = thread_priority::normal;
+            }
+
+            data.run_now = true;
+            data.initial_state = thread_schedule_state::suspended;
+
+            thread_id_ref_type thrd;
+            queues_[num_thread].data_->create_thread(data, &thrd, ec);
+            if (ec)
+            {
+                return;
+            }
+
+            thread_data* thrdptr = get_thread_id_data(thrd);
+            thrdptr->set_state(thread_schedule_state::pending);
+
+            LTM_(debug)
+                .format("local_priority_queue_scheduler::create_thread, "
+                        "deadline queue: "
+                        "pool({}), scheduler({}), worker_thread({}), "
+                        "thread({})",
+                    *this->get_parent_pool(), *this, num_thread, thrd)
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+                .format(", description({})", data.description)
+#endif
+                ;
+
+            if (id)
+            {
+                *id = thrd;
+            }
+            schedule_deadline_thread(
+                num_thread, HPX_MOVE(thrd), thrdptr->get_deadline());
+        }
+
+        void schedule_deadline_thread(std::size_t num_thread,
+            thread_id_ref_type thrd,
+            thread_schedule_hint::deadline_type deadline)
+        {
+            HPX_ASSERT(num_thread < num_queues_);
+
+            deadline_thread_count_.data_.fetch_add(
+                1, std::memory_order_relaxed);
+            deadline_queues_[num_thread].data_.push(HPX_MOVE(thrd), deadline);
+        }
+
+        bool get_next_deadline_thread(std::size_t num_thread, bool running,
+            thread_id_ref_type& thrd, bool enable_stealing)
+        {
+            if (!deadline_queues_[num_thread].data_.pop(thrd))
+            {
+                if (!running || !enable_stealing)
+                {
+                    return false;
+                }
+
+                bool stolen = false;
+                for (std::size_t idx : victim_threads_[num_thread].data_)
+                {
+                    HPX_ASSERT(idx != num_thread);
+                    if (deadline_queues_[idx].data_.pop(thrd, true))
+                    {
+                        stolen = true;
+                        break;
+                    }
+                }
+
+                if (!stolen)
+                {
+                    return false;
+                }
+            }
+
+            deadline_thread_count_.data_.fetch_sub(
+                1, std::memory_order_relaxed);
+            return true;
+        }
+
         std::atomic<std::size_t> curr_queue_;
 
         detail::affinity_data const& affinity_data_;
@@ -1413,6 +1579,10 @@ namespace hpx { namespace threads { namespace policies {
             high_priority_queues_;
         std::vector<util::cache_line_data<std::vector<std::size_t>>>
             victim_threads_;
+
+        std::vector<util::cache_line_data<deadline_queue_type>>
+            deadline_queues_;
+        util::cache_line_data<std::atomic<std::int64_t>> deadline_thread_count_;
     };
 }}}    // namespace hpx::threads::policies
 
@@ -20,10 +20,14 @@
 #include <hpx/allocator_support/aligned_allocator.hpp>
 
 // Does not rely on CXX11_STD_ATOMIC_128BIT
+#include <hpx/concurrency/chase_lev_deque.hpp>
 #include <hpx/concurrency/concurrentqueue.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 namespace hpx { namespace threads { namespace policies {
@@ -153,6 +157,114 @@ namespace hpx { namespace threads { namespace policies {
         };
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Chase-Lev work-stealing deque. The worker thread owning the queue pushes
+    // and pops at the bottom end (LIFO) without atomic read-modify-write
+    // operations in the common case, all other threads steal from the top end.
+    // Items pushed by threads other than the owner (or pushed to the other
+    // end) are funneled through a separate multi-producer queue which is
+    // drained once the deque has run empty.
+    //
+    // The owner is bound by calling bind_owner() from the worker thread (see
+    // thread_queue::on_start_thread). Ownership is decided by thread identity
+    // only, the 'steal' argument of pop() is ignored.
+    template <typename T>
+    struct lockfree_chase_lev_backend
+    {
+        using container_type = hpx::concurrency::chase_lev_deque<T>;
+        using overflow_container_type = hpx::concurrency::ConcurrentQueue<T>;
+
+        using value_type = T;
+        using reference = T&;
+        using const_reference = T const&;
+        using rvalue_reference = T&&;
+        using size_type = std::uint64_t;
+
+        lockfree_chase_lev_backend(size_type initial_size = 0,
+            size_type /* num_thread */ = size_type(-1))
+          : queue_(std::size_t(initial_size))
+          , overflow_queue_(std::size_t(initial_size))
+          , owner_()
+        {
+        }
+
+        void bind_owner() noexcept
+        {
+            owner_.store(std::this_thread::get_id(), std::memory_order_release);
+        }
+
+        bool push(const_reference val, bool other_end = false)
+        {
+            if (!other_end && is_owner())
+            {
+                queue_.push(val);
+                return true;
+            }
+            return overflow_queue_.enqueue(val);
+        }
+
+        bool pop(reference val, bool /* steal */ = true)
+        {
+            if (is_owner())
+            {
+                return queue_.pop(val) || overflow_queue_.try_dequeue(val);
+            }
+            return queue_.steal(val) || overflow_queue_.try_dequeue(val);
+        }
+
+        bool empty()
+        {
+            return queue_.empty() && overflow_queue_.size_approx() == 0;
+        }
+
+    private:
+        bool is_owner() const noexcept
+        {
+            return owner_.load(std::memory_order_relaxed) ==
+                std::this_thread::get_id();
+        }
+
+        container_type queue_;
+        overflow_container_type overflow_queue_;
+        std::atomic<std::thread::id> owner_;
+    };
+
+    struct lockfree_chase_lev
+    {
+        template <typename T>
+        struct apply
+        {
+            using type = lockfree_chase_lev_backend<T>;
+        };
+    };
+
+    namespace detail {
+
+        template <typename Queue, typename Enable = void>
+        struct has_bind_owner : std::false_type
+        {
+        };
+
+        template <typename Queue>
+        struct has_bind_owner<Queue,
+            std::void_t<decltype(std::declval<Queue&>().bind_owner())>>
+          : std::true_type
+        {
+        };
+
+        // Bind owner-aware queue back-ends to the calling (worker) thread,
+        // this is a no-op for all other back-ends.
+        template <typename Queue>
+        void bind_queue_backend_owner(Queue& queue) noexcept
+        {
+            if constexpr (has_bind_owner<Queue>::value)
+            {
+                queue.bind_owner();
+            }
+        }
+    }    // namespace detail
+
+    ////////////////////////////////////////////////////////////////////////////
     // LIFO
 #if defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
     struct lockfree_lifo;
@@ -743,6 +743,81 @@ namespace hpx { namespace threads { namespace policies {
             return 0;
         }
 
+        // ----------------------------------------------------------------
+        // Steal up to half of the pending high priority threads of 'victim'
+        bool steal_next_thread_HP(
+            thread_holder_type* victim, threads::thread_id_ref_type& thrd)
+        {
+            // bound threads are never stolen
+            if (hp_queue_ && victim->hp_queue_ &&
+                hp_queue_->steal_next_thread(victim->hp_queue_, thrd))
+            {
+                tq_deb.debug(debug::str<>("steal_next_HP"),
+                    queue_data_print(this), "from", queue_data_print(victim),
+                    debug::threadinfo<threads::thread_id_ref_type*>(&thrd),
+                    "thread_priority::high");
+                return true;
+            }
+            return false;
+        }
+
+        // ----------------------------------------------------------------
+        // Steal up to half of the pending normal/low priority threads of
+        // 'victim'
+        bool steal_next_thread(
+            thread_holder_type* victim, threads::thread_id_ref_type& thrd)
+        {
+            if (np_queue_->steal_next_thread(victim->np_queue_, thrd))
+            {
+                tq_deb.debug(debug::str<>("steal_next_NP"),
+                    queue_data_print(this), "from", queue_data_print(victim),
+                    debug::threadinfo<threads::thread_id_ref_type*>(&thrd),
+                    "thread_priority::normal");
+                return true;
+            }
+
+            if (lp_queue_ && victim->lp_queue_ &&
+                lp_queue_->steal_next_thread(victim->lp_queue_, thrd))
+            {
+                tq_deb.debug(debug::str<>("steal_next_LP"),
+                    queue_data_print(this), "from", queue_data_print(victim),
+                    debug::threadinfo<threads::thread_id_ref_type*>(&thrd),
+                    "thread_priority::low");
+                return true;
+            }
+            return false;
+        }
+
+        // ----------------------------------------------------------------
+        // Steal up to half of the new high priority tasks of 'victim'
+        std::size_t steal_new_HP(thread_holder_type* victim)
+        {
+            if (owns_hp_queue() && victim->hp_queue_)
+            {
+                return hp_queue_->steal_new(victim->hp_queue_);
+            }
+            return 0;
+        }
+
+        // ----------------------------------------------------------------
+        // Steal up to half of the new normal/low priority tasks of 'victim'
+        std::size_t steal_new(thread_holder_type* victim)
+        {
+            std::size_t added;
+            if (owns_np_queue())
+            {
+                added = np_queue_->steal_new(victim->np_queue_);
+                if (added > 0)
+                    return added;
+            }
+
+            if (owns_lp_queue() && victim->lp_queue_)
+            {
+                return lp_queue_->steal_new(victim->lp_queue_);
+            }
+            return 0;
+        }
+
         // ----------------------------------------------------------------
         inline std::size_t get_queue_length()
         {
@@ -27,6 +27,7 @@
 #include <hpx/threading_base/thread_queue_init_parameters.hpp>
 #include <hpx/topology/topology.hpp>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
@@ -37,6 +38,7 @@
 #include <mutex>
 #include <numeric>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -169,6 +171,8 @@ namespace hpx { namespace threads { namespace policies {
           , num_domains_(1)
           , affinity_data_(init.affinity_data_)
           , queue_parameters_(init.thread_queue_init_)
+          , steal_victims_(init.num_worker_threads_)
+          , num_local_victims_(init.num_worker_threads_, 0)
           , initialized_(false)
           , debug_init_(false)
           , thread_init_counter_(0)
@@ -194,11 +198,14 @@ namespace hpx { namespace threads { namespace policies {
                 mode & policies::scheduler_mode::steal_high_priority_first;
             core_stealing_ = mode & policies::scheduler_mode::enable_stealing;
             numa_stealing_ = mode & policies::scheduler_mode::enable_stealing_numa;
+            steal_hierarchical_ =
+                mode & policies::scheduler_mode::steal_hierarchical;
             spq_deb.debug(debug::str<>("scheduler_mode")
                 , round_robin_ ? "round_robin" : "thread parent", ','
                 , steal_hp_first_ ? "steal_hp_first" : "steal after local", ','
                 , core_stealing_ ? "stealing" : "no stealing", ','
-                , numa_stealing_ ? "numa stealing" : "no numa stealing");
+                , numa_stealing_ ? "numa stealing" : "no numa stealing", ','
+                , steal_hierarchical_ ? "hierarchical" : "not hierarchical");
             // clang-format on
         }
 
@@ -597,6 +604,45 @@ namespace hpx { namespace threads { namespace policies {
             return false;
         }
 
+        // Steal from the queues of the other worker threads in the order
+        // computed at startup (cores sharing a cache first, then the other
+        // cores on the same numa domain, then other numa domains). Each
+        // successful steal takes up to half of the work of the victim.
+        template <typename T>
+        bool steal_from_victims(std::size_t this_thread, bool steal_numa,
+            T& var, const char* prefix,
+            hpx::function<bool(thread_holder_type*, T&)> operation_HP,
+            hpx::function<bool(thread_holder_type*, T&)> operation)
+        {
+            auto const& victims = steal_victims_[this_thread];
+            std::size_t const count =
+                steal_numa ? victims.size() : num_local_victims_[this_thread];
+
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                if (operation_HP(victims[i], var))
+                {
+                    spq_deb.debug(debug::str<>(prefix),
+                        "steal_hierarchical BP/HP", "victim", debug::dec<3>(i),
+                        "D", debug::dec<2>(victims[i]->domain_index_), "Q",
+                        debug::dec<3>(victims[i]->queue_index_));
+                    return true;
+                }
+            }
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                if (operation(victims[i], var))
+                {
+                    spq_deb.debug(debug::str<>(prefix),
+                        "steal_hierarchical NP/LP", "victim", debug::dec<3>(i),
+                        "D", debug::dec<2>(victims[i]->domain_index_), "Q",
+                        debug::dec<3>(victims[i]->queue_index_));
+                    return true;
+                }
+            }
+            return false;
+        }
+
         /// Return the next thread to be executed, return false if none available
         virtual bool get_next_thread(std::size_t thread_num, bool running,
             threads::thread_id_ref_type& thrd, bool enable_stealing) override
@@ -631,13 +677,34 @@ namespace hpx { namespace threads { namespace policies {
             std::size_t domain = d_lookup_[this_thread];
             std::size_t q_index = q_lookup_[this_thread];
 
+            // hierarchical stealing replaces stealing after local work
+            bool const hierarchical =
+                core_stealing_ && steal_hierarchical_ && !steal_hp_first_;
+
             // first try a high priority task, allow stealing
             // if stealing of HP tasks in on, this will be fine
             // but send a null function for normal tasks
             bool result = steal_by_function<threads::thread_id_ref_type>(domain,
-                q_index, numa_stealing_, core_stealing_, nullptr, thrd,
-                "SBF-get_next_thread", get_next_thread_function_HP,
-                get_next_thread_function);
+                q_index, numa_stealing_, core_stealing_ && !hierarchical,
+                nullptr, thrd, "SBF-get_next_thread",
+                get_next_thread_function_HP, get_next_thread_function);
+
+            if (!result && hierarchical)
+            {
+                thread_holder_type* receiver =
+                    numa_holder_[domain].queues_[q_index];
+
+                result = steal_from_victims<threads::thread_id_ref_type>(
+                    this_thread, numa_stealing_, thrd, "SFV-get_next_thread",
+                    [receiver](thread_holder_type* victim,
+                        threads::thread_id_ref_type& thrd) {
+                        return receiver->steal_next_thread_HP(victim, thrd);
+                    },
+                    [receiver](thread_holder_type* victim,
+                        threads::thread_id_ref_type& thrd) {
+                        return receiver->steal_next_thread(victim, thrd);
+                    });
+            }
 
             if (result)
                 return result;
@@ -692,9 +759,28 @@ namespace hpx { namespace threads { namespace policies {
                 q_index, "numa_stealing ", numa_stealing_, "core_stealing ",
                 core_stealing_);
 
+            // hierarchical stealing replaces stealing after local work
+            bool const hierarchical =
+                core_stealing_ && steal_hierarchical_ && !steal_hp_first_;
+
             bool added_tasks = steal_by_function<std::size_t>(domain, q_index,
-                numa_stealing_, core_stealing_, receiver, added,
-                "wait_or_add_new", add_new_function_HP, add_new_function);
+                numa_stealing_, core_stealing_ && !hierarchical, receiver,
+                added, "wait_or_add_new", add_new_function_HP,
+                add_new_function);
+
+            if (!added_tasks && hierarchical)
+            {
+                added_tasks = steal_from_victims<std::size_t>(this_thread,
+                    numa_stealing_, added, "SFV-wait_or_add_new",
+                    [receiver](thread_holder_type* victim, std::size_t& added) {
+                        added = receiver->steal_new_HP(victim);
+                        return added > 0;
+                    },
+                    [receiver](thread_holder_type* victim, std::size_t& added) {
+                        added = receiver->steal_new(victim);
+                        return added > 0;
+                    });
+            }
 
             if (added_tasks)
             {
@@ -1202,6 +1288,10 @@ namespace hpx { namespace threads { namespace policies {
                 std::this_thread::yield();
             }
 
+            // now that all queues exist, order the queues of the other
+            // threads by distance for hierarchical stealing
+            init_steal_victims(local_thread);
+
             lock.lock();
             if (!debug_init_)
             {
@@ -1220,6 +1310,68 @@ namespace hpx { namespace threads { namespace policies {
             }
         }
 
+        // Sort the queue holders of all other worker threads by their
+        // distance to the given thread: threads sharing the L2 cache come
+        // first, followed by threads sharing the L3 cache, the remaining
+        // threads of the same numa domain and finally the threads on other
+        // numa domains. Within each group the victims are ordered starting
+        // from the next thread to spread the stealing load.
+        void init_steal_victims(std::size_t local_thread)
+        {
+            auto const& topo = create_topology();
+
+            std::size_t pu_num = affinity_data_.get_pu_num(
+                local_to_global_thread_index(local_thread));
+            mask_type const l2_mask = topo.get_cache_affinity_mask(pu_num, 2);
+            mask_type const l3_mask = topo.get_cache_affinity_mask(pu_num, 3);
+            std::size_t const domain = d_lookup_[local_thread];
+
+            // tuple of : distance, relative thread id, queue holder
+            using victim_tuple =
+                std::tuple<std::size_t, std::size_t, thread_holder_type*>;
+            std::vector<victim_tuple> victims;
+            victims.reserve(num_workers_);
+
+            std::size_t num_local = 0;
+            for (std::size_t i = 1; i != num_workers_; ++i)
+            {
+                std::size_t local_id = fast_mod(local_thread + i, num_workers_);
+                std::size_t victim_domain = d_lookup_[local_id];
+                thread_holder_type* victim =
+                    numa_holder_[victim_domain]
+                        .queues_[local_id - q_offset_[victim_domain]];
+
+                std::size_t victim_pu = affinity_data_.get_pu_num(
+                    local_to_global_thread_index(local_id));
+
+                std::size_t distance = 3;
+                if (victim_domain == domain)
+                {
+                    ++num_local;
+                    if (test(l2_mask, victim_pu))
+                        distance = 0;
+                    else if (test(l3_mask, victim_pu))
+                        distance = 1;
+                    else
+                        distance = 2;
+                }
+                victims.push_back(std::make_tuple(distance, i, victim));
+            }
+
+            std::sort(victims.begin(), victims.end());
+
+            steal_victims_[local_thread].clear();
+            steal_victims_[local_thread].reserve(victims.size());
+            for (auto const& v : victims)
+            {
+                steal_victims_[local_thread].push_back(std::get<2>(v));
+            }
+            num_local_victims_[local_thread] = num_local;
+
+            spq_deb.debug(debug::str<>("steal victims"), "local_thread",
+                local_thread, "victims", victims.size(), "local", num_local);
+        }
+
         void on_stop_thread(std::size_t thread_num) override
         {
             if (thread_num > num_workers_)
@@ -1389,6 +1541,10 @@ namespace hpx { namespace threads { namespace policies {
         // when false, no stealing takes place between any cores(queues)
         bool core_stealing_;
 
+        // when true, victims are selected by distance (shared caches first)
+        // and up to half of the work of a victim is stolen at once
+        bool steal_hierarchical_;
+
         // number of worker threads assigned to this pool
         std::size_t num_workers_;
 
@@ -1399,6 +1555,11 @@ namespace hpx { namespace threads { namespace policies {
 
         const thread_queue_init_parameters queue_parameters_;
 
+        // for each thread, the queue holders of all other threads ordered
+        // by distance, and the number of those on the same numa domain
+        std::vector<std::vector<thread_holder_type*>> steal_victims_;
+        std::vector<std::size_t> num_local_victims_;
+
         // used to make sure the scheduler is only initialized once on a thread
         std::mutex init_mutex;
         bool initialized_;
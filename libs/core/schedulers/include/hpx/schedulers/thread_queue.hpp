@@ -1117,6 +1117,11 @@ namespace hpx { namespace threads { namespace policies {
         ///////////////////////////////////////////////////////////////////////
         void on_start_thread(std::size_t /* num_thread */)
         {
+            // owner-aware queue back-ends (e.g. lockfree_chase_lev) need to
+            // know which worker thread is allowed to use their private end
+            detail::bind_queue_backend_owner(work_items_);
+            detail::bind_queue_backend_owner(new_tasks_);
+
             thread_heap_small_.reserve(parameters_.init_threads_count_);
             thread_heap_medium_.reserve(parameters_.init_threads_count_);
             thread_heap_large_.reserve(parameters_.init_threads_count_);
@@ -136,6 +136,65 @@ namespace hpx { namespace threads { namespace policies {
             return added;
         }
 
+        // ----------------------------------------------------------------
+        // Steal up to half of the new work items of 'victim' in one batch,
+        // the stolen tasks are converted into threads and added to the
+        // pending queue of this queue.
+        //
+        // This is not thread safe, only the thread owning the holder should
+        // call this function
+        std::size_t steal_new(thread_queue_type* victim)
+        {
+            if (victim == this)
+            {
+                return 0;
+            }
+
+            std::int64_t count =
+                victim->new_tasks_count_.data_.load(std::memory_order_relaxed);
+            return add_new((count + 1) / 2, victim, true);
+        }
+
+        // ----------------------------------------------------------------
+        // Steal up to half of the pending work items of 'victim' in one
+        // batch. The first stolen thread is returned, the remaining ones are
+        // added to the pending queue of this queue.
+        bool steal_next_thread(
+            thread_queue_type* victim, threads::thread_id_ref_type& thrd)
+        {
+            if (victim == this)
+            {
+                return false;
+            }
+
+            std::int64_t count =
+                victim->work_items_count_.data_.load(std::memory_order_relaxed);
+            if (count <= 0 || !victim->work_items_.pop(thrd, true))
+            {
+                return false;
+            }
+            --victim->work_items_count_.data_;
+
+            std::size_t stolen = 1;
+            threads::thread_id_ref_type tid;
+            for (count /= 2; count > 1 && victim->work_items_.pop(tid, true);
+                 --count)
+            {
+                --victim->work_items_count_.data_;
+                schedule_work(HPX_MOVE(tid), false);
+                ++stolen;
+            }
+
+            tqmc_deb.debug(debug::str<>("steal_next_thread"), "D",
+                debug::dec<2>(holder_->domain_index_), "Q",
+                debug::dec<3>(queue_index_), "from D",
+                debug::dec<2>(victim->holder_->domain_index_), "Q",
+                debug::dec<3>(victim->queue_index_), "stolen",
+                debug::dec<4>(stolen),
+                debug::threadinfo<threads::thread_id_ref_type*>(&thrd));
+            return true;
+        }
+
     public:
         explicit thread_queue_mc(const thread_queue_init_parameters& parameters,
             std::size_t queue_num = std::size_t(-1))
@@ -0,0 +1,163 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test that threads with a deadline are executed in the order of their
+// deadlines (earliest deadline first) before threads without a deadline, and
+// that threads executed after their deadline has passed are counted once.
+
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using hpx::execution::experimental::get_deadline;
+using hpx::execution::experimental::with_deadline;
+
+std::mutex mtx;
+std::vector<int> order;
+
+void record(int i)
+{
+    std::lock_guard<std::mutex> l(mtx);
+    order.push_back(i);
+}
+
+std::int64_t get_num_missed_deadlines()
+{
+    return hpx::threads::get_self_id_data()
+        ->get_scheduler_base()
+        ->get_num_missed_deadlines(std::size_t(-1), false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_deadline_properties()
+{
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    auto exec = with_deadline(hpx::execution::parallel_executor(), deadline);
+    HPX_TEST(get_deadline(exec) == deadline);
+
+    auto policy = with_deadline(hpx::launch::async, deadline);
+    HPX_TEST(get_deadline(policy) == deadline);
+
+    HPX_TEST(!hpx::threads::thread_schedule_hint().has_deadline());
+    HPX_TEST(hpx::threads::thread_schedule_hint(deadline).has_deadline());
+}
+
+void test_earliest_deadline_first()
+{
+    order.clear();
+
+    auto const now = std::chrono::steady_clock::now();
+    int const deadlines[] = {5, 2, 8, 1, 9, 3, 7, 4, 6, 0};
+
+    std::vector<hpx::future<void>> futures;
+
+    // threads without a deadline are executed after all threads with one
+    for (int i = 0; i != 10; ++i)
+    {
+        futures.push_back(hpx::async(hpx::launch::async, &record, -1));
+    }
+
+    for (int d : deadlines)
+    {
+        futures.push_back(hpx::async(
+            with_deadline(hpx::launch::async, now + std::chrono::hours(d + 1)),
+            &record, d));
+    }
+
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(order.size(), std::size_t(20));
+    for (std::size_t i = 0; i != order.size(); ++i)
+    {
+        HPX_TEST_EQ(order[i], i < 10 ? static_cast<int>(i) : -1);
+    }
+}
+
+void test_missed_deadlines()
+{
+    std::int64_t const missed = get_num_missed_deadlines();
+
+    auto const now = std::chrono::steady_clock::now();
+
+    std::vector<hpx::future<void>> futures;
+    for (int i = 0; i != 10; ++i)
+    {
+        // half of the threads are created with a deadline in the past
+        auto const deadline = i % 2 == 0 ? now - std::chrono::seconds(1) :
+                                           now + std::chrono::hours(1);
+        futures.push_back(hpx::async(
+            with_deadline(hpx::execution::parallel_executor(), deadline),
+            &record, i));
+    }
+
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(get_num_missed_deadlines() - missed, std::int64_t(5));
+}
+
+void yield_and_record(int i)
+{
+    // every yield queues the thread again
+    for (int j = 0; j != 3; ++j)
+    {
+        hpx::this_thread::yield();
+    }
+    record(i);
+}
+
+void test_missed_deadlines_counted_once()
+{
+    std::int64_t const missed = get_num_missed_deadlines();
+
+    auto const deadline =
+        std::chrono::steady_clock::now() - std::chrono::seconds(1);
+
+    std::vector<hpx::future<void>> futures;
+    for (int i = 0; i != 5; ++i)
+    {
+        futures.push_back(hpx::async(
+            with_deadline(hpx::execution::parallel_executor(), deadline),
+            &yield_and_record, i));
+    }
+
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(get_num_missed_deadlines() - missed, std::int64_t(5));
+}
+
+int hpx_main()
+{
+    test_deadline_properties();
+    test_earliest_deadline_first();
+    test_missed_deadlines();
+    test_missed_deadlines_counted_once();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // the order of execution is deterministic with one worker thread only
+    std::vector<std::string> const cfg = {"hpx.os_threads=1"};
+
+    hpx::local::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
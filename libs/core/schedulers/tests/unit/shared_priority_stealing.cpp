@@ -0,0 +1,99 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test that an irregular task graph whose tasks are all created on the same
+// worker thread is completely executed by the shared_priority_queue_scheduler,
+// with and without hierarchical (steal-half) work stealing.
+
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/runtime.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/resource_partitioner.hpp>
+#include <hpx/modules/schedulers.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+std::atomic<std::size_t> tasks_executed(0);
+
+// number of tasks in the tree spawned by spawn_tree(depth)
+std::size_t tree_size(std::size_t depth)
+{
+    return depth == 0 ? 1 : 1 + (depth % 3 + 1) * tree_size(depth - 1);
+}
+
+void spawn_tree(std::size_t depth)
+{
+    ++tasks_executed;
+
+    if (depth == 0)
+    {
+        return;
+    }
+
+    // create all children on worker 0 to force the others to steal
+    auto exec = hpx::execution::parallel_executor(
+        hpx::threads::thread_priority::normal,
+        hpx::threads::thread_stacksize::default_,
+        hpx::threads::thread_schedule_hint(std::int16_t(0)));
+
+    std::vector<hpx::future<void>> children;
+    for (std::size_t i = 0; i != depth % 3 + 1; ++i)
+    {
+        children.push_back(hpx::async(exec, &spawn_tree, depth - 1));
+    }
+    hpx::wait_all(children);
+}
+
+int hpx_main()
+{
+    constexpr std::size_t depth = 9;
+
+    tasks_executed = 0;
+    spawn_tree(depth);
+    HPX_TEST_EQ(tasks_executed.load(), tree_size(depth));
+
+    return hpx::local::finalize();
+}
+
+void test_scheduler(
+    int argc, char* argv[], hpx::threads::policies::scheduler_mode mode)
+{
+    hpx::local::init_params init_args;
+
+    init_args.rp_callback = [mode](auto& rp,
+                                hpx::program_options::variables_map const&) {
+        rp.create_thread_pool(
+            "default", hpx::resource::scheduling_policy::shared_priority, mode);
+    };
+
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+}
+
+int main(int argc, char* argv[])
+{
+    using hpx::threads::policies::scheduler_mode;
+
+    // hierarchical stealing is part of the default mode
+    test_scheduler(argc, argv, scheduler_mode::default_);
+
+    // stealing from the neighboring queues only
+    test_scheduler(argc, argv,
+        scheduler_mode(scheduler_mode::default_ &
+            ~scheduler_mode::steal_hierarchical));
+
+    // hierarchical stealing within numa domains only
+    test_scheduler(argc, argv,
+        scheduler_mode(scheduler_mode::default_ &
+            ~scheduler_mode::enable_stealing_numa));
+
+    return hpx::util::report_errors();
+}
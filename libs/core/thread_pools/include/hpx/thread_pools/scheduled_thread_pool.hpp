@@ -219,6 +219,18 @@ namespace hpx { namespace threads { namespace detail {
             return sched_->Scheduler::get_num_stolen_to_staged(num, reset);
         }
 #endif
+
+        std::int64_t get_num_missed_deadlines(
+            std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_num_missed_deadlines(num, reset);
+        }
+
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        std::vector<std::int64_t> get_latency_histogram(
+            thread_latency which, std::size_t num, bool reset) override;
+#endif
+
         std::int64_t get_queue_length(
             std::size_t num_thread, bool /* reset */) override
         {
@@ -389,6 +401,11 @@ namespace hpx { namespace threads { namespace detail {
 
         std::vector<scheduling_counter_data> counter_data_;
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        // latency histograms, one set for each worker thread
+        std::unique_ptr<thread_latency_histograms[]> latency_histograms_;
+#endif
+
         // support detail::manage_executor interface
         std::atomic<long> thread_count_;
         std::atomic<std::int64_t> tasks_scheduled_;
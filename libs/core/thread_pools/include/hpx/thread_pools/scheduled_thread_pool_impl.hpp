@@ -233,7 +233,7 @@ namespace hpx { namespace threads { namespace detail {
             sched_->Scheduler::set_all_states_at_least(hpx::state::stopping);
 
             // make sure we're not waiting
-            sched_->Scheduler::do_some_work(std::size_t(-1));
+            sched_->Scheduler::wake_all_idle_workers();
 
             if (blocking)
             {
@@ -246,7 +246,7 @@ namespace hpx { namespace threads { namespace detail {
                     // make sure no OS thread is waiting
                     LTM_(info).format("stop: {} notify_all", id_.name());
 
-                    sched_->Scheduler::do_some_work(std::size_t(-1));
+                    sched_->Scheduler::wake_all_idle_workers();
 
                     LTM_(info).format("stop: {} join:{}", id_.name(), i);
 
@@ -518,6 +518,10 @@ namespace hpx { namespace threads { namespace detail {
                     counter_data.tasks_active_);
 #endif    // HPX_HAVE_BACKGROUND_THREAD_COUNTERS
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+                counters.latency_histograms_ = &latency_histograms_[thread_num];
+#endif
+
                 detail::scheduling_callbacks callbacks(
                     util::deferred_call(    //-V107
                         &policies::scheduler_base::idle_callback, sched_.get(),
@@ -1774,6 +1778,29 @@ namespace hpx { namespace threads { namespace detail {
     }
 #endif    // HPX_HAVE_THREAD_IDLE_RATES
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    template <typename Scheduler>
+    std::vector<std::int64_t>
+    scheduled_thread_pool<Scheduler>::get_latency_histogram(
+        thread_latency which, std::size_t num, bool reset)
+    {
+        std::vector<std::int64_t> counts(latency_histogram::bucket_count, 0);
+        if (num != std::size_t(-1))
+        {
+            latency_histograms_[num].get(which).get_counts(counts, reset);
+        }
+        else
+        {
+            std::size_t const num_threads = counter_data_.size();
+            for (std::size_t i = 0; i != num_threads; ++i)
+            {
+                latency_histograms_[i].get(which).get_counts(counts, reset);
+            }
+        }
+        return counts;
+    }
+#endif
+
     template <typename Scheduler>
     std::int64_t scheduled_thread_pool<Scheduler>::get_idle_loop_count(
         std::size_t num, bool /* reset */)
@@ -1847,6 +1874,9 @@ namespace hpx { namespace threads { namespace detail {
         std::size_t pool_threads)
     {
         counter_data_.resize(pool_threads);
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        latency_histograms_.reset(new thread_latency_histograms[pool_threads]);
+#endif
     }
 
     ///////////////////////////////////////////////////////////////////////////
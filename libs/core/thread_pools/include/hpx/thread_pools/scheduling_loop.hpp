@@ -26,6 +26,11 @@
 #include <hpx/threading_base/external_timer.hpp>
 #endif
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+#include <hpx/threading_base/detail/latency_histogram.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+#endif
+
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -316,6 +321,49 @@ namespace hpx { namespace threads { namespace detail {
     };
 #endif
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    // Record the time the given thread has waited for being executed when
+    // constructed and the duration of the execution phase when destructed
+    struct latency_histograms_wrapper
+    {
+        latency_histograms_wrapper(
+            thread_latency_histograms* histograms, thread_data* thrd)
+          : histograms_(histograms)
+          , thrd_(thrd)
+          , start_(0)
+        {
+            if (histograms_ != nullptr)
+            {
+                start_ = hpx::chrono::high_resolution_clock::now();
+
+                std::uint64_t const queued = thrd_->get_queued_timestamp();
+                histograms_
+                    ->get(thrd_->has_executed() ? thread_latency::resume :
+                                                  thread_latency::creation)
+                    .record(start_ > queued ? start_ - queued : 0);
+            }
+        }
+        ~latency_histograms_wrapper()
+        {
+            if (histograms_ != nullptr)
+            {
+                std::uint64_t const end =
+                    hpx::chrono::high_resolution_clock::now();
+                histograms_->get(thread_latency::phase).record(end - start_);
+
+                // a thread that has yielded is pending from now on, suspended
+                // threads are time-stamped again once they are resumed
+                thrd_->set_queued_timestamp(end);
+                thrd_->set_executed();
+            }
+        }
+
+        thread_latency_histograms* histograms_;
+        thread_data* thrd_;
+        std::uint64_t start_;
+    };
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     struct is_active_wrapper
     {
@@ -367,6 +415,9 @@ namespace hpx { namespace threads { namespace detail {
         std::int64_t& background_send_duration_;
         std::int64_t& background_receive_duration_;
         bool& is_active_;
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        thread_latency_histograms* latency_histograms_ = nullptr;
+#endif
     };
 #else
     struct scheduling_counters
@@ -392,6 +443,9 @@ namespace hpx { namespace threads { namespace detail {
         std::int64_t& idle_loop_count_;
         std::int64_t& busy_loop_count_;
         bool& is_active_;
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        thread_latency_histograms* latency_histograms_ = nullptr;
+#endif
     };
 
 #endif    // HPX_HAVE_BACKGROUND_THREAD_COUNTERS
@@ -625,6 +679,11 @@ namespace hpx { namespace threads { namespace detail {
         {
             thread_id_ref_type thrd = HPX_MOVE(next_thrd);
 
+            // resume threads whose timers have expired, idling OS threads
+            // help with the timers of all other OS threads
+            scheduler.SchedulingPolicy::poll_timers(
+                num_thread, idle_loop_count != 0);
+
             // Get the next HPX thread from the queue
             bool running = this_state.load(std::memory_order_relaxed) <
                 hpx::state::pre_sleep;
@@ -704,6 +763,10 @@ namespace hpx { namespace threads { namespace detail {
                                 // and add to aggregate execution time.
                                 exec_time_wrapper exec_time_collector(
                                     idle_rate);
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+                                latency_histograms_wrapper latency_collector(
+                                    counters.latency_histograms_, thrdptr);
+#endif
 
 #if defined(HPX_HAVE_APEX)
                                 // get the APEX data pointer, in case we are resuming the
@@ -57,6 +57,23 @@ template class HPX_CORE_EXPORT hpx::threads::detail::scheduled_thread_pool<
         hpx::threads::policies::lockfree_abp_lifo>>;
 #endif
 
+template class HPX_CORE_EXPORT
+    hpx::threads::policies::local_queue_scheduler<std::mutex,
+        hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev>;
+template class HPX_CORE_EXPORT hpx::threads::detail::scheduled_thread_pool<
+    hpx::threads::policies::local_queue_scheduler<std::mutex,
+        hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev>>;
+template class HPX_CORE_EXPORT
+    hpx::threads::policies::local_priority_queue_scheduler<std::mutex,
+        hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev>;
+template class HPX_CORE_EXPORT hpx::threads::detail::scheduled_thread_pool<
+    hpx::threads::policies::local_priority_queue_scheduler<std::mutex,
+        hpx::threads::policies::lockfree_chase_lev,
+        hpx::threads::policies::lockfree_chase_lev>>;
+
 template class HPX_CORE_EXPORT
     hpx::threads::policies::shared_priority_queue_scheduler<>;
 template class HPX_CORE_EXPORT hpx::threads::detail::scheduled_thread_pool<
@@ -0,0 +1,278 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace threads {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The latencies recorded by the scheduling loop for each worker thread
+    enum class thread_latency : std::uint8_t
+    {
+        /// time between the creation of an HPX thread and the start of its
+        /// first execution phase
+        creation = 0,
+
+        /// time between an HPX thread becoming pending again (after it was
+        /// suspended or has yielded) and the start of its next execution
+        /// phase
+        resume = 1,
+
+        /// duration of an execution phase of an HPX thread
+        phase = 2
+    };
+
+    inline constexpr std::size_t thread_latency_count = 3;
+}}    // namespace hpx::threads
+
+namespace hpx { namespace threads { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A latency_histogram records durations (in nanoseconds) using log-linear
+    /// buckets (similar to HDR histograms): every power of two is subdivided
+    /// into sub_bucket_count equally sized buckets which bounds the relative
+    /// error of any reported value by 1/sub_bucket_count. Values above
+    /// max_value are accounted for in the last bucket.
+    ///
+    /// Each histogram has exactly one writer (the worker thread it belongs
+    /// to), which allows for recording values without any atomic
+    /// read-modify-write operations. Readers may concurrently inspect the
+    /// histogram. Resetting is implemented by remembering the values at the
+    /// time of the last reset, as for the other scheduler counters.
+    class latency_histogram
+    {
+    public:
+        static constexpr std::size_t sub_bucket_bits = 4;
+        static constexpr std::size_t sub_bucket_count = std::size_t(1)
+            << sub_bucket_bits;
+
+        // durations of up to 2^40ns (~18 minutes) are tracked exactly
+        static constexpr std::size_t max_exponent = 40;
+        static constexpr std::uint64_t max_value =
+            (std::uint64_t(1) << max_exponent) - 1;
+
+        static constexpr std::size_t bucket_count =
+            (max_exponent - sub_bucket_bits + 1) * sub_bucket_count;
+
+        latency_histogram() noexcept
+        {
+            for (std::size_t i = 0; i != bucket_count; ++i)
+            {
+                buckets_[i].store(0, std::memory_order_relaxed);
+                reset_buckets_[i] = 0;
+            }
+        }
+
+        latency_histogram(latency_histogram const&) = delete;
+        latency_histogram& operator=(latency_histogram const&) = delete;
+
+        // Return the index of the bucket the given value is accounted for
+        static std::size_t bucket_index(std::uint64_t value) noexcept
+        {
+            if (value < sub_bucket_count)
+            {
+                return static_cast<std::size_t>(value);
+            }
+            if (value > max_value)
+            {
+                return bucket_count - 1;
+            }
+
+            std::size_t const exponent = most_significant_bit(value);
+            std::size_t const sub_bucket = static_cast<std::size_t>(
+                (value >> (exponent - sub_bucket_bits)) &
+                (sub_bucket_count - 1));
+
+            return (exponent - sub_bucket_bits + 1) * sub_bucket_count +
+                sub_bucket;
+        }
+
+        // Return the smallest value accounted for in the given bucket
+        static std::uint64_t bucket_lower_bound(std::size_t index) noexcept
+        {
+            HPX_ASSERT(index < bucket_count);
+            if (index < sub_bucket_count)
+            {
+                return index;
+            }
+
+            std::size_t const exponent =
+                index / sub_bucket_count + sub_bucket_bits - 1;
+            std::size_t const sub_bucket = index % sub_bucket_count;
+
+            return std::uint64_t(sub_bucket_count + sub_bucket)
+                << (exponent - sub_bucket_bits);
+        }
+
+        // Return the largest value accounted for in the given bucket
+        static std::uint64_t bucket_upper_bound(std::size_t index) noexcept
+        {
+            HPX_ASSERT(index < bucket_count);
+            if (index < sub_bucket_count)
+            {
+                return index;
+            }
+            if (index == bucket_count - 1)
+            {
+                return max_value;
+            }
+            return bucket_lower_bound(index + 1) - 1;
+        }
+
+        // Record the given value, must be called by the owning thread only
+        void record(std::uint64_t value) noexcept
+        {
+            std::atomic<std::uint64_t>& bucket = buckets_[bucket_index(value)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+        }
+
+        // Add the number of values recorded since the last reset to the
+        // given counts (which must hold bucket_count elements)
+        void get_counts(std::vector<std::int64_t>& counts, bool reset) noexcept
+        {
+            HPX_ASSERT(counts.size() == bucket_count);
+            for (std::size_t i = 0; i != bucket_count; ++i)
+            {
+                std::uint64_t const value =
+                    buckets_[i].load(std::memory_order_relaxed);
+                counts[i] +=
+                    static_cast<std::int64_t>(value - reset_buckets_[i]);
+                if (reset)
+                {
+                    reset_buckets_[i] = value;
+                }
+            }
+        }
+
+        // Return the upper bound of the bucket holding the given percentile
+        // (0 < percentile <= 100) of the values represented by the counts,
+        // returns zero if no values were recorded.
+        static std::int64_t get_percentile(
+            std::vector<std::int64_t> const& counts, double percentile) noexcept
+        {
+            HPX_ASSERT(counts.size() <= bucket_count);
+            HPX_ASSERT(percentile > 0.0 && percentile <= 100.0);
+
+            std::int64_t total = 0;
+            for (std::int64_t count : counts)
+            {
+                total += count;
+            }
+            if (total == 0)
+            {
+                return 0;
+            }
+
+            // the rank of the requested value, rounded up
+            double const rank = static_cast<double>(total) * percentile / 100.0;
+            std::int64_t threshold = static_cast<std::int64_t>(rank);
+            if (static_cast<double>(threshold) < rank || threshold == 0)
+            {
+                ++threshold;
+            }
+
+            std::int64_t seen = 0;
+            for (std::size_t i = 0; i != counts.size(); ++i)
+            {
+                seen += counts[i];
+                if (seen >= threshold)
+                {
+                    return static_cast<std::int64_t>(bucket_upper_bound(i));
+                }
+            }
+            return static_cast<std::int64_t>(max_value);
+        }
+
+        // Return the values represented by the counts as a histogram with
+        // num_buckets buckets of equal size starting at lower, using the
+        // layout of the histogram performance counters: the lower and upper
+        // bound and the bucket size followed by the counts of all buckets.
+        // The counts of each log-linear bucket are accounted for in the
+        // bucket holding its center, values outside of [lower, upper) are
+        // accounted for in the first or the last bucket.
+        static std::vector<std::int64_t> get_linear_histogram(
+            std::vector<std::int64_t> const& counts, std::int64_t lower,
+            std::int64_t upper, std::int64_t num_buckets)
+        {
+            HPX_ASSERT(counts.size() <= bucket_count);
+            HPX_ASSERT(lower >= 0 && lower < upper && num_buckets > 0);
+
+            std::int64_t const bucket_size =
+                (upper - lower + num_buckets - 1) / num_buckets;
+
+            std::vector<std::int64_t> result(
+                static_cast<std::size_t>(num_buckets) + 3, 0);
+            result[0] = lower;
+            result[1] = lower + bucket_size * num_buckets;
+            result[2] = bucket_size;
+
+            for (std::size_t i = 0; i != counts.size(); ++i)
+            {
+                if (counts[i] == 0)
+                {
+                    continue;
+                }
+
+                std::uint64_t const center = bucket_lower_bound(i) +
+                    (bucket_upper_bound(i) - bucket_lower_bound(i)) / 2;
+
+                std::int64_t index = 0;
+                if (center >= static_cast<std::uint64_t>(lower))
+                {
+                    index = (std::min)(num_buckets - 1,
+                        static_cast<std::int64_t>(
+                            (center - static_cast<std::uint64_t>(lower)) /
+                            static_cast<std::uint64_t>(bucket_size)));
+                }
+                result[static_cast<std::size_t>(index) + 3] += counts[i];
+            }
+            return result;
+        }
+
+    private:
+        static std::size_t most_significant_bit(std::uint64_t value) noexcept
+        {
+            HPX_ASSERT(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+            std::size_t result = 0;
+            while (value >>= 1)
+            {
+                ++result;
+            }
+            return result;
+#endif
+        }
+
+        std::atomic<std::uint64_t> buckets_[bucket_count];
+
+        // values of the buckets at the time of the last reset
+        std::uint64_t reset_buckets_[bucket_count];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The latency histograms maintained for each worker thread
+    struct thread_latency_histograms
+    {
+        latency_histogram& get(thread_latency which) noexcept
+        {
+            return histograms_[static_cast<std::size_t>(which)];
+        }
+
+        latency_histogram histograms_[thread_latency_count];
+    };
+}}}    // namespace hpx::threads::detail
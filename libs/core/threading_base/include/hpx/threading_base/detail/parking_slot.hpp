@@ -0,0 +1,70 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if !defined(__linux) && !defined(linux) && !defined(__linux__)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace hpx { namespace threads { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A parking slot allows exactly one (worker) thread to block until it is
+    /// either woken up by another thread or a timeout expires. On Linux the
+    /// slot is backed by a private futex, elsewhere by a mutex/condition
+    /// variable pair. A wakeup that arrives while the owning thread is not
+    /// parked is remembered and makes the next call to park_for return
+    /// immediately, so no wakeup can get lost.
+    class HPX_CORE_EXPORT parking_slot
+    {
+    public:
+        parking_slot() noexcept
+          : state_(running)
+        {
+        }
+
+        parking_slot(parking_slot const&) = delete;
+        parking_slot& operator=(parking_slot const&) = delete;
+
+        /// Block the calling thread until unpark() is called or the given
+        /// time has elapsed. Returns true if the thread was woken up by
+        /// unpark(), false on timeout. Must only be called by the thread
+        /// owning the slot.
+        bool park_for(std::chrono::nanoseconds timeout);
+
+        /// Wake up the thread parked in this slot (if any). Returns true if
+        /// the thread was actually blocked and had to be woken up.
+        bool unpark();
+
+        bool is_parked() const noexcept
+        {
+            return state_.load(std::memory_order_relaxed) == parked;
+        }
+
+    private:
+        enum : std::uint32_t
+        {
+            running = 0,
+            parked = 1,
+            notified = 2
+        };
+
+        std::atomic<std::uint32_t> state_;
+
+#if !defined(__linux) && !defined(linux) && !defined(__linux__)
+        std::mutex mtx_;
+        std::condition_variable cond_;
+#endif
+    };
+}}}    // namespace hpx::threads::detail
@@ -0,0 +1,134 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/thread_support/spinlock.hpp>
+#include <hpx/threading_base/threading_base_fwd.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace detail {
+
+    class timer_wheel;
+
+    struct timer_wheel_node
+    {
+        timer_wheel_node* prev_ = nullptr;
+        timer_wheel_node* next_ = nullptr;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A timer_entry describes a single timer registered with a timer_wheel.
+    /// Once the timer expires the referenced (suspended) thread is set to
+    /// pending with thread_restart_state::timeout. Entries are intrusive and
+    /// are usually allocated on the stack of the thread waiting for them,
+    /// arming a timer does not allocate any memory.
+    class timer_entry : private timer_wheel_node
+    {
+    public:
+        explicit timer_entry(thread_id_type const& thrd) noexcept
+          : thrd_(thrd)
+        {
+        }
+
+        timer_entry(timer_entry const&) = delete;
+        timer_entry& operator=(timer_entry const&) = delete;
+
+        thread_id_type const& get_thread_id() const noexcept
+        {
+            return thrd_;
+        }
+
+    private:
+        friend class timer_wheel;
+
+        enum : std::uint8_t
+        {
+            idle = 0,
+            armed = 1,
+            firing = 2,
+            fired = 3
+        };
+
+        thread_id_type thrd_;
+        std::uint64_t expiry_ = 0;
+        timer_wheel* wheel_ = nullptr;
+        std::uint8_t level_ = 0;
+        std::atomic<std::uint8_t> state_{idle};
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A hierarchical timing wheel (Varghese and Lauck, 1987) with four levels
+    /// of 256 slots each. Arming and cancelling a timer are O(1) operations,
+    /// expired timers are found by polling the wheel, usually from the
+    /// scheduling loop of the owning scheduler. Timers never expire early,
+    /// they may expire up to one tick (plus the polling delay) late.
+    class HPX_CORE_EXPORT timer_wheel
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+        static constexpr std::chrono::nanoseconds tick_duration =
+            std::chrono::microseconds(50);
+
+        static constexpr std::size_t slot_bits = 8;
+        static constexpr std::size_t num_slots = std::size_t(1) << slot_bits;
+        static constexpr std::size_t num_levels = 4;
+
+        timer_wheel();
+
+        timer_wheel(timer_wheel const&) = delete;
+        timer_wheel& operator=(timer_wheel const&) = delete;
+
+        /// Arm the given timer to expire at the given point in time. Returns
+        /// false (without arming the timer) if that point in time has passed
+        /// already.
+        bool add(timer_entry& e, clock_type::time_point const& abs_time);
+
+        /// Disarm the given timer. Returns true if the timer was cancelled
+        /// before it expired. If the timer has expired concurrently this
+        /// waits for the wheel to be done resuming the referenced thread.
+        static bool cancel(timer_entry& e);
+
+        /// Resume the threads of all expired timers, returns the number of
+        /// expired timers. Returns immediately if no timer can have expired
+        /// yet or if some other thread is currently polling this wheel.
+        std::size_t poll();
+
+        /// Return a lower bound for the point in time the next timer expires
+        /// at (clock_type::time_point::max() if no timers are armed).
+        clock_type::time_point next_expiry() const noexcept;
+
+        bool empty() const noexcept
+        {
+            return count_.load(std::memory_order_relaxed) == 0;
+        }
+
+    private:
+        using mutex_type = hpx::util::detail::spinlock;
+
+        std::uint64_t to_tick(clock_type::time_point const& t,
+            bool round_up) const noexcept;
+
+        void insert(timer_entry& e) noexcept;
+        void remove(timer_entry& e) noexcept;
+        timer_entry* advance(std::uint64_t target) noexcept;
+        std::uint64_t calculate_next_tick() const noexcept;
+
+        mutable mutex_type mtx_;
+        clock_type::time_point const epoch_;
+        std::uint64_t now_;
+        std::atomic<std::size_t> count_;
+        std::atomic<std::uint64_t> next_tick_;
+        std::size_t level_count_[num_levels];
+        timer_wheel_node slots_[num_levels][num_slots];
+    };
+}}}    // namespace hpx::threads::detail
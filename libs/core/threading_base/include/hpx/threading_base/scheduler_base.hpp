@@ -12,6 +12,10 @@
 #include <hpx/functional/function.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/format.hpp>
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+#include <hpx/threading_base/detail/parking_slot.hpp>
+#endif
+#include <hpx/threading_base/detail/timer_wheel.hpp>
 #include <hpx/threading_base/scheduler_mode.hpp>
 #include <hpx/threading_base/scheduler_state.hpp>
 #include <hpx/threading_base/thread_data.hpp>
@@ -24,6 +28,7 @@
 #endif
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
@@ -96,10 +101,30 @@ namespace hpx { namespace threads { namespace policies {
         void idle_callback(std::size_t num_thread);
 
         /// This function gets called by the thread-manager whenever new work
-        /// has been added, allowing the scheduler to reactivate one or more of
-        /// possibly idling OS threads
+        /// has been added, allowing the scheduler to reactivate one of the
+        /// possibly idling OS threads (preferably the given one)
         void do_some_work(std::size_t);
 
+        /// Reactivate all possibly idling OS threads
+        void wake_all_idle_workers();
+
+        /// Arm the given timer, the referenced thread will be set to pending
+        /// once the given point in time has been reached. Returns false
+        /// (without arming the timer) if that point in time has passed
+        /// already. Armed timers have to be disarmed using
+        /// threads::detail::timer_wheel::cancel.
+        bool add_timer(threads::detail::timer_entry& e,
+            std::chrono::steady_clock::time_point const& abs_time);
+
+        /// This function gets called by the scheduling loop to resume the
+        /// threads of all expired timers. Idling OS threads additionally
+        /// help polling the timers of all other OS threads.
+        void poll_timers(std::size_t num_thread, bool idle);
+
+        /// Return a lower bound for the point in time the next timer of this
+        /// scheduler expires at
+        std::chrono::steady_clock::time_point next_timer_expiry() const;
+
         virtual void suspend(std::size_t num_thread);
         virtual void resume(std::size_t num_thread);
 
@@ -190,6 +215,14 @@ namespace hpx { namespace threads { namespace policies {
             std::size_t num_thread, bool reset) = 0;
 #endif
 
+        // Return the number of threads which started running only after
+        // their deadline had passed
+        virtual std::int64_t get_num_missed_deadlines(
+            std::size_t /* num_thread */, bool /* reset */)
+        {
+            return 0;
+        }
+
         virtual std::int64_t get_queue_length(
             std::size_t num_thread = std::size_t(-1)) const = 0;
 
@@ -374,17 +407,33 @@ namespace hpx { namespace threads { namespace policies {
         util::cache_line_data<std::atomic<scheduler_mode>> mode_;
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        // support for suspension on idle queues
-        pu_mutex_type mtx_;
-        std::condition_variable cond_;
+        // support for suspension on idle queues: each OS thread parks in its
+        // own slot, the bitmap of idle OS threads is used to wake up exactly
+        // one of them whenever new work arrives
         struct idle_backoff_data
         {
-            std::uint32_t wait_count_;
-            double max_idle_backoff_time_;
+            std::uint32_t wait_count_ = 0;
+            double max_idle_backoff_time_ = 0.0;
+            std::size_t numa_domain_ = std::size_t(-1);
+            threads::detail::parking_slot slot_;
         };
         std::vector<util::cache_line_data<idle_backoff_data>> wait_counts_;
+        std::vector<std::atomic<std::uint64_t>> idle_workers_;
+
+        bool wake_idle_worker(std::size_t num_thread);
+        bool wake_any_idle_worker(std::size_t numa_domain);
 #endif
 
+        // return the number of the OS thread of this scheduler the caller is
+        // running on (or std::size_t(-1) for any other thread)
+        std::size_t get_local_thread_num() const;
+
+        // support for timed suspension of threads, each OS thread polls its
+        // own timer wheel
+        std::vector<util::cache_line_data<threads::detail::timer_wheel>>
+            timer_wheels_;
+        std::atomic<std::size_t> next_timer_wheel_;
+
         // support for suspension of pus
         std::vector<pu_mutex_type> suspend_mtxs_;
         std::vector<std::condition_variable> suspend_conds_;
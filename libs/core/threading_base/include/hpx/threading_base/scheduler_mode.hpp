@@ -61,6 +61,11 @@ namespace hpx { namespace threads { namespace policies {
         /// This option allows for certain schedulers to explicitly disable
         /// exponential idle-back off
         enable_idle_backoff = 0x0800,
+        /// This option tells schedulers that support it to steal from the
+        /// queues of cores sharing a cache first, then from the remaining
+        /// cores of the same NUMA domain, and to steal up to half of the
+        /// work of a victim at once
+        steal_hierarchical = 0x1000,
 
         // clang-format off
         /// This option represents the default mode.
@@ -72,7 +77,8 @@ namespace hpx { namespace threads { namespace policies {
             enable_stealing_numa |
             assign_work_round_robin |
             steal_after_local |
-            enable_idle_backoff,
+            enable_idle_backoff |
+            steal_hierarchical,
         /// This enables all available options.
         all_flags =
             do_background_work |
@@ -86,7 +92,8 @@ namespace hpx { namespace threads { namespace policies {
             assign_work_thread_parent |
             steal_high_priority_first |
             steal_after_local |
-            enable_idle_backoff
+            enable_idle_backoff |
+            steal_hierarchical
         // clang-format on
     };
 
@@ -10,11 +10,13 @@
 #include <hpx/coroutines/coroutine.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/timing.hpp>
+#include <hpx/threading_base/detail/timer_wheel.hpp>
 #include <hpx/threading_base/scheduler_base.hpp>
 #include <hpx/threading_base/set_thread_state.hpp>
 #include <hpx/threading_base/threading_base_fwd.hpp>
 
 #include <atomic>
+#include <chrono>
 
 namespace hpx { namespace threads { namespace detail {
 
@@ -66,4 +68,45 @@ namespace hpx { namespace threads { namespace detail {
             thread_priority::normal, thread_schedule_hint(), started,
             retry_on_active, ec);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Arms a timer in the timer wheel of the given scheduler which sets the
+    /// given (suspended) thread to pending once the given point in time has
+    /// been reached. The timer is disarmed on destruction, this makes sure
+    /// that no stale timeout can hit the thread after it has been resumed
+    /// for some other reason.
+    class scoped_timer
+    {
+    public:
+        scoped_timer(policies::scheduler_base* scheduler,
+            thread_id_type const& thrd,
+            std::chrono::steady_clock::time_point const& abs_time)
+          : entry_(thrd)
+          , armed_(scheduler->add_timer(entry_, abs_time))
+        {
+        }
+
+        ~scoped_timer()
+        {
+            if (armed_)
+            {
+                timer_wheel::cancel(entry_);
+            }
+        }
+
+        scoped_timer(scoped_timer const&) = delete;
+        scoped_timer& operator=(scoped_timer const&) = delete;
+
+        /// Return whether the timer was armed, i.e. whether the thread will
+        /// be resumed by the timer (if not, the given point in time has
+        /// passed already)
+        bool armed() const noexcept
+        {
+            return armed_;
+        }
+
+    private:
+        timer_entry entry_;
+        bool armed_;
+    };
 }}}    // namespace hpx::threads::detail
@@ -464,6 +464,53 @@ namespace hpx { namespace threads {
             priority_ = priority;
         }
 
+        // the absolute deadline of this thread (if any)
+        thread_schedule_hint::deadline_type get_deadline() const noexcept
+        {
+            return deadline_;
+        }
+        void set_deadline(
+            thread_schedule_hint::deadline_type deadline) noexcept
+        {
+            deadline_ = deadline;
+        }
+        bool has_deadline() const noexcept
+        {
+            return deadline_ != thread_schedule_hint::no_deadline();
+        }
+
+        // mark this thread as having missed its deadline, returns false if
+        // it was marked before (a thread may be scheduled several times)
+        bool set_missed_deadline() noexcept
+        {
+            bool const missed = missed_deadline_;
+            missed_deadline_ = true;
+            return !missed;
+        }
+
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        // the point in time this thread has (last) become pending, in
+        // nanoseconds as returned by hpx::chrono::high_resolution_clock
+        std::uint64_t get_queued_timestamp() const noexcept
+        {
+            return queued_timestamp_;
+        }
+        void set_queued_timestamp(std::uint64_t timestamp) noexcept
+        {
+            queued_timestamp_ = timestamp;
+        }
+
+        // whether this thread has executed at least one phase already
+        bool has_executed() const noexcept
+        {
+            return executed_;
+        }
+        void set_executed() noexcept
+        {
+            executed_ = true;
+        }
+#endif
+
         // handle thread interruption
         bool interruption_requested() const noexcept
         {
@@ -640,6 +687,13 @@ namespace hpx { namespace threads {
 #endif
         ///////////////////////////////////////////////////////////////////////
         thread_priority priority_;
+        thread_schedule_hint::deadline_type deadline_;
+        bool missed_deadline_;
+
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        std::uint64_t queued_timestamp_;
+        bool executed_;
+#endif
 
         bool requested_interrupt_;
         bool enabled_interrupt_;
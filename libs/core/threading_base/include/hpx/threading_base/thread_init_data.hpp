@@ -14,6 +14,9 @@
 #if defined(HPX_HAVE_APEX)
 #include <hpx/threading_base/external_timer.hpp>
 #endif
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+#include <hpx/timing/high_resolution_clock.hpp>
+#endif
 #include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
@@ -45,6 +48,9 @@ namespace hpx { namespace threads {
           , initial_state(thread_schedule_state::pending)
           , run_now(false)
           , scheduler_base(nullptr)
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+          , creation_timestamp(hpx::chrono::high_resolution_clock::now())
+#endif
         {
             if (initial_state == thread_schedule_state::staged)
             {
@@ -63,6 +69,9 @@ namespace hpx { namespace threads {
             initial_state = rhs.initial_state;
             run_now = rhs.run_now;
             scheduler_base = rhs.scheduler_base;
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+            creation_timestamp = rhs.creation_timestamp;
+#endif
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
             description = HPX_MOVE(rhs.description);
 #endif
@@ -101,6 +110,9 @@ namespace hpx { namespace threads {
           , initial_state(rhs.initial_state)
           , run_now(rhs.run_now)
           , scheduler_base(rhs.scheduler_base)
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+          , creation_timestamp(rhs.creation_timestamp)
+#endif
         {
         }
 
@@ -134,6 +146,9 @@ namespace hpx { namespace threads {
           , initial_state(initial_state_)
           , run_now(run_now_)
           , scheduler_base(scheduler_base_)
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+          , creation_timestamp(hpx::chrono::high_resolution_clock::now())
+#endif
         {
             HPX_UNUSED(desc);
 
@@ -168,5 +183,11 @@ namespace hpx { namespace threads {
         bool run_now;
 
         policies::scheduler_base* scheduler_base;
+
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        // the creation latency of the thread is measured from here, this
+        // includes the time the thread may spend staged
+        std::uint64_t creation_timestamp;
+#endif
     };
 }}    // namespace hpx::threads
@@ -13,6 +13,7 @@
 #include <hpx/functional/function.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/threading_base/callback_notifier.hpp>
+#include <hpx/threading_base/detail/latency_histogram.hpp>
 #include <hpx/threading_base/network_background_callback.hpp>
 #include <hpx/threading_base/scheduler_mode.hpp>
 #include <hpx/threading_base/scheduler_state.hpp>
@@ -384,6 +385,22 @@ namespace hpx { namespace threads {
         }
 #endif
 
+        virtual std::int64_t get_num_missed_deadlines(
+            std::size_t /*thread_num*/, bool /*reset*/)
+        {
+            return 0;
+        }
+
+        // Return the bucket counts of the given latency histogram (see
+        // detail::latency_histogram), the result is empty if no latency
+        // histograms are maintained
+        virtual std::vector<std::int64_t> get_latency_histogram(
+            thread_latency /*which*/, std::size_t /*thread_num*/,
+            bool /*reset*/)
+        {
+            return std::vector<std::int64_t>();
+        }
+
         virtual std::int64_t get_thread_count(thread_schedule_state /*state*/,
             thread_priority /*priority*/, std::size_t /*num_thread*/,
             bool /*reset*/)
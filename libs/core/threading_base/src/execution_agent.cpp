@@ -18,6 +18,7 @@
 #include <hpx/threading_base/execution_agent.hpp>
 #include <hpx/threading_base/scheduler_base.hpp>
 #include <hpx/threading_base/set_thread_state.hpp>
+#include <hpx/threading_base/set_thread_state_timed.hpp>
 #include <hpx/threading_base/thread_description.hpp>
 
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
@@ -101,27 +102,19 @@ namespace hpx { namespace threads {
     void execution_agent::sleep_until(
         hpx::chrono::steady_time_point const& sleep_time, const char* desc)
     {
-        // Just yield until time has passed by...
-        auto now = std::chrono::steady_clock::now();
+        // Suspend this thread until the given point in time has been reached
+        // or until it is resumed explicitly (for instance by a condition
+        // variable). The timer is disarmed on scope exit in the latter case.
+        thread_id_ref_type id = self_.get_thread_id();    // keep alive
+        threads::detail::scoped_timer timer(
+            get_thread_id_data(id)->get_scheduler_base(), id.noref(),
+            sleep_time.value());
 
         // Note: we yield at least once to allow for other threads to
-        // make progress in any case. We also use yield instead of yield_k
-        // for the same reason.
-        std::size_t k = 0;
-        do
-        {
-            if (k < 32 || k & 1)
-            {
-                do_yield(
-                    desc, hpx::threads::thread_schedule_state::pending_boost);
-            }
-            else
-            {
-                do_yield(desc, hpx::threads::thread_schedule_state::pending);
-            }
-            ++k;
-            now = std::chrono::steady_clock::now();
-        } while (now < sleep_time.value());
+        // make progress in any case.
+        do_yield(desc,
+            timer.armed() ? hpx::threads::thread_schedule_state::suspended :
+                            hpx::threads::thread_schedule_state::pending_boost);
     }
 
 #if defined(HPX_HAVE_VERIFY_LOCKS)
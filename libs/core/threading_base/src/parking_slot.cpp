@@ -0,0 +1,92 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/threading_base/detail/parking_slot.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace hpx { namespace threads { namespace detail {
+
+    bool parking_slot::park_for(std::chrono::nanoseconds timeout)
+    {
+        std::uint32_t expected = running;
+        if (!state_.compare_exchange_strong(expected, parked))
+        {
+            // a wakeup arrived while we were not parked, consume it
+            state_.store(running, std::memory_order_relaxed);
+            return true;
+        }
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        while (state_.load(std::memory_order_acquire) == parked)
+        {
+            auto const now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                break;
+            }
+
+            auto const rel =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    deadline - now)
+                    .count();
+
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(rel / 1000000000);
+            ts.tv_nsec = static_cast<long>(rel % 1000000000);
+
+            // the futex returns immediately if the state has changed already
+            syscall(SYS_futex, &state_, FUTEX_WAIT_PRIVATE, parked, &ts,
+                nullptr, 0);
+        }
+#else
+        {
+            std::unique_lock<std::mutex> l(mtx_);
+            cond_.wait_for(l, timeout, [this]() {
+                return state_.load(std::memory_order_acquire) != parked;
+            });
+        }
+#endif
+
+        return state_.exchange(running, std::memory_order_acq_rel) ==
+            notified;
+    }
+
+    bool parking_slot::unpark()
+    {
+        if (state_.exchange(notified, std::memory_order_acq_rel) != parked)
+        {
+            // the owning thread is not blocked, it will see the notification
+            // the next time it tries to park
+            return false;
+        }
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        syscall(SYS_futex, &state_, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+        {
+            // synchronize with the waiting thread to avoid a lost wakeup
+            std::lock_guard<std::mutex> l(mtx_);
+        }
+        cond_.notify_one();
+#endif
+        return true;
+    }
+}}}    // namespace hpx::threads::detail
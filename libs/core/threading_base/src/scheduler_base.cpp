@@ -11,7 +11,9 @@
 #include <hpx/threading_base/scheduler_mode.hpp>
 #include <hpx/threading_base/scheduler_state.hpp>
 #include <hpx/threading_base/thread_init_data.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
 #include <hpx/threading_base/thread_pool_base.hpp>
+#include <hpx/topology/topology.hpp>
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
 #include <hpx/coroutines/detail/tss.hpp>
 #endif
@@ -38,7 +40,15 @@ namespace hpx { namespace threads { namespace policies {
     scheduler_base::scheduler_base(std::size_t num_threads,
         char const* description, thread_queue_init_parameters thread_queue_init,
         scheduler_mode mode)
-      : suspend_mtxs_(num_threads)
+      :
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+      wait_counts_(num_threads)
+      , idle_workers_((num_threads + 63) / 64)
+      ,
+#endif
+      timer_wheels_(num_threads)
+      , next_timer_wheel_(0)
+      , suspend_mtxs_(num_threads)
       , suspend_conds_(num_threads)
       , pu_mtxs_(num_threads)
       , states_(num_threads)
@@ -56,12 +66,15 @@ namespace hpx { namespace threads { namespace policies {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         double max_time = thread_queue_init.max_idle_backoff_time_;
 
-        wait_counts_.resize(num_threads);
         for (auto&& data : wait_counts_)
         {
             data.data_.wait_count_ = 0;
             data.data_.max_idle_backoff_time_ = max_time;
         }
+        for (auto&& idle_mask : idle_workers_)
+        {
+            idle_mask.store(0, std::memory_order_relaxed);
+        }
 #endif
 
         for (std::size_t i = 0; i != num_threads; ++i)
@@ -79,6 +92,18 @@ namespace hpx { namespace threads { namespace policies {
 
             idle_backoff_data& data = wait_counts_[num_thread].data_;
 
+            // Determine the NUMA domain this thread is bound to, this is used
+            // to prefer waking up threads close to the one producing work.
+            if (data.numa_domain_ == std::size_t(-1))
+            {
+                auto const& topo = create_topology();
+                error_code ec(throwmode::lightweight);
+                std::size_t pu = threads::find_first(topo.get_cpubind_mask(ec));
+                data.numa_domain_ = (ec || pu == std::size_t(-1)) ?
+                    0 :
+                    topo.get_numa_node_number(pu);
+            }
+
             // Exponential back-off with a maximum sleep time.
             double exponent = (std::min)(double(data.wait_count_),
                 double(std::numeric_limits<double>::max_exponent - 1));
@@ -86,10 +111,38 @@ namespace hpx { namespace threads { namespace policies {
             std::chrono::milliseconds period(std::lround((std::min)(
                 data.max_idle_backoff_time_, std::pow(2.0, exponent))));
 
+            // Do not sleep past the point in time the next timer expires at.
+            std::chrono::nanoseconds timeout = period;
+            auto const next_timer = next_timer_expiry();
+            if (next_timer != std::chrono::steady_clock::time_point::max())
+            {
+                auto const now = std::chrono::steady_clock::now();
+                if (next_timer <= now)
+                {
+                    return;
+                }
+                timeout = (std::min)(timeout,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        next_timer - now));
+            }
+
             ++data.wait_count_;
 
-            std::unique_lock<pu_mutex_type> l(mtx_);
-            if (cond_.wait_for(l, period) == std::cv_status::no_timeout)
+            // Announce that this thread is about to go to sleep. Any work
+            // scheduled after this point will find this thread in the bitmap
+            // of idle threads, any work scheduled before will be visible in
+            // the queue length below.
+            std::uint64_t const bit = std::uint64_t(1) << (num_thread % 64);
+            std::atomic<std::uint64_t>& idle_mask =
+                idle_workers_[num_thread / 64];
+            idle_mask.fetch_or(bit);
+
+            bool const woken_up = get_queue_length(num_thread) != 0 ||
+                data.slot_.park_for(timeout);
+
+            idle_mask.fetch_and(~bit);
+
+            if (woken_up)
             {
                 // reset counter if thread was woken up
                 data.wait_count_ = 0;
@@ -100,20 +153,159 @@ namespace hpx { namespace threads { namespace policies {
 #endif
     }
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    bool scheduler_base::wake_idle_worker(std::size_t num_thread)
+    {
+        std::uint64_t const bit = std::uint64_t(1) << (num_thread % 64);
+        std::atomic<std::uint64_t>& idle_mask = idle_workers_[num_thread / 64];
+
+        // claim the idle thread, this makes sure that concurrent notifiers do
+        // not wake up the same thread
+        if ((idle_mask.load(std::memory_order_relaxed) & bit) == 0 ||
+            (idle_mask.fetch_and(~bit) & bit) == 0)
+        {
+            return false;
+        }
+
+        wait_counts_[num_thread].data_.slot_.unpark();
+        return true;
+    }
+
+    bool scheduler_base::wake_any_idle_worker(std::size_t numa_domain)
+    {
+        // first try threads in the given NUMA domain, then all others
+        for (int pass = (numa_domain == std::size_t(-1)) ? 1 : 0; pass != 2;
+             ++pass)
+        {
+            for (std::size_t word = 0; word != idle_workers_.size(); ++word)
+            {
+                std::uint64_t idle =
+                    idle_workers_[word].load(std::memory_order_relaxed);
+                for (std::size_t bit = 0; idle != 0; ++bit, idle >>= 1)
+                {
+                    if ((idle & 1) == 0)
+                        continue;
+
+                    std::size_t const num_thread = word * 64 + bit;
+                    if (pass == 0 &&
+                        wait_counts_[num_thread].data_.numa_domain_ !=
+                            numa_domain)
+                    {
+                        continue;
+                    }
+
+                    if (wake_idle_worker(num_thread))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+#endif
+
     /// This function gets called by the thread-manager whenever new work
-    /// has been added, allowing the scheduler to reactivate one or more of
+    /// has been added, allowing the scheduler to reactivate one of the
     /// possibly idling OS threads
-    void scheduler_base::do_some_work(std::size_t)
+    void scheduler_base::do_some_work(std::size_t num_thread)
     {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         if (mode_.data_.load(std::memory_order_relaxed) &
             policies::scheduler_mode::enable_idle_backoff)
         {
-            cond_.notify_all();
+            // pairs with the announcement in idle_callback
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // wake up the thread the work was scheduled on, if it sleeps
+            if (num_thread < wait_counts_.size() &&
+                wake_idle_worker(num_thread))
+            {
+                return;
+            }
+
+            // otherwise wake up exactly one sleeping thread, preferably from
+            // the NUMA domain of the thread that has produced the work
+            std::size_t numa_domain = std::size_t(-1);
+            std::size_t const local_thread = get_local_thread_num();
+            if (local_thread < wait_counts_.size())
+            {
+                numa_domain = wait_counts_[local_thread].data_.numa_domain_;
+            }
+
+            wake_any_idle_worker(numa_domain);
         }
+#else
+        (void) num_thread;
 #endif
     }
 
+    void scheduler_base::wake_all_idle_workers()
+    {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        for (std::size_t i = 0; i != wait_counts_.size(); ++i)
+        {
+            wake_idle_worker(i);
+        }
+#endif
+    }
+
+    std::size_t scheduler_base::get_local_thread_num() const
+    {
+        if (parent_pool_ != nullptr &&
+            threads::detail::get_thread_pool_num_tss() ==
+                parent_pool_->get_pool_id().index())
+        {
+            return threads::detail::get_local_thread_num_tss();
+        }
+        return std::size_t(-1);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool scheduler_base::add_timer(threads::detail::timer_entry& e,
+        std::chrono::steady_clock::time_point const& abs_time)
+    {
+        HPX_ASSERT(!timer_wheels_.empty());
+
+        // timers are usually armed by the thread which is about to be
+        // suspended, keep them on the wheel of the current OS thread
+        std::size_t num_thread = get_local_thread_num();
+        if (num_thread >= timer_wheels_.size())
+        {
+            num_thread = next_timer_wheel_++ % timer_wheels_.size();
+        }
+        return timer_wheels_[num_thread].data_.add(e, abs_time);
+    }
+
+    void scheduler_base::poll_timers(std::size_t num_thread, bool idle)
+    {
+        if (num_thread < timer_wheels_.size())
+        {
+            timer_wheels_[num_thread].data_.poll();
+        }
+
+        if (idle)
+        {
+            // help with the timers of OS threads which are busy or suspended
+            for (std::size_t i = 0; i != timer_wheels_.size(); ++i)
+            {
+                if (i != num_thread)
+                {
+                    timer_wheels_[i].data_.poll();
+                }
+            }
+        }
+    }
+
+    std::chrono::steady_clock::time_point scheduler_base::next_timer_expiry()
+        const
+    {
+        auto next = std::chrono::steady_clock::time_point::max();
+        for (auto const& wheel : timer_wheels_)
+        {
+            next = (std::min)(next, wheel.data_.next_expiry());
+        }
+        return next;
+    }
+
     void scheduler_base::suspend(std::size_t num_thread)
     {
         HPX_ASSERT(num_thread < suspend_conds_.size());
@@ -321,7 +513,7 @@ namespace hpx { namespace threads { namespace policies {
     {
         // distribute the same value across all cores
         mode_.data_.store(mode, std::memory_order_release);
-        do_some_work(std::size_t(-1));
+        wake_all_idle_workers();
     }
 
     void scheduler_base::add_scheduler_mode(scheduler_mode mode)
@@ -16,6 +16,9 @@
 #include <hpx/threading_base/set_thread_state.hpp>
 #include <hpx/threading_base/thread_data.hpp>
 #include <hpx/threading_base/threading_base_fwd.hpp>
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+#include <hpx/timing/high_resolution_clock.hpp>
+#endif
 
 #include <cstddef>
 #include <functional>
@@ -262,6 +265,11 @@ namespace hpx { namespace threads { namespace detail {
             // round robin queuing.
 
             auto* thrd_data = get_thread_id_data(thrd);
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+            // the resume latency is measured from here
+            thrd_data->set_queued_timestamp(
+                hpx::chrono::high_resolution_clock::now());
+#endif
             auto* scheduler = thrd_data->get_scheduler_base();
             scheduler->schedule_thread(
                 thrd, schedulehint, false, thrd_data->get_priority());
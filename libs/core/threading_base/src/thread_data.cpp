@@ -66,6 +66,12 @@ namespace hpx { namespace threads {
       , backtrace_(nullptr)
 #endif
       , priority_(init_data.priority)
+      , deadline_(init_data.schedulehint.deadline)
+      , missed_deadline_(false)
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+      , queued_timestamp_(init_data.creation_timestamp)
+      , executed_(false)
+#endif
       , requested_interrupt_(false)
       , enabled_interrupt_(true)
       , ran_exit_funcs_(false)
@@ -215,6 +221,12 @@ namespace hpx { namespace threads {
         backtrace_ = nullptr;
 #endif
         priority_ = init_data.priority;
+        deadline_ = init_data.schedulehint.deadline;
+        missed_deadline_ = false;
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        queued_timestamp_ = init_data.creation_timestamp;
+        executed_ = false;
+#endif
         requested_interrupt_ = false;
         enabled_interrupt_ = true;
         ran_exit_funcs_ = false;
@@ -425,6 +425,27 @@ namespace hpx { namespace threads {
 
 namespace hpx { namespace this_thread {
 
+    namespace {
+
+        // Stackless threads (for instance created using
+        // hpx::launch::inline_if_nonblocking) run on the stack of the
+        // scheduling loop and can't be suspended.
+        bool verify_suspendable(threads::thread_id_type const& id,
+            char const* function_name, error_code& ec)
+        {
+            if (get_thread_id_data(id)->is_stackless())
+            {
+                HPX_THROWS_IF(ec, invalid_status, function_name,
+                    "thread({}, {}) is stackless and can't be suspended, "
+                    "create it with a stack size other than "
+                    "thread_stacksize::nostack if it needs to wait",
+                    id, threads::get_thread_description(id));
+                return false;
+            }
+            return true;
+        }
+    }    // namespace
+
     /// The function \a suspend will return control to the thread manager
     /// (suspends the current thread). It sets the new state of this thread
     /// to the thread state passed as the parameter.
@@ -446,6 +467,9 @@ namespace hpx { namespace this_thread {
         if (ec)
             return threads::thread_restart_state::unknown;
 
+        if (!verify_suspendable(id.noref(), "suspend", ec))
+            return threads::thread_restart_state::unknown;
+
         threads::thread_restart_state statex =
             threads::thread_restart_state::unknown;
 
@@ -507,7 +531,7 @@ namespace hpx { namespace this_thread {
         threads::thread_id_type nextid,
         util::thread_description const& description, error_code& ec)
     {
-        // schedule a thread waking us up at_time
+        // arm a timer waking us up at_time
         threads::thread_self& self = threads::get_self();
 
         // keep alive
@@ -518,6 +542,9 @@ namespace hpx { namespace this_thread {
         if (ec)
             return threads::thread_restart_state::unknown;
 
+        if (!verify_suspendable(id.noref(), "suspend_at", ec))
+            return threads::thread_restart_state::unknown;
+
         // let the thread manager do other things while waiting
         threads::thread_restart_state statex =
             threads::thread_restart_state::unknown;
@@ -536,14 +563,16 @@ namespace hpx { namespace this_thread {
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             threads::detail::reset_backtrace bt(id, ec);
 #endif
-            std::atomic<bool> timer_started(false);
-            threads::thread_id_ref_type timer_id =
-                threads::set_thread_state(id.noref(), abs_time, &timer_started,
-                    threads::thread_schedule_state::pending,
-                    threads::thread_restart_state::timeout,
-                    threads::thread_priority::boost, true, ec);
-            if (ec)
-                return threads::thread_restart_state::unknown;
+            // arm a timer waking us up at the given point in time, the timer
+            // is disarmed on scope exit if we were woken up for another reason
+            threads::detail::scoped_timer timer(
+                get_thread_id_data(id)->get_scheduler_base(), id.noref(),
+                abs_time.value());
+
+            // if the given point in time has passed already, just yield
+            threads::thread_schedule_state const state = timer.armed() ?
+                threads::thread_schedule_state::suspended :
+                threads::thread_schedule_state::pending;
 
             // We might need to dispatch 'nextid' to it's correct scheduler
             // only if our current scheduler is the same, we should yield the id
@@ -556,29 +585,22 @@ namespace hpx { namespace this_thread {
                 scheduler->schedule_thread(
                     HPX_MOVE(nextid), threads::thread_schedule_hint());
                 statex = self.yield(threads::thread_result_type(
-                    threads::thread_schedule_state::suspended,
-                    threads::invalid_thread_id));
+                    state, threads::invalid_thread_id));
             }
             else
             {
-                statex = self.yield(threads::thread_result_type(
-                    threads::thread_schedule_state::suspended,
-                    HPX_MOVE(nextid)));
+                statex = self.yield(
+                    threads::thread_result_type(state, HPX_MOVE(nextid)));
             }
 
-            if (statex != threads::thread_restart_state::timeout)
+            if (!timer.armed())
             {
-                HPX_ASSERT(statex == threads::thread_restart_state::abort ||
-                    statex == threads::thread_restart_state::signaled);
-                error_code ec1(throwmode::lightweight);    // do not throw
-                hpx::util::yield_while(
-                    [&timer_started]() { return !timer_started.load(); },
-                    "set_thread_state_timed");
-                threads::set_thread_state(timer_id.noref(),
-                    threads::thread_schedule_state::pending,
-                    threads::thread_restart_state::abort,
-                    threads::thread_priority::boost, true, ec1);
+                statex = threads::thread_restart_state::timeout;
             }
+
+            HPX_ASSERT(statex == threads::thread_restart_state::timeout ||
+                statex == threads::thread_restart_state::abort ||
+                statex == threads::thread_restart_state::signaled);
         }
 
         // handle interruption, if needed
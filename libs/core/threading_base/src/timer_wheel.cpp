@@ -0,0 +1,382 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/threading_base/detail/timer_wheel.hpp>
+#include <hpx/threading_base/set_thread_state.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+namespace hpx { namespace threads { namespace detail {
+
+    namespace {
+
+        constexpr std::uint64_t max_tick =
+            (std::numeric_limits<std::uint64_t>::max)();
+
+        // number of ticks covered by all levels of the wheel
+        constexpr std::uint64_t max_delta = std::uint64_t(1)
+            << (timer_wheel::slot_bits * timer_wheel::num_levels);
+
+        // advancing the wheel tick by tick is cheap, but after long periods
+        // without polling it is faster to re-insert all armed timers
+        constexpr std::uint64_t max_advance_steps = 4096;
+
+        constexpr std::uint64_t slot_mask = timer_wheel::num_slots - 1;
+
+        void link(timer_wheel_node& head, timer_wheel_node& node) noexcept
+        {
+            node.next_ = &head;
+            node.prev_ = head.prev_;
+            head.prev_->next_ = &node;
+            head.prev_ = &node;
+        }
+
+        void unlink(timer_wheel_node& node) noexcept
+        {
+            node.prev_->next_ = node.next_;
+            node.next_->prev_ = node.prev_;
+            node.prev_ = node.next_ = nullptr;
+        }
+
+        bool is_empty(timer_wheel_node const& head) noexcept
+        {
+            return head.next_ == &head;
+        }
+    }    // namespace
+
+    timer_wheel::timer_wheel()
+      : epoch_(clock_type::now())
+      , now_(0)
+      , count_(0)
+      , next_tick_(max_tick)
+    {
+        for (std::size_t level = 0; level != num_levels; ++level)
+        {
+            level_count_[level] = 0;
+            for (timer_wheel_node& head : slots_[level])
+            {
+                head.prev_ = head.next_ = &head;
+            }
+        }
+    }
+
+    std::uint64_t timer_wheel::to_tick(
+        clock_type::time_point const& t, bool round_up) const noexcept
+    {
+        if (t <= epoch_)
+        {
+            return 0;
+        }
+
+        std::uint64_t const ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch_)
+                .count());
+        std::uint64_t const tick =
+            static_cast<std::uint64_t>(tick_duration.count());
+
+        return ns / tick + ((round_up && ns % tick != 0) ? 1 : 0);
+    }
+
+    bool timer_wheel::add(
+        timer_entry& e, clock_type::time_point const& abs_time)
+    {
+        HPX_ASSERT(e.state_.load(std::memory_order_relaxed) !=
+                timer_entry::armed &&
+            e.state_.load(std::memory_order_relaxed) != timer_entry::firing);
+
+        // round up to make sure the timer never expires early
+        std::uint64_t const expiry = to_tick(abs_time, true);
+        if (expiry <= to_tick(clock_type::now(), false))
+        {
+            return false;
+        }
+
+        std::lock_guard<mutex_type> l(mtx_);
+        if (expiry <= now_)
+        {
+            return false;
+        }
+
+        e.expiry_ = expiry;
+        e.wheel_ = this;
+        e.state_.store(timer_entry::armed, std::memory_order_relaxed);
+        insert(e);
+
+        count_.store(count_.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        if (expiry < next_tick_.load(std::memory_order_relaxed))
+        {
+            next_tick_.store(expiry, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool timer_wheel::cancel(timer_entry& e)
+    {
+        timer_wheel* wheel = e.wheel_;
+        if (wheel == nullptr ||
+            e.state_.load(std::memory_order_acquire) == timer_entry::fired)
+        {
+            e.wheel_ = nullptr;
+            return false;
+        }
+
+        {
+            std::lock_guard<mutex_type> l(wheel->mtx_);
+            if (e.state_.load(std::memory_order_relaxed) == timer_entry::armed)
+            {
+                wheel->remove(e);
+                wheel->count_.store(
+                    wheel->count_.load(std::memory_order_relaxed) - 1,
+                    std::memory_order_relaxed);
+
+                e.state_.store(timer_entry::idle, std::memory_order_relaxed);
+                e.wheel_ = nullptr;
+                return true;
+            }
+        }
+
+        // the timer has expired concurrently, the wheel might still be busy
+        // resuming the thread, we have to wait for it to let go of the entry
+        hpx::util::yield_while(
+            [&e]() {
+                return e.state_.load(std::memory_order_acquire) ==
+                    timer_entry::firing;
+            },
+            "timer_wheel::cancel", false);
+
+        e.wheel_ = nullptr;
+        return false;
+    }
+
+    std::size_t timer_wheel::poll()
+    {
+        if (count_.load(std::memory_order_relaxed) == 0)
+        {
+            return 0;
+        }
+
+        std::uint64_t const tick = to_tick(clock_type::now(), false);
+        if (tick < next_tick_.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
+        timer_entry* expired = nullptr;
+        {
+            std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+            if (!l.owns_lock() || tick <= now_)
+            {
+                return 0;
+            }
+
+            expired = advance(tick);
+            next_tick_.store(calculate_next_tick(), std::memory_order_relaxed);
+        }
+
+        // resume the threads outside of the lock
+        std::size_t count = 0;
+        while (expired != nullptr)
+        {
+            timer_entry* next = static_cast<timer_entry*>(expired->next_);
+
+            error_code ec(throwmode::lightweight);    // do not throw
+            set_thread_state(expired->thrd_, thread_schedule_state::pending,
+                thread_restart_state::timeout, thread_priority::boost,
+                thread_schedule_hint(), false, ec);
+
+            // the entry might go out of scope as soon as this is visible
+            expired->state_.store(
+                timer_entry::fired, std::memory_order_release);
+
+            expired = next;
+            ++count;
+        }
+        return count;
+    }
+
+    timer_wheel::clock_type::time_point timer_wheel::next_expiry()
+        const noexcept
+    {
+        std::uint64_t const tick = next_tick_.load(std::memory_order_relaxed);
+        if (tick == max_tick)
+        {
+            return clock_type::time_point::max();
+        }
+        return epoch_ + static_cast<std::int64_t>(tick) * tick_duration;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void timer_wheel::insert(timer_entry& e) noexcept
+    {
+        // timers expiring in the current tick (this happens while cascading)
+        // end up in the slot which is processed next
+        HPX_ASSERT(e.expiry_ >= now_);
+
+        // select the level based on the distance to the expiry time, timers
+        // too far in the future are placed into the last slot of the highest
+        // level and are re-inserted once that slot is cascaded
+        std::uint64_t const delta = e.expiry_ - now_;
+        std::uint64_t slot_tick = e.expiry_;
+        if (delta >= max_delta)
+        {
+            slot_tick = now_ + max_delta - 1;
+        }
+
+        std::size_t level = 0;
+        while (level != num_levels - 1 &&
+            slot_tick - now_ >= std::uint64_t(1) << (slot_bits * (level + 1)))
+        {
+            ++level;
+        }
+
+        std::size_t const index =
+            static_cast<std::size_t>((slot_tick >> (slot_bits * level)) &
+                slot_mask);
+
+        e.level_ = static_cast<std::uint8_t>(level);
+        link(slots_[level][index], e);
+        ++level_count_[level];
+    }
+
+    void timer_wheel::remove(timer_entry& e) noexcept
+    {
+        unlink(e);
+        --level_count_[e.level_];
+    }
+
+    timer_entry* timer_wheel::advance(std::uint64_t target) noexcept
+    {
+        HPX_ASSERT(target > now_);
+
+        timer_entry* expired = nullptr;
+        auto expire = [&](timer_entry& e) {
+            e.state_.store(timer_entry::firing, std::memory_order_relaxed);
+            e.next_ = expired;
+            expired = &e;
+        };
+
+        std::size_t count = count_.load(std::memory_order_relaxed);
+        if (target - now_ > max_advance_steps)
+        {
+            // collect all armed timers and re-insert them relative to the
+            // new point in time
+            timer_wheel_node pending;
+            pending.prev_ = pending.next_ = &pending;
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                for (timer_wheel_node& head : slots_[level])
+                {
+                    while (!is_empty(head))
+                    {
+                        timer_wheel_node* node = head.next_;
+                        unlink(*node);
+                        link(pending, *node);
+                    }
+                }
+                level_count_[level] = 0;
+            }
+
+            now_ = target;
+            while (!is_empty(pending))
+            {
+                timer_entry& e = *static_cast<timer_entry*>(pending.next_);
+                unlink(e);
+                if (e.expiry_ <= now_)
+                {
+                    expire(e);
+                    --count;
+                }
+                else
+                {
+                    insert(e);
+                }
+            }
+        }
+
+        while (now_ != target)
+        {
+            if (count == 0)
+            {
+                now_ = target;
+                break;
+            }
+
+            ++now_;
+
+            // move the timers of the slots that are due on the higher levels
+            // down to the lower levels
+            for (std::size_t level = 1; level != num_levels; ++level)
+            {
+                std::uint64_t const shift = slot_bits * level;
+                if ((now_ & ((std::uint64_t(1) << shift) - 1)) != 0)
+                {
+                    break;
+                }
+
+                timer_wheel_node& head =
+                    slots_[level][(now_ >> shift) & slot_mask];
+                while (!is_empty(head))
+                {
+                    timer_entry& e = *static_cast<timer_entry*>(head.next_);
+                    remove(e);
+                    insert(e);
+                }
+            }
+
+            // all timers in the current slot of the lowest level have expired
+            timer_wheel_node& head = slots_[0][now_ & slot_mask];
+            while (!is_empty(head))
+            {
+                timer_entry& e = *static_cast<timer_entry*>(head.next_);
+                HPX_ASSERT(e.expiry_ == now_);
+                remove(e);
+                expire(e);
+                --count;
+            }
+        }
+
+        count_.store(count, std::memory_order_relaxed);
+        return expired;
+    }
+
+    std::uint64_t timer_wheel::calculate_next_tick() const noexcept
+    {
+        std::uint64_t next = max_tick;
+
+        // timers on higher levels do not expire before the next cascade
+        for (std::size_t level = 1; level != num_levels; ++level)
+        {
+            if (level_count_[level] != 0)
+            {
+                next = ((now_ >> slot_bits) + 1) << slot_bits;
+                break;
+            }
+        }
+
+        // timers on the lowest level expire within the next num_slots ticks
+        if (level_count_[0] != 0)
+        {
+            for (std::uint64_t i = 1; i != num_slots && now_ + i < next; ++i)
+            {
+                if (!is_empty(slots_[0][(now_ + i) & slot_mask]))
+                {
+                    return now_ + i;
+                }
+            }
+        }
+        return next;
+    }
+}}}    // namespace hpx::threads::detail
@@ -0,0 +1,210 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test the bucketing of the latency histograms and verify that the scheduling
+// loop records the scheduling latencies and phase durations of HPX threads.
+
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threading_base.hpp>
+#include <hpx/threading_base/detail/latency_histogram.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::threads::thread_latency;
+using hpx::threads::detail::latency_histogram;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_buckets()
+{
+    for (std::size_t i = 0; i != latency_histogram::bucket_count; ++i)
+    {
+        std::uint64_t const lower = latency_histogram::bucket_lower_bound(i);
+        std::uint64_t const upper = latency_histogram::bucket_upper_bound(i);
+
+        HPX_TEST_LTE(lower, upper);
+        HPX_TEST_EQ(latency_histogram::bucket_index(lower), i);
+        HPX_TEST_EQ(latency_histogram::bucket_index(upper), i);
+
+        // the buckets are contiguous
+        if (i != 0)
+        {
+            HPX_TEST_EQ(
+                latency_histogram::bucket_upper_bound(i - 1) + 1, lower);
+        }
+
+        // the relative error is bounded by the number of sub-buckets
+        if (lower >= latency_histogram::sub_bucket_count)
+        {
+            HPX_TEST_LTE((upper - lower + 1) *
+                    latency_histogram::sub_bucket_count,
+                lower);
+        }
+    }
+
+    HPX_TEST_EQ(latency_histogram::bucket_index(latency_histogram::max_value +
+                    1000),
+        latency_histogram::bucket_count - 1);
+}
+
+void test_percentiles()
+{
+    latency_histogram h;
+
+    std::vector<std::int64_t> counts(latency_histogram::bucket_count, 0);
+    h.get_counts(counts, false);
+    HPX_TEST_EQ(latency_histogram::get_percentile(counts, 50.0), 0);
+
+    // 1000 values: 1, 2, ..., 1000
+    for (std::uint64_t i = 1; i <= 1000; ++i)
+    {
+        h.record(i);
+    }
+
+    std::fill(counts.begin(), counts.end(), 0);
+    h.get_counts(counts, true);
+
+    std::int64_t const p50 = latency_histogram::get_percentile(counts, 50.0);
+    std::int64_t const p99 = latency_histogram::get_percentile(counts, 99.0);
+    std::int64_t const p100 = latency_histogram::get_percentile(counts, 100.0);
+
+    HPX_TEST_LTE(std::int64_t(500), p50);
+    HPX_TEST_LTE(p50, std::int64_t(500 + 500 / 16));
+    HPX_TEST_LTE(std::int64_t(990), p99);
+    HPX_TEST_LTE(p99, std::int64_t(990 + 990 / 16));
+    HPX_TEST_LTE(std::int64_t(1000), p100);
+    HPX_TEST_LTE(p100, std::int64_t(1000 + 1000 / 16));
+
+    // the histogram was reset above
+    std::fill(counts.begin(), counts.end(), 0);
+    h.get_counts(counts, false);
+    HPX_TEST_EQ(latency_histogram::get_percentile(counts, 99.0), 0);
+}
+
+// the counters expose histograms with buckets of equal size
+void test_linear_histogram()
+{
+    latency_histogram h;
+    for (std::uint64_t i = 1; i <= 1000; ++i)
+    {
+        h.record(i);
+    }
+    h.record(5000);
+
+    std::vector<std::int64_t> counts(latency_histogram::bucket_count, 0);
+    h.get_counts(counts, false);
+
+    std::vector<std::int64_t> result =
+        latency_histogram::get_linear_histogram(counts, 100, 1100, 10);
+    HPX_TEST_EQ(result.size(), std::size_t(13));
+    HPX_TEST_EQ(result[0], std::int64_t(100));
+    HPX_TEST_EQ(result[1], std::int64_t(1100));
+    HPX_TEST_EQ(result[2], std::int64_t(100));
+
+    // values below the lower bound are accounted for in the first bucket,
+    // values above the upper bound in the last one
+    std::int64_t total = 0;
+    for (std::size_t i = 3; i != result.size(); ++i)
+    {
+        HPX_TEST_LTE(std::int64_t(50), result[i]);
+        total += result[i];
+    }
+    HPX_TEST_EQ(total, std::int64_t(1001));
+    HPX_TEST_LTE(std::int64_t(150), result[3]);
+    HPX_TEST_LTE(std::int64_t(1), result[12]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::int64_t> get_counts(thread_latency which, bool reset = false)
+{
+    return hpx::threads::get_self_id_data()
+        ->get_scheduler_base()
+        ->get_parent_pool()
+        ->get_latency_histogram(which, std::size_t(-1), reset);
+}
+
+std::int64_t get_count(thread_latency which)
+{
+    std::vector<std::int64_t> counts = get_counts(which);
+
+    std::int64_t result = 0;
+    for (std::int64_t count : counts)
+    {
+        result += count;
+    }
+    return result;
+}
+
+void test_scheduling_loop()
+{
+    std::int64_t const creation = get_count(thread_latency::creation);
+    std::int64_t const phase = get_count(thread_latency::phase);
+
+    std::vector<hpx::future<void>> futures;
+    for (int i = 0; i != 100; ++i)
+    {
+        futures.push_back(hpx::async([]() {}));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST_LTE(creation + 100, get_count(thread_latency::creation));
+    HPX_TEST_LTE(phase + 100, get_count(thread_latency::phase));
+
+    // suspending a thread adds to the resume latencies
+    std::int64_t const resume = get_count(thread_latency::resume);
+
+    hpx::async([]() {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }).get();
+
+    HPX_TEST_LT(resume, get_count(thread_latency::resume));
+}
+
+// the creation latency includes the time a thread was staged
+void test_creation_latency()
+{
+    get_counts(thread_latency::creation, true);
+
+    hpx::promise<void> p;
+    hpx::future<void> f = p.get_future();
+
+    hpx::threads::thread_init_data data(
+        hpx::threads::make_thread_function_nullary([&p]() { p.set_value(); }),
+        "test_creation_latency");
+
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(20));
+    hpx::threads::register_work(data);
+    f.get();
+
+    std::vector<std::int64_t> result = latency_histogram::get_linear_histogram(
+        get_counts(thread_latency::creation), 0, 20000000, 2);
+    HPX_TEST_LTE(std::int64_t(1), result[4]);
+}
+
+int hpx_main()
+{
+    test_buckets();
+    test_percentiles();
+    test_linear_histogram();
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    test_scheduling_loop();
+    test_creation_latency();
+#endif
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,118 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that timed suspension of threads (which is backed by the
+// timer wheels of the schedulers) never wakes up threads early, and that
+// threads waiting for a timeout can be woken up before the timer expires.
+
+#include <hpx/local/init.hpp>
+
+#include <hpx/modules/async_local.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/threading.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sleep_for()
+{
+    constexpr std::size_t num_threads = 1000;
+
+    std::atomic<std::size_t> early(0);
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(num_threads);
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        // spread the timeouts over different slots and levels of the wheel
+        std::chrono::microseconds const duration((i * 97) % 30000);
+        futures.push_back(hpx::async([duration, &early]() {
+            auto const start = std::chrono::steady_clock::now();
+            hpx::this_thread::sleep_for(duration);
+            if (std::chrono::steady_clock::now() - start < duration)
+            {
+                ++early;
+            }
+        }));
+    }
+
+    hpx::wait_all(futures);
+    HPX_TEST_EQ(early.load(), std::size_t(0));
+}
+
+void test_condition_variable_timeout()
+{
+    hpx::mutex mtx;
+    hpx::condition_variable_any cv;
+
+    auto const duration = std::chrono::milliseconds(10);
+    auto const start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<hpx::mutex> l(mtx);
+        HPX_TEST(cv.wait_for(l, duration) == hpx::cv_status::timeout);
+    }
+    HPX_TEST(std::chrono::steady_clock::now() - start >= duration);
+}
+
+void test_condition_variable_notify()
+{
+    hpx::mutex mtx;
+    hpx::condition_variable_any cv;
+    bool ready = false;
+
+    hpx::future<void> f = hpx::async([&]() {
+        std::unique_lock<hpx::mutex> l(mtx);
+        // the notification has to end the wait long before the timeout
+        bool const result = cv.wait_for(
+            l, std::chrono::seconds(60), [&ready]() { return ready; });
+        HPX_TEST(result);
+    });
+
+    auto const start = std::chrono::steady_clock::now();
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+        std::lock_guard<hpx::mutex> l(mtx);
+        ready = true;
+    }
+    cv.notify_all();
+
+    f.get();
+    HPX_TEST(std::chrono::steady_clock::now() - start <
+        std::chrono::seconds(30));
+}
+
+void test_timed_future()
+{
+    auto const duration = std::chrono::milliseconds(10);
+    auto const start = std::chrono::steady_clock::now();
+
+    hpx::future<void> f = hpx::make_ready_future_after(duration);
+    f.get();
+
+    HPX_TEST(std::chrono::steady_clock::now() - start >= duration);
+}
+
+int hpx_main()
+{
+    test_sleep_for();
+    test_condition_variable_timeout();
+    test_condition_variable_notify();
+    test_timed_future();
+
+    return hpx::local::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv), 0);
+    return hpx::util::report_errors();
+}
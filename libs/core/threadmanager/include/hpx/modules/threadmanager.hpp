@@ -392,6 +392,13 @@ namespace hpx { namespace threads {
         std::int64_t get_num_stolen_to_staged(bool reset);
 #endif
 
+        std::int64_t get_num_missed_deadlines(bool reset);
+
+        // Return the bucket counts of the given latency histogram summed over
+        // all thread pools (see threads::detail::latency_histogram)
+        std::vector<std::int64_t> get_latency_histogram(
+            thread_latency which, bool reset);
+
     private:
         mutable mutex_type mtx_;    // mutex protecting the members
 
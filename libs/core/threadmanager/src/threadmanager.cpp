@@ -515,6 +515,78 @@ namespace hpx { namespace threads {
                 pools_.push_back(HPX_MOVE(pool));
                 break;
             }
+
+            case resource::local_chase_lev:
+            {
+                // instantiate the scheduler
+                using local_sched_type =
+                    hpx::threads::policies::local_queue_scheduler<std::mutex,
+                        hpx::threads::policies::lockfree_chase_lev,
+                        hpx::threads::policies::lockfree_chase_lev>;
+
+                local_sched_type::init_parameter_type init(
+                    thread_pool_init.num_threads_,
+                    thread_pool_init.affinity_data_, thread_queue_init,
+                    "core-local_chase_lev_queue_scheduler");
+
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // set the default scheduler flags
+                sched->set_scheduler_mode(thread_pool_init.mode_);
+                // conditionally set/unset this flag
+                sched->update_scheduler_mode(
+                    policies::scheduler_mode::enable_stealing_numa,
+                    !numa_sensitive);
+
+                // instantiate the pool
+                std::unique_ptr<thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                        local_sched_type>(HPX_MOVE(sched), thread_pool_init));
+                pools_.push_back(HPX_MOVE(pool));
+                break;
+            }
+
+            case resource::local_priority_chase_lev:
+            {
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                std::size_t num_high_priority_queues =
+                    hpx::util::get_entry_as<std::size_t>(rtcfg_,
+                        "hpx.thread_queue.high_priority_queues",
+                        thread_pool_init.num_threads_);
+                detail::check_num_high_priority_queues(
+                    thread_pool_init.num_threads_, num_high_priority_queues);
+
+                // instantiate the scheduler
+                using local_sched_type =
+                    hpx::threads::policies::local_priority_queue_scheduler<
+                        std::mutex, hpx::threads::policies::lockfree_chase_lev,
+                        hpx::threads::policies::lockfree_chase_lev>;
+
+                local_sched_type::init_parameter_type init(
+                    thread_pool_init.num_threads_,
+                    thread_pool_init.affinity_data_, num_high_priority_queues,
+                    thread_queue_init,
+                    "core-local_priority_chase_lev_queue_scheduler");
+
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // set the default scheduler flags
+                sched->set_scheduler_mode(thread_pool_init.mode_);
+                // conditionally set/unset this flag
+                sched->update_scheduler_mode(
+                    policies::scheduler_mode::enable_stealing_numa,
+                    !numa_sensitive);
+
+                // instantiate the pool
+                std::unique_ptr<thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                        local_sched_type>(HPX_MOVE(sched), thread_pool_init));
+                pools_.push_back(HPX_MOVE(pool));
+                break;
+            }
             }
 
             // update the thread_offset for the next pool
@@ -1015,6 +1087,38 @@ namespace hpx { namespace threads {
     }
 #endif
 
+    std::int64_t threadmanager::get_num_missed_deadlines(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_missed_deadlines(all_threads, reset);
+        return result;
+    }
+
+    std::vector<std::int64_t> threadmanager::get_latency_histogram(
+        thread_latency which, bool reset)
+    {
+        std::vector<std::int64_t> result;
+        for (auto const& pool_iter : pools_)
+        {
+            std::vector<std::int64_t> counts =
+                pool_iter->get_latency_histogram(which, all_threads, reset);
+            if (result.empty())
+            {
+                result = HPX_MOVE(counts);
+            }
+            else if (!counts.empty())
+            {
+                HPX_ASSERT(result.size() == counts.size());
+                for (std::size_t i = 0; i != counts.size(); ++i)
+                {
+                    result[i] += counts[i];
+                }
+            }
+        }
+        return result;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool threadmanager::run()
     {
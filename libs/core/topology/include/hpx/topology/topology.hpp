@@ -187,6 +187,18 @@ namespace hpx { namespace threads {
         mask_cref_type get_core_affinity_mask(
             std::size_t num_thread, error_code& ec = throws) const;
 
+        /// \brief Return a bit mask where each set bit corresponds to a
+        ///        processing unit sharing the data cache of the given level
+        ///        (e.g. 2 for the L2 cache) with the given thread. The
+        ///        returned mask is empty if the system does not expose a
+        ///        cache of that level.
+        ///
+        /// \param ec         [in,out] this represents the error status on exit,
+        ///                   if this is pre-initialized to \a hpx#throws
+        ///                   the function will throw on error instead.
+        mask_type get_cache_affinity_mask(std::size_t num_thread,
+            std::size_t level, error_code& ec = throws) const;
+
         /// \brief Return a bit mask where each set bit corresponds to a
         ///        processing unit available to the given thread.
         ///
@@ -104,6 +104,16 @@ namespace hpx { namespace threads { namespace detail {
         return static_cast<std::size_t>(obj->logical_index);
     }
 
+    bool is_data_cache(hwloc_obj_t obj) noexcept
+    {
+#if HWLOC_API_VERSION >= 0x00020000
+        return hwloc_obj_type_is_dcache(obj->type) != 0;
+#else
+        return obj->type == HWLOC_OBJ_CACHE &&
+            obj->attr->cache.type != HWLOC_OBJ_CACHE_INSTRUCTION;
+#endif
+    }
+
     hwloc_obj_t adjust_node_obj(hwloc_obj_t node) noexcept
     {
 #if HWLOC_API_VERSION >= 0x00020000
@@ -457,6 +467,45 @@ namespace hpx { namespace threads {
         return empty_mask;
     }
 
+    mask_type topology::get_cache_affinity_mask(
+        std::size_t num_thread, std::size_t level, error_code& ec) const
+    {    // {{{
+        std::size_t num_pu = (num_thread + pu_offset) % num_of_pus_;
+
+        hwloc_obj_t obj = nullptr;
+        {
+            std::unique_lock<mutex_type> lk(topo_mtx);
+            obj = hwloc_get_obj_by_type(
+                topo, HWLOC_OBJ_PU, static_cast<unsigned>(num_pu));
+        }
+
+        if (!obj)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "hpx::threads::topology::get_cache_affinity_mask",
+                "thread number {1} is out of range", num_thread);
+            return empty_mask;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        mask_type cache_affinity_mask = mask_type();
+        resize(cache_affinity_mask, get_number_of_pus());
+
+        // walk up the tree until we find the cache of the requested level
+        for (obj = obj->parent; obj != nullptr; obj = obj->parent)
+        {
+            if (detail::is_data_cache(obj) &&
+                obj->attr->cache.depth == static_cast<unsigned>(level))
+            {
+                extract_node_mask(obj, cache_affinity_mask);
+                break;
+            }
+        }
+        return cache_affinity_mask;
+    }    // }}}
+
     mask_cref_type topology::get_thread_affinity_mask(
         std::size_t num_thread, error_code& ec) const
     {    // {{{
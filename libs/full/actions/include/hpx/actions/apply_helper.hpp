@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/actions/apply_helper_fwd.hpp>
+#include <hpx/actions/thread_start_hook.hpp>
 #include <hpx/actions_base/actions_base_support.hpp>
 #include <hpx/actions_base/traits/action_continuation.hpp>
 #include <hpx/actions_base/traits/action_decorate_continuation.hpp>
@@ -64,6 +65,11 @@ namespace hpx { namespace applier { namespace detail {
                 target, lva, comptype, HPX_FORWARD(Ts, vs)...);
         }
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        data.func =
+            actions::detail::apply_thread_start_hook(HPX_MOVE(data.func));
+#endif
+
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         data.description =
@@ -99,6 +105,11 @@ namespace hpx { namespace applier { namespace detail {
             HPX_FORWARD(Continuation, cont), lva, comptype,
             HPX_FORWARD(Ts, vs)...);
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        data.func =
+            actions::detail::apply_thread_start_hook(HPX_MOVE(data.func));
+#endif
+
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         data.description =
@@ -0,0 +1,36 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/functional/move_only_function.hpp>
+#include <hpx/threading_base/threading_base_fwd.hpp>
+
+#include <cstdint>
+
+namespace hpx::actions::detail {
+
+    // The thread start hook is used by the parcel layer to find out when the
+    // thread executing the action of a received parcel starts running. The
+    // hook is stored in thread local storage. It is picked up (and cleared)
+    // by the next action scheduled as a new HPX thread on the calling OS
+    // thread and is invoked with the current time [ns] right before the
+    // action is executed.
+    using thread_start_hook_type = hpx::move_only_function<void(std::int64_t)>;
+
+    HPX_EXPORT void set_thread_start_hook(thread_start_hook_type&& hook);
+    HPX_EXPORT thread_start_hook_type take_thread_start_hook();
+
+    // Wrap the given thread function such that the currently set thread start
+    // hook (if any) is invoked when the thread starts running.
+    HPX_EXPORT threads::thread_function_type apply_thread_start_hook(
+        threads::thread_function_type&& f);
+}    // namespace hpx::actions::detail
+
+#endif
@@ -0,0 +1,62 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/actions/thread_start_hook.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/threading_base/threading_base_fwd.hpp>
+
+#include <cstdint>
+#include <utility>
+
+namespace hpx::actions::detail {
+
+    namespace {
+
+        thread_start_hook_type& get_thread_start_hook()
+        {
+            static thread_local thread_start_hook_type hook;
+            return hook;
+        }
+    }    // namespace
+
+    void set_thread_start_hook(thread_start_hook_type&& hook)
+    {
+        get_thread_start_hook() = HPX_MOVE(hook);
+    }
+
+    thread_start_hook_type take_thread_start_hook()
+    {
+        thread_start_hook_type hook;
+        std::swap(hook, get_thread_start_hook());
+        return hook;
+    }
+
+    threads::thread_function_type apply_thread_start_hook(
+        threads::thread_function_type&& f)
+    {
+        thread_start_hook_type hook = take_thread_start_hook();
+        if (hook.empty())
+        {
+            return HPX_MOVE(f);
+        }
+
+        return [f = HPX_MOVE(f), hook = HPX_MOVE(hook)](
+                   threads::thread_restart_state state) mutable {
+            if (!hook.empty())
+            {
+                thread_start_hook_type h = HPX_MOVE(hook);
+                hook.reset();
+                h(hpx::chrono::high_resolution_clock::now());
+            }
+            return f(state);
+        };
+    }
+}    // namespace hpx::actions::detail
+
+#endif
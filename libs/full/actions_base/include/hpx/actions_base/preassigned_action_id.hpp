@@ -82,6 +82,7 @@ namespace hpx { namespace actions {
         primary_namespace_end_migration_action_id,
         primary_namespace_increment_credit_action_id,
         primary_namespace_resolve_gid_action_id,
+        primary_namespace_resolve_gids_action_id,
         primary_namespace_route_action_id,
         primary_namespace_unbind_gid_action_id,
         primary_namespace_statistics_counter_action_id,
@@ -96,10 +97,14 @@ namespace hpx { namespace actions {
         store64_action_id,
         store8_action_id,
         symbol_namespace_bind_action_id,
+        symbol_namespace_bind_names_action_id,
         symbol_namespace_resolve_action_id,
         symbol_namespace_unbind_action_id,
+        symbol_namespace_unbind_names_action_id,
         symbol_namespace_iterate_action_id,
         symbol_namespace_on_event_action_id,
+        symbol_namespace_on_prefix_event_action_id,
+        symbol_namespace_cancel_prefix_event_action_id,
         symbol_namespace_statistics_counter_action_id,
         terminate_action_id,
         terminate_all_action_id,
@@ -159,6 +164,8 @@ namespace hpx { namespace actions {
         base_lco_with_value_naming_address_set,
         base_lco_with_value_gva_tuple_get,
         base_lco_with_value_gva_tuple_set,
+        base_lco_with_value_vector_gva_tuple_get,
+        base_lco_with_value_vector_gva_tuple_set,
         base_lco_with_value_std_pair_address_id_type_get,
         base_lco_with_value_std_pair_address_id_type_set,
         base_lco_with_value_std_pair_gid_type_get,
@@ -11,8 +11,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/agas/agas_fwd.hpp>
-#include <hpx/cache/lru_cache.hpp>
-#include <hpx/cache/statistics/local_full_statistics.hpp>
+#include <hpx/agas/detail/gva_cache.hpp>
 #include <hpx/components_base/pinned_ptr.hpp>
 #include <hpx/datastructures/detail/dynamic_bitset.hpp>
 #include <hpx/functional/function.hpp>
@@ -60,16 +59,12 @@ namespace hpx { namespace agas {
 
         using mutex_type = hpx::spinlock;
 
-        // gva cache
-        struct gva_cache_key;
-
-        using gva_cache_type = hpx::util::cache::lru_cache<gva_cache_key, gva,
-            hpx::util::cache::statistics::local_full_statistics>;
+        // gva cache, synchronizes internally
+        using gva_cache_type = detail::gva_cache;
 
         using migrated_objects_table_type = std::set<naming::gid_type>;
         using refcnt_requests_type = std::map<naming::gid_type, std::int64_t>;
 
-        mutable mutex_type gva_cache_mtx_;
         std::shared_ptr<gva_cache_type> gva_cache_;
 
         mutable mutex_type migrated_objects_mtx_;
@@ -221,6 +216,8 @@ namespace hpx { namespace agas {
 
         naming::address resolve_full_postproc(naming::gid_type const& id,
             future<primary_namespace::resolved_type> f);
+        naming::address get_resolved_address(naming::gid_type const& id,
+            primary_namespace::resolved_type const& rep);
         bool bind_postproc(
             naming::gid_type const& id, gva const& g, future<bool> f);
 
@@ -859,6 +856,20 @@ namespace hpx { namespace agas {
             return resolve_async(id.get_gid());
         }
 
+        /// \brief Resolve a range of global ids at once.
+        ///
+        /// The ids which can't be resolved from the local cache are grouped
+        /// by the locality of the primary namespace instance managing them,
+        /// each group is resolved using a single request.
+        ///
+        /// \returns A future referring to the addresses of the given ids, in
+        ///          the same order.
+        hpx::future<std::vector<naming::address>> resolve_async(
+            std::vector<naming::gid_type> const& ids);
+
+        hpx::future<std::vector<naming::address>> resolve_async(
+            std::vector<hpx::id_type> const& ids);
+
         ///////////////////////////////////////////////////////////////////////////
         hpx::future<hpx::id_type> get_colocation_id_async(
             hpx::id_type const& id);
@@ -1054,6 +1065,18 @@ namespace hpx { namespace agas {
         bool register_name(std::string const& name, hpx::id_type const& id,
             error_code& ec = throws);
 
+        /// \brief Register several global names at once.
+        ///
+        /// The names are grouped by the symbol namespace instance managing
+        /// them, each group is registered using a single request.
+        ///
+        /// \returns          A future referring to one flag for each of the
+        ///                   given names, in the same order, \a true if the
+        ///                   corresponding name was registered.
+        hpx::future<std::vector<bool>> register_names_async(
+            std::vector<std::string> const& names,
+            std::vector<hpx::id_type> const& ids);
+
         /// \brief Unregister a global name (release any existing association)
         ///
         /// This function releases any existing association of the given global
@@ -1082,6 +1105,14 @@ namespace hpx { namespace agas {
         hpx::id_type unregister_name(
             std::string const& name, error_code& ec = throws);
 
+        /// \brief Unregister several global names at once.
+        ///
+        /// \returns          A future referring to the ids which were
+        ///                   associated with the given names, in the same
+        ///                   order.
+        hpx::future<std::vector<hpx::id_type>> unregister_names_async(
+            std::vector<std::string> const& names);
+
         /// \brief Query for the global address associated with a given global name.
         ///
         /// This function returns the global address associated with the given
@@ -1136,6 +1167,20 @@ namespace hpx { namespace agas {
         future<hpx::id_type> on_symbol_namespace_event(
             std::string const& name, bool call_for_past_events = false);
 
+        /// \brief Install a listener for the registration of any global name
+        ///        starting with the given prefix.
+        ///
+        /// \param prefix     [in] The prefix of the global names for which
+        ///                   the listener should be triggered.
+        /// \param call_for_past_events   [in, optional] Trigger the listener
+        ///                   even if a matching name has already been
+        ///                   registered in the past.
+        ///
+        /// \returns  A future instance encapsulating the global id registered
+        ///           with the first matching name.
+        future<hpx::id_type> on_symbol_namespace_prefix_event(
+            std::string const& prefix, bool call_for_past_events = false);
+
         /// \warning This function is for internal use only. It is dangerous and
         ///          may break your code if you use it.
         void update_cache_entry(naming::gid_type const& gid, gva const& gva,
@@ -0,0 +1,168 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/agas_base/detail/shared_spinlock.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The local cache of GVAs resolved through AGAS.
+    //
+    // The cached ranges of gids are distributed over independently locked
+    // shards in the same way as in the primary namespace's GVA table (see
+    // gva_table). Lookups take the shard lock in shared mode only, hits merely
+    // mark the entry as referenced. The capacity is shared by all shards as
+    // the gids of consecutively created objects map to a few shards only.
+    // Once the cache is full, each insertion evicts an entry of the shard it
+    // inserts into (or of another one if that shard is empty) using the
+    // CLOCK algorithm: newly inserted entries are not marked as referenced,
+    // so entries used only once (e.g. while scanning over many remote
+    // objects) are evicted before entries which have been hit since the clock
+    // hand passed them last.
+    class HPX_EXPORT gva_cache
+    {
+    public:
+        // the statistics gathered by the cache
+        enum class statistic
+        {
+            hits,
+            misses,
+            evictions,
+            insertions,
+            get_entry_count,
+            insert_entry_count,
+            update_entry_count,
+            erase_entry_count,
+            get_entry_time,
+            insert_entry_time,
+            update_entry_time,
+            erase_entry_time,
+            last
+        };
+
+        gva_cache();
+
+        gva_cache(gva_cache const&) = delete;
+        gva_cache& operator=(gva_cache const&) = delete;
+
+        // Limit the overall number of cached entries, std::size_t(-1) means
+        // unlimited.
+        void reserve(std::size_t capacity);
+
+        std::size_t capacity() const noexcept
+        {
+            return capacity_.load(std::memory_order_relaxed);
+        }
+
+        std::size_t size() const;
+
+        // Find the cached range containing the given gid, return its base
+        // gid and GVA.
+        bool get_entry(
+            naming::gid_type const& id, naming::gid_type& base, gva& g);
+
+        // Store the GVA for the given range of gids. Returns false without
+        // modifying the cache if a different range overlapping the given one
+        // is cached already, in this case base and count describe that range.
+        bool update_entry(naming::gid_type const& id, std::uint64_t count,
+            gva const& g, naming::gid_type& base, std::uint64_t& base_count);
+
+        // Remove the range starting at the given gid (if any).
+        void erase_entry(naming::gid_type const& id);
+
+        void clear();
+
+        std::int64_t get_statistics(statistic s, bool reset);
+
+    private:
+        struct entry
+        {
+            entry(gva const& g, std::uint64_t count, std::size_t slot) noexcept
+              : gva_(g)
+              , count_(count)
+              , slot_(slot)
+              , referenced_(false)
+            {
+            }
+
+            gva gva_;
+            std::uint64_t count_;
+            std::size_t slot_;    // position in the clock
+
+            mutable std::atomic<bool> referenced_;
+        };
+
+        using map_type = std::map<naming::gid_type, entry>;
+
+        struct shard_data
+        {
+            shard_data() = default;
+
+            // remove the given entry, expects the shard to be locked
+            void erase(map_type::iterator it);
+
+            // evict entries until the given number of entries is left
+            std::size_t evict(std::size_t max_size);
+
+            mutable shared_spinlock mtx_;
+            map_type entries_;
+
+            std::vector<map_type::iterator> clock_;
+            std::size_t hand_ = 0;
+
+            std::array<std::atomic<std::int64_t>,
+                static_cast<std::size_t>(statistic::last)>
+                statistics_ = {};
+        };
+        using shard = util::cache_aligned_data_derived<shard_data>;
+
+        static constexpr std::size_t num_shards = 64;
+
+        // evict entries from the given shard until the given number of
+        // entries is left, expects the shard to be locked
+        std::size_t evict(shard& t, std::size_t max_size);
+
+        // make room for a new entry if the cache is full, expects the given
+        // shard to be locked
+        std::size_t make_room(shard& t);
+
+        shard& get_shard(naming::gid_type const& id) noexcept
+        {
+            return shards_[get_gva_shard_index(id, num_shards)];
+        }
+
+        std::array<shard, num_shards> shards_;
+
+        // ranges spanning more than one block of gids
+        shard wide_entries_;
+        std::atomic<std::size_t> num_wide_entries_;
+
+        std::atomic<std::size_t> num_entries_;
+        std::atomic<std::size_t> capacity_;
+
+        // the shard to look at first if an entry has to be evicted from a
+        // shard other than the one being inserted into
+        std::atomic<std::size_t> next_victim_;
+    };
+}}}    // namespace hpx::agas::detail
+
+#include <hpx/config/warnings_suffix.hpp>
@@ -16,6 +16,8 @@
 #include <hpx/assert.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/async_combinators/when_all.hpp>
+#include <hpx/async_combinators/when_any.hpp>
+#include <hpx/components_base/agas_interface.hpp>
 #include <hpx/components_base/traits/component_supports_migration.hpp>
 #include <hpx/datastructures/detail/dynamic_bitset.hpp>
 #include <hpx/functional/bind.hpp>
@@ -51,72 +53,6 @@
 
 namespace hpx { namespace agas {
 
-    struct addressing_service::gva_cache_key
-    {    // {{{ gva_cache_key implementation
-    private:
-        using key_type = std::pair<naming::gid_type, naming::gid_type>;
-
-        key_type key_;
-
-    public:
-        gva_cache_key()
-          : key_()
-        {
-        }
-
-        explicit gva_cache_key(
-            naming::gid_type const& id, std::uint64_t count = 1)
-          : key_(naming::detail::get_stripped_gid(id),
-                naming::detail::get_stripped_gid(id) + (count - 1))
-        {
-            HPX_ASSERT(count);
-        }
-
-        naming::gid_type get_gid() const
-        {
-            return key_.first;
-        }
-
-        std::uint64_t get_count() const
-        {
-            naming::gid_type const size = key_.second - key_.first;
-            HPX_ASSERT(size.get_msb() == 0);
-            return size.get_lsb();
-        }
-
-        friend bool operator<(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            return lhs.key_.second < rhs.key_.first;
-        }
-
-        friend bool operator==(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            // Direct hit
-            if (lhs.key_ == rhs.key_)
-            {
-                return true;
-            }
-
-            // Is lhs in rhs?
-            if (1 == lhs.get_count() && 1 != rhs.get_count())
-            {
-                return rhs.key_.first <= lhs.key_.first &&
-                    lhs.key_.second <= rhs.key_.second;
-            }
-
-            // Is rhs in lhs?
-            else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            {
-                return lhs.key_.first <= rhs.key_.first &&
-                    rhs.key_.second <= lhs.key_.second;
-            }
-
-            return false;
-        }
-    };    // }}}
-
     addressing_service::addressing_service(
         util::runtime_configuration const& ini_)
       : gva_cache_(new gva_cache_type)
@@ -1050,12 +986,17 @@ namespace hpx { namespace agas {
     ///////////////////////////////////////////////////////////////////////////
     naming::address addressing_service::resolve_full_postproc(
         naming::gid_type const& id, future<primary_namespace::resolved_type> f)
+    {
+        return get_resolved_address(id, f.get());
+    }
+
+    naming::address addressing_service::get_resolved_address(
+        naming::gid_type const& id, primary_namespace::resolved_type const& rep)
     {
         using hpx::get;
 
         naming::address addr;
 
-        auto rep = f.get();
         if (get<0>(rep) == naming::invalid_gid ||
             get<2>(rep) == naming::invalid_gid)
         {
@@ -1113,6 +1054,106 @@ namespace hpx { namespace agas {
                 &addressing_service::resolve_full_postproc, this, gid)));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<std::vector<naming::address>>
+    addressing_service::resolve_async(std::vector<naming::gid_type> const& gids)
+    {
+        auto addrs = std::make_shared<std::vector<naming::address>>(gids.size());
+
+        // the ids which were not found in the cache, grouped by the locality
+        // of the primary namespace instance managing them
+        struct request
+        {
+            std::vector<naming::gid_type> gids;
+            std::vector<std::size_t> indices;
+        };
+        std::map<std::uint32_t, request> requests;
+
+        for (std::size_t i = 0; i != gids.size(); ++i)
+        {
+            naming::gid_type const& gid = gids[i];
+            if (!gid)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "addressing_service::resolve_async",
+                    "invalid reference id");
+                return make_ready_future(std::vector<naming::address>());
+            }
+
+            // Try the cache.
+            if (caching_)
+            {
+                error_code ec;
+                if (resolve_cached(gid, (*addrs)[i], ec))
+                    continue;
+
+                if (ec)
+                {
+                    return hpx::make_exceptional_future<
+                        std::vector<naming::address>>(
+                        hpx::detail::access_exception(ec));
+                }
+            }
+
+            request& r = requests[naming::get_locality_id_from_gid(gid)];
+            r.gids.push_back(gid);
+            r.indices.push_back(i);
+        }
+
+        if (requests.empty())
+        {
+            return make_ready_future(HPX_MOVE(*addrs));
+        }
+
+        // now ask the AGAS service, one request per primary namespace
+        std::vector<hpx::future<void>> responses;
+        responses.reserve(requests.size());
+
+        for (auto& r : requests)
+        {
+            hpx::future<std::vector<primary_namespace::resolved_type>> f =
+                primary_ns_.resolve_full(r.second.gids);
+
+            responses.push_back(f.then(hpx::launch::sync,
+                [this, addrs, r = HPX_MOVE(r.second)](
+                    hpx::future<std::vector<primary_namespace::resolved_type>>&&
+                        f) {
+                    auto reps = f.get();
+                    HPX_ASSERT(reps.size() == r.gids.size());
+
+                    for (std::size_t i = 0; i != reps.size(); ++i)
+                    {
+                        (*addrs)[r.indices[i]] =
+                            get_resolved_address(r.gids[i], reps[i]);
+                    }
+                }));
+        }
+
+        return hpx::when_all(responses).then(hpx::launch::sync,
+            [addrs](hpx::future<std::vector<hpx::future<void>>>&& f)
+                -> std::vector<naming::address> {
+                // rethrow exceptions, if any
+                for (auto& response : f.get())
+                {
+                    response.get();
+                }
+                return HPX_MOVE(*addrs);
+            });
+    }
+
+    hpx::future<std::vector<naming::address>>
+    addressing_service::resolve_async(std::vector<hpx::id_type> const& ids)
+    {
+        std::vector<naming::gid_type> gids;
+        gids.reserve(ids.size());
+
+        for (hpx::id_type const& id : ids)
+        {
+            gids.push_back(id.get_gid());
+        }
+        return resolve_async(gids);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool addressing_service::resolve_full_local(naming::gid_type const* gids,
         naming::address* addrs, std::size_t count,
@@ -1501,6 +1542,61 @@ namespace hpx { namespace agas {
         return f;
     }    // }}}
 
+    hpx::future<std::vector<bool>> addressing_service::register_names_async(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids)
+    {
+        HPX_ASSERT(names.size() == ids.size());
+
+        // We need to modify the reference counts.
+        std::vector<naming::gid_type> gids;
+        std::vector<std::int64_t> credits;
+        gids.reserve(ids.size());
+        credits.reserve(ids.size());
+
+        for (hpx::id_type const& id : ids)
+        {
+            naming::gid_type& mutable_gid =
+                const_cast<hpx::id_type&>(id).get_gid();
+            gids.push_back(
+                naming::detail::split_gid_if_needed(mutable_gid).get());
+            credits.push_back(naming::detail::get_credit_from_gid(gids.back()));
+        }
+
+        hpx::future<std::vector<bool>> f =
+            symbol_ns_.bind_async(names, HPX_MOVE(gids));
+
+        // Return the credits to the ids whose names were not registered
+        return f.then(hpx::launch::sync,
+            [ids = ids, credits = HPX_MOVE(credits)](
+                hpx::future<std::vector<bool>>&& f) mutable
+            -> std::vector<bool> {
+                if (f.has_exception())
+                {
+                    for (std::size_t i = 0; i != ids.size(); ++i)
+                    {
+                        if (credits[i] != 0)
+                        {
+                            naming::detail::add_credit_to_gid(
+                                ids[i].get_gid(), credits[i]);
+                        }
+                    }
+                    return f.get();    // rethrow
+                }
+
+                std::vector<bool> results = f.get();
+                for (std::size_t i = 0; i != ids.size(); ++i)
+                {
+                    if (!results[i] && credits[i] != 0)
+                    {
+                        naming::detail::add_credit_to_gid(
+                            ids[i].get_gid(), credits[i]);
+                    }
+                }
+                return results;
+            });
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::id_type addressing_service::unregister_name(
         std::string const& name, error_code& ec)
@@ -1522,6 +1618,13 @@ namespace hpx { namespace agas {
         return symbol_ns_.unbind_async(name);
     }    // }}}
 
+    hpx::future<std::vector<hpx::id_type>>
+    addressing_service::unregister_names_async(
+        std::vector<std::string> const& names)
+    {
+        return symbol_ns_.unbind_async(names);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::id_type addressing_service::resolve_name(
         std::string const& name, error_code& ec)
@@ -1573,6 +1676,68 @@ namespace hpx { namespace agas {
                 &detail::on_register_event, HPX_MOVE(result_f))));
     }
 
+    future<hpx::id_type> addressing_service::on_symbol_namespace_prefix_event(
+        std::string const& prefix, bool call_for_past_events)
+    {
+        // names starting with the prefix may be managed by any instance,
+        // install a separate listener with each of them
+        std::vector<std::uint32_t> locality_ids = agas::get_all_locality_ids();
+
+        std::vector<hpx::id_type> lcos;
+        std::vector<hpx::future<hpx::id_type>> results;
+        std::vector<hpx::future<bool>> registered;
+        lcos.reserve(locality_ids.size());
+        results.reserve(locality_ids.size());
+        registered.reserve(locality_ids.size());
+
+        for (std::uint32_t locality_id : locality_ids)
+        {
+            hpx::distributed::promise<hpx::id_type, naming::gid_type> p;
+            results.push_back(p.get_future());
+            lcos.push_back(p.get_id());
+            registered.push_back(symbol_ns_.on_prefix_event(
+                prefix, call_for_past_events, p.get_id(), locality_id));
+        }
+
+        // the first listener to be triggered wins, the others are removed
+        auto on_triggered = [this, prefix, lcos = HPX_MOVE(lcos),
+                                locality_ids = HPX_MOVE(locality_ids)](
+                                hpx::future<hpx::when_any_result<
+                                    std::vector<hpx::future<hpx::id_type>>>>&&
+                                    f) -> hpx::id_type {
+            auto result = f.get();
+            for (std::size_t i = 0; i != lcos.size(); ++i)
+            {
+                if (i != result.index)
+                {
+                    symbol_ns_.cancel_prefix_event(
+                        prefix, lcos[i], locality_ids[i]);
+                }
+            }
+            return result.futures[result.index].get();
+        };
+
+        return hpx::when_all(registered).then(hpx::launch::sync,
+            [results = HPX_MOVE(results),
+                on_triggered = HPX_MOVE(on_triggered)](
+                hpx::future<std::vector<hpx::future<bool>>>&& f) mutable
+            -> hpx::future<hpx::id_type> {
+                for (auto& r : f.get())
+                {
+                    if (!r.get())
+                    {
+                        HPX_THROW_EXCEPTION(bad_request,
+                            "addressing_service::"
+                            "on_symbol_namespace_prefix_event",
+                            "request 'symbol_ns_on_prefix_event' failed");
+                    }
+                }
+
+                return hpx::when_any(results).then(
+                    hpx::launch::sync, HPX_MOVE(on_triggered));
+            });
+    }
+
     // Return all matching entries in the symbol namespace
     hpx::future<addressing_service::iterate_names_return_type>
     addressing_service::iterate_ids(std::string const& pattern)
@@ -1580,15 +1745,6 @@ namespace hpx { namespace agas {
         return symbol_ns_.iterate_async(pattern);
     }    // }}}
 
-    // This function has to return false if the key is already in the cache (true
-    // means go ahead with the cache update).
-    bool check_for_collisions(addressing_service::gva_cache_key const& new_key,
-        addressing_service::gva_cache_key const& old_key)
-    {
-        return (new_key.get_gid() != old_key.get_gid()) ||
-            (new_key.get_count() != old_key.get_count());
-    }
-
     void addressing_service::update_cache_entry(
         naming::gid_type const& id, gva const& g, error_code& ec)
     {    // {{{
@@ -1649,37 +1805,18 @@ namespace hpx { namespace agas {
                 "addressing_service::update_cache_entry, gid({1}), count({2})",
                 gid, count);
 
-            const gva_cache_key key(gid, count);
+            // Figure out who we collided with, if any.
+            naming::gid_type idbase;
+            std::uint64_t idbase_count = 0;
 
+            if (!gva_cache_->update_entry(gid, count, g, idbase, idbase_count))
             {
-                std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-                if (!gva_cache_->update_if(key, g, check_for_collisions))
-                {
-                    if (LAGAS_ENABLED(warning))
-                    {
-                        // Figure out who we collided with.
-                        addressing_service::gva_cache_key idbase;
-                        addressing_service::gva_cache_type::entry_type e;
-
-                        if (!gva_cache_->get_entry(key, idbase, e))
-                        {
-                            // This is impossible under sane conditions.
-                            lock.unlock();
-                            HPX_THROWS_IF(ec, invalid_data,
-                                "addressing_service::update_cache_entry",
-                                "data corruption or lock error occurred in "
-                                "cache");
-                            return;
-                        }
-
-                        LAGAS_(warning).format(
-                            "addressing_service::update_cache_entry, aborting "
-                            "update due to key collision in cache, "
-                            "new_gid({1}), new_count({2}), old_gid({3}), "
-                            "old_count({4})",
-                            gid, count, idbase.get_gid(), idbase.get_count());
-                    }
-                }
+                LAGAS_(warning).format(
+                    "addressing_service::update_cache_entry, aborting "
+                    "update due to key collision in cache, "
+                    "new_gid({1}), new_count({2}), old_gid({3}), "
+                    "old_count({4})",
+                    gid, count, idbase, idbase_count);
             }
 
             if (&ec != &throws)
@@ -1699,25 +1836,22 @@ namespace hpx { namespace agas {
         {
             return false;
         }
-        gva_cache_key k(gid);
-        gva_cache_key idbase_key;
-
-        std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-        if (gva_cache_->get_entry(k, idbase_key, gva))
+        naming::gid_type idbase_gid;
+        if (gva_cache_->get_entry(
+                naming::detail::get_stripped_gid(gid), idbase_gid, gva))
         {
             const std::uint64_t id_msb =
                 naming::detail::strip_internal_bits_from_gid(gid.get_msb());
 
-            if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
+            if (HPX_UNLIKELY(id_msb != idbase_gid.get_msb()))
             {
-                lock.unlock();
                 HPX_THROWS_IF(ec, internal_server_error,
                     "addressing_service::get_cache_entry",
                     "bad entry in cache, MSBs of GID base and GID do not "
                     "match");
                 return false;
             }
-            idbase = idbase_key.get_gid();
+            idbase = idbase_gid;
             return true;
         }
 
@@ -1739,8 +1873,6 @@ namespace hpx { namespace agas {
             LAGAS_(warning).format(
                 "addressing_service::clear_cache, clearing cache");
 
-            std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
             gva_cache_->clear();
 
             if (&ec != &throws)
@@ -1786,11 +1918,7 @@ namespace hpx { namespace agas {
         {
             LAGAS_(warning).format("addressing_service::remove_cache_entry");
 
-            std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-            gva_cache_->erase([&gid](std::pair<gva_cache_key, gva> const& p) {
-                return gid == p.first.get_gid();
-            });
+            gva_cache_->erase_entry(gid);
 
             if (&ec != &throws)
                 ec = make_success_code();
@@ -1817,82 +1945,81 @@ namespace hpx { namespace agas {
     // Helper functions to access the current cache statistics
     std::uint64_t addressing_service::get_cache_entries(bool /* reset */)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
         return gva_cache_->size();
     }
 
     std::uint64_t addressing_service::get_cache_hits(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().hits(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::hits, reset);
     }
 
     std::uint64_t addressing_service::get_cache_misses(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().misses(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::misses, reset);
     }
 
     std::uint64_t addressing_service::get_cache_evictions(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().evictions(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::evictions, reset);
     }
 
     std::uint64_t addressing_service::get_cache_insertions(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().insertions(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::insertions, reset);
     }
 
     ///////////////////////////////////////////////////////////////////////////
     std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_get_entry_count(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::get_entry_count, reset);
     }
 
     std::uint64_t addressing_service::get_cache_insertion_entry_count(
         bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_insert_entry_count(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::insert_entry_count, reset);
     }
 
     std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_update_entry_count(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::update_entry_count, reset);
     }
 
     std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_erase_entry_count(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::erase_entry_count, reset);
     }
 
     std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_get_entry_time(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::get_entry_time, reset);
     }
 
     std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_insert_entry_time(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::insert_entry_time, reset);
     }
 
     std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_update_entry_time(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::update_entry_time, reset);
     }
 
     std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
     {
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-        return gva_cache_->get_statistics().get_erase_entry_time(reset);
+        return gva_cache_->get_statistics(
+            gva_cache_type::statistic::erase_entry_time, reset);
     }
 
     void addressing_service::register_server_instances()
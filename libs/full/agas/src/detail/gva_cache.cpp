@@ -0,0 +1,432 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/agas/detail/gva_cache.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+
+namespace hpx { namespace agas { namespace detail {
+
+    namespace {
+
+        // update the count and time of an API function of the cache on exit
+        struct update_on_exit
+        {
+            static std::int64_t now() noexcept
+            {
+                std::chrono::nanoseconds ns =
+                    std::chrono::steady_clock::now().time_since_epoch();
+                return static_cast<std::int64_t>(ns.count());
+            }
+
+            update_on_exit(std::atomic<std::int64_t>& count,
+                std::atomic<std::int64_t>& time) noexcept
+              : started_at_(now())
+              , count_(count)
+              , time_(time)
+            {
+            }
+
+            ~update_on_exit()
+            {
+                time_.fetch_add(now() - started_at_, std::memory_order_relaxed);
+                count_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::int64_t started_at_;
+            std::atomic<std::int64_t>& count_;
+            std::atomic<std::int64_t>& time_;
+        };
+
+        // find the entry of the given table covering the given gid
+        template <typename Map>
+        typename Map::iterator find_covering(
+            Map& entries, naming::gid_type const& id) noexcept
+        {
+            auto it = entries.upper_bound(id);
+            if (it == entries.begin())
+            {
+                return entries.end();
+            }
+
+            --it;
+            if (it->first == id || it->first + it->second.count_ > id)
+            {
+                return it;
+            }
+            return entries.end();
+        }
+
+        // find an entry of the given table overlapping the range [id, last]
+        template <typename Map>
+        typename Map::iterator find_overlapping(Map& entries,
+            naming::gid_type const& id, naming::gid_type const& last) noexcept
+        {
+            auto it = find_covering(entries, id);
+            if (it != entries.end())
+            {
+                return it;
+            }
+
+            it = entries.lower_bound(id);
+            if (it != entries.end() && it->first <= last)
+            {
+                return it;
+            }
+            return entries.end();
+        }
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    void gva_cache::shard_data::erase(map_type::iterator it)
+    {
+        std::size_t const slot = it->second.slot_;
+        if (slot != clock_.size() - 1)
+        {
+            clock_[slot] = clock_.back();
+            clock_[slot]->second.slot_ = slot;
+        }
+        clock_.pop_back();
+        entries_.erase(it);
+    }
+
+    std::size_t gva_cache::shard_data::evict(std::size_t max_size)
+    {
+        std::size_t evicted = 0;
+        while (entries_.size() > max_size)
+        {
+            HPX_ASSERT(!clock_.empty());
+            if (hand_ >= clock_.size())
+            {
+                hand_ = 0;
+            }
+
+            // give entries which were referenced since the hand passed them
+            // last a second chance
+            map_type::iterator it = clock_[hand_];
+            if (it->second.referenced_.exchange(
+                    false, std::memory_order_relaxed))
+            {
+                ++hand_;
+                continue;
+            }
+
+            // the hand now refers to the entry moved into the free slot
+            erase(it);
+            ++evicted;
+        }
+        return evicted;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache()
+      : num_wide_entries_(0)
+      , num_entries_(0)
+      , capacity_(0)
+      , next_victim_(0)
+    {
+    }
+
+    std::size_t gva_cache::evict(shard& t, std::size_t max_size)
+    {
+        std::size_t const evicted = t.evict(max_size);
+        if (evicted != 0)
+        {
+            num_entries_.fetch_sub(evicted, std::memory_order_relaxed);
+            if (&t == &wide_entries_)
+            {
+                num_wide_entries_.fetch_sub(
+                    evicted, std::memory_order_release);
+            }
+        }
+        return evicted;
+    }
+
+    std::size_t gva_cache::make_room(shard& t)
+    {
+        if (num_entries_.load(std::memory_order_relaxed) <
+            capacity_.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
+        if (!t.entries_.empty())
+        {
+            return evict(t, t.entries_.size() - 1);
+        }
+
+        // The shard is locked already, other shards are only tried to avoid
+        // deadlocks. The cache may exceed its capacity for a short time if
+        // all of them are busy.
+        std::size_t const start =
+            next_victim_.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i <= num_shards; ++i)
+        {
+            shard& v = i == num_shards ? wide_entries_ :
+                                         shards_[(start + i) % num_shards];
+
+            std::unique_lock<shared_spinlock> l(v.mtx_, std::try_to_lock);
+            if (l.owns_lock() && !v.entries_.empty())
+            {
+                return evict(v, v.entries_.size() - 1);
+            }
+        }
+        return 0;
+    }
+
+    void gva_cache::reserve(std::size_t capacity)
+    {
+        capacity_.store(capacity, std::memory_order_relaxed);
+
+        // evict the same share of the entries of all shards
+        auto evict_share = [&](shard& t) {
+            std::lock_guard<shared_spinlock> l(t.mtx_);
+
+            std::size_t const size = num_entries_.load();
+            if (size <= capacity)
+            {
+                return;
+            }
+
+            std::size_t const shard_size = t.entries_.size();
+            std::size_t const excess =
+                (shard_size * (size - capacity) + size - 1) / size;
+
+            t.statistics_[static_cast<std::size_t>(statistic::evictions)]
+                .fetch_add(evict(t, shard_size - excess),
+                    std::memory_order_relaxed);
+        };
+
+        while (num_entries_.load() > capacity)
+        {
+            for (shard& s : shards_)
+            {
+                evict_share(s);
+            }
+            evict_share(wide_entries_);
+        }
+    }
+
+    std::size_t gva_cache::size() const
+    {
+        return num_entries_.load(std::memory_order_relaxed);
+    }
+
+    bool gva_cache::get_entry(
+        naming::gid_type const& id, naming::gid_type& base, gva& g)
+    {
+        shard& s = get_shard(id);
+
+        auto& statistics = s.statistics_;
+        update_on_exit update(
+            statistics[static_cast<std::size_t>(statistic::get_entry_count)],
+            statistics[static_cast<std::size_t>(statistic::get_entry_time)]);
+
+        auto lookup = [&](shard& t) {
+            std::shared_lock<shared_spinlock> l(t.mtx_);
+
+            auto it = find_covering(t.entries_, id);
+            if (it == t.entries_.end())
+            {
+                return false;
+            }
+
+            // avoid writing to the entry if it is referenced already
+            if (!it->second.referenced_.load(std::memory_order_relaxed))
+            {
+                it->second.referenced_.store(true, std::memory_order_relaxed);
+            }
+
+            base = it->first;
+            g = it->second.gva_;
+            return true;
+        };
+
+        if (lookup(s) ||
+            (num_wide_entries_.load(std::memory_order_acquire) != 0 &&
+                lookup(wide_entries_)))
+        {
+            statistics[static_cast<std::size_t>(statistic::hits)].fetch_add(
+                1, std::memory_order_relaxed);
+            return true;
+        }
+
+        statistics[static_cast<std::size_t>(statistic::misses)].fetch_add(
+            1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool gva_cache::update_entry(naming::gid_type const& id,
+        std::uint64_t count, gva const& g, naming::gid_type& base,
+        std::uint64_t& base_count)
+    {
+        HPX_ASSERT(count != 0);
+
+        shard& s = get_shard(id);
+
+        auto& statistics = s.statistics_;
+        update_on_exit update(
+            statistics[static_cast<std::size_t>(statistic::update_entry_count)],
+            statistics[static_cast<std::size_t>(statistic::update_entry_time)]);
+
+        naming::gid_type const last = id + (count - 1);
+
+        // update the entry for the same range or report a collision
+        auto update_existing = [&](map_type::iterator it) {
+            if (it->first != id || it->second.count_ != count)
+            {
+                base = it->first;
+                base_count = it->second.count_;
+                return false;
+            }
+
+            it->second.gva_ = g;
+            it->second.referenced_.store(true, std::memory_order_relaxed);
+
+            statistics[static_cast<std::size_t>(statistic::hits)].fetch_add(
+                1, std::memory_order_relaxed);
+            return true;
+        };
+
+        // insert a new entry, evicting others if the shard is full
+        auto insert = [&](shard& t) {
+            statistics[static_cast<std::size_t>(statistic::misses)].fetch_add(
+                1, std::memory_order_relaxed);
+            statistics[static_cast<std::size_t>(statistic::insertions)]
+                .fetch_add(1, std::memory_order_relaxed);
+
+            std::size_t evicted = 1;
+            if (capacity_.load(std::memory_order_relaxed) != 0)
+            {
+                // announce the new wide entry before evicting any
+                if (&t == &wide_entries_)
+                {
+                    num_wide_entries_.fetch_add(1, std::memory_order_release);
+                }
+                evicted = make_room(t);
+
+                auto p = t.entries_.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(id),
+                    std::forward_as_tuple(g, count, t.clock_.size()));
+                HPX_ASSERT(p.second);
+                t.clock_.push_back(p.first);
+                num_entries_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            statistics[static_cast<std::size_t>(statistic::evictions)]
+                .fetch_add(evicted, std::memory_order_relaxed);
+        };
+
+        // the shard is always locked before the table of wide entries
+        std::lock_guard<shared_spinlock> l(s.mtx_);
+
+        auto it = find_overlapping(s.entries_, id, last);
+        if (it != s.entries_.end())
+        {
+            return update_existing(it);
+        }
+
+        bool const wide = spans_gva_blocks(id, count);
+        if (!wide && num_wide_entries_.load(std::memory_order_acquire) == 0)
+        {
+            insert(s);
+            return true;
+        }
+
+        std::lock_guard<shared_spinlock> wl(wide_entries_.mtx_);
+
+        it = find_overlapping(wide_entries_.entries_, id, last);
+        if (it != wide_entries_.entries_.end())
+        {
+            return update_existing(it);
+        }
+
+        insert(wide ? wide_entries_ : s);
+        return true;
+    }
+
+    void gva_cache::erase_entry(naming::gid_type const& id)
+    {
+        shard& s = get_shard(id);
+
+        auto& statistics = s.statistics_;
+        update_on_exit update(
+            statistics[static_cast<std::size_t>(statistic::erase_entry_count)],
+            statistics[static_cast<std::size_t>(statistic::erase_entry_time)]);
+
+        auto erase = [&](shard& t) {
+            std::lock_guard<shared_spinlock> l(t.mtx_);
+
+            auto it = t.entries_.find(id);
+            if (it == t.entries_.end())
+            {
+                return false;
+            }
+
+            t.erase(it);
+            num_entries_.fetch_sub(1, std::memory_order_relaxed);
+            statistics[static_cast<std::size_t>(statistic::evictions)]
+                .fetch_add(1, std::memory_order_relaxed);
+            return true;
+        };
+
+        if (!erase(s) &&
+            num_wide_entries_.load(std::memory_order_acquire) != 0 &&
+            erase(wide_entries_))
+        {
+            num_wide_entries_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void gva_cache::clear()
+    {
+        auto clear = [&](shard& t) {
+            std::lock_guard<shared_spinlock> l(t.mtx_);
+
+            num_entries_.fetch_sub(
+                t.entries_.size(), std::memory_order_relaxed);
+            t.entries_.clear();
+            t.clock_.clear();
+            t.hand_ = 0;
+        };
+
+        for (shard& s : shards_)
+        {
+            clear(s);
+        }
+
+        clear(wide_entries_);
+        num_wide_entries_.store(0, std::memory_order_release);
+    }
+
+    std::int64_t gva_cache::get_statistics(statistic s, bool reset)
+    {
+        std::size_t const index = static_cast<std::size_t>(s);
+
+        auto get_value = [&](shard& t) {
+            return reset ? t.statistics_[index].exchange(0) :
+                           t.statistics_[index].load();
+        };
+
+        std::int64_t value = get_value(wide_entries_);
+        for (shard& t : shards_)
+        {
+            value += get_value(t);
+        }
+        return value;
+    }
+}}}    // namespace hpx::agas::detail
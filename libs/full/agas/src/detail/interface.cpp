@@ -44,6 +44,13 @@ namespace hpx { namespace agas { namespace detail { namespace impl {
         return naming::get_agas_client().register_name_async(name, id);
     }
 
+    future<std::vector<bool>> register_names_async(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids)
+    {
+        return naming::get_agas_client().register_names_async(names, ids);
+    }
+
     bool register_name_id(
         std::string const& name, hpx::id_type const& id, error_code& ec)
     {
@@ -69,6 +76,12 @@ namespace hpx { namespace agas { namespace detail { namespace impl {
         return naming::get_agas_client().unregister_name_async(name);
     }
 
+    future<std::vector<hpx::id_type>> unregister_names_async(
+        std::vector<std::string> const& names)
+    {
+        return naming::get_agas_client().unregister_names_async(names);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     future<hpx::id_type> resolve_name_async(std::string const& name)
     {
@@ -150,6 +163,12 @@ namespace hpx { namespace agas { namespace detail { namespace impl {
         return naming::get_agas_client().resolve_async(id);
     }
 
+    hpx::future<std::vector<naming::address>> resolve_bulk_async(
+        std::vector<hpx::id_type> const& ids)
+    {
+        return naming::get_agas_client().resolve_async(ids);
+    }
+
     naming::address resolve(hpx::id_type const& id, error_code& ec)
     {
         return naming::get_agas_client().resolve_async(id).get(ec);
@@ -435,6 +454,13 @@ namespace hpx { namespace agas { namespace detail { namespace impl {
             name, call_for_past_events);
     }
 
+    hpx::future<hpx::id_type> on_symbol_namespace_prefix_event(
+        std::string const& prefix, bool call_for_past_events)
+    {
+        return naming::get_agas_client().on_symbol_namespace_prefix_event(
+            prefix, call_for_past_events);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<std::pair<hpx::id_type, naming::address>> begin_migration(
         hpx::id_type const& id)
@@ -533,10 +559,13 @@ namespace hpx { namespace agas {
             detail::register_name = &detail::impl::register_name;
             detail::register_name_async = &detail::impl::register_name_async;
             detail::register_name_id = &detail::impl::register_name_id;
+            detail::register_names_async = &detail::impl::register_names_async;
 
             detail::unregister_name_async =
                 &detail::impl::unregister_name_async;
             detail::unregister_name = &detail::impl::unregister_name;
+            detail::unregister_names_async =
+                &detail::impl::unregister_names_async;
 
             detail::resolve_name_async = &detail::impl::resolve_name_async;
             detail::resolve_name = &detail::impl::resolve_name;
@@ -567,6 +596,7 @@ namespace hpx { namespace agas {
                 &detail::impl::is_local_lva_encoded_address;
 
             detail::resolve_async = &detail::impl::resolve_async;
+            detail::resolve_bulk_async = &detail::impl::resolve_bulk_async;
             detail::resolve = &detail::impl::resolve;
             detail::resolve_cached = &detail::impl::resolve_cached;
             detail::resolve_local = &detail::impl::resolve_local;
@@ -610,6 +640,8 @@ namespace hpx { namespace agas {
 
             detail::on_symbol_namespace_event =
                 &detail::impl::on_symbol_namespace_event;
+            detail::on_symbol_namespace_prefix_event =
+                &detail::impl::on_symbol_namespace_prefix_event;
 
             detail::begin_migration = &detail::impl::begin_migration;
             detail::end_migration = &detail::impl::end_migration;
@@ -23,7 +23,6 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <mutex>
 #include <utility>
 
 namespace hpx::detail {
@@ -54,22 +53,18 @@ namespace hpx::agas::server {
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
-
             error_code& ec = throws;
 
             // wait for any migration to be completed
             if (naming::detail::is_migratable(gid))
             {
-                wait_for_migration_locked(l, gid, ec);
+                wait_for_migration(gid, ec);
             }
 
-            cache_address = resolve_gid_locked(l, gid, ec);
+            cache_address = resolve_gid_impl(gid, ec);
 
             if (ec || hpx::get<0>(cache_address) == naming::invalid_gid)
             {
-                l.unlock();
-
                 HPX_THROWS_IF(ec, no_success, "primary_namespace::route",
                     "can't route parcel to unknown gid: {}", gid);
 
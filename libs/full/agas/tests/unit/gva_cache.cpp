@@ -0,0 +1,194 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify lookups, collisions and CLOCK eviction of the sharded AGAS GVA cache.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/agas/detail/gva_cache.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::agas::gva;
+using hpx::agas::detail::gva_cache;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t const msb = 0x0000000200000001ull;
+gid_type const locality(0x0000000200000000ull, std::uint64_t(0));
+
+gva make_gva(std::uint64_t count, std::uint64_t lva)
+{
+    return gva(locality, 1, count, lva);
+}
+
+void test_lookup()
+{
+    gva_cache cache;
+    cache.reserve(std::size_t(-1));
+
+    gid_type base;
+    std::uint64_t base_count = 0;
+    HPX_TEST(cache.update_entry(
+        gid_type(msb, 2), 10, make_gva(10, 2), base, base_count));
+    HPX_TEST(cache.update_entry(
+        gid_type(msb, 100), 1000, make_gva(1000, 100), base, base_count));
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+
+    // updating the same range succeeds, overlapping ranges collide
+    HPX_TEST(cache.update_entry(
+        gid_type(msb, 2), 10, make_gva(10, 42), base, base_count));
+    HPX_TEST(!cache.update_entry(
+        gid_type(msb, 5), 1, make_gva(1, 5), base, base_count));
+    HPX_TEST_EQ(base, gid_type(msb, 2));
+    HPX_TEST_EQ(base_count, std::uint64_t(10));
+    HPX_TEST(!cache.update_entry(
+        gid_type(msb, 50), 100, make_gva(100, 50), base, base_count));
+    HPX_TEST_EQ(base, gid_type(msb, 100));
+    HPX_TEST_EQ(base_count, std::uint64_t(1000));
+
+    gva g;
+    HPX_TEST(cache.get_entry(gid_type(msb, 11), base, g));
+    HPX_TEST_EQ(base, gid_type(msb, 2));
+    HPX_TEST_EQ(g.lva(), reinterpret_cast<void*>(42));
+    HPX_TEST(cache.get_entry(gid_type(msb, 1099), base, g));
+    HPX_TEST_EQ(base, gid_type(msb, 100));
+    HPX_TEST(!cache.get_entry(gid_type(msb, 12), base, g));
+    HPX_TEST(!cache.get_entry(gid_type(msb, 1100), base, g));
+
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::hits, false),
+        std::int64_t(3));
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::misses, true),
+        std::int64_t(4));
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::misses, false),
+        std::int64_t(0));
+
+    cache.erase_entry(gid_type(msb, 100));
+    HPX_TEST(!cache.get_entry(gid_type(msb, 500), base, g));
+    HPX_TEST_EQ(cache.size(), std::size_t(1));
+
+    cache.clear();
+    HPX_TEST(!cache.get_entry(gid_type(msb, 2), base, g));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+}
+
+void test_eviction()
+{
+    gva_cache cache;
+
+    // nothing is cached without any capacity
+    gid_type base;
+    std::uint64_t base_count = 0;
+    HPX_TEST(cache.update_entry(
+        gid_type(msb, 1), 1, make_gva(1, 1), base, base_count));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+
+    std::size_t const capacity = 256;
+    cache.reserve(capacity);
+
+    // entries which are hit survive a scan over many others
+    gva g;
+    for (std::uint64_t i = 1; i != 10000; ++i)
+    {
+        HPX_TEST(cache.update_entry(
+            gid_type(msb, i), 1, make_gva(1, i), base, base_count));
+        cache.get_entry(gid_type(msb, 1), base, g);
+        HPX_TEST(cache.size() <= capacity);
+    }
+    HPX_TEST(cache.get_entry(gid_type(msb, 1), base, g));
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::evictions, false),
+        std::int64_t(9999 - capacity));
+
+    cache.reserve(capacity / 4);
+    HPX_TEST(cache.size() <= capacity / 4);
+}
+
+// the gids of consecutively created objects map to a few shards only, the
+// cache has to hold as many of them as its capacity allows nevertheless
+void test_capacity()
+{
+    gva_cache cache;
+
+    std::size_t const capacity = HPX_AGAS_LOCAL_CACHE_SIZE;
+    cache.reserve(capacity);
+
+    gid_type base;
+    std::uint64_t base_count = 0;
+    for (std::uint64_t i = 1; i <= capacity; ++i)
+    {
+        HPX_TEST(cache.update_entry(
+            gid_type(msb, i), 1, make_gva(1, i), base, base_count));
+    }
+    HPX_TEST_EQ(cache.size(), capacity);
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::evictions, false),
+        std::int64_t(0));
+
+    gva g;
+    for (std::uint64_t i = 1; i <= capacity; ++i)
+    {
+        HPX_TEST(cache.get_entry(gid_type(msb, i), base, g));
+    }
+
+    // any further entry evicts exactly one other
+    HPX_TEST(cache.update_entry(gid_type(msb, capacity + 1), 1,
+        make_gva(1, capacity + 1), base, base_count));
+    HPX_TEST_EQ(cache.size(), capacity);
+    HPX_TEST_EQ(cache.get_statistics(gva_cache::statistic::evictions, false),
+        std::int64_t(1));
+}
+
+void test_concurrent_access()
+{
+    gva_cache cache;
+    cache.reserve(std::size_t(-1));
+
+    std::size_t const num_tasks = 16;
+    std::uint64_t const num_entries = 2000;
+
+    std::vector<hpx::future<void>> tasks;
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async([&cache, t, num_entries]() {
+            gid_type base;
+            std::uint64_t base_count = 0;
+            gva g;
+            for (std::uint64_t i = 0; i != num_entries; ++i)
+            {
+                gid_type const id(msb, t + i * num_tasks + 1);
+                HPX_TEST(cache.update_entry(
+                    id, 1, make_gva(1, i), base, base_count));
+                HPX_TEST(cache.get_entry(id, base, g));
+                HPX_TEST_EQ(base, id);
+            }
+        }));
+    }
+    hpx::wait_all(tasks);
+
+    HPX_TEST_EQ(cache.size(), num_tasks * num_entries);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_lookup();
+    test_eviction();
+    test_capacity();
+    test_concurrent_access();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
@@ -0,0 +1,146 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/shared_spinlock.hpp>
+#include <hpx/agas_base/gva.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The gid space is split into blocks of 2^gva_block_bits consecutive gids
+    // which are distributed over the shards of the GVA tables.
+    inline constexpr std::size_t gva_block_bits = 6;
+
+    // Return the shard (out of num_shards, a power of two) the block of the
+    // given gid is assigned to.
+    HPX_EXPORT std::size_t get_gva_shard_index(
+        naming::gid_type const& id, std::size_t num_shards) noexcept;
+
+    // Return whether the given range of gids spans more than one block.
+    HPX_EXPORT bool spans_gva_blocks(
+        naming::gid_type const& id, std::uint64_t count) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The table of all GVAs bound in a primary namespace instance.
+    //
+    // Entries are keyed by the first gid of the range they cover. Each block
+    // of gids is hashed onto one of num_shards independently locked shards.
+    // Entries fully contained in a block are stored in that block's shard,
+    // which is the only one a lookup for a gid of the block has to consult.
+    // The rare ranges spanning more than one block are kept in a separate
+    // table which is searched only if it is not empty.
+    class HPX_EXPORT gva_table
+    {
+    public:
+        using data_type = std::pair<gva, naming::gid_type>;
+
+        enum class insert_result
+        {
+            inserted,     // a new entry was created
+            exists,       // an entry with the same base gid exists already
+            contained,    // the gid is covered by an existing range
+        };
+
+        enum class erase_result
+        {
+            erased,
+            not_found,
+            count_mismatch,
+        };
+
+        gva_table();
+
+        gva_table(gva_table const&) = delete;
+        gva_table& operator=(gva_table const&) = delete;
+
+        // Find the entry covering the given gid, return its base gid and
+        // associated data.
+        bool find(naming::gid_type const& id, naming::gid_type& base,
+            data_type& data) const;
+
+        // Bind a new range starting at the given gid.
+        insert_result insert(naming::gid_type const& id, data_type const& data);
+
+        // Call f with the data of the entry whose base gid is equal to the
+        // given gid (if any) while holding the corresponding lock exclusively.
+        template <typename F>
+        bool update(naming::gid_type const& id, F&& f)
+        {
+            {
+                shard& s = get_shard(id);
+                std::lock_guard<shared_spinlock> l(s.mtx_);
+
+                auto it = s.entries_.find(id);
+                if (it != s.entries_.end())
+                {
+                    f(it->second);
+                    return true;
+                }
+            }
+
+            if (num_wide_entries_.load(std::memory_order_acquire) != 0)
+            {
+                std::lock_guard<shared_spinlock> l(wide_entries_.mtx_);
+
+                auto it = wide_entries_.entries_.find(id);
+                if (it != wide_entries_.entries_.end())
+                {
+                    f(it->second);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Remove the entry whose base gid is equal to the given gid, the
+        // number of gids covered by the entry has to match.
+        erase_result erase(
+            naming::gid_type const& id, std::uint64_t count, data_type& data);
+
+    private:
+        using table_type = std::map<naming::gid_type, data_type>;
+
+        static constexpr std::size_t num_shards = 64;
+
+        struct shard_data
+        {
+            mutable shared_spinlock mtx_;
+            table_type entries_;
+        };
+        using shard = util::cache_aligned_data_derived<shard_data>;
+
+        shard& get_shard(naming::gid_type const& id) noexcept
+        {
+            return shards_[get_gva_shard_index(id, num_shards)];
+        }
+        shard const& get_shard(naming::gid_type const& id) const noexcept
+        {
+            return shards_[get_gva_shard_index(id, num_shards)];
+        }
+
+        std::array<shard, num_shards> shards_;
+
+        shard wide_entries_;
+        std::atomic<std::size_t> num_wide_entries_;
+    };
+}}}    // namespace hpx::agas::detail
+
+#include <hpx/config/warnings_suffix.hpp>
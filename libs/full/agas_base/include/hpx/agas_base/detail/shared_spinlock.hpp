@@ -0,0 +1,56 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace agas { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Readers-writer spinlock protecting one shard of the AGAS tables. Any
+    // number of readers may hold the lock concurrently, a pending writer
+    // keeps new readers from entering to avoid being starved.
+    class shared_spinlock
+    {
+    public:
+        shared_spinlock() = default;
+
+        shared_spinlock(shared_spinlock const&) = delete;
+        shared_spinlock& operator=(shared_spinlock const&) = delete;
+
+        HPX_EXPORT void lock();
+        HPX_EXPORT void lock_shared();
+
+        bool try_lock() noexcept
+        {
+            std::uint32_t expected =
+                state_.load(std::memory_order_relaxed) & writer_pending;
+            return state_.compare_exchange_strong(
+                expected, writer, std::memory_order_acquire);
+        }
+
+        void unlock() noexcept
+        {
+            state_.fetch_and(~writer, std::memory_order_release);
+        }
+
+        void unlock_shared() noexcept
+        {
+            state_.fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        static constexpr std::uint32_t writer = 0x80000000;
+        static constexpr std::uint32_t writer_pending = 0x40000000;
+
+        // writer flags in the upper bits, number of readers in the lower bits
+        std::atomic<std::uint32_t> state_{0};
+    };
+}}}    // namespace hpx::agas::detail
@@ -14,6 +14,7 @@
 #include <hpx/actions/transfer_action.hpp>
 #include <hpx/actions_base/component_action.hpp>
 #include <hpx/agas_base/agas_fwd.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
 #include <hpx/agas_base/gva.hpp>
 #include <hpx/allocator_support/internal_allocator.hpp>
 #include <hpx/async_distributed/base_lco_with_value.hpp>
@@ -120,18 +121,18 @@ namespace hpx::agas::server {
         using component_type = std::int32_t;
 
         using gva_table_data_type = std::pair<gva, naming::gid_type>;
-        using gva_table_type = std::map<naming::gid_type, gva_table_data_type>;
+        using gva_table_type = detail::gva_table;
         using refcnt_table_type = std::map<naming::gid_type, std::int64_t>;
 
         using resolved_type =
             hpx::tuple<naming::gid_type, gva, naming::gid_type>;
 
     private:
-        // REVIEW: Separate mutexes might reduce contention here. This has to be
-        // investigated carefully.
-        mutex_type mutex_;
-
+        // The GVA table is sharded and uses its own locks, the remaining
+        // tables are protected by separate mutexes.
         gva_table_type gvas_;
+
+        mutex_type refcnt_mutex_;
         refcnt_table_type refcnts_;
 
         using migration_table_type = std::map<naming::gid_type,
@@ -141,6 +142,8 @@ namespace hpx::agas::server {
         std::string instance_name_;
         naming::gid_type next_id_;     // next available gid
         naming::gid_type locality_;    // our locality id
+
+        mutex_type migration_mutex_;
         migration_table_type migrating_objects_;
 
         struct update_time_on_exit;
@@ -234,14 +237,14 @@ namespace hpx::agas::server {
             const char* func_name);
 #endif
 
-        // helper function
+        // helper functions
+        void wait_for_migration(naming::gid_type const& id, error_code& ec);
         void wait_for_migration_locked(std::unique_lock<mutex_type>& l,
             naming::gid_type const& id, error_code& ec);
 
     public:
         primary_namespace()
           : base_type(agas::primary_ns_msb, agas::primary_ns_lsb)
-          , mutex_()
           , instance_name_()
           , next_id_(naming::invalid_gid)
           , locality_(naming::invalid_gid)
@@ -276,6 +279,10 @@ namespace hpx::agas::server {
 
         resolved_type resolve_gid(naming::gid_type const& id);
 
+        // Resolve a batch of gids managed by this instance at once.
+        std::vector<resolved_type> resolve_gids(
+            std::vector<naming::gid_type> const& ids);
+
         hpx::id_type colocate(naming::gid_type const& id);
 
         naming::address unbind_gid(std::uint64_t count, naming::gid_type id);
@@ -291,7 +298,7 @@ namespace hpx::agas::server {
             std::uint64_t count);
 
     private:
-        resolved_type resolve_gid_locked(std::unique_lock<mutex_type>& l,
+        resolved_type resolve_gid_impl(
             naming::gid_type const& gid, error_code& ec);
 
         void increment(naming::gid_type const& lower,
@@ -318,8 +325,7 @@ namespace hpx::agas::server {
         using free_entry_list_type =
             std::list<free_entry, free_entry_allocator_type>;
 
-        void resolve_free_list(std::unique_lock<mutex_type>& l,
-            std::list<refcnt_table_type::iterator> const& free_list,
+        void resolve_free_list(std::vector<naming::gid_type> const& free_list,
             free_entry_list_type& free_entry_list,
             naming::gid_type const& lower, naming::gid_type const& upper,
             error_code& ec);
@@ -341,6 +347,7 @@ namespace hpx::agas::server {
         HPX_DEFINE_COMPONENT_ACTION(primary_namespace, decrement_credit)
         HPX_DEFINE_COMPONENT_ACTION(primary_namespace, increment_credit)
         HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gid)
+        HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gids)
         HPX_DEFINE_COMPONENT_ACTION(primary_namespace, unbind_gid)
 #if defined(HPX_HAVE_NETWORKING)
         HPX_DEFINE_COMPONENT_ACTION(primary_namespace, route)
@@ -397,6 +404,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::resolve_gid_action,
     primary_namespace_resolve_gid_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::primary_namespace::resolve_gids_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::resolve_gids_action,
+    primary_namespace_resolve_gids_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::primary_namespace::colocate_action)
 
@@ -424,6 +438,9 @@ HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
 typedef hpx::tuple<hpx::naming::gid_type, hpx::agas::gva, hpx::naming::gid_type>
     gva_tuple_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(gva_tuple_type, gva_tuple)
+typedef std::vector<gva_tuple_type> vector_gva_tuple_type;
+HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
+    vector_gva_tuple_type, vector_gva_tuple)
 typedef std::pair<hpx::id_type, hpx::naming::address> std_pair_address_id_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
     std_pair_address_id_type, std_pair_address_id_type)
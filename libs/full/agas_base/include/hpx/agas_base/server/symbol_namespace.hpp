@@ -12,20 +12,25 @@
 #include <hpx/actions/transfer_action.hpp>
 #include <hpx/actions_base/component_action.hpp>
 #include <hpx/agas_base/agas_fwd.hpp>
+#include <hpx/agas_base/detail/shared_spinlock.hpp>
 #include <hpx/async_distributed/base_lco_with_value.hpp>
 #include <hpx/async_distributed/transfer_continuation_action.hpp>
 #include <hpx/components_base/component_type.hpp>
 #include <hpx/components_base/server/fixed_component_base.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/functional/function.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/naming_base/id_type.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -51,16 +56,53 @@ namespace hpx { namespace agas { namespace server {
         using iterate_names_return_type =
             std::map<std::string, naming::gid_type>;
 
-        using gid_table_type =
-            std::map<std::string, std::shared_ptr<naming::gid_type>>;
+        using gid_table_type = std::unordered_map<std::string,
+            std::shared_ptr<naming::gid_type>>;
 
-        using on_event_data_map_type = std::multimap<std::string, hpx::id_type>;
+        using on_event_data_map_type =
+            std::unordered_multimap<std::string, hpx::id_type>;
 
     private:
-        mutex_type mutex_;
-        gid_table_type gids_;
+        // The names are hashed onto independently locked shards. Resolving
+        // a name locks its shard in shared mode only, binding a name locks
+        // just the shard it belongs to. The LCOs waiting for a name to be
+        // bound are kept in the same shard as the name itself.
+        struct shard_data
+        {
+            mutable detail::shared_spinlock mtx_;
+            gid_table_type gids_;
+            on_event_data_map_type on_event_data_;
+        };
+        using shard = util::cache_aligned_data_derived<shard_data>;
+
+        static constexpr std::size_t num_shards = 64;
+
+        static std::size_t get_shard_index(std::string const& key) noexcept;
+
+        shard& get_shard(std::string const& key) noexcept
+        {
+            return shards_[get_shard_index(key)];
+        }
+
+        // Bind the given name, expects its shard to be locked. The LCOs to
+        // notify about a new binding are appended to lcos, the stored gid
+        // is returned in current_gid.
+        bool bind_locked(shard_data& s, std::string const& key,
+            naming::gid_type gid, std::vector<hpx::id_type>& lcos,
+            std::shared_ptr<naming::gid_type>& current_gid);
+
+        // Trigger the given LCO with (a split of) the gid bound to key.
+        void notify(std::string const& key, hpx::id_type const& lco,
+            std::shared_ptr<naming::gid_type> const& current_gid);
+
+        std::array<shard, num_shards> shards_;
+
+        // LCOs waiting for any name starting with a given prefix to be bound
+        mutex_type prefix_watches_mtx_;
+        std::vector<std::pair<std::string, hpx::id_type>> prefix_watches_;
+        std::atomic<std::size_t> num_prefix_watches_;
+
         std::string instance_name_;
-        on_event_data_map_type on_event_data_;
 
     public:
         // data structure holding all counters for the omponent_namespace component
@@ -125,6 +167,7 @@ namespace hpx { namespace agas { namespace server {
     public:
         symbol_namespace()
           : base_type(agas::symbol_ns_msb, agas::symbol_ns_lsb)
+          , num_prefix_watches_(0)
         {
         }
 
@@ -142,20 +185,41 @@ namespace hpx { namespace agas { namespace server {
 
         bool bind(std::string key, naming::gid_type gid);
 
+        // Bind all given names at once, keys[i] is bound to gids[i].
+        std::vector<bool> bind_names(std::vector<std::string> keys,
+            std::vector<naming::gid_type> gids);
+
         naming::gid_type resolve(std::string const& key);
 
         naming::gid_type unbind(std::string const& key);
 
+        std::vector<naming::gid_type> unbind_names(
+            std::vector<std::string> const& keys);
+
         iterate_names_return_type iterate(std::string const& pattern);
 
         bool on_event(std::string const& name, bool call_for_past_events,
             hpx::id_type lco);
 
+        // Trigger the given LCO once any name starting with the given prefix
+        // is bound in this instance.
+        bool on_prefix_event(std::string const& prefix,
+            bool call_for_past_events, hpx::id_type lco);
+
+        // Remove a watch registered using on_prefix_event, returns false if
+        // it has been triggered already.
+        bool cancel_prefix_event(
+            std::string const& prefix, hpx::id_type const& lco);
+
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind)
+        HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind_names)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, unbind)
+        HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, unbind_names)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, iterate)
         HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_event)
+        HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_prefix_event)
+        HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, cancel_prefix_event)
     };
 
 }}}    // namespace hpx::agas::server
@@ -166,6 +230,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::bind_action,
     symbol_namespace_bind_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::bind_names_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::bind_names_action,
+    symbol_namespace_bind_names_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::symbol_namespace::resolve_action)
 
@@ -179,6 +250,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::unbind_action,
     symbol_namespace_unbind_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::unbind_names_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::unbind_names_action,
+    symbol_namespace_unbind_names_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::symbol_namespace::iterate_action)
 
@@ -193,4 +271,18 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::on_event_action,
     symbol_namespace_on_event_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::on_prefix_event_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::on_prefix_event_action,
+    symbol_namespace_on_prefix_event_action)
+
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::cancel_prefix_event_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::cancel_prefix_event_action,
+    symbol_namespace_cancel_prefix_event_action)
+
 #include <hpx/config/warnings_suffix.hpp>
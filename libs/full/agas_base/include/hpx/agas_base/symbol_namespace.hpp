@@ -62,15 +62,32 @@ namespace hpx { namespace agas {
         hpx::future<bool> bind_async(std::string key, naming::gid_type gid);
         bool bind(std::string key, naming::gid_type gid);
 
+        // Bind all given names, using one request for each instance managing
+        // some of the names.
+        hpx::future<std::vector<bool>> bind_async(
+            std::vector<std::string> keys, std::vector<naming::gid_type> gids);
+
         hpx::future<hpx::id_type> resolve_async(std::string key) const;
         hpx::id_type resolve(std::string key) const;
 
         hpx::future<hpx::id_type> unbind_async(std::string key);
         hpx::id_type unbind(std::string key);
 
+        hpx::future<std::vector<hpx::id_type>> unbind_async(
+            std::vector<std::string> keys);
+
         hpx::future<bool> on_event(std::string const& name,
             bool call_for_past_events, hpx::id_type lco);
 
+        // Names starting with the same prefix may be managed by any instance,
+        // prefix watches are registered with one given instance each.
+        hpx::future<bool> on_prefix_event(std::string const& prefix,
+            bool call_for_past_events, hpx::id_type lco,
+            std::uint32_t locality_id);
+
+        void cancel_prefix_event(std::string const& prefix, hpx::id_type lco,
+            std::uint32_t locality_id);
+
         hpx::future<iterate_names_return_type> iterate_async(
             std::string const& pattern) const;
         iterate_names_return_type iterate(std::string const& pattern) const;
@@ -0,0 +1,185 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace hpx { namespace agas { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t get_gva_shard_index(
+        naming::gid_type const& id, std::size_t num_shards) noexcept
+    {
+        std::uint64_t h =
+            (id.get_lsb() >> gva_block_bits) * 0x9e3779b97f4a7c15ull;
+        h ^= id.get_msb() + (h >> 29);
+        return static_cast<std::size_t>(h ^ (h >> 32)) & (num_shards - 1);
+    }
+
+    bool spans_gva_blocks(
+        naming::gid_type const& id, std::uint64_t count) noexcept
+    {
+        if (count <= 1)
+        {
+            return false;
+        }
+
+        naming::gid_type const last = id + (count - 1);
+        return last.get_msb() != id.get_msb() ||
+            (last.get_lsb() >> gva_block_bits) !=
+            (id.get_lsb() >> gva_block_bits);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace {
+
+        // find the entry of the given table covering the given gid
+        template <typename Table>
+        typename Table::const_iterator find_covering(
+            Table const& table, naming::gid_type const& id) noexcept
+        {
+            auto it = table.upper_bound(id);
+            if (it == table.begin())
+            {
+                return table.end();
+            }
+
+            --it;
+            if (it->first == id || it->first + it->second.first.count > id)
+            {
+                return it;
+            }
+            return table.end();
+        }
+    }    // namespace
+
+    gva_table::gva_table()
+      : num_wide_entries_(0)
+    {
+    }
+
+    bool gva_table::find(naming::gid_type const& id, naming::gid_type& base,
+        data_type& data) const
+    {
+        {
+            shard const& s = get_shard(id);
+            std::shared_lock<shared_spinlock> l(s.mtx_);
+
+            auto it = find_covering(s.entries_, id);
+            if (it != s.entries_.end())
+            {
+                base = it->first;
+                data = it->second;
+                return true;
+            }
+        }
+
+        if (num_wide_entries_.load(std::memory_order_acquire) != 0)
+        {
+            std::shared_lock<shared_spinlock> l(wide_entries_.mtx_);
+
+            auto it = find_covering(wide_entries_.entries_, id);
+            if (it != wide_entries_.entries_.end())
+            {
+                base = it->first;
+                data = it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    gva_table::insert_result gva_table::insert(
+        naming::gid_type const& id, data_type const& data)
+    {
+        // the shard is always locked before the table of wide entries
+        shard& s = get_shard(id);
+        std::lock_guard<shared_spinlock> l(s.mtx_);
+
+        auto it = find_covering(s.entries_, id);
+        if (it != s.entries_.end())
+        {
+            return it->first == id ? insert_result::exists :
+                                     insert_result::contained;
+        }
+
+        bool const wide = spans_gva_blocks(id, data.first.count);
+        if (!wide && num_wide_entries_.load(std::memory_order_acquire) == 0)
+        {
+            s.entries_.emplace(id, data);
+            return insert_result::inserted;
+        }
+
+        std::lock_guard<shared_spinlock> wl(wide_entries_.mtx_);
+
+        auto wit = find_covering(wide_entries_.entries_, id);
+        if (wit != wide_entries_.entries_.end())
+        {
+            return wit->first == id ? insert_result::exists :
+                                      insert_result::contained;
+        }
+
+        if (wide)
+        {
+            wide_entries_.entries_.emplace(id, data);
+            num_wide_entries_.fetch_add(1, std::memory_order_release);
+        }
+        else
+        {
+            s.entries_.emplace(id, data);
+        }
+        return insert_result::inserted;
+    }
+
+    gva_table::erase_result gva_table::erase(
+        naming::gid_type const& id, std::uint64_t count, data_type& data)
+    {
+        {
+            shard& s = get_shard(id);
+            std::lock_guard<shared_spinlock> l(s.mtx_);
+
+            auto it = s.entries_.find(id);
+            if (it != s.entries_.end())
+            {
+                if (it->second.first.count != count)
+                {
+                    return erase_result::count_mismatch;
+                }
+
+                data = it->second;
+                s.entries_.erase(it);
+                return erase_result::erased;
+            }
+        }
+
+        if (num_wide_entries_.load(std::memory_order_acquire) != 0)
+        {
+            std::lock_guard<shared_spinlock> l(wide_entries_.mtx_);
+
+            auto it = wide_entries_.entries_.find(id);
+            if (it != wide_entries_.entries_.end())
+            {
+                if (it->second.first.count != count)
+                {
+                    return erase_result::count_mismatch;
+                }
+
+                data = it->second;
+                wide_entries_.entries_.erase(it);
+                num_wide_entries_.fetch_sub(1, std::memory_order_release);
+                return erase_result::erased;
+            }
+        }
+        return erase_result::not_found;
+    }
+}}}    // namespace hpx::agas::detail
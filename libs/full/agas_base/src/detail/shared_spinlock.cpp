@@ -0,0 +1,61 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/agas_base/detail/shared_spinlock.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace agas { namespace detail {
+
+    void shared_spinlock::lock()
+    {
+        std::uint32_t expected = 0;
+        while (!state_.compare_exchange_weak(
+            expected, writer, std::memory_order_acquire))
+        {
+            if (expected & ~writer_pending)
+            {
+                // announce this writer and wait for the lock to be released
+                state_.fetch_or(writer_pending, std::memory_order_relaxed);
+                util::yield_while(
+                    [this]() noexcept {
+                        return (state_.load(std::memory_order_relaxed) &
+                                   ~writer_pending) != 0;
+                    },
+                    "hpx::agas::detail::shared_spinlock::lock");
+            }
+            expected &= writer_pending;
+        }
+    }
+
+    void shared_spinlock::lock_shared()
+    {
+        std::uint32_t expected = state_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (expected & (writer | writer_pending))
+            {
+                util::yield_while(
+                    [this]() noexcept {
+                        return (state_.load(std::memory_order_relaxed) &
+                                   (writer | writer_pending)) != 0;
+                    },
+                    "hpx::agas::detail::shared_spinlock::lock_shared");
+                expected = state_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (state_.compare_exchange_weak(
+                    expected, expected + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+}}}    // namespace hpx::agas::detail
@@ -20,12 +20,10 @@
 #include <hpx/thread_support/assert_owns_lock.hpp>
 #include <hpx/timing/scoped_timer.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
-#include <hpx/util/insert_checked.hpp>
 
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -94,10 +92,10 @@ namespace hpx { namespace agas { namespace server {
         counter_data_.increment_begin_migration_count();
         using hpx::get;
 
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(migration_mutex_);
 
         wait_for_migration_locked(l, id, hpx::throws);
-        resolved_type r = resolve_gid_locked(l, id, hpx::throws);
+        resolved_type r = resolve_gid_impl(id, hpx::throws);
         if (get<0>(r) == naming::invalid_gid)
         {
             l.unlock();
@@ -141,7 +139,7 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.end_migration_.enabled_);
         counter_data_.increment_end_migration_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(migration_mutex_);
 
         using hpx::get;
 
@@ -164,6 +162,13 @@ namespace hpx { namespace agas { namespace server {
     }
 
     // wait if given object is currently being migrated
+    void primary_namespace::wait_for_migration(
+        naming::gid_type const& id, error_code& ec)
+    {
+        std::unique_lock<mutex_type> l(migration_mutex_);
+        wait_for_migration_locked(l, id, ec);
+    }
+
     void primary_namespace::wait_for_migration_locked(
         std::unique_lock<mutex_type>& l, naming::gid_type const& id,
         error_code& ec)
@@ -200,81 +205,94 @@ namespace hpx { namespace agas { namespace server {
         util::scoped_timer<std::atomic<std::int64_t>> update(
             counter_data_.bind_gid_.time_, counter_data_.bind_gid_.enabled_);
         counter_data_.increment_bind_gid_count();
-        using hpx::get;
 
         naming::gid_type gid = id;
         naming::detail::strip_internal_bits_from_gid(id);
 
-        std::unique_lock<mutex_type> l(mutex_);
-
-        gva_table_type::iterator it = gvas_.lower_bound(id),
-                                 begin = gvas_.begin(), end = gvas_.end();
+        bool const non_migratable = naming::refers_to_local_lva(gid) &&
+            !naming::refers_to_virtual_memory(gid);
 
-        if (it != end)
+        enum class update_status
+        {
+            updated,
+            non_migratable,
+            count_mismatch,
+            invalid_type,
+            invalid_locality
+        };
+
+        while (true)
         {
-            // If we got an exact match, this is a request to update an existing
-            // binding (e.g. move semantics).
-            if (it->first == id)
+            // If we got an exact match, this is a request to update an
+            // existing binding (e.g. move semantics).
+            update_status status = update_status::updated;
+            bool const found =
+                gvas_.update(id, [&](gva_table_data_type& data) {
+                    gva& gaddr = data.first;
+
+                    // non-migratable gids can't be rebound, we can't change
+                    // block sizes of existing bindings
+                    if (non_migratable)
+                    {
+                        status = update_status::non_migratable;
+                    }
+                    else if (HPX_UNLIKELY(gaddr.count != g.count))
+                    {
+                        status = update_status::count_mismatch;
+                    }
+                    else if (HPX_UNLIKELY(
+                                 components::component_invalid == g.type))
+                    {
+                        status = update_status::invalid_type;
+                    }
+                    else if (HPX_UNLIKELY(!locality))
+                    {
+                        status = update_status::invalid_locality;
+                    }
+                    else
+                    {
+                        // Store the new endpoint and offset
+                        gaddr.prefix = g.prefix;
+                        gaddr.type = g.type;
+                        gaddr.lva(g.lva());
+                        gaddr.offset = g.offset;
+                        data.second = locality;
+                    }
+                });
+
+            if (found)
             {
-                // non-migratable gids can't be rebound
-                if (naming::refers_to_local_lva(gid) &&
-                    !naming::refers_to_virtual_memory(gid))
+                switch (status)
                 {
-                    l.unlock();
-
+                case update_status::non_migratable:
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "primary_namespace::bind_gid",
                         "cannot rebind gids for non-migratable objects");
 
-                    return false;
-                }
-
-                gva& gaddr = it->second.first;
-                naming::gid_type& loc = it->second.second;
-
-                // Check for count mismatch (we can't change block sizes of
-                // existing bindings).
-                if (HPX_UNLIKELY(gaddr.count != g.count))
-                {
+                case update_status::count_mismatch:
                     // REVIEW: Is this the right error code to use?
-                    l.unlock();
-
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "primary_namespace::bind_gid",
                         "cannot change block size of existing binding");
-                }
-
-                if (HPX_UNLIKELY(components::component_invalid == g.type))
-                {
-                    l.unlock();
 
+                case update_status::invalid_type:
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "primary_namespace::bind_gid",
                         "attempt to update a GVA with an invalid type, "
                         "gid({1}), gva({2}), locality({3})",
                         id, g, locality);
-                }
-
-                if (HPX_UNLIKELY(!locality))
-                {
-                    l.unlock();
 
+                case update_status::invalid_locality:
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "primary_namespace::bind_gid",
                         "attempt to update a GVA with an invalid "
                         "locality id, "
                         "gid({1}), gva({2}), locality({3})",
                         id, g, locality);
-                }
 
-                // Store the new endpoint and offset
-                gaddr.prefix = g.prefix;
-                gaddr.type = g.type;
-                gaddr.lva(g.lva());
-                gaddr.offset = g.offset;
-                loc = locality;
-
-                l.unlock();
+                default:
+                    break;
+                }
 
                 LAGAS_(info).format(
                     "primary_namespace::bind_gid, gid({1}), gva({2}), "
@@ -284,93 +302,59 @@ namespace hpx { namespace agas { namespace server {
                 return false;
             }
 
-            // We're about to decrement the iterator it - first, we
-            // check that it's safe to do this.
-            else if (it != begin)
+            // non-migratable gids don't need to be bound
+            if (non_migratable)
             {
-                --it;
+                LAGAS_(info).format(
+                    "primary_namespace::bind_gid, gid({1}), gva({2}), "
+                    "locality({3})",
+                    gid, g, locality);
 
-                // Check that a previous range doesn't cover the new id.
-                if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-                {
-                    // REVIEW: Is this the right error code to use?
-                    l.unlock();
+                return true;
+            }
 
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "primary_namespace::bind_gid",
-                        "the new GID is contained in an existing range");
-                }
+            naming::gid_type upper_bound(id + (g.count - 1));
+
+            if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
+            {
+                HPX_THROW_EXCEPTION(internal_server_error,
+                    "primary_namespace::bind_gid",
+                    "MSBs of lower and upper range bound do not match");
             }
-        }
 
-        else if (HPX_LIKELY(!gvas_.empty()))
-        {
-            --it;
+            if (HPX_UNLIKELY(components::component_invalid == g.type))
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "primary_namespace::bind_gid",
+                    "attempt to insert a GVA with an invalid type, "
+                    "gid({1}), gva({2}), locality({3})",
+                    id, g, locality);
+            }
 
-            // Check that a previous range doesn't cover the new id.
-            if ((it->first + it->second.first.count) > id)
+            // Insert a GID -> GVA entry into the GVA table.
+            switch (gvas_.insert(id, gva_table_data_type(g, locality)))
             {
+            case gva_table_type::insert_result::contained:
                 // REVIEW: Is this the right error code to use?
-                l.unlock();
-
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "primary_namespace::bind_gid",
                     "the new GID is contained in an existing range");
+
+            case gva_table_type::insert_result::exists:
+                // the gid was bound concurrently, update the new binding
+                continue;
+
+            default:
+                break;
             }
-        }
 
-        // non-migratable gids don't need to be bound
-        if (naming::refers_to_local_lva(gid) &&
-            !naming::refers_to_virtual_memory(gid))
-        {
             LAGAS_(info).format(
                 "primary_namespace::bind_gid, gid({1}), gva({2}), "
                 "locality({3})",
-                gid, g, locality);
-
-            return true;
-        }
-
-        naming::gid_type upper_bound(id + (g.count - 1));
-
-        if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
-        {
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(internal_server_error,
-                "primary_namespace::bind_gid",
-                "MSBs of lower and upper range bound do not match");
-        }
-
-        if (HPX_UNLIKELY(components::component_invalid == g.type))
-        {
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(bad_parameter, "primary_namespace::bind_gid",
-                "attempt to insert a GVA with an invalid type, "
-                "gid({1}), gva({2}), locality({3})",
                 id, g, locality);
-        }
 
-        // Insert a GID -> GVA entry into the GVA table.
-        if (HPX_UNLIKELY(!util::insert_checked(
-                gvas_.insert(std::make_pair(id, std::make_pair(g, locality))))))
-        {
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(lock_error, "primary_namespace::bind_gid",
-                "GVA table insertion failed due to a locking error or "
-                "memory corruption, gid({1}), gva({2}), locality({3})",
-                id, g, locality);
+            return true;
         }
-
-        l.unlock();
-
-        LAGAS_(info).format(
-            "primary_namespace::bind_gid, gid({1}), gva({2}), locality({3})",
-            id, g, locality);
-
-        return true;
     }    // }}}
 
     primary_namespace::resolved_type primary_namespace::resolve_gid(
@@ -382,21 +366,15 @@ namespace hpx { namespace agas { namespace server {
         counter_data_.increment_resolve_gid_count();
         using hpx::get;
 
-        resolved_type r;
-
+        // wait for any migration to be completed
+        if (naming::detail::is_migratable(id))
         {
-            std::unique_lock<mutex_type> l(mutex_);
-
-            // wait for any migration to be completed
-            if (naming::detail::is_migratable(id))
-            {
-                wait_for_migration_locked(l, id, hpx::throws);
-            }
-
-            // now, resolve the id
-            r = resolve_gid_locked(l, id, hpx::throws);
+            wait_for_migration(id, hpx::throws);
         }
 
+        // now, resolve the id
+        resolved_type r = resolve_gid_impl(id, hpx::throws);
+
         if (get<0>(r) == naming::invalid_gid)
         {
             LAGAS_(info).format("primary_namespace::resolve_gid, gid({1}), "
@@ -415,6 +393,19 @@ namespace hpx { namespace agas { namespace server {
         return r;
     }    // }}}
 
+    std::vector<primary_namespace::resolved_type>
+    primary_namespace::resolve_gids(std::vector<naming::gid_type> const& ids)
+    {
+        std::vector<resolved_type> result;
+        result.reserve(ids.size());
+
+        for (naming::gid_type const& id : ids)
+        {
+            result.push_back(resolve_gid(id));
+        }
+        return result;
+    }
+
     hpx::id_type primary_namespace::colocate(naming::gid_type const& id)
     {
         return hpx::id_type(hpx::get<2>(resolve_gid(id)),
@@ -431,25 +422,15 @@ namespace hpx { namespace agas { namespace server {
 
         naming::detail::strip_internal_bits_from_gid(id);
 
-        std::unique_lock<mutex_type> l(mutex_);
-
-        gva_table_type::iterator it = gvas_.find(id), end = gvas_.end();
-
-        if (it != end)
+        gva_table_data_type data;
+        switch (gvas_.erase(id, count, data))
         {
-            if (HPX_UNLIKELY(it->second.first.count != count))
-            {
-                l.unlock();
-
-                HPX_THROW_EXCEPTION(bad_parameter,
-                    "primary_namespace::unbind_gid", "block sizes must match");
-            }
-
-            gva_table_data_type data = it->second;
-
-            gvas_.erase(it);
+        case gva_table_type::erase_result::count_mismatch:
+            HPX_THROW_EXCEPTION(bad_parameter, "primary_namespace::unbind_gid",
+                "block sizes must match");
 
-            l.unlock();
+        case gva_table_type::erase_result::erased:
+        {
             LAGAS_(info).format(
                 "primary_namespace::unbind_gid, gid({1}), count({2}), "
                 "gva({3}), locality_id({4})",
@@ -459,6 +440,10 @@ namespace hpx { namespace agas { namespace server {
             return naming::address(g.prefix, g.type, g.lva());
         }
 
+        default:
+            break;
+        }
+
         // non-migratable gids are not bound
         if (naming::refers_to_local_lva(id) &&
             !naming::refers_to_virtual_memory(id))
@@ -476,8 +461,6 @@ namespace hpx { namespace agas { namespace server {
             return naming::address(g.prefix, g.type, g.lva());
         }
 
-        l.unlock();
-
         LAGAS_(info).format(
             "primary_namespace::unbind_gid, gid({1}), count({2}), "
             "response(no_success)",
@@ -658,7 +641,7 @@ namespace hpx { namespace agas { namespace server {
     void primary_namespace::increment(naming::gid_type const& lower,
         naming::gid_type const& upper, std::int64_t& credits, error_code& ec)
     {    // {{{ increment implementation
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(refcnt_mutex_);
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
         if (LAGAS_ENABLED(debug))
@@ -732,41 +715,30 @@ namespace hpx { namespace agas { namespace server {
     }    // }}}
 
     ///////////////////////////////////////////////////////////////////////////////
-    void primary_namespace::resolve_free_list(std::unique_lock<mutex_type>& l,
-        std::list<refcnt_table_type::iterator> const& free_list,
+    void primary_namespace::resolve_free_list(
+        std::vector<naming::gid_type> const& free_list,
         free_entry_list_type& free_entry_list,
         naming::gid_type const& /* lower */,
         naming::gid_type const& /* upper */, error_code& ec)
     {
-        HPX_ASSERT_OWNS_LOCK(l);
-
         using hpx::get;
 
-        typedef refcnt_table_type::iterator iterator;
-
-        for (iterator const& it : free_list)
+        for (naming::gid_type const& gid : free_list)
         {
-            typedef refcnt_table_type::key_type key_type;
-
-            // The mapping's key space.
-            key_type gid = it->first;
-
             if (naming::detail::is_migratable(gid))
             {
                 // wait for any migration to be completed
-                wait_for_migration_locked(l, gid, ec);
+                wait_for_migration(gid, ec);
             }
 
             // Resolve the query GID.
-            resolved_type r = resolve_gid_locked(l, gid, ec);
+            resolved_type r = resolve_gid_impl(gid, ec);
             if (ec)
                 return;
 
             naming::gid_type& raw = get<0>(r);
             if (raw == naming::invalid_gid)
             {
-                l.unlock();
-
                 HPX_THROWS_IF(ec, internal_server_error,
                     "primary_namespace::resolve_free_list",
                     "primary_namespace::resolve_free_list, failed to resolve "
@@ -781,8 +753,6 @@ namespace hpx { namespace agas { namespace server {
             // REVIEW: Should we do more to make sure the GVA is valid?
             if (HPX_UNLIKELY(components::component_invalid == g.type))
             {
-                l.unlock();
-
                 HPX_THROWS_IF(ec, internal_server_error,
                     "primary_namespace::resolve_free_list",
                     "encountered a GVA with an invalid type while performing a "
@@ -792,8 +762,6 @@ namespace hpx { namespace agas { namespace server {
             }
             else if (HPX_UNLIKELY(0 == g.count))
             {
-                l.unlock();
-
                 HPX_THROWS_IF(ec, internal_server_error,
                     "primary_namespace::resolve_free_list",
                     "encountered a GVA with a count of zero while performing a "
@@ -813,9 +781,6 @@ namespace hpx { namespace agas { namespace server {
             // Add the information needed to destroy these components to the
             // free list.
             free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-            // remove this entry from the refcnt table
-            refcnts_.erase(it);
         }
     }
 
@@ -831,8 +796,10 @@ namespace hpx { namespace agas { namespace server {
 
         free_entry_list.clear();
 
+        std::vector<naming::gid_type> free_list;
+
         {
-            std::unique_lock<mutex_type> l(mutex_);
+            std::unique_lock<mutex_type> l(refcnt_mutex_);
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
             if (LAGAS_ENABLED(debug))
@@ -866,7 +833,6 @@ namespace hpx { namespace agas { namespace server {
             // we know that it's global reference count is the initial global
             // reference count.
 
-            std::list<refcnt_table_type::iterator> free_list;
             for (naming::gid_type raw = lower; raw != upper; ++raw)
             {
                 refcnt_table_type::iterator it = refcnts_.find(raw);
@@ -923,16 +889,21 @@ namespace hpx { namespace agas { namespace server {
                     return;
                 }
 
-                // this objects needs to be deleted
+                // this objects needs to be deleted, remove its entry from
+                // the refcnt table
                 if (it->second == 0)
-                    free_list.push_back(it);
+                {
+                    free_list.push_back(raw);
+                    refcnts_.erase(it);
+                }
             }
-
-            // Resolve the objects which have to be deleted.
-            resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
-
         }    // Unlock the mutex.
 
+        // Resolve the objects which have to be deleted.
+        resolve_free_list(free_list, free_entry_list, lower, upper, ec);
+        if (ec)
+            return;
+
         if (&ec != &throws)
             ec = make_success_code();
     }
@@ -992,12 +963,9 @@ namespace hpx { namespace agas { namespace server {
             ec = make_success_code();
     }    // }}}
 
-    primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
-        std::unique_lock<mutex_type>& l, naming::gid_type const& gid,
-        error_code& ec)
-    {    // {{{ resolve_gid_locked implementation
-        HPX_ASSERT_OWNS_LOCK(l);
-
+    primary_namespace::resolved_type primary_namespace::resolve_gid_impl(
+        naming::gid_type const& gid, error_code& ec)
+    {    // {{{ resolve_gid_impl implementation
         // handle (non-migratable) components located on this locality first
         if (naming::refers_to_local_lva(gid) &&
             !naming::refers_to_virtual_memory(gid))
@@ -1013,75 +981,24 @@ namespace hpx { namespace agas { namespace server {
         naming::gid_type id = gid;
         naming::detail::strip_internal_bits_from_gid(id);
 
-        gva_table_type::const_iterator it = gvas_.lower_bound(id),
-                                       begin = gvas_.begin(), end = gvas_.end();
-
-        if (it != end)
-        {
-            // Check for exact match
-            if (it->first == id)
-            {
-                if (&ec != &throws)
-                    ec = make_success_code();
-
-                gva_table_data_type const& data = it->second;
-                return resolved_type(it->first, data.first, data.second);
-            }
-
-            // We need to decrement the iterator, first we check that it's safe
-            // to do this.
-            else if (it != begin)
-            {
-                --it;
-
-                // Found the GID in a range
-                gva_table_data_type const& data = it->second;
-                if ((it->first + data.first.count) > id)
-                {
-                    if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                    {
-                        l.unlock();
-
-                        HPX_THROWS_IF(ec, internal_server_error,
-                            "primary_namespace::resolve_gid_locked",
-                            "MSBs of lower and upper range bound do not "
-                            "match");
-                        return resolved_type(
-                            naming::invalid_gid, gva(), naming::invalid_gid);
-                    }
-
-                    if (&ec != &throws)
-                        ec = make_success_code();
-
-                    return resolved_type(it->first, data.first, data.second);
-                }
-            }
-        }
-
-        else if (HPX_LIKELY(!gvas_.empty()))
+        naming::gid_type base;
+        gva_table_data_type data;
+        if (gvas_.find(id, base, data))
         {
-            --it;
-
             // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
+            if (HPX_UNLIKELY(id.get_msb() != base.get_msb()))
             {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, internal_server_error,
-                        "primary_namespace::resolve_gid_locked",
-                        "MSBs of lower and upper range bound do not match");
-                    return resolved_type(
-                        naming::invalid_gid, gva(), naming::invalid_gid);
-                }
+                HPX_THROWS_IF(ec, internal_server_error,
+                    "primary_namespace::resolve_gid_impl",
+                    "MSBs of lower and upper range bound do not match");
+                return resolved_type(
+                    naming::invalid_gid, gva(), naming::invalid_gid);
+            }
 
-                if (&ec != &throws)
-                    ec = make_success_code();
+            if (&ec != &throws)
+                ec = make_success_code();
 
-                return resolved_type(it->first, data.first, data.second);
-            }
+            return resolved_type(base, data.first, data.second);
         }
 
         if (&ec != &throws)
@@ -17,20 +17,21 @@
 #include <hpx/modules/format.hpp>
 #include <hpx/naming/credit_handling.hpp>
 #include <hpx/naming/split_gid.hpp>
-#include <hpx/thread_support/unlock_guard.hpp>
 #include <hpx/timing/scoped_timer.hpp>
 #include <hpx/type_support/unused.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
-#include <hpx/util/insert_checked.hpp>
 #include <hpx/util/regex_from_pattern.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <regex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -86,19 +87,35 @@ namespace hpx { namespace agas { namespace server {
         }
     }
 
-    bool symbol_namespace::bind(std::string key, naming::gid_type gid)
-    {    // {{{ bind implementation
-        // parameters
-        util::scoped_timer<std::atomic<std::int64_t>> update(
-            counter_data_.bind_.time_, counter_data_.bind_.enabled_);
-        counter_data_.increment_bind_count();
+    std::size_t symbol_namespace::get_shard_index(
+        std::string const& key) noexcept
+    {
+        return std::hash<std::string>()(key) & (num_shards - 1);
+    }
 
-        std::unique_lock<mutex_type> l(mutex_);
+    void symbol_namespace::notify(std::string const& key,
+        hpx::id_type const& lco,
+        std::shared_ptr<naming::gid_type> const& current_gid)
+    {
+        // split the credit as the receiving end will expect to keep the
+        // object alive
+        naming::gid_type new_gid =
+            naming::detail::split_gid_if_needed(*current_gid).get();
 
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+        // trigger the lco
+        set_lco_value(lco, new_gid);
 
-        if (it != end)
+        LAGAS_(info).format("symbol_namespace::notify, key({1}), "
+                            "stored_gid({2}), new_gid({3})",
+            key, *current_gid, new_gid);
+    }
+
+    bool symbol_namespace::bind_locked(shard_data& s, std::string const& key,
+        naming::gid_type gid, std::vector<hpx::id_type>& lcos,
+        std::shared_ptr<naming::gid_type>& current_gid)
+    {
+        gid_table_type::iterator it = s.gids_.find(key);
+        if (it != s.gids_.end())
         {
             std::int64_t const credits =
                 naming::detail::get_credit_from_gid(gid);
@@ -112,105 +129,102 @@ namespace hpx { namespace agas { namespace server {
             {
                 // REVIEW: do we need to add the credit of the argument to the table?
                 naming::detail::add_credit_to_gid(*(it->second), credits);
-
-                l.unlock();
-                LAGAS_(info).format(
-                    "symbol_namespace::bind, key({1}), gid({2}), "
-                    "old_credit({3}), new_credit({4})",
-                    key, gid,
-                    naming::detail::get_credit_from_gid(*(it->second)),
-                    naming::detail::get_credit_from_gid(*(it->second)) +
-                        credits);
-
+                current_gid = it->second;
                 return true;
             }
-
-            if (LAGAS_ENABLED(info))
-            {
-                naming::detail::add_credit_to_gid(gid, credits);
-
-                l.unlock();
-                LAGAS_(info).format(
-                    "symbol_namespace::bind, key({1}), gid({2}), "
-                    "response(no_success)",
-                    key, gid);
-            }
-
             return false;
         }
 
-        if (HPX_UNLIKELY(!util::insert_checked(gids_.insert(
-                std::make_pair(key, std::make_shared<naming::gid_type>(gid))))))
-        {
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(lock_error, "symbol_namespace::bind",
-                "GID table insertion failed due to a locking error or "
-                "memory corruption");
-        }
+        current_gid = std::make_shared<naming::gid_type>(gid);
+        s.gids_.emplace(key, current_gid);
 
         // handle registered events
-        typedef on_event_data_map_type::iterator iterator;
-        std::pair<iterator, iterator> p = on_event_data_.equal_range(key);
-
-        std::vector<hpx::id_type> lcos;
-        if (p.first != p.second)
+        auto p = s.on_event_data_.equal_range(key);
+        for (auto eit = p.first; eit != p.second; ++eit)
         {
-            iterator it = p.first;
-            while (it != p.second)
-            {
-                lcos.push_back((*it).second);
-                ++it;
-            }
+            lcos.push_back(HPX_MOVE(eit->second));
+        }
+        s.on_event_data_.erase(p.first, p.second);
 
-            on_event_data_.erase(p.first, p.second);
+        // handle registered prefix watches, the counter is checked while
+        // holding the lock of the shard, this ensures that on_prefix_event
+        // either sees this binding or its watch is seen here
+        if (num_prefix_watches_.load(std::memory_order_acquire) != 0)
+        {
+            std::lock_guard<mutex_type> l(prefix_watches_mtx_);
 
-            // notify all LCOS which were registered with this name
-            for (hpx::id_type const& id : lcos)
+            auto wit = prefix_watches_.begin();
+            while (wit != prefix_watches_.end())
             {
-                // re-locate the entry in the GID table for each LCO anew, as we
-                // need to unlock the mutex protecting the table for each iteration
-                // below
-                gid_table_type::iterator gid_it = gids_.find(key);
-                if (gid_it == gids_.end())
+                if (key.compare(0, wit->first.size(), wit->first) == 0)
                 {
-                    l.unlock();
-
-                    HPX_THROW_EXCEPTION(invalid_status,
-                        "symbol_namespace::bind",
-                        "unable to re-locate the entry in the GID table");
+                    lcos.push_back(HPX_MOVE(wit->second));
+                    wit = prefix_watches_.erase(wit);
                 }
-
-                // hold on to the gid while the map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid = gid_it->second;
-
+                else
                 {
-                    util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
+                    ++wit;
+                }
+            }
+            num_prefix_watches_.store(
+                prefix_watches_.size(), std::memory_order_release);
+        }
+        return true;
+    }
 
-                    // split the credit as the receiving end will expect to keep the
-                    // object alive
-                    naming::gid_type new_gid =
-                        naming::detail::split_gid_if_needed(*current_gid).get();
+    bool symbol_namespace::bind(std::string key, naming::gid_type gid)
+    {    // {{{ bind implementation
+        // parameters
+        util::scoped_timer<std::atomic<std::int64_t>> update(
+            counter_data_.bind_.time_, counter_data_.bind_.enabled_);
+        counter_data_.increment_bind_count();
 
-                    // trigger the lco
-                    set_lco_value(id, new_gid);
+        std::vector<hpx::id_type> lcos;
+        std::shared_ptr<naming::gid_type> current_gid;
+        bool result = false;
 
-                    LAGAS_(info).format(
-                        "symbol_namespace::bind, notify: key({1}), "
-                        "stored_gid({2}), new_gid({3})",
-                        key, *current_gid, new_gid);
-                }
-            }
+        {
+            shard& s = get_shard(key);
+            std::lock_guard<detail::shared_spinlock> l(s.mtx_);
+
+            result = bind_locked(s, key, gid, lcos, current_gid);
         }
 
-        l.unlock();
+        // notify all LCOs which were registered with this name
+        for (hpx::id_type const& id : lcos)
+        {
+            notify(key, id, current_gid);
+        }
 
-        LAGAS_(info).format(
-            "symbol_namespace::bind, key({1}), gid({2})", key, gid);
+        LAGAS_(info).format("symbol_namespace::bind, key({1}), gid({2}), "
+                            "response({3})",
+            key, gid, result ? "success" : "no_success");
 
-        return true;
+        return result;
     }    // }}}
 
+    std::vector<bool> symbol_namespace::bind_names(
+        std::vector<std::string> keys, std::vector<naming::gid_type> gids)
+    {
+        if (keys.size() != gids.size())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "symbol_namespace::bind_names",
+                "the number of names ({1}) does not match the number of "
+                "global ids ({2})",
+                keys.size(), gids.size());
+        }
+
+        std::vector<bool> results;
+        results.reserve(keys.size());
+
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            results.push_back(bind(HPX_MOVE(keys[i]), gids[i]));
+        }
+        return results;
+    }
+
     naming::gid_type symbol_namespace::resolve(std::string const& key)
     {    // {{{ resolve implementation
         // parameters
@@ -218,12 +232,21 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.resolve_.time_, counter_data_.resolve_.enabled_);
         counter_data_.increment_resolve_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        // hold on to gid after unlocking the table
+        std::shared_ptr<naming::gid_type> current_gid;
+
+        {
+            shard const& s = get_shard(key);
+            std::shared_lock<detail::shared_spinlock> l(s.mtx_);
 
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+            gid_table_type::const_iterator it = s.gids_.find(key);
+            if (it != s.gids_.end())
+            {
+                current_gid = it->second;
+            }
+        }
 
-        if (it == end)
+        if (!current_gid)
         {
             LAGAS_(info).format(
                 "symbol_namespace::resolve, key({1}), response(no_success)",
@@ -232,11 +255,6 @@ namespace hpx { namespace agas { namespace server {
             return naming::invalid_gid;
         }
 
-        // hold on to gid before unlocking the map
-        std::shared_ptr<naming::gid_type> current_gid(it->second);
-
-        l.unlock();
-
         naming::gid_type gid =
             naming::detail::split_gid_if_needed(*current_gid).get();
 
@@ -253,25 +271,25 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.unbind_.time_, counter_data_.unbind_.enabled_);
         counter_data_.increment_unbind_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
-
-        gid_table_type::iterator it = gids_.find(key);
-        gid_table_type::iterator end = gids_.end();
+        naming::gid_type gid;
 
-        if (it == end)
         {
-            LAGAS_(info).format(
-                "symbol_namespace::unbind, key({1}), response(no_success)",
-                key);
-
-            return naming::invalid_gid;
-        }
+            shard& s = get_shard(key);
+            std::lock_guard<detail::shared_spinlock> l(s.mtx_);
 
-        naming::gid_type const gid = *(it->second);
+            gid_table_type::iterator it = s.gids_.find(key);
+            if (it == s.gids_.end())
+            {
+                LAGAS_(info).format(
+                    "symbol_namespace::unbind, key({1}), response(no_success)",
+                    key);
 
-        gids_.erase(it);
+                return naming::invalid_gid;
+            }
 
-        l.unlock();
+            gid = *(it->second);
+            s.gids_.erase(it);
+        }
 
         LAGAS_(info).format(
             "symbol_namespace::unbind, key({1}), gid({2})", key, gid);
@@ -279,6 +297,19 @@ namespace hpx { namespace agas { namespace server {
         return gid;
     }    // }}}
 
+    std::vector<naming::gid_type> symbol_namespace::unbind_names(
+        std::vector<std::string> const& keys)
+    {
+        std::vector<naming::gid_type> gids;
+        gids.reserve(keys.size());
+
+        for (std::string const& key : keys)
+        {
+            gids.push_back(unbind(key));
+        }
+        return gids;
+    }
+
     // TODO: catch exceptions
     symbol_namespace::iterate_names_return_type symbol_namespace::iterate(
         std::string const& pattern)
@@ -288,45 +319,52 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.iterate_names_.enabled_);
         counter_data_.increment_iterate_names_count();
 
-        std::map<std::string, naming::gid_type> found;
+        // hold on to the matching entries while the table is unlocked
+        std::vector<std::pair<std::string, std::shared_ptr<naming::gid_type>>>
+            entries;
+
+        auto collect = [&](shard const& s, auto&& match) {
+            std::shared_lock<detail::shared_spinlock> l(s.mtx_);
+            for (auto const& e : s.gids_)
+            {
+                if (match(e.first))
+                {
+                    entries.emplace_back(e.first, e.second);
+                }
+            }
+        };
 
         if (pattern.find_first_of("*?[]") != std::string::npos)
         {
             std::string str_rx(util::regex_from_pattern(pattern, throws));
             std::regex rx(str_rx);
 
-            std::unique_lock<mutex_type> l(mutex_);
-            for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-                 ++it)
+            for (shard const& s : shards_)
             {
-                if (!std::regex_match(it->first, rx))
-                    continue;
-
-                // hold on to entry while map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid(it->second);
-                util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
-
-                found[it->first] =
-                    naming::detail::split_gid_if_needed(*current_gid).get();
+                collect(s, [&](std::string const& name) {
+                    return std::regex_match(name, rx);
+                });
             }
         }
-        else
+        else if (pattern.empty())
         {
-            std::unique_lock<mutex_type> l(mutex_);
-            for (gid_table_type::iterator it = gids_.begin(); it != gids_.end();
-                 ++it)
+            for (shard const& s : shards_)
             {
-                if (!pattern.empty() && pattern != it->first)
-                    continue;
-
-                // hold on to entry while map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid(it->second);
-                util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
-
-                found[it->first] =
-                    naming::detail::split_gid_if_needed(*current_gid).get();
+                collect(s, [](std::string const&) { return true; });
             }
         }
+        else
+        {
+            collect(get_shard(pattern),
+                [&](std::string const& name) { return name == pattern; });
+        }
+
+        iterate_names_return_type found;
+        for (auto& e : entries)
+        {
+            found[HPX_MOVE(e.first)] =
+                naming::detail::split_gid_if_needed(*e.second).get();
+        }
 
         LAGAS_(info).format("symbol_namespace::iterate");
 
@@ -340,56 +378,114 @@ namespace hpx { namespace agas { namespace server {
             counter_data_.on_event_.time_, counter_data_.on_event_.enabled_);
         counter_data_.increment_on_event_count();
 
-        std::unique_lock<mutex_type> l(mutex_);
+        // hold on to entry while the table is unlocked
+        std::shared_ptr<naming::gid_type> current_gid;
 
-        bool handled = false;
-        naming::gid_type new_gid;
-
-        if (call_for_past_events)
         {
-            gid_table_type::iterator it = gids_.find(name);
-            if (it != gids_.end())
-            {
-                // hold on to entry while map is unlocked
-                std::shared_ptr<naming::gid_type> current_gid(it->second);
+            shard& s = get_shard(name);
+            std::lock_guard<detail::shared_spinlock> l(s.mtx_);
 
-                // split the credit as the receiving end will expect to keep the
-                // object alive
+            if (call_for_past_events)
+            {
+                gid_table_type::iterator it = s.gids_.find(name);
+                if (it != s.gids_.end())
                 {
-                    util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
-                    new_gid =
-                        naming::detail::split_gid_if_needed(*current_gid).get();
+                    current_gid = it->second;
+                }
+            }
 
-                    // trigger the lco
-                    handled = true;
+            if (!current_gid)
+            {
+                s.on_event_data_.emplace(name, HPX_MOVE(lco));
+            }
+        }
 
-                    // trigger LCO as name is already bound to an id
-                    set_lco_value(lco, new_gid);
+        // trigger LCO as name is already bound to an id
+        if (current_gid)
+        {
+            notify(name, lco, current_gid);
+        }
 
-                    LAGAS_(info).format(
-                        "symbol_namespace::on_event, notify: key({1}), "
-                        "stored_gid({2}), new_gid({3})",
-                        name, *current_gid, new_gid);
+        LAGAS_(info).format("symbol_namespace::on_event: name({1})", name);
+
+        return true;
+    }    // }}}
+
+    bool symbol_namespace::on_prefix_event(
+        std::string const& prefix, bool call_for_past_events, hpx::id_type lco)
+    {
+        util::scoped_timer<std::atomic<std::int64_t>> update(
+            counter_data_.on_event_.time_, counter_data_.on_event_.enabled_);
+        counter_data_.increment_on_event_count();
+
+        // register the watch first to not miss concurrent bindings
+        {
+            std::lock_guard<mutex_type> l(prefix_watches_mtx_);
+
+            prefix_watches_.emplace_back(prefix, lco);
+            num_prefix_watches_.store(
+                prefix_watches_.size(), std::memory_order_release);
+        }
+
+        LAGAS_(info).format(
+            "symbol_namespace::on_prefix_event: prefix({1})", prefix);
+
+        if (!call_for_past_events)
+        {
+            return true;
+        }
+
+        // look for a name bound before the watch was registered
+        std::string key;
+        std::shared_ptr<naming::gid_type> current_gid;
+
+        for (shard const& s : shards_)
+        {
+            std::shared_lock<detail::shared_spinlock> l(s.mtx_);
+            for (auto const& e : s.gids_)
+            {
+                if (e.first.compare(0, prefix.size(), prefix) == 0)
+                {
+                    key = e.first;
+                    current_gid = e.second;
+                    break;
                 }
             }
+
+            if (current_gid)
+            {
+                break;
+            }
         }
 
-        if (!handled)
+        // the watch might have been triggered by a concurrent bind already
+        if (current_gid && cancel_prefix_event(prefix, lco))
         {
-            on_event_data_map_type::iterator it = on_event_data_.insert(
-                on_event_data_map_type::value_type(name, lco));
-
-            // This overload of insert always returns the iterator pointing
-            // to the inserted value. It should never point to end
-            HPX_ASSERT(it != on_event_data_.end());
-            HPX_UNUSED(it);
+            notify(key, lco, current_gid);
         }
-        l.unlock();
+        return true;
+    }
 
-        LAGAS_(info).format("symbol_namespace::on_event: name({1})", name);
+    bool symbol_namespace::cancel_prefix_event(
+        std::string const& prefix, hpx::id_type const& lco)
+    {
+        std::lock_guard<mutex_type> l(prefix_watches_mtx_);
+
+        auto it = std::find_if(prefix_watches_.begin(), prefix_watches_.end(),
+            [&](std::pair<std::string, hpx::id_type> const& watch) {
+                return watch.second == lco && watch.first == prefix;
+            });
 
+        if (it == prefix_watches_.end())
+        {
+            return false;
+        }
+
+        prefix_watches_.erase(it);
+        num_prefix_watches_.store(
+            prefix_watches_.size(), std::memory_order_release);
         return true;
-    }    // }}}
+    }
 
     // access current counter values
     std::int64_t symbol_namespace::counter_data::get_bind_count(bool reset)
@@ -12,14 +12,17 @@
 #include <hpx/agas_base/server/symbol_namespace.hpp>
 #include <hpx/agas_base/symbol_namespace.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/async_combinators/when_all.hpp>
 #include <hpx/async_distributed/base_lco_with_value.hpp>
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/hashing/jenkins_hash.hpp>
 #include <hpx/modules/async_distributed.hpp>
 #include <hpx/type_support/unused.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,6 +38,10 @@ HPX_DEFINE_GET_COMPONENT_TYPE_STATIC(
 HPX_REGISTER_ACTION_ID(symbol_namespace::bind_action,
     symbol_namespace_bind_action, hpx::actions::symbol_namespace_bind_action_id)
 
+HPX_REGISTER_ACTION_ID(symbol_namespace::bind_names_action,
+    symbol_namespace_bind_names_action,
+    hpx::actions::symbol_namespace_bind_names_action_id)
+
 HPX_REGISTER_ACTION_ID(symbol_namespace::resolve_action,
     symbol_namespace_resolve_action,
     hpx::actions::symbol_namespace_resolve_action_id)
@@ -43,6 +50,10 @@ HPX_REGISTER_ACTION_ID(symbol_namespace::unbind_action,
     symbol_namespace_unbind_action,
     hpx::actions::symbol_namespace_unbind_action_id)
 
+HPX_REGISTER_ACTION_ID(symbol_namespace::unbind_names_action,
+    symbol_namespace_unbind_names_action,
+    hpx::actions::symbol_namespace_unbind_names_action_id)
+
 HPX_REGISTER_ACTION_ID(symbol_namespace::iterate_action,
     symbol_namespace_iterate_action,
     hpx::actions::symbol_namespace_iterate_action_id)
@@ -51,8 +62,47 @@ HPX_REGISTER_ACTION_ID(symbol_namespace::on_event_action,
     symbol_namespace_on_event_action,
     hpx::actions::symbol_namespace_on_event_action_id)
 
+HPX_REGISTER_ACTION_ID(symbol_namespace::on_prefix_event_action,
+    symbol_namespace_on_prefix_event_action,
+    hpx::actions::symbol_namespace_on_prefix_event_action_id)
+
+HPX_REGISTER_ACTION_ID(symbol_namespace::cancel_prefix_event_action,
+    symbol_namespace_cancel_prefix_event_action,
+    hpx::actions::symbol_namespace_cancel_prefix_event_action_id)
+
 namespace hpx { namespace agas {
 
+    namespace {
+
+        // wait for all requests sent to the different instances and return
+        // the combined results
+        template <typename T>
+        hpx::future<std::vector<T>> combine_results(
+            std::vector<hpx::future<void>>&& responses,
+            std::shared_ptr<std::vector<T>> results)
+        {
+            return hpx::when_all(responses).then(hpx::launch::sync,
+                [results = HPX_MOVE(results)](
+                    hpx::future<std::vector<hpx::future<void>>>&& f)
+                    -> std::vector<T> {
+                    // rethrow exceptions, if any
+                    for (auto& response : f.get())
+                    {
+                        response.get();
+                    }
+                    return HPX_MOVE(*results);
+                });
+        }
+
+        hpx::id_type make_id(naming::gid_type&& raw_gid)
+        {
+            bool const has_credits = naming::detail::has_credits(raw_gid);
+            return hpx::id_type(HPX_MOVE(raw_gid),
+                has_credits ? hpx::id_type::management_type::managed :
+                              hpx::id_type::management_type::unmanaged);
+        }
+    }    // namespace
+
     naming::gid_type symbol_namespace::get_service_instance(
         std::uint32_t service_locality_id)
     {
@@ -161,6 +211,71 @@ namespace hpx { namespace agas {
 #endif
     }
 
+    hpx::future<std::vector<bool>> symbol_namespace::bind_async(
+        std::vector<std::string> keys, std::vector<naming::gid_type> gids)
+    {
+        HPX_ASSERT(keys.size() == gids.size());
+
+        // group the names by the instance managing them
+        struct request
+        {
+            std::vector<std::string> keys;
+            std::vector<naming::gid_type> gids;
+            std::vector<std::size_t> indices;
+        };
+        std::map<std::uint32_t, request> requests;
+
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            request& r = requests[naming::get_locality_id_from_id(
+                symbol_namespace_locality(keys[i]))];
+            r.keys.push_back(HPX_MOVE(keys[i]));
+            r.gids.push_back(HPX_MOVE(gids[i]));
+            r.indices.push_back(i);
+        }
+
+        auto results = std::make_shared<std::vector<bool>>(keys.size());
+
+        std::vector<hpx::future<void>> responses;
+        responses.reserve(requests.size());
+
+        for (auto& r : requests)
+        {
+            hpx::future<std::vector<bool>> f;
+            if (r.first == agas::get_locality_id())
+            {
+                f = hpx::make_ready_future(server_->bind_names(
+                    HPX_MOVE(r.second.keys), HPX_MOVE(r.second.gids)));
+            }
+            else
+            {
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+                server::symbol_namespace::bind_names_action action;
+                f = hpx::async(action,
+                    hpx::id_type(get_service_instance(r.first),
+                        hpx::id_type::management_type::unmanaged),
+                    HPX_MOVE(r.second.keys), HPX_MOVE(r.second.gids));
+#else
+                HPX_ASSERT(false);
+                f = hpx::make_ready_future(
+                    std::vector<bool>(r.second.indices.size(), true));
+#endif
+            }
+
+            responses.push_back(f.then(hpx::launch::sync,
+                [results, indices = HPX_MOVE(r.second.indices)](
+                    hpx::future<std::vector<bool>>&& f) {
+                    std::vector<bool> bound = f.get();
+                    for (std::size_t i = 0; i != bound.size(); ++i)
+                    {
+                        (*results)[indices[i]] = bound[i];
+                    }
+                }));
+        }
+
+        return combine_results(HPX_MOVE(responses), HPX_MOVE(results));
+    }
+
     hpx::future<hpx::id_type> symbol_namespace::resolve_async(
         std::string key) const
     {
@@ -220,6 +335,76 @@ namespace hpx { namespace agas {
         return unbind_async(HPX_MOVE(key)).get();
     }
 
+    hpx::future<std::vector<hpx::id_type>> symbol_namespace::unbind_async(
+        std::vector<std::string> keys)
+    {
+        // group the names by the instance managing them
+        struct request
+        {
+            std::vector<std::string> keys;
+            std::vector<std::size_t> indices;
+        };
+        std::map<std::uint32_t, request> requests;
+
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            request& r = requests[naming::get_locality_id_from_id(
+                symbol_namespace_locality(keys[i]))];
+            r.keys.push_back(HPX_MOVE(keys[i]));
+            r.indices.push_back(i);
+        }
+
+        auto results =
+            std::make_shared<std::vector<hpx::id_type>>(keys.size());
+
+        std::vector<hpx::future<void>> responses;
+        responses.reserve(requests.size());
+
+        for (auto& r : requests)
+        {
+            hpx::future<std::vector<hpx::id_type>> f;
+            if (r.first == agas::get_locality_id())
+            {
+                std::vector<naming::gid_type> gids =
+                    server_->unbind_names(r.second.keys);
+
+                std::vector<hpx::id_type> ids;
+                ids.reserve(gids.size());
+                for (naming::gid_type& gid : gids)
+                {
+                    ids.push_back(make_id(HPX_MOVE(gid)));
+                }
+                f = hpx::make_ready_future(HPX_MOVE(ids));
+            }
+            else
+            {
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+                server::symbol_namespace::unbind_names_action action;
+                f = hpx::async(action,
+                    hpx::id_type(get_service_instance(r.first),
+                        hpx::id_type::management_type::unmanaged),
+                    HPX_MOVE(r.second.keys));
+#else
+                HPX_ASSERT(false);
+                f = hpx::make_ready_future(
+                    std::vector<hpx::id_type>(r.second.indices.size()));
+#endif
+            }
+
+            responses.push_back(f.then(hpx::launch::sync,
+                [results, indices = HPX_MOVE(r.second.indices)](
+                    hpx::future<std::vector<hpx::id_type>>&& f) {
+                    std::vector<hpx::id_type> ids = f.get();
+                    for (std::size_t i = 0; i != ids.size(); ++i)
+                    {
+                        (*results)[indices[i]] = HPX_MOVE(ids[i]);
+                    }
+                }));
+        }
+
+        return combine_results(HPX_MOVE(responses), HPX_MOVE(results));
+    }
+
     hpx::future<bool> symbol_namespace::on_event(
         std::string const& name, bool call_for_past_events, hpx::id_type lco)
     {
@@ -236,6 +421,44 @@ namespace hpx { namespace agas {
             action, HPX_MOVE(dest), name, call_for_past_events, HPX_MOVE(lco));
 #else
         return hpx::make_ready_future(true);
+#endif
+    }
+
+    hpx::future<bool> symbol_namespace::on_prefix_event(
+        std::string const& prefix, bool call_for_past_events, hpx::id_type lco,
+        std::uint32_t locality_id)
+    {
+        if (locality_id == agas::get_locality_id())
+        {
+            return hpx::make_ready_future(server_->on_prefix_event(
+                prefix, call_for_past_events, HPX_MOVE(lco)));
+        }
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+        hpx::id_type dest(get_service_instance(locality_id),
+            hpx::id_type::management_type::unmanaged);
+
+        server::symbol_namespace::on_prefix_event_action action;
+        return hpx::async(action, HPX_MOVE(dest), prefix, call_for_past_events,
+            HPX_MOVE(lco));
+#else
+        return hpx::make_ready_future(true);
+#endif
+    }
+
+    void symbol_namespace::cancel_prefix_event(std::string const& prefix,
+        hpx::id_type lco, std::uint32_t locality_id)
+    {
+        if (locality_id == agas::get_locality_id())
+        {
+            server_->cancel_prefix_event(prefix, lco);
+            return;
+        }
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+        hpx::id_type dest(get_service_instance(locality_id),
+            hpx::id_type::management_type::unmanaged);
+
+        server::symbol_namespace::cancel_prefix_event_action action;
+        hpx::apply(action, HPX_MOVE(dest), prefix, HPX_MOVE(lco));
 #endif
     }
 }}    // namespace hpx::agas
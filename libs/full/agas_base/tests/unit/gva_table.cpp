@@ -0,0 +1,179 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify binding, resolving and unbinding of ranges in the sharded GVA table
+// used by the primary namespace.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/agas_base/detail/gva_table.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::agas::detail::gva_table;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t const msb = 0x0000000100000001ull;
+gid_type const locality(0x0000000100000000ull, std::uint64_t(0));
+
+gva_table::data_type make_data(std::uint64_t count, std::uint64_t lva)
+{
+    return gva_table::data_type(
+        hpx::agas::gva(locality, 1, count, lva), locality);
+}
+
+void test_single_entries()
+{
+    gva_table table;
+
+    for (std::uint64_t i = 1; i != 1000; ++i)
+    {
+        HPX_TEST(table.insert(gid_type(msb, i), make_data(1, i)) ==
+            gva_table::insert_result::inserted);
+    }
+    HPX_TEST(table.insert(gid_type(msb, 10), make_data(1, 10)) ==
+        gva_table::insert_result::exists);
+
+    gid_type base;
+    gva_table::data_type data;
+    for (std::uint64_t i = 1; i != 1000; ++i)
+    {
+        HPX_TEST(table.find(gid_type(msb, i), base, data));
+        HPX_TEST_EQ(base, gid_type(msb, i));
+        HPX_TEST_EQ(data.first.lva(), reinterpret_cast<void*>(i));
+    }
+    HPX_TEST(!table.find(gid_type(msb, 1000), base, data));
+    HPX_TEST(!table.find(gid_type(msb + 1, 10), base, data));
+
+    HPX_TEST(table.update(gid_type(msb, 20), [](gva_table::data_type& d) {
+        d.first.lva(reinterpret_cast<void*>(42));
+    }));
+    HPX_TEST(table.find(gid_type(msb, 20), base, data));
+    HPX_TEST_EQ(data.first.lva(), reinterpret_cast<void*>(42));
+
+    HPX_TEST(table.erase(gid_type(msb, 20), 2, data) ==
+        gva_table::erase_result::count_mismatch);
+    HPX_TEST(table.erase(gid_type(msb, 20), 1, data) ==
+        gva_table::erase_result::erased);
+    HPX_TEST(table.erase(gid_type(msb, 20), 1, data) ==
+        gva_table::erase_result::not_found);
+    HPX_TEST(!table.find(gid_type(msb, 20), base, data));
+    HPX_TEST(table.find(gid_type(msb, 21), base, data));
+}
+
+void test_ranges()
+{
+    gva_table table;
+
+    // ranges inside a single block of gids and ranges spanning many blocks
+    HPX_TEST(table.insert(gid_type(msb, 2), make_data(10, 2)) ==
+        gva_table::insert_result::inserted);
+    HPX_TEST(table.insert(gid_type(msb, 100), make_data(1000, 100)) ==
+        gva_table::insert_result::inserted);
+    HPX_TEST(table.insert(gid_type(msb, 1100), make_data(1, 1100)) ==
+        gva_table::insert_result::inserted);
+
+    HPX_TEST(table.insert(gid_type(msb, 5), make_data(1, 5)) ==
+        gva_table::insert_result::contained);
+    HPX_TEST(table.insert(gid_type(msb, 500), make_data(1, 500)) ==
+        gva_table::insert_result::contained);
+    HPX_TEST(table.insert(gid_type(msb, 100), make_data(1000, 100)) ==
+        gva_table::insert_result::exists);
+
+    gid_type base;
+    gva_table::data_type data;
+    for (std::uint64_t i = 0; i != 1200; ++i)
+    {
+        bool const found = table.find(gid_type(msb, i), base, data);
+        if (i >= 2 && i < 12)
+        {
+            HPX_TEST(found);
+            HPX_TEST_EQ(base, gid_type(msb, 2));
+        }
+        else if (i >= 100 && i < 1100)
+        {
+            HPX_TEST(found);
+            HPX_TEST_EQ(base, gid_type(msb, 100));
+        }
+        else if (i == 1100)
+        {
+            HPX_TEST(found);
+            HPX_TEST_EQ(base, gid_type(msb, 1100));
+        }
+        else
+        {
+            HPX_TEST(!found);
+        }
+    }
+
+    HPX_TEST(table.erase(gid_type(msb, 100), 1000, data) ==
+        gva_table::erase_result::erased);
+    HPX_TEST(!table.find(gid_type(msb, 500), base, data));
+    HPX_TEST(table.find(gid_type(msb, 1100), base, data));
+}
+
+void test_concurrent_access()
+{
+    gva_table table;
+
+    std::size_t const num_tasks = 16;
+    std::uint64_t const num_entries = 2000;
+
+    std::vector<hpx::future<void>> tasks;
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async([&table, t, num_entries]() {
+            gid_type base;
+            gva_table::data_type data;
+            for (std::uint64_t i = 0; i != num_entries; ++i)
+            {
+                gid_type const id(msb, t + i * num_tasks + 1);
+                HPX_TEST(table.insert(id, make_data(1, i)) ==
+                    gva_table::insert_result::inserted);
+                HPX_TEST(table.find(id, base, data));
+                HPX_TEST_EQ(base, id);
+            }
+            for (std::uint64_t i = 0; i != num_entries; i += 2)
+            {
+                gid_type const id(msb, t + i * num_tasks + 1);
+                HPX_TEST(table.erase(id, 1, data) ==
+                    gva_table::erase_result::erased);
+            }
+        }));
+    }
+    hpx::wait_all(tasks);
+
+    gid_type base;
+    gva_table::data_type data;
+    for (std::uint64_t i = 1; i <= num_tasks * num_entries; ++i)
+    {
+        bool const erased = ((i - 1) / num_tasks) % 2 == 0;
+        HPX_TEST_EQ(table.find(gid_type(msb, i), base, data), !erased);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_single_entries();
+    test_ranges();
+    test_concurrent_access();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
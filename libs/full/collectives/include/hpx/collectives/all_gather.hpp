@@ -35,6 +35,13 @@ namespace hpx { namespace collectives {
     /// \params root_site   The site that is responsible for creating the
     ///                     all_gather support object. This value is optional
     ///                     and defaults to '0' (zero).
+    /// \param  algorithm   The algorithm used to exchange the data between
+    ///                     the sites. This value is optional and defaults to
+    ///                     collective_algorithm::root, which sends all values
+    ///                     through the root site. Any other algorithm
+    ///                     exchanges the data directly between the sites
+    ///                     using a temporary channel communicator (see
+    ///                     below), all sites have to pass the same value.
     ///
     /// \returns    This function returns a future holding a vector with all
     ///             values send by all participating sites. It will become
@@ -46,7 +53,8 @@ namespace hpx { namespace collectives {
         num_sites_arg num_sites = num_sites_arg(),
         this_site_arg this_site = this_site_arg(),
         generation_arg generation = generation_arg(),
-        root_site_arg root_site = root_site_arg());
+        root_site_arg root_site = root_site_arg(),
+        algorithm_arg algorithm = algorithm_arg());
 
     /// AllGather a set of values from different call sites
     ///
@@ -105,6 +113,45 @@ namespace hpx { namespace collectives {
     all_gather(communicator comm, T&& result,
         generation_arg generation,
         this_site_arg this_site = this_site_arg());
+
+    /// AllGather a set of values from different call sites
+    ///
+    /// This function exchanges the values directly between the sites
+    /// connected by the given channel communicator instead of sending all of
+    /// them through a root site. The ring algorithm passes the values around
+    /// a ring of all sites in num_sites-1 steps, the recursive doubling
+    /// algorithm exchanges all values collected so far with a partner site
+    /// in each of its log2(num_sites) steps (it falls back to the ring
+    /// algorithm if the number of sites is not a power of two). Both send
+    /// and receive each value only once per site.
+    ///
+    /// \param  comm        A communicator object returned from
+    ///                     \a create_channel_communicator
+    /// \param  local_result The value to transmit to all
+    ///                     participating sites from this call site.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_gather operation performed on the
+    ///                     given communicator. This is optional and needs to
+    ///                     be supplied only if the all_gather operation on the
+    ///                     given communicator has to be performed more than
+    ///                     once. The generation number (if given) must be a
+    ///                     positive number greater than zero.
+    /// \param  algorithm   The algorithm used to exchange the data between
+    ///                     the sites. This value is optional and defaults to
+    ///                     collective_algorithm::automatic, which selects
+    ///                     the algorithm based on the number of sites only,
+    ///                     as the values contributed by the sites may differ
+    ///                     in size.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             values send by all participating sites. It will become
+    ///             ready once the all_gather operation has been completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<std::decay_t<T>>>
+    all_gather(channel_communicator comm, T&& result,
+        generation_arg generation = generation_arg(),
+        algorithm_arg algorithm = algorithm_arg());
 }}    // namespace hpx::collectives
 
 // clang-format on
@@ -117,12 +164,16 @@ namespace hpx { namespace collectives {
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/async_distributed/async.hpp>
 #include <hpx/collectives/argument_types.hpp>
+#include <hpx/collectives/channel_communicator.hpp>
 #include <hpx/collectives/create_communicator.hpp>
+#include <hpx/collectives/detail/collective_algorithms.hpp>
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/futures/future.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
+#include <limits>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -210,16 +261,98 @@ namespace hpx { namespace collectives {
             HPX_MOVE(fid), HPX_FORWARD(T, local_result), this_site, generation);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // all_gather exchanging the data between all sites
+    template <typename T>
+    hpx::future<std::vector<std::decay_t<T>>> all_gather(
+        channel_communicator comm, T&& local_result,
+        generation_arg generation = generation_arg(),
+        algorithm_arg algorithm = algorithm_arg())
+    {
+        using arg_type = std::decay_t<T>;
+
+        if (generation == 0)
+        {
+            return hpx::make_exceptional_future<std::vector<arg_type>>(
+                HPX_GET_EXCEPTION(hpx::bad_parameter,
+                    "hpx::collectives::all_gather",
+                    "the generation number shouldn't be zero"));
+        }
+
+        // all_gather sends each value only once, thus the algorithms not
+        // involving the root site can be used for any type. The sites may
+        // contribute values of different sizes, the selection must not
+        // depend on them for all sites to agree on the algorithm.
+        collective_algorithm const alg = detail::select_algorithm(algorithm,
+            comm.get_info().first, (std::numeric_limits<std::size_t>::max)(),
+            true);
+
+        return hpx::async(
+            [comm = HPX_MOVE(comm),
+                local_result = arg_type(HPX_FORWARD(T, local_result)),
+                generation, alg]() mutable -> std::vector<arg_type> {
+                return detail::all_gather(
+                    comm, generation, alg, HPX_MOVE(local_result));
+            });
+    }
+
     template <typename T>
     hpx::future<std::vector<std::decay_t<T>>> all_gather(char const* basename,
         T&& local_result, num_sites_arg num_sites = num_sites_arg(),
         this_site_arg this_site = this_site_arg(),
         generation_arg generation = generation_arg(),
-        root_site_arg root_site = root_site_arg())
+        root_site_arg root_site = root_site_arg(),
+        algorithm_arg algorithm = algorithm_arg(collective_algorithm::root))
     {
-        return all_gather(create_communicator(basename, num_sites, this_site,
-                              generation, root_site),
-            HPX_FORWARD(T, local_result), this_site);
+        using arg_type = std::decay_t<T>;
+
+        if (num_sites == std::size_t(-1))
+        {
+            num_sites = static_cast<std::size_t>(
+                agas::get_num_localities(hpx::launch::sync));
+        }
+
+        // see above, the selection must not depend on the local value
+        collective_algorithm const alg = detail::select_algorithm(algorithm,
+            num_sites, (std::numeric_limits<std::size_t>::max)(), true);
+
+        if (alg == collective_algorithm::root)
+        {
+            return all_gather(create_communicator(basename, num_sites,
+                                  this_site, generation, root_site),
+                HPX_FORWARD(T, local_result), this_site);
+        }
+
+        if (generation == 0)
+        {
+            return hpx::make_exceptional_future<std::vector<arg_type>>(
+                HPX_GET_EXCEPTION(hpx::bad_parameter,
+                    "hpx::collectives::all_gather",
+                    "the generation number shouldn't be zero"));
+        }
+
+        // the data is exchanged between all sites, this needs a new
+        // communicator connecting all of them
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+        {
+            name += std::to_string(generation) + "/";
+        }
+
+        return create_channel_communicator(name.c_str(), num_sites, this_site)
+            .then(hpx::launch::async,
+                [local_result = arg_type(HPX_FORWARD(T, local_result)),
+                    generation,
+                    alg](hpx::future<channel_communicator>&& f) mutable {
+                    channel_communicator comm = f.get();
+                    std::vector<arg_type> result = detail::all_gather(
+                        comm, generation, alg, HPX_MOVE(local_result));
+
+                    // the communicator is not reused, unregister its name
+                    // before the result is made available
+                    comm.free();
+                    return result;
+                });
     }
 }}    // namespace hpx::collectives
 
@@ -37,6 +37,13 @@ namespace hpx { namespace collectives {
     /// \params root_site   The site that is responsible for creating the
     ///                     all_reduce support object. This value is optional
     ///                     and defaults to '0' (zero).
+    /// \param  algorithm   The algorithm used to exchange the data between
+    ///                     the sites. This value is optional and defaults to
+    ///                     collective_algorithm::root, which sends all values
+    ///                     through the root site. Any other algorithm
+    ///                     exchanges the data directly between the sites
+    ///                     using a temporary channel communicator (see
+    ///                     below), all sites have to pass the same value.
     ///
     /// \returns    This function returns a future holding a vector with all
     ///             values send by all participating sites. It will become
@@ -47,7 +54,8 @@ namespace hpx { namespace collectives {
         F&& op, num_sites_arg num_sites = num_sites_arg(),
         this_site_arg this_site = this_site_arg(),
         generation_arg generation = generation_arg(),
-        root_site_arg root_site = root_site_arg());
+        root_site_arg root_site = root_site_arg(),
+        algorithm_arg algorithm = algorithm_arg());
 
     /// AllReduce a set of values from different call sites
     ///
@@ -110,6 +118,56 @@ namespace hpx { namespace collectives {
     all_reduce(communicator comm,
         T&& result, F&& op, generation_arg generation,
         this_site_arg this_site = this_site_arg());
+
+    /// AllReduce a set of values from different call sites
+    ///
+    /// This function exchanges the values directly between the sites
+    /// connected by the given channel communicator instead of sending all of
+    /// them through a root site. For large vectors the ring algorithm (each
+    /// site sends and receives 2*(num_sites-1)/num_sites times the size of
+    /// its value in 2*(num_sites-1) steps) and Rabenseifner's recursive
+    /// halving/doubling algorithm (the same amount of data in
+    /// 2*log2(num_sites) steps) split the vectors into chunks that are
+    /// reduced on different sites concurrently.
+    ///
+    /// All sites have to contribute vectors of the same size. The reduction
+    /// operation is applied to (equally sized) sub-ranges of the vectors and
+    /// has to be element-wise, associative, and commutative. Values which
+    /// are not vectors are reduced using recursive doubling if the ring or
+    /// the recursive doubling algorithm is requested.
+    ///
+    /// \param  comm        A communicator object returned from
+    ///                     \a create_channel_communicator
+    /// \param  local_result The value to transmit to all
+    ///                     participating sites from this call site.
+    /// \param  op          Reduction operation to apply to all values supplied
+    ///                     from all participating sites
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_reduce operation performed on the
+    ///                     given communicator. This is optional and needs to
+    ///                     be supplied only if the all_reduce operation on the
+    ///                     given communicator has to be performed more than
+    ///                     once. The generation number (if given) must be a
+    ///                     positive number greater than zero.
+    /// \param  algorithm   The algorithm used to exchange the data between
+    ///                     the sites. This value is optional and defaults to
+    ///                     collective_algorithm::automatic, which selects
+    ///                     the algorithm based on the number of sites and the
+    ///                     size of the data (see the configuration settings
+    ///                     hpx.lcos.collectives.chunked_threshold and
+    ///                     hpx.lcos.collectives.ring_threshold). All sites
+    ///                     have to contribute values of the same size for
+    ///                     them to select the same algorithm.
+    ///
+    /// \returns    This function returns a future holding the reduced
+    ///             value. It will become ready once the all_reduce operation
+    ///             has been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<std::decay_t<T>>
+    all_reduce(channel_communicator comm,
+        T&& result, F&& op, generation_arg generation = generation_arg(),
+        algorithm_arg algorithm = algorithm_arg());
 }}    // namespace hpx::collectives
 
 // clang-format on
@@ -123,13 +181,16 @@ namespace hpx { namespace collectives {
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/async_distributed/async.hpp>
 #include <hpx/collectives/argument_types.hpp>
+#include <hpx/collectives/channel_communicator.hpp>
 #include <hpx/collectives/create_communicator.hpp>
+#include <hpx/collectives/detail/collective_algorithms.hpp>
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/futures/future.hpp>
 #include <hpx/parallel/algorithms/reduce.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -229,16 +290,93 @@ namespace hpx { namespace collectives {
             HPX_FORWARD(F, op), this_site, generation);
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    // all_reduce exchanging the data between all sites
+    template <typename T, typename F>
+    hpx::future<std::decay_t<T>> all_reduce(channel_communicator comm,
+        T&& local_result, F&& op, generation_arg generation = generation_arg(),
+        algorithm_arg algorithm = algorithm_arg())
+    {
+        using arg_type = std::decay_t<T>;
+
+        if (generation == 0)
+        {
+            return hpx::make_exceptional_future<arg_type>(HPX_GET_EXCEPTION(
+                hpx::bad_parameter, "hpx::collectives::all_reduce",
+                "the generation number shouldn't be zero"));
+        }
+
+        collective_algorithm const alg =
+            detail::select_algorithm(algorithm, comm.get_info().first,
+                detail::payload_size(local_result),
+                detail::is_chunkable<arg_type>::value);
+
+        return hpx::async(
+            [comm = HPX_MOVE(comm),
+                local_result = arg_type(HPX_FORWARD(T, local_result)),
+                op = HPX_FORWARD(F, op), generation, alg]() mutable
+            -> arg_type {
+                return detail::all_reduce(
+                    comm, generation, alg, HPX_MOVE(local_result), op);
+            });
+    }
+
     template <typename T, typename F>
     hpx::future<std::decay_t<T>> all_reduce(char const* basename,
         T&& local_result, F&& op, num_sites_arg num_sites = num_sites_arg(),
         this_site_arg this_site = this_site_arg(),
         generation_arg generation = generation_arg(),
-        root_site_arg root_site = root_site_arg())
+        root_site_arg root_site = root_site_arg(),
+        algorithm_arg algorithm = algorithm_arg(collective_algorithm::root))
     {
-        return all_reduce(create_communicator(basename, num_sites, this_site,
-                              generation, root_site),
-            HPX_FORWARD(T, local_result), HPX_FORWARD(F, op), this_site);
+        using arg_type = std::decay_t<T>;
+
+        if (num_sites == std::size_t(-1))
+        {
+            num_sites = static_cast<std::size_t>(
+                agas::get_num_localities(hpx::launch::sync));
+        }
+
+        collective_algorithm const alg = detail::select_algorithm(algorithm,
+            num_sites, detail::payload_size(local_result),
+            detail::is_chunkable<arg_type>::value);
+
+        if (alg == collective_algorithm::root)
+        {
+            return all_reduce(create_communicator(basename, num_sites,
+                                  this_site, generation, root_site),
+                HPX_FORWARD(T, local_result), HPX_FORWARD(F, op), this_site);
+        }
+
+        if (generation == 0)
+        {
+            return hpx::make_exceptional_future<arg_type>(HPX_GET_EXCEPTION(
+                hpx::bad_parameter, "hpx::collectives::all_reduce",
+                "the generation number shouldn't be zero"));
+        }
+
+        // the data is exchanged between all sites, this needs a new
+        // communicator connecting all of them
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+        {
+            name += std::to_string(generation) + "/";
+        }
+
+        return create_channel_communicator(name.c_str(), num_sites, this_site)
+            .then(hpx::launch::async,
+                [local_result = arg_type(HPX_FORWARD(T, local_result)),
+                    op = HPX_FORWARD(F, op), generation,
+                    alg](hpx::future<channel_communicator>&& f) mutable {
+                    channel_communicator comm = f.get();
+                    arg_type result = detail::all_reduce(comm, generation,
+                        alg, HPX_MOVE(local_result), op);
+
+                    // the communicator is not reused, unregister its name
+                    // before the result is made available
+                    comm.free();
+                    return result;
+                });
     }
 }}    // namespace hpx::collectives
 
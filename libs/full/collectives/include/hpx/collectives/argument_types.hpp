@@ -145,4 +145,45 @@ namespace hpx { namespace collectives {
 
         std::size_t tag_;
     };
+
+    /// The algorithms available for the data exchange performed by
+    /// \a all_reduce and \a all_gather.
+    enum class collective_algorithm
+    {
+        /// select one of the algorithms below based on the number of sites
+        /// and on the size of the data contributed by each site
+        automatic = 0,
+        /// all data is sent to the root site which distributes the result
+        root = 1,
+        /// the data is split into chunks which are passed around a ring of
+        /// all sites (bandwidth optimal, 2*(num_sites-1) steps)
+        ring = 2,
+        /// the data is exchanged between pairs of sites whose distance
+        /// doubles (or halves) in each step (log2(num_sites) steps)
+        recursive_doubling = 3
+    };
+
+    struct algorithm_arg
+    {
+        explicit constexpr algorithm_arg(
+            collective_algorithm algorithm =
+                collective_algorithm::automatic) noexcept
+          : algorithm_(algorithm)
+        {
+        }
+
+        constexpr algorithm_arg& operator=(
+            collective_algorithm algorithm) noexcept
+        {
+            algorithm_ = algorithm;
+            return *this;
+        }
+
+        constexpr operator collective_algorithm() const noexcept
+        {
+            return algorithm_;
+        }
+
+        collective_algorithm algorithm_;
+    };
 }}    // namespace hpx::collectives
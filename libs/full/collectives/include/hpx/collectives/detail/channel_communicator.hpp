@@ -60,8 +60,16 @@ namespace hpx { namespace collectives { namespace detail {
                 util::ignore_while_checking il(&l);
                 HPX_UNUSED(il);
 
-                channel_type& c = data_[which].channels_[tag];
-                f = c.get();
+                auto& channels = data_[which].channels_;
+                auto it = channels.try_emplace(tag).first;
+                f = it->second.channel_.get();
+
+                // the channel is not needed anymore once all values that
+                // were sent through it have been received
+                if (--it->second.balance_ == 0)
+                {
+                    channels.erase(it);
+                }
             }
 
             return f.then(
@@ -87,7 +95,15 @@ namespace hpx { namespace collectives { namespace detail {
             util::ignore_while_checking il(&l);
             HPX_UNUSED(il);
 
-            data_[which].channels_[tag].set(HPX_MOVE(value));
+            auto& channels = data_[which].channels_;
+            auto it = channels.try_emplace(tag).first;
+            it->second.channel_.set(HPX_MOVE(value));
+
+            // a pending get operation has been satisfied by this value
+            if (++it->second.balance_ == 0)
+            {
+                channels.erase(it);
+            }
         }
 
         template <typename T>
@@ -100,10 +116,18 @@ namespace hpx { namespace collectives { namespace detail {
         };
 
     private:
+        struct channel_data
+        {
+            channel_type channel_;
+
+            // number of set operations minus number of get operations
+            std::ptrdiff_t balance_ = 0;
+        };
+
         struct locality_data
         {
             hpx::spinlock mtx_;
-            std::map<std::size_t, channel_type> channels_;
+            std::map<std::size_t, channel_data> channels_;
         };
 
         mutable std::vector<locality_data> data_;
@@ -0,0 +1,573 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+
+#include <hpx/assert.hpp>
+#include <hpx/collectives/argument_types.hpp>
+#include <hpx/collectives/channel_communicator.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/functional/invoke.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/type_support/unused.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The algorithms in this file exchange the data directly between the
+// participating sites using a channel_communicator. All of them are meant to
+// be executed on a separate HPX thread as they suspend while waiting for the
+// data sent by other sites.
+namespace hpx { namespace collectives { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Values of these types are split into chunks by the ring and recursive
+    // halving algorithms of all_reduce.
+    template <typename T>
+    struct is_chunkable : std::false_type
+    {
+    };
+
+    template <typename T, typename Allocator>
+    struct is_chunkable<std::vector<T, Allocator>> : std::true_type
+    {
+    };
+
+    template <typename Allocator>
+    struct is_chunkable<std::vector<bool, Allocator>> : std::false_type
+    {
+    };
+
+    // estimated number of bytes sent for the given value
+    template <typename T>
+    std::size_t payload_size(T const& value) noexcept
+    {
+        if constexpr (is_chunkable<T>::value)
+        {
+            return value.size() * sizeof(typename T::value_type);
+        }
+        else
+        {
+            HPX_UNUSED(value);
+            return sizeof(T);
+        }
+    }
+
+    // Resolve collective_algorithm::automatic into a concrete algorithm.
+    // The returned algorithm is the same on all sites as long as all of them
+    // contribute values of the same size.
+    HPX_EXPORT collective_algorithm select_algorithm(
+        collective_algorithm algorithm, std::size_t num_sites,
+        std::size_t payload, bool chunkable);
+
+    // The largest power of two not larger than the given (non-zero) number
+    constexpr std::size_t floor_power_of_two(std::size_t n) noexcept
+    {
+        std::size_t result = 1;
+        while (result <= n / 2)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    constexpr std::size_t floor_log2(std::size_t n) noexcept
+    {
+        std::size_t result = 0;
+        while (n > 1)
+        {
+            n /= 2;
+            ++result;
+        }
+        return result;
+    }
+
+    // The tag used for step 'step' of the operation 'generation'
+    constexpr std::size_t make_tag(
+        std::size_t generation, std::size_t step) noexcept
+    {
+        return ((generation == std::size_t(-1) ? 0 : generation) << 24) + step;
+    }
+
+    // The index of the first element of the given block if 'size' elements
+    // are split into 'num_blocks' blocks of (almost) equal size
+    constexpr std::size_t block_begin(
+        std::size_t block, std::size_t num_blocks, std::size_t size) noexcept
+    {
+        return (size / num_blocks) * block +
+            (std::min)(block, size % num_blocks);
+    }
+
+    template <typename T>
+    T extract_blocks(T const& data, std::size_t first, std::size_t last,
+        std::size_t num_blocks)
+    {
+        std::size_t const size = data.size();
+        return T(data.begin() + block_begin(first, num_blocks, size),
+            data.begin() + block_begin(last, num_blocks, size));
+    }
+
+    template <typename T>
+    void store_blocks(T& data, std::size_t first, std::size_t last,
+        std::size_t num_blocks, T&& blocks)
+    {
+        std::size_t const size = data.size();
+        std::size_t const begin = block_begin(first, num_blocks, size);
+
+        // the blocks are reduced independently of each other, this works
+        // only for element-wise operations applied to values of equal size
+        if (blocks.size() != block_begin(last, num_blocks, size) - begin)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "hpx::collectives::detail::store_blocks",
+                "the ring and recursive halving algorithms require an "
+                "element-wise reduction operation and values of the same "
+                "size on all sites, use collective_algorithm::root instead");
+        }
+
+        std::move(blocks.begin(), blocks.end(), data.begin() + begin);
+    }
+
+    template <typename T, typename F>
+    void reduce_blocks(T& data, std::size_t first, std::size_t last,
+        std::size_t num_blocks, T&& blocks, F& op)
+    {
+        T result = hpx::util::invoke(op,
+            extract_blocks(data, first, last, num_blocks), HPX_MOVE(blocks));
+        store_blocks(data, first, last, num_blocks, HPX_MOVE(result));
+    }
+
+    // Send the value to 'to' and receive a value from 'from' using the same
+    // tag for both
+    template <typename Result, typename T>
+    Result exchange(collectives::channel_communicator const& comm,
+        std::size_t to, std::size_t from, T&& value, std::size_t tag)
+    {
+        hpx::future<void> sent =
+            set(comm, that_site_arg(to), HPX_FORWARD(T, value), tag_arg(tag));
+        Result result =
+            get<Result>(comm, that_site_arg(from), tag_arg(tag)).get();
+        sent.get();
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // all_reduce: all sites send their value to site zero which sends back
+    // the result
+    template <typename T, typename F>
+    T all_reduce_root(collectives::channel_communicator const& comm,
+        std::size_t generation, T&& value, F& op)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        if (this_site != 0)
+        {
+            set(comm, that_site_arg(0), HPX_MOVE(value),
+                tag_arg(make_tag(generation, 0)))
+                .get();
+            return get<T>(comm, that_site_arg(0),
+                tag_arg(make_tag(generation, 1)))
+                .get();
+        }
+
+        for (std::size_t site = 1; site != num_sites; ++site)
+        {
+            value = hpx::util::invoke(op, HPX_MOVE(value),
+                get<T>(comm, that_site_arg(site),
+                    tag_arg(make_tag(generation, 0)))
+                    .get());
+        }
+
+        std::vector<hpx::future<void>> sent;
+        sent.reserve(num_sites - 1);
+        for (std::size_t site = 1; site != num_sites; ++site)
+        {
+            sent.push_back(set(comm, that_site_arg(site), value,
+                tag_arg(make_tag(generation, 1))));
+        }
+        for (hpx::future<void>& f : sent)
+        {
+            f.get();
+        }
+
+        return HPX_MOVE(value);
+    }
+
+    // all_reduce: reduce-scatter followed by an allgather, both passing one
+    // block of the data to the right neighbor in each step
+    template <typename T, typename F>
+    T all_reduce_ring(collectives::channel_communicator const& comm,
+        std::size_t generation, T&& value, F& op)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        std::size_t const right = (this_site + 1) % num_sites;
+        std::size_t const left = (this_site + num_sites - 1) % num_sites;
+
+        // after this, this site holds the fully reduced block this_site + 1
+        for (std::size_t step = 0; step != num_sites - 1; ++step)
+        {
+            std::size_t const send_block =
+                (this_site + num_sites - step) % num_sites;
+            std::size_t const recv_block =
+                (this_site + 2 * num_sites - step - 1) % num_sites;
+
+            reduce_blocks(value, recv_block, recv_block + 1, num_sites,
+                exchange<T>(comm, right, left,
+                    extract_blocks(
+                        value, send_block, send_block + 1, num_sites),
+                    make_tag(generation, step)),
+                op);
+        }
+
+        // distribute the reduced blocks
+        for (std::size_t step = 0; step != num_sites - 1; ++step)
+        {
+            std::size_t const send_block =
+                (this_site + 1 + num_sites - step) % num_sites;
+            std::size_t const recv_block =
+                (this_site + num_sites - step) % num_sites;
+
+            store_blocks(value, recv_block, recv_block + 1, num_sites,
+                exchange<T>(comm, right, left,
+                    extract_blocks(
+                        value, send_block, send_block + 1, num_sites),
+                    make_tag(generation, num_sites + step)));
+        }
+
+        return HPX_MOVE(value);
+    }
+
+    // all_reduce: recursive halving reduce-scatter followed by a recursive
+    // doubling allgather (Rabenseifner's algorithm). The sites beyond the
+    // largest power of two first hand their data to a partner site and
+    // receive the result from it at the end.
+    template <typename T, typename F>
+    T all_reduce_recursive_halving(
+        collectives::channel_communicator const& comm, std::size_t generation,
+        T&& value, F& op)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        std::size_t const num_blocks = floor_power_of_two(num_sites);
+        std::size_t const last_step = 1 + 2 * floor_log2(num_blocks);
+
+        if (this_site >= num_blocks)
+        {
+            set(comm, that_site_arg(this_site - num_blocks), HPX_MOVE(value),
+                tag_arg(make_tag(generation, 0)))
+                .get();
+            return get<T>(comm, that_site_arg(this_site - num_blocks),
+                tag_arg(make_tag(generation, last_step)))
+                .get();
+        }
+
+        if (this_site + num_blocks < num_sites)
+        {
+            value = hpx::util::invoke(op, HPX_MOVE(value),
+                get<T>(comm, that_site_arg(this_site + num_blocks),
+                    tag_arg(make_tag(generation, 0)))
+                    .get());
+        }
+
+        // this site is responsible for the blocks [first, last)
+        std::size_t first = 0;
+        std::size_t last = num_blocks;
+        std::size_t step = 1;
+
+        for (std::size_t mask = num_blocks / 2; mask != 0; mask /= 2, ++step)
+        {
+            std::size_t const middle = first + (last - first) / 2;
+            std::size_t send_first = first;
+            std::size_t send_last = middle;
+            if ((this_site & mask) == 0)
+            {
+                send_first = middle;
+                send_last = last;
+                last = middle;
+            }
+            else
+            {
+                first = middle;
+            }
+
+            reduce_blocks(value, first, last, num_blocks,
+                exchange<T>(comm, this_site ^ mask, this_site ^ mask,
+                    extract_blocks(value, send_first, send_last, num_blocks),
+                    make_tag(generation, step)),
+                op);
+        }
+
+        HPX_ASSERT(first == this_site && last == this_site + 1);
+
+        for (std::size_t mask = 1; mask != num_blocks; mask *= 2, ++step)
+        {
+            // the partner holds the neighboring blocks of the same size
+            std::size_t const count = last - first;
+            std::size_t const recv_first =
+                (this_site & mask) != 0 ? first - count : last;
+
+            store_blocks(value, recv_first, recv_first + count, num_blocks,
+                exchange<T>(comm, this_site ^ mask, this_site ^ mask,
+                    extract_blocks(value, first, last, num_blocks),
+                    make_tag(generation, step)));
+
+            first = (std::min)(first, recv_first);
+            last = (std::max)(last, recv_first + count);
+        }
+
+        HPX_ASSERT(step == last_step);
+
+        if (this_site + num_blocks < num_sites)
+        {
+            set(comm, that_site_arg(this_site + num_blocks), value,
+                tag_arg(make_tag(generation, last_step)))
+                .get();
+        }
+
+        return HPX_MOVE(value);
+    }
+
+    // all_reduce: recursive doubling exchanging the full values, used for
+    // values that can't be split into chunks
+    template <typename T, typename F>
+    T all_reduce_recursive_doubling(
+        collectives::channel_communicator const& comm, std::size_t generation,
+        T&& value, F& op)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        std::size_t const num_blocks = floor_power_of_two(num_sites);
+        std::size_t const last_step = 1 + floor_log2(num_blocks);
+
+        if (this_site >= num_blocks)
+        {
+            set(comm, that_site_arg(this_site - num_blocks), HPX_MOVE(value),
+                tag_arg(make_tag(generation, 0)))
+                .get();
+            return get<T>(comm, that_site_arg(this_site - num_blocks),
+                tag_arg(make_tag(generation, last_step)))
+                .get();
+        }
+
+        if (this_site + num_blocks < num_sites)
+        {
+            value = hpx::util::invoke(op, HPX_MOVE(value),
+                get<T>(comm, that_site_arg(this_site + num_blocks),
+                    tag_arg(make_tag(generation, 0)))
+                    .get());
+        }
+
+        std::size_t step = 1;
+        for (std::size_t mask = 1; mask != num_blocks; mask *= 2, ++step)
+        {
+            std::size_t const partner = this_site ^ mask;
+            T received = exchange<T>(
+                comm, partner, partner, value, make_tag(generation, step));
+
+            // combine the values in the same order on both sites
+            if (this_site < partner)
+            {
+                value = hpx::util::invoke(
+                    op, HPX_MOVE(value), HPX_MOVE(received));
+            }
+            else
+            {
+                value = hpx::util::invoke(
+                    op, HPX_MOVE(received), HPX_MOVE(value));
+            }
+        }
+
+        if (this_site + num_blocks < num_sites)
+        {
+            set(comm, that_site_arg(this_site + num_blocks), value,
+                tag_arg(make_tag(generation, last_step)))
+                .get();
+        }
+
+        return HPX_MOVE(value);
+    }
+
+    template <typename T, typename F>
+    T all_reduce(collectives::channel_communicator const& comm,
+        std::size_t generation, collective_algorithm algorithm, T&& value,
+        F& op)
+    {
+        switch (algorithm)
+        {
+        case collective_algorithm::ring:
+            if constexpr (is_chunkable<T>::value)
+            {
+                if (value.size() >= comm.get_info().first)
+                {
+                    return all_reduce_ring(
+                        comm, generation, HPX_MOVE(value), op);
+                }
+            }
+            return all_reduce_recursive_doubling(
+                comm, generation, HPX_MOVE(value), op);
+
+        case collective_algorithm::recursive_doubling:
+            if constexpr (is_chunkable<T>::value)
+            {
+                if (value.size() >= floor_power_of_two(comm.get_info().first))
+                {
+                    return all_reduce_recursive_halving(
+                        comm, generation, HPX_MOVE(value), op);
+                }
+            }
+            return all_reduce_recursive_doubling(
+                comm, generation, HPX_MOVE(value), op);
+
+        default:
+            break;
+        }
+        return all_reduce_root(comm, generation, HPX_MOVE(value), op);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // all_gather: all sites send their value to site zero which sends back
+    // all values
+    template <typename T>
+    std::vector<T> all_gather_root(
+        collectives::channel_communicator const& comm, std::size_t generation,
+        T&& value)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        if (this_site != 0)
+        {
+            set(comm, that_site_arg(0), HPX_MOVE(value),
+                tag_arg(make_tag(generation, 0)))
+                .get();
+            return get<std::vector<T>>(comm, that_site_arg(0),
+                tag_arg(make_tag(generation, 1)))
+                .get();
+        }
+
+        std::vector<T> result(num_sites);
+        result[0] = HPX_MOVE(value);
+        for (std::size_t site = 1; site != num_sites; ++site)
+        {
+            result[site] = get<T>(comm, that_site_arg(site),
+                tag_arg(make_tag(generation, 0)))
+                               .get();
+        }
+
+        std::vector<hpx::future<void>> sent;
+        sent.reserve(num_sites - 1);
+        for (std::size_t site = 1; site != num_sites; ++site)
+        {
+            sent.push_back(set(comm, that_site_arg(site), result,
+                tag_arg(make_tag(generation, 1))));
+        }
+        for (hpx::future<void>& f : sent)
+        {
+            f.get();
+        }
+
+        return result;
+    }
+
+    // all_gather: each site passes the value it received last to its right
+    // neighbor
+    template <typename T>
+    std::vector<T> all_gather_ring(
+        collectives::channel_communicator const& comm, std::size_t generation,
+        T&& value)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        std::size_t const right = (this_site + 1) % num_sites;
+        std::size_t const left = (this_site + num_sites - 1) % num_sites;
+
+        std::vector<T> result(num_sites);
+        result[this_site] = HPX_MOVE(value);
+
+        for (std::size_t step = 0; step != num_sites - 1; ++step)
+        {
+            std::size_t const send_index =
+                (this_site + num_sites - step) % num_sites;
+            std::size_t const recv_index =
+                (this_site + 2 * num_sites - step - 1) % num_sites;
+
+            result[recv_index] = exchange<T>(comm, right, left,
+                T(result[send_index]), make_tag(generation, step));
+        }
+
+        return result;
+    }
+
+    // all_gather: recursive doubling, each site exchanges all values it has
+    // collected so far with a partner site whose distance doubles in each
+    // step (requires the number of sites to be a power of two)
+    template <typename T>
+    std::vector<T> all_gather_recursive_doubling(
+        collectives::channel_communicator const& comm, std::size_t generation,
+        T&& value)
+    {
+        auto [num_sites, this_site] = comm.get_info();
+        HPX_ASSERT(floor_power_of_two(num_sites) == num_sites);
+
+        std::vector<T> result(num_sites);
+        result[this_site] = HPX_MOVE(value);
+
+        // this site holds the values [first, last)
+        std::size_t first = this_site;
+        std::size_t last = this_site + 1;
+        std::size_t step = 0;
+
+        for (std::size_t mask = 1; mask != num_sites; mask *= 2, ++step)
+        {
+            std::size_t const count = last - first;
+            std::size_t const recv_first =
+                (this_site & mask) != 0 ? first - count : last;
+
+            std::vector<T> received = exchange<std::vector<T>>(comm,
+                this_site ^ mask, this_site ^ mask,
+                std::vector<T>(result.begin() + first, result.begin() + last),
+                make_tag(generation, step));
+
+            HPX_ASSERT(received.size() == count);
+            std::move(received.begin(), received.end(),
+                result.begin() + recv_first);
+
+            first = (std::min)(first, recv_first);
+            last = (std::max)(last, recv_first + count);
+        }
+
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> all_gather(collectives::channel_communicator const& comm,
+        std::size_t generation, collective_algorithm algorithm, T&& value)
+    {
+        switch (algorithm)
+        {
+        case collective_algorithm::recursive_doubling:
+        {
+            std::size_t const num_sites = comm.get_info().first;
+            if (floor_power_of_two(num_sites) == num_sites)
+            {
+                return all_gather_recursive_doubling(
+                    comm, generation, HPX_MOVE(value));
+            }
+            return all_gather_ring(comm, generation, HPX_MOVE(value));
+        }
+
+        case collective_algorithm::ring:
+            return all_gather_ring(comm, generation, HPX_MOVE(value));
+
+        default:
+            break;
+        }
+        return all_gather_root(comm, generation, HPX_MOVE(value));
+    }
+}}}    // namespace hpx::collectives::detail
+
+#endif    // !HPX_COMPUTE_DEVICE_CODE
@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <utility>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -42,6 +43,12 @@ namespace hpx { namespace collectives {
         comm_.reset();
     }
 
+    std::pair<std::size_t, std::size_t> channel_communicator::get_info() const
+        noexcept
+    {
+        return comm_->get_info();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<channel_communicator> create_channel_communicator(
         char const* basename, num_sites_arg num_sites, this_site_arg this_site)
@@ -70,7 +77,8 @@ namespace hpx { namespace collectives {
             hpx::detail::name_from_basename(basename, this_site.this_site_));
 
         return f.then(hpx::launch::sync,
-            [=, target = HPX_MOVE(c)](hpx::future<bool>&& f) mutable {
+            [=, name = std::string(basename), target = HPX_MOVE(c)](
+                hpx::future<bool>&& f) mutable {
                 bool result = f.get();
                 if (!result)
                 {
@@ -82,7 +90,7 @@ namespace hpx { namespace collectives {
                             target.registered_name()));
                 }
                 return channel_communicator(
-                    basename, num_sites, this_site, HPX_MOVE(target));
+                    name.c_str(), num_sites, this_site, HPX_MOVE(target));
             });
     }
 
@@ -0,0 +1,71 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/collectives/argument_types.hpp>
+#include <hpx/collectives/detail/collective_algorithms.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/util/from_string.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace collectives { namespace detail {
+
+    namespace {
+
+        // values smaller than this are sent through the root site [bytes]
+        std::size_t get_chunked_threshold()
+        {
+            static std::size_t const threshold =
+                hpx::util::from_string<std::size_t>(
+                    get_config_entry(
+                        "hpx.lcos.collectives.chunked_threshold", 16384),
+                    16384);
+            return threshold;
+        }
+
+        // values larger than this use the ring algorithms if the number of
+        // sites is not a power of two [bytes]
+        std::size_t get_ring_threshold()
+        {
+            static std::size_t const threshold =
+                hpx::util::from_string<std::size_t>(
+                    get_config_entry(
+                        "hpx.lcos.collectives.ring_threshold", 1048576),
+                    1048576);
+            return threshold;
+        }
+    }    // namespace
+
+    collective_algorithm select_algorithm(collective_algorithm algorithm,
+        std::size_t num_sites, std::size_t payload, bool chunkable)
+    {
+        if (algorithm != collective_algorithm::automatic)
+        {
+            return algorithm;
+        }
+
+        // the data exchanged with the root site is small enough or there is
+        // nothing to gain from splitting it
+        if (num_sites < 2 || !chunkable || payload < get_chunked_threshold())
+        {
+            return collective_algorithm::root;
+        }
+
+        // recursive halving/doubling needs fewer steps, the ring algorithm
+        // sends less data if the number of sites is not a power of two
+        if (floor_power_of_two(num_sites) == num_sites ||
+            payload < get_ring_threshold())
+        {
+            return collective_algorithm::recursive_doubling;
+        }
+        return collective_algorithm::ring;
+    }
+}}}    // namespace hpx::collectives::detail
+
+#endif    // !HPX_COMPUTE_DEVICE_CODE
@@ -0,0 +1,297 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the results of all_reduce and all_gather for all algorithms which
+// exchange the data directly between the participating sites.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace hpx::collectives;
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr char const* collective_algorithms_basename =
+    "/test/collective_algorithms/";
+
+constexpr collective_algorithm algorithms[] = {collective_algorithm::automatic,
+    collective_algorithm::root, collective_algorithm::ring,
+    collective_algorithm::recursive_doubling};
+
+struct plus_elements
+{
+    std::vector<std::uint32_t> operator()(std::vector<std::uint32_t> lhs,
+        std::vector<std::uint32_t> const& rhs) const
+    {
+        HPX_TEST_EQ(lhs.size(), rhs.size());
+        std::transform(lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(),
+            std::plus<std::uint32_t>{});
+        return lhs;
+    }
+};
+
+// each test uses its own set of communicators
+std::string next_basename()
+{
+    static std::size_t count = 0;
+    return collective_algorithms_basename + std::to_string(++count) + "/";
+}
+
+// run the given function for all sites hosted by this locality
+template <typename F>
+void run_sites(std::size_t num_sites, F&& f)
+{
+    std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t here = hpx::get_locality_id();
+    std::string basename = next_basename();
+
+    std::vector<hpx::future<void>> tasks;
+    for (std::size_t site = here; site < num_sites; site += num_localities)
+    {
+        tasks.push_back(hpx::async([&, site]() {
+            auto comm = create_channel_communicator(hpx::launch::sync,
+                basename.c_str(), num_sites_arg(num_sites),
+                this_site_arg(site));
+            f(comm, site);
+        }));
+    }
+    hpx::wait_all(tasks);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_all_reduce(std::size_t num_sites, collective_algorithm algorithm,
+    std::size_t size)
+{
+    run_sites(num_sites, [=](channel_communicator comm, std::size_t site) {
+        for (std::size_t i = 0; i != 5; ++i)
+        {
+            std::vector<std::uint32_t> data(size);
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                data[j] = static_cast<std::uint32_t>(site + i * j);
+            }
+
+            std::vector<std::uint32_t> result =
+                all_reduce(comm, std::move(data), plus_elements{},
+                    generation_arg(i + 1), algorithm_arg(algorithm))
+                    .get();
+
+            HPX_TEST_EQ(result.size(), size);
+            for (std::size_t j = 0; j != result.size(); ++j)
+            {
+                HPX_TEST_EQ(result[j],
+                    static_cast<std::uint32_t>(
+                        num_sites * (num_sites - 1) / 2 + num_sites * i * j));
+            }
+        }
+    });
+}
+
+void test_all_reduce_scalar(
+    std::size_t num_sites, collective_algorithm algorithm)
+{
+    run_sites(num_sites, [=](channel_communicator comm, std::size_t site) {
+        for (std::size_t i = 0; i != 5; ++i)
+        {
+            hpx::future<std::uint32_t> result = all_reduce(comm,
+                static_cast<std::uint32_t>(site + i),
+                std::plus<std::uint32_t>{}, generation_arg(i + 1),
+                algorithm_arg(algorithm));
+
+            HPX_TEST_EQ(result.get(),
+                static_cast<std::uint32_t>(
+                    num_sites * (num_sites - 1) / 2 + num_sites * i));
+        }
+    });
+}
+
+void test_all_gather(std::size_t num_sites, collective_algorithm algorithm,
+    std::size_t size)
+{
+    run_sites(num_sites, [=](channel_communicator comm, std::size_t site) {
+        for (std::size_t i = 0; i != 5; ++i)
+        {
+            std::vector<std::uint32_t> data(
+                size, static_cast<std::uint32_t>(site + i));
+
+            std::vector<std::vector<std::uint32_t>> result =
+                all_gather(comm, std::move(data), generation_arg(i + 1),
+                    algorithm_arg(algorithm))
+                    .get();
+
+            HPX_TEST_EQ(result.size(), num_sites);
+            for (std::size_t j = 0; j != result.size(); ++j)
+            {
+                HPX_TEST(result[j] ==
+                    std::vector<std::uint32_t>(
+                        size, static_cast<std::uint32_t>(j + i)));
+            }
+        }
+    });
+}
+
+// the sites may contribute values of different sizes to all_gather
+void test_all_gather_sizes(
+    std::size_t num_sites, collective_algorithm algorithm)
+{
+    run_sites(num_sites, [=](channel_communicator comm, std::size_t site) {
+        std::vector<std::uint32_t> data(
+            site * 10000, static_cast<std::uint32_t>(site));
+
+        std::vector<std::vector<std::uint32_t>> result =
+            all_gather(comm, std::move(data), generation_arg(1),
+                algorithm_arg(algorithm))
+                .get();
+
+        HPX_TEST_EQ(result.size(), num_sites);
+        for (std::size_t j = 0; j != result.size(); ++j)
+        {
+            HPX_TEST(result[j] ==
+                std::vector<std::uint32_t>(
+                    j * 10000, static_cast<std::uint32_t>(j)));
+        }
+    });
+}
+
+// the chunked algorithms reject operations which are not element-wise
+struct concatenate
+{
+    std::vector<std::uint32_t> operator()(std::vector<std::uint32_t> lhs,
+        std::vector<std::uint32_t> const& rhs) const
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+    }
+};
+
+void test_all_reduce_concatenate(std::size_t num_sites)
+{
+    run_sites(num_sites, [=](channel_communicator comm, std::size_t site) {
+        std::vector<std::uint32_t> data(
+            2 * num_sites, static_cast<std::uint32_t>(site));
+
+        HPX_TEST_THROW(all_reduce(comm, std::move(data), concatenate{},
+                           generation_arg(1),
+                           algorithm_arg(collective_algorithm::ring))
+                           .get(),
+            hpx::exception);
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the basename based API uses the root site unless told otherwise, any other
+// algorithm creates a channel communicator which is released afterwards
+void test_name_released(
+    std::string const& basename, std::size_t generation, std::uint32_t here)
+{
+    std::string const name = hpx::detail::name_from_basename(
+        basename + std::to_string(generation) + "/", here);
+    HPX_TEST_EQ(
+        hpx::agas::resolve_name(hpx::launch::sync, name), hpx::invalid_id);
+}
+
+void test_all_reduce_basename(
+    std::size_t size, collective_algorithm algorithm)
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t here = hpx::get_locality_id();
+    std::string basename = next_basename();
+
+    for (std::size_t i = 0; i != 5; ++i)
+    {
+        std::vector<std::uint32_t> data(size, here);
+
+        hpx::future<std::vector<std::uint32_t>> result =
+            all_reduce(basename.c_str(), std::move(data), plus_elements{},
+                num_sites_arg(num_localities), this_site_arg(here),
+                generation_arg(i + 1), root_site_arg(),
+                algorithm_arg(algorithm));
+
+        HPX_TEST(result.get() ==
+            std::vector<std::uint32_t>(
+                size, num_localities * (num_localities - 1) / 2));
+
+        test_name_released(basename, i + 1, here);
+    }
+}
+
+void test_all_gather_basename(
+    std::size_t size, collective_algorithm algorithm)
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t here = hpx::get_locality_id();
+    std::string basename = next_basename();
+
+    for (std::size_t i = 0; i != 5; ++i)
+    {
+        std::vector<std::uint32_t> data(size, here);
+
+        std::vector<std::vector<std::uint32_t>> result =
+            all_gather(basename.c_str(), std::move(data),
+                num_sites_arg(num_localities), this_site_arg(here),
+                generation_arg(i + 1), root_site_arg(),
+                algorithm_arg(algorithm))
+                .get();
+
+        HPX_TEST_EQ(result.size(), std::size_t(num_localities));
+        for (std::uint32_t j = 0; j != result.size(); ++j)
+        {
+            HPX_TEST(result[j] == std::vector<std::uint32_t>(size, j));
+        }
+
+        test_name_released(basename, i + 1, here);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (std::size_t num_sites : {1, 3, 4, 6})
+    {
+        for (collective_algorithm algorithm : algorithms)
+        {
+            // fewer elements than sites, small and large vectors
+            for (std::size_t size : {3, 100, 20000})
+            {
+                test_all_reduce(num_sites, algorithm, size);
+                test_all_gather(num_sites, algorithm, size);
+            }
+            test_all_reduce_scalar(num_sites, algorithm);
+            test_all_gather_sizes(num_sites, algorithm);
+        }
+    }
+
+    test_all_reduce_concatenate(3);
+
+    for (collective_algorithm algorithm : algorithms)
+    {
+        for (std::size_t size : {10, 20000})
+        {
+            test_all_reduce_basename(size, algorithm);
+            test_all_gather_basename(size, algorithm);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
@@ -49,6 +49,11 @@ namespace hpx { namespace agas {
     HPX_EXPORT hpx::future<bool> register_name(
         std::string const& name, hpx::id_type const& id);
 
+    // Register all given names at once, names[i] is associated with ids[i].
+    HPX_EXPORT hpx::future<std::vector<bool>> register_names(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids);
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT hpx::id_type unregister_name(
         launch::sync_policy, std::string const& name, error_code& ec = throws);
@@ -56,6 +61,9 @@ namespace hpx { namespace agas {
     HPX_EXPORT hpx::future<hpx::id_type> unregister_name(
         std::string const& name);
 
+    HPX_EXPORT hpx::future<std::vector<hpx::id_type>> unregister_names(
+        std::vector<std::string> const& names);
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT hpx::id_type resolve_name(
         launch::sync_policy, std::string const& name, error_code& ec = throws);
@@ -152,6 +160,11 @@ namespace hpx { namespace agas {
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT hpx::future<naming::address> resolve(hpx::id_type const& id);
 
+    // Resolve all given ids at once, the ids not found in the local cache
+    // are resolved using one request per managing locality.
+    HPX_EXPORT hpx::future<std::vector<naming::address>> resolve(
+        std::vector<hpx::id_type> const& ids);
+
     HPX_EXPORT naming::address resolve(
         launch::sync_policy, hpx::id_type const& id, error_code& ec = throws);
 
@@ -247,6 +260,11 @@ namespace hpx { namespace agas {
     HPX_EXPORT hpx::future<hpx::id_type> on_symbol_namespace_event(
         std::string const& name, bool call_for_past_events);
 
+    // The returned future becomes ready once any name starting with the
+    // given prefix is registered.
+    HPX_EXPORT hpx::future<hpx::id_type> on_symbol_namespace_prefix_event(
+        std::string const& prefix, bool call_for_past_events);
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT hpx::future<std::pair<hpx::id_type, naming::address>>
     begin_migration(hpx::id_type const& id);
@@ -40,6 +40,10 @@ namespace hpx { namespace agas { namespace detail {
     extern HPX_EXPORT future<bool> (*register_name_async)(
         std::string const& name, hpx::id_type const& id);
 
+    extern HPX_EXPORT future<std::vector<bool>> (*register_names_async)(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids);
+
     ///////////////////////////////////////////////////////////////////////////
     extern HPX_EXPORT hpx::id_type (*unregister_name)(
         std::string const& name, error_code& ec);
@@ -47,6 +51,9 @@ namespace hpx { namespace agas { namespace detail {
     extern HPX_EXPORT future<hpx::id_type> (*unregister_name_async)(
         std::string const& name);
 
+    extern HPX_EXPORT future<std::vector<hpx::id_type>> (
+        *unregister_names_async)(std::vector<std::string> const& names);
+
     ///////////////////////////////////////////////////////////////////////////
     extern HPX_EXPORT hpx::id_type (*resolve_name)(
         std::string const& name, error_code& ec);
@@ -111,6 +118,9 @@ namespace hpx { namespace agas { namespace detail {
     extern HPX_EXPORT hpx::future<naming::address> (*resolve_async)(
         hpx::id_type const& id);
 
+    extern HPX_EXPORT hpx::future<std::vector<naming::address>> (
+        *resolve_bulk_async)(std::vector<hpx::id_type> const& ids);
+
     extern HPX_EXPORT naming::address (*resolve)(
         hpx::id_type const& id, error_code& ec);
 
@@ -198,6 +208,10 @@ namespace hpx { namespace agas { namespace detail {
     extern HPX_EXPORT hpx::future<hpx::id_type> (*on_symbol_namespace_event)(
         std::string const& name, bool call_for_past_events);
 
+    extern HPX_EXPORT hpx::future<hpx::id_type> (
+        *on_symbol_namespace_prefix_event)(
+        std::string const& prefix, bool call_for_past_events);
+
     ///////////////////////////////////////////////////////////////////////////
     extern HPX_EXPORT hpx::future<std::pair<hpx::id_type, naming::address>> (
         *begin_migration)(hpx::id_type const& id);
@@ -52,6 +52,13 @@ namespace hpx { namespace agas {
         return detail::register_name_async(name, id);
     }
 
+    hpx::future<std::vector<bool>> register_names(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids)
+    {
+        return detail::register_names_async(names, ids);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::id_type unregister_name(
         launch::sync_policy, std::string const& name, error_code& ec)
@@ -64,6 +71,12 @@ namespace hpx { namespace agas {
         return detail::unregister_name_async(name);
     }
 
+    hpx::future<std::vector<hpx::id_type>> unregister_names(
+        std::vector<std::string> const& names)
+    {
+        return detail::unregister_names_async(names);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<hpx::id_type> resolve_name(std::string const& name)
     {
@@ -145,6 +158,12 @@ namespace hpx { namespace agas {
         return detail::resolve_async(id);
     }
 
+    hpx::future<std::vector<naming::address>> resolve(
+        std::vector<hpx::id_type> const& ids)
+    {
+        return detail::resolve_bulk_async(ids);
+    }
+
     naming::address resolve(
         launch::sync_policy, hpx::id_type const& id, error_code& ec)
     {
@@ -330,6 +349,13 @@ namespace hpx { namespace agas {
         return detail::on_symbol_namespace_event(name, call_for_past_events);
     }
 
+    hpx::future<hpx::id_type> on_symbol_namespace_prefix_event(
+        std::string const& prefix, bool call_for_past_events)
+    {
+        return detail::on_symbol_namespace_prefix_event(
+            prefix, call_for_past_events);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<std::pair<hpx::id_type, naming::address>> begin_migration(
         hpx::id_type const& id)
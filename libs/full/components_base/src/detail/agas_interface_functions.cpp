@@ -41,6 +41,10 @@ namespace hpx { namespace agas { namespace detail {
     future<bool> (*register_name_async)(
         std::string const& name, hpx::id_type const& id) = nullptr;
 
+    future<std::vector<bool>> (*register_names_async)(
+        std::vector<std::string> const& names,
+        std::vector<hpx::id_type> const& ids) = nullptr;
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::id_type (*unregister_name)(
         std::string const& name, error_code& ec) = nullptr;
@@ -48,6 +52,9 @@ namespace hpx { namespace agas { namespace detail {
     future<hpx::id_type> (*unregister_name_async)(
         std::string const& name) = nullptr;
 
+    future<std::vector<hpx::id_type>> (*unregister_names_async)(
+        std::vector<std::string> const& names) = nullptr;
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::id_type (*resolve_name)(
         std::string const& name, error_code& ec) = nullptr;
@@ -108,6 +115,9 @@ namespace hpx { namespace agas { namespace detail {
     hpx::future<naming::address> (*resolve_async)(
         hpx::id_type const& id) = nullptr;
 
+    hpx::future<std::vector<naming::address>> (*resolve_bulk_async)(
+        std::vector<hpx::id_type> const& ids) = nullptr;
+
     naming::address (*resolve)(
         hpx::id_type const& id, error_code& ec) = nullptr;
 
@@ -193,6 +203,9 @@ namespace hpx { namespace agas { namespace detail {
     hpx::future<hpx::id_type> (*on_symbol_namespace_event)(
         std::string const& name, bool call_for_past_events) = nullptr;
 
+    hpx::future<hpx::id_type> (*on_symbol_namespace_prefix_event)(
+        std::string const& prefix, bool call_for_past_events) = nullptr;
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<std::pair<hpx::id_type, naming::address>> (*begin_migration)(
         hpx::id_type const& id) = nullptr;
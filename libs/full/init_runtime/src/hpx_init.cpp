@@ -340,7 +340,13 @@ namespace hpx {
     defined(__FreeBSD__)
             threads::coroutines::detail::posix::use_guard_pages =
                 cmdline.rtcfg_.use_stack_guard_pages();
+            threads::coroutines::detail::posix::use_stack_arena =
+                cmdline.rtcfg_.use_stack_arena();
+            threads::coroutines::detail::posix::stack_arena_high_water_mark =
+                cmdline.rtcfg_.get_stack_arena_high_water_mark();
 #endif
+            lcos::detail::continuation_placement_enabled =
+                cmdline.rtcfg_.use_continuation_placement();
 #ifdef HPX_HAVE_VERIFY_LOCKS
             if (cmdline.rtcfg_.enable_lock_detection())
             {
@@ -61,7 +61,8 @@ namespace hpx::parcelset::policies::mpi {
             data.time_ = timer_.elapsed_nanoseconds();
             data.bytes_ = static_cast<std::size_t>(header_.numbytes());
 #endif
-            buffer_.data_.resize(static_cast<std::size_t>(header_.size()));
+            pp_.get_buffer_pool().resize(
+                buffer_.data_, static_cast<std::size_t>(header_.size()));
             buffer_.num_chunks_ = header_.num_chunks();
         }
 
@@ -159,7 +160,7 @@ namespace hpx::parcelset::policies::mpi {
                     buffer_.transmission_chunks_[idx].second;
 
                 data_type& c = buffer_.chunks_[idx];
-                c.resize(chunk_size);
+                pp_.get_buffer_pool().resize(c, chunk_size);
                 {
                     util::mpi_environment::scoped_lock l;
                     MPI_Irecv(c.data(), static_cast<int>(c.size()), MPI_BYTE,
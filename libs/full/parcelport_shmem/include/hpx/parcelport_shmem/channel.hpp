@@ -0,0 +1,74 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/assert.hpp>
+
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // A channel represents the ring this locality has claimed in the segment
+    // of one destination. All connections to that destination share the
+    // channel, a connection has to acquire the channel before writing a
+    // message and releases it once the whole message has been written. This
+    // keeps each ring single-producer without blocking: a connection which
+    // fails to acquire the channel simply retries during the next round of
+    // background work.
+    class channel
+    {
+    public:
+        channel(std::shared_ptr<segment> s, ring_buffer ring) noexcept
+          : segment_(HPX_MOVE(s))
+          , ring_(ring)
+          , busy_(false)
+        {
+            HPX_ASSERT(segment_ && ring_);
+        }
+
+        channel(channel const&) = delete;
+        channel& operator=(channel const&) = delete;
+
+        ~channel()
+        {
+            segment::release_ring(ring_);
+        }
+
+        bool try_acquire() noexcept
+        {
+            return !busy_.load(std::memory_order_relaxed) &&
+                !busy_.exchange(true, std::memory_order_acquire);
+        }
+
+        void release() noexcept
+        {
+            HPX_ASSERT(busy_.load(std::memory_order_relaxed));
+            busy_.store(false, std::memory_order_release);
+        }
+
+        ring_buffer& ring() noexcept
+        {
+            return ring_;
+        }
+
+    private:
+        // keeps the mapping of the destination's segment alive
+        std::shared_ptr<segment> segment_;
+        ring_buffer ring_;
+        std::atomic<bool> busy_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
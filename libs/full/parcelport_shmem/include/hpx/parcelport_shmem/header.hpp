@@ -0,0 +1,65 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/parcelset/parcel_buffer.hpp>
+
+#include <cstdint>
+#include <utility>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // Every message written to a ring starts with a header describing the
+    // sizes of the parts following it: the transmission chunks (if there are
+    // any zero-copy chunks), the main data buffer, and the zero-copy chunks.
+    struct header
+    {
+        header() noexcept
+          : size_(0)
+          , numbytes_(0)
+          , num_zero_copy_chunks_(0)
+          , num_non_zero_copy_chunks_(0)
+        {
+        }
+
+        template <typename Buffer>
+        explicit header(Buffer const& buffer) noexcept
+          : size_(buffer.size_)
+          , numbytes_(buffer.data_size_)
+          , num_zero_copy_chunks_(buffer.num_chunks_.first)
+          , num_non_zero_copy_chunks_(buffer.num_chunks_.second)
+        {
+        }
+
+        std::uint64_t size() const noexcept
+        {
+            return size_;
+        }
+
+        std::uint64_t numbytes() const noexcept
+        {
+            return numbytes_;
+        }
+
+        std::pair<std::uint32_t, std::uint32_t> num_chunks() const noexcept
+        {
+            return std::make_pair(
+                num_zero_copy_chunks_, num_non_zero_copy_chunks_);
+        }
+
+    private:
+        std::uint64_t size_;
+        std::uint64_t numbytes_;
+        std::uint32_t num_zero_copy_chunks_;
+        std::uint32_t num_non_zero_copy_chunks_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
@@ -0,0 +1,81 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/modules/serialization.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // A shared memory endpoint is identified by the name of the host the
+    // locality runs on and by the id of its process. The process id is used
+    // to derive the name of the shared memory segment the locality receives
+    // parcels through.
+    class locality
+    {
+    public:
+        locality() noexcept
+          : pid_(-1)
+        {
+        }
+
+        locality(std::string const& host, std::int32_t pid)
+          : host_(host)
+          , pid_(pid)
+        {
+        }
+
+        std::string const& host() const noexcept
+        {
+            return host_;
+        }
+
+        std::int32_t pid() const noexcept
+        {
+            return pid_;
+        }
+
+        static constexpr const char* type() noexcept
+        {
+            return "shmem";
+        }
+
+        explicit constexpr operator bool() const noexcept
+        {
+            return pid_ != -1;
+        }
+
+        HPX_EXPORT void save(serialization::output_archive& ar) const;
+        HPX_EXPORT void load(serialization::input_archive& ar);
+
+    private:
+        friend bool operator==(
+            locality const& lhs, locality const& rhs) noexcept
+        {
+            return lhs.pid_ == rhs.pid_ && lhs.host_ == rhs.host_;
+        }
+
+        friend bool operator<(locality const& lhs, locality const& rhs) noexcept
+        {
+            return lhs.host_ < rhs.host_ ||
+                (lhs.host_ == rhs.host_ && lhs.pid_ < rhs.pid_);
+        }
+
+        friend HPX_EXPORT std::ostream& operator<<(
+            std::ostream& os, locality const& loc) noexcept;
+
+        std::string host_;
+        std::int32_t pid_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
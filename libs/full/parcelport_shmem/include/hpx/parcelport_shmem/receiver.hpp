@@ -0,0 +1,66 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/parcelport_shmem/receiver_connection.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // The receiver polls all rings of this locality's segment. Each ring is
+    // read by at most one thread at any point in time, different rings may be
+    // drained concurrently.
+    template <typename Parcelport>
+    struct receiver
+    {
+        using connection_type = receiver_connection<Parcelport>;
+        using connection_ptr = std::unique_ptr<connection_type>;
+
+        receiver(Parcelport& pp, segment const& s)
+          : next_(0)
+        {
+            connections_.reserve(s.num_rings());
+            for (std::size_t i = 0; i != s.num_rings(); ++i)
+            {
+                connections_.push_back(
+                    std::make_unique<connection_type>(s.get_ring(i), pp));
+            }
+        }
+
+        bool background_work(std::size_t num_thread = -1)
+        {
+            // start at a different ring each time to spread concurrent
+            // callers over the rings
+            std::size_t const size = connections_.size();
+            std::size_t const first =
+                next_.fetch_add(1, std::memory_order_relaxed) % size;
+
+            bool has_work = false;
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                has_work =
+                    connections_[(first + i) % size]->receive(num_thread) ||
+                    has_work;
+            }
+            return has_work;
+        }
+
+    private:
+        std::vector<connection_ptr> connections_;
+        std::atomic<std::size_t> next_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
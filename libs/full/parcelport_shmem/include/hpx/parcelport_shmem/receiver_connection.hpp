@@ -0,0 +1,274 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/assert.hpp>
+#include <hpx/lock_registration/detail/register_locks.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <hpx/parcelport_shmem/header.hpp>
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+#include <hpx/parcelset/decode_parcels.hpp>
+#include <hpx/parcelset/parcel_buffer.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // A receiver_connection reads the messages written to one of the rings
+    // of this locality's segment. The parts of a message are read directly
+    // into the parcel buffer which is eventually handed to decode_parcels.
+    template <typename Parcelport>
+    struct receiver_connection
+    {
+    private:
+        enum connection_state
+        {
+            initialized,
+            rcvd_header,
+            rcvd_transmission_chunks,
+            rcvd_data
+        };
+
+        using data_type = std::vector<char>;
+        using buffer_type = parcel_buffer<data_type, data_type>;
+
+    public:
+        receiver_connection(ring_buffer ring, Parcelport& pp) noexcept
+          : state_(initialized)
+          , ring_(ring)
+          , offset_(0)
+          , chunks_idx_(0)
+          , idle_rounds_(0)
+          , pp_(pp)
+        {
+        }
+
+        // Read and decode all messages available in the ring, returns whether
+        // any work was performed.
+        bool receive(std::size_t num_thread = -1)
+        {
+            ring_control* control = ring_.control();
+            if (control->owner_.data_.load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+
+            // there is only one reader for each ring
+            std::unique_lock l(mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+            {
+                return false;
+            }
+
+            // decoding the parcels might run their actions directly, those
+            // could suspend while the lock is held
+            util::ignore_while_checking il(&l);
+            HPX_UNUSED(il);
+
+            bool has_work = false;
+            while (receive_message(num_thread))
+            {
+                has_work = true;
+            }
+
+            // free the ring once its writer has detached and all messages
+            // have been consumed
+            if (state_ == initialized &&
+                control->closing_.data_.load(std::memory_order_acquire) != 0 &&
+                ring_.empty())
+            {
+                segment::free_ring(ring_);
+                return true;
+            }
+
+            // A writer which terminated without releasing the ring (e.g.
+            // because it crashed) would own it forever. Check for this from
+            // time to time while no data arrives.
+            if (has_work)
+            {
+                idle_rounds_ = 0;
+            }
+            else if (++idle_rounds_ == owner_check_interval)
+            {
+                idle_rounds_ = 0;
+                has_work = reclaim_abandoned_ring();
+            }
+            return has_work;
+        }
+
+    private:
+        // number of idle rounds after which the owner of the ring is checked
+        static constexpr std::size_t owner_check_interval = 4096;
+
+        // Free the ring if its writer does not exist anymore, an incomplete
+        // message is discarded
+        bool reclaim_abandoned_ring()
+        {
+            if (!segment::is_abandoned(ring_))
+            {
+                return false;
+            }
+
+            LPT_(warning).format(
+                "shmem::receiver_connection: reclaiming the ring of "
+                "terminated process {}",
+                ring_.control()->owner_.data_.load(std::memory_order_relaxed));
+
+            buffer_ = buffer_type();
+            chunks_idx_ = 0;
+            offset_ = 0;
+            state_ = initialized;
+
+            segment::free_ring(ring_);
+            return true;
+        }
+
+        // Continue reading the current message, returns true if a message
+        // was received completely
+        bool receive_message(std::size_t num_thread)
+        {
+            switch (state_)
+            {
+            case initialized:
+                if (!read(&header_, sizeof(header_)))
+                {
+                    return false;
+                }
+                init_buffer();
+                state_ = rcvd_header;
+                [[fallthrough]];
+
+            case rcvd_header:
+                if (!read(buffer_.transmission_chunks_.data(),
+                        buffer_.transmission_chunks_.size() *
+                            sizeof(buffer_type::transmission_chunk_type)))
+                {
+                    return false;
+                }
+                state_ = rcvd_transmission_chunks;
+                [[fallthrough]];
+
+            case rcvd_transmission_chunks:
+                if (!read(buffer_.data_.data(), buffer_.data_.size()))
+                {
+                    return false;
+                }
+                state_ = rcvd_data;
+                [[fallthrough]];
+
+            case rcvd_data:
+                if (!receive_chunks())
+                {
+                    return false;
+                }
+                break;
+
+            default:
+                HPX_ASSERT(false);
+                return false;
+            }
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            parcelset::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+#endif
+            decode_parcels(pp_, HPX_MOVE(buffer_), num_thread);
+
+            buffer_ = buffer_type();
+            chunks_idx_ = 0;
+            state_ = initialized;
+
+            return true;
+        }
+
+        void init_buffer()
+        {
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            parcelset::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.bytes_ = static_cast<std::size_t>(header_.numbytes());
+#endif
+            pp_.get_buffer_pool().resize(
+                buffer_.data_, static_cast<std::size_t>(header_.size()));
+            buffer_.num_chunks_ = header_.num_chunks();
+
+            std::size_t const num_zero_copy_chunks =
+                static_cast<std::size_t>(buffer_.num_chunks_.first);
+            if (num_zero_copy_chunks != 0)
+            {
+                buffer_.transmission_chunks_.resize(num_zero_copy_chunks +
+                    static_cast<std::size_t>(buffer_.num_chunks_.second));
+                buffer_.chunks_.resize(num_zero_copy_chunks);
+            }
+        }
+
+        // The zero-copy chunks are copied from the ring straight into the
+        // chunks of the parcel buffer.
+        bool receive_chunks()
+        {
+            while (chunks_idx_ < buffer_.chunks_.size())
+            {
+                data_type& c = buffer_.chunks_[chunks_idx_];
+                pp_.get_buffer_pool().resize(c,
+                    static_cast<std::size_t>(
+                        buffer_.transmission_chunks_[chunks_idx_].second));
+                if (!read(c.data(), c.size()))
+                {
+                    return false;
+                }
+                ++chunks_idx_;
+            }
+            return true;
+        }
+
+        // Read the remainder of the given part of the message, returns true
+        // if the part has been read completely
+        bool read(void* data, std::size_t size) noexcept
+        {
+            HPX_ASSERT(offset_ <= size);
+            offset_ +=
+                ring_.read(static_cast<char*>(data) + offset_, size - offset_);
+            if (offset_ != size)
+            {
+                return false;
+            }
+            offset_ = 0;
+            return true;
+        }
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+        hpx::chrono::high_resolution_timer timer_;
+#endif
+        connection_state state_;
+
+        hpx::spinlock mtx_;
+        ring_buffer ring_;
+
+        header header_;
+        buffer_type buffer_;
+
+        std::size_t offset_;
+        std::size_t chunks_idx_;
+        std::size_t idle_rounds_;
+
+        Parcelport& pp_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
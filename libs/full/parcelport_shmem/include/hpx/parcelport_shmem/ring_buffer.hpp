@@ -0,0 +1,198 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/assert.hpp>
+#include <hpx/modules/concurrency.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hpx::parcelset::policies::shmem {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The control block of a ring buffer, it is placed into the shared memory
+    // segment and is accessed concurrently by two processes. All members are
+    // lock-free atomics, which are address-free and may therefore be shared
+    // between processes.
+    struct ring_control
+    {
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+            "the shared memory parcelport requires lock-free 64 bit atomics");
+        static_assert(std::atomic<std::int32_t>::is_always_lock_free,
+            "the shared memory parcelport requires lock-free 32 bit atomics");
+
+        ring_control() noexcept
+        {
+            owner_.data_.store(0, std::memory_order_relaxed);
+            closing_.data_.store(0, std::memory_order_relaxed);
+            head_.data_.store(0, std::memory_order_relaxed);
+            tail_.data_.store(0, std::memory_order_relaxed);
+        }
+
+        // process id of the locality currently writing to the ring, zero if
+        // the ring is free
+        util::cache_line_data<std::atomic<std::int32_t>> owner_;
+
+        // set by the writer once it will not write to the ring anymore, the
+        // reader releases the ring after it has consumed all of its data
+        util::cache_line_data<std::atomic<std::int32_t>> closing_;
+
+        // total number of bytes written, modified by the writer only
+        util::cache_line_data<std::atomic<std::uint64_t>> head_;
+
+        // total number of bytes read, modified by the reader only
+        util::cache_line_data<std::atomic<std::uint64_t>> tail_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A lock-free single-producer/single-consumer byte stream. The ring_buffer
+    // is a process local view onto a ring_control block and its data area in
+    // a shared memory segment. Each side caches the position of the other
+    // side and re-reads it only if the cached value does not permit any
+    // progress, which keeps the cache lines of the control block from
+    // bouncing between the processes on every access.
+    class ring_buffer
+    {
+    public:
+        ring_buffer() noexcept
+          : control_(nullptr)
+          , data_(nullptr)
+          , capacity_(0)
+          , cached_position_(0)
+        {
+        }
+
+        ring_buffer(
+            ring_control* control, char* data, std::size_t capacity) noexcept
+          : control_(control)
+          , data_(data)
+          , capacity_(capacity)
+          , cached_position_(0)
+        {
+            // positions are mapped onto the data area using a mask
+            HPX_ASSERT(capacity_ != 0 && (capacity_ & (capacity_ - 1)) == 0);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return control_ != nullptr;
+        }
+
+        ring_control* control() const noexcept
+        {
+            return control_;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        // Write up to size bytes to the ring, returns the number of bytes
+        // written. Must be called by the writing side only.
+        std::size_t write(void const* src, std::size_t size) noexcept
+        {
+            std::uint64_t const head =
+                control_->head_.data_.load(std::memory_order_relaxed);
+
+            // cached_position_ is the tail as last seen by the writer
+            if (capacity_ - (head - cached_position_) < size)
+            {
+                cached_position_ =
+                    control_->tail_.data_.load(std::memory_order_acquire);
+            }
+
+            std::size_t const count = (std::min)(size,
+                capacity_ - static_cast<std::size_t>(head - cached_position_));
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            std::size_t const offset =
+                static_cast<std::size_t>(head) & (capacity_ - 1);
+            std::size_t const first = (std::min)(count, capacity_ - offset);
+            std::memcpy(data_ + offset, src, first);
+            if (first != count)
+            {
+                std::memcpy(data_, static_cast<char const*>(src) + first,
+                    count - first);
+            }
+
+            control_->head_.data_.store(
+                head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Read up to size bytes from the ring, returns the number of bytes
+        // read. Must be called by the reading side only.
+        std::size_t read(void* dest, std::size_t size) noexcept
+        {
+            std::uint64_t const tail =
+                control_->tail_.data_.load(std::memory_order_relaxed);
+
+            // cached_position_ is the head as last seen by the reader
+            if (cached_position_ - tail < size)
+            {
+                cached_position_ =
+                    control_->head_.data_.load(std::memory_order_acquire);
+            }
+
+            std::size_t const count = (std::min)(
+                size, static_cast<std::size_t>(cached_position_ - tail));
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            std::size_t const offset =
+                static_cast<std::size_t>(tail) & (capacity_ - 1);
+            std::size_t const first = (std::min)(count, capacity_ - offset);
+            std::memcpy(dest, data_ + offset, first);
+            if (first != count)
+            {
+                std::memcpy(
+                    static_cast<char*>(dest) + first, data_, count - first);
+            }
+
+            control_->tail_.data_.store(
+                tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Return whether all data written to the ring has been read
+        bool empty() const noexcept
+        {
+            return control_->head_.data_.load(std::memory_order_acquire) ==
+                control_->tail_.data_.load(std::memory_order_relaxed);
+        }
+
+        // Reset the positions, may be called only while no writer is
+        // attached to the ring
+        void reset() noexcept
+        {
+            control_->head_.data_.store(0, std::memory_order_relaxed);
+            control_->tail_.data_.store(0, std::memory_order_relaxed);
+            cached_position_ = 0;
+        }
+
+    private:
+        ring_control* control_;
+        char* data_;
+        std::size_t capacity_;
+        std::uint64_t cached_position_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
@@ -0,0 +1,97 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/modules/errors.hpp>
+
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx::parcelset::policies::shmem {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A segment is a POSIX shared memory object (living in /dev/shm) holding
+    // the inbound ring buffers of one locality. The receiving locality creates
+    // (and eventually removes) its segment, sending localities attach to the
+    // segment of their destination and claim one of its rings for each of
+    // their connections. This way every ring has exactly one writer and
+    // exactly one reader.
+    class HPX_EXPORT segment
+    {
+    public:
+        // Create the segment receiving parcels for the process with the
+        // given id, num_rings rings of ring_size bytes each are created
+        segment(std::int32_t pid, std::size_t num_rings, std::size_t ring_size);
+
+        // Attach to the segment of the process with the given id
+        segment(std::int32_t pid, error_code& ec);
+
+        segment(segment const&) = delete;
+        segment& operator=(segment const&) = delete;
+
+        ~segment();
+
+        explicit operator bool() const noexcept
+        {
+            return base_ != nullptr;
+        }
+
+        std::size_t num_rings() const noexcept
+        {
+            return num_rings_;
+        }
+
+        std::size_t ring_size() const noexcept
+        {
+            return ring_size_;
+        }
+
+        // Return a view onto the ring with the given index
+        ring_buffer get_ring(std::size_t index) const noexcept;
+
+        // Claim a free ring for writing on behalf of the process with the
+        // given id, returns an invalid ring_buffer if all rings are in use
+        ring_buffer claim_ring(std::int32_t pid) const noexcept;
+
+        // Hand the given (claimed) ring back to the reader, the reader frees
+        // the ring after it has consumed all data
+        static void release_ring(ring_buffer const& ring) noexcept;
+
+        // Return whether the given ring is owned by a process which does not
+        // exist anymore, i.e. its writer terminated without releasing it
+        static bool is_abandoned(ring_buffer const& ring) noexcept;
+
+        // Make the given ring available for claiming again, may be called by
+        // the reader of the ring only
+        static void free_ring(ring_buffer& ring) noexcept;
+
+        // Return the name of the shared memory object of the process with the
+        // given id
+        static std::string name(std::int32_t pid);
+
+    private:
+        std::size_t mapping_size() const noexcept;
+
+        std::string name_;
+        bool owner_;
+        char* base_;
+        std::size_t num_rings_;
+        std::size_t ring_size_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,94 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/functional.hpp>
+#include <hpx/modules/synchronization.hpp>
+
+#include <hpx/parcelport_shmem/channel.hpp>
+#include <hpx/parcelport_shmem/sender_connection.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx::parcelset::policies::shmem {
+
+    // The sender keeps track of the connections whose messages did not fit
+    // into their ring at once, those are driven to completion by the
+    // background work of the parcelport.
+    struct sender
+    {
+        using connection_type = sender_connection;
+        using connection_ptr = std::shared_ptr<connection_type>;
+        using connection_list = std::deque<connection_ptr>;
+
+        connection_ptr create_connection(parcelset::locality const& dest,
+            std::shared_ptr<channel> ch, parcelset::parcelport* pp)
+        {
+            return std::make_shared<connection_type>(
+                this, dest, HPX_MOVE(ch), pp);
+        }
+
+        void add(connection_ptr const& ptr)
+        {
+            std::unique_lock l(connections_mtx_);
+            connections_.push_back(ptr);
+        }
+
+        void send_messages(connection_ptr connection)
+        {
+            // Check if sending has been completed....
+            if (connection->send())
+            {
+                error_code ec(throwmode::lightweight);
+                hpx::move_only_function<void(error_code const&,
+                    parcelset::locality const&, connection_ptr)>
+                    postprocess_handler;
+                std::swap(
+                    postprocess_handler, connection->postprocess_handler_);
+                postprocess_handler(ec, connection->destination(), connection);
+            }
+            else
+            {
+                std::unique_lock l(connections_mtx_);
+                connections_.push_back(HPX_MOVE(connection));
+            }
+        }
+
+        bool background_work() noexcept
+        {
+            connection_ptr connection;
+            {
+                std::unique_lock l(connections_mtx_, std::try_to_lock);
+                if (l && !connections_.empty())
+                {
+                    connection = HPX_MOVE(connections_.front());
+                    connections_.pop_front();
+                }
+            }
+
+            if (connection)
+            {
+                send_messages(HPX_MOVE(connection));
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        hpx::spinlock connections_mtx_;
+        connection_list connections_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
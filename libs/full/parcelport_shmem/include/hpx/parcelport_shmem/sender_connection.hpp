@@ -0,0 +1,249 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/assert.hpp>
+#include <hpx/modules/functional.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <hpx/parcelport_shmem/channel.hpp>
+#include <hpx/parcelport_shmem/header.hpp>
+#include <hpx/parcelset/parcelport_connection.hpp>
+#include <hpx/parcelset/parcelset_fwd.hpp>
+#include <hpx/parcelset_base/parcelport.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::policies::shmem {
+
+    struct sender;
+    struct sender_connection;
+
+    void add_connection(sender*, std::shared_ptr<sender_connection> const&);
+
+    struct sender_connection
+      : parcelset::parcelport_connection<sender_connection, std::vector<char>>
+    {
+    private:
+        using sender_type = sender;
+
+        using data_type = std::vector<char>;
+        using transmission_chunk_type =
+            parcel_buffer_type::transmission_chunk_type;
+
+        enum connection_state
+        {
+            initialized,
+            acquired_channel,
+            sent_header,
+            sent_transmission_chunks,
+            sent_data,
+            sent_chunks
+        };
+
+        using base_type =
+            parcelset::parcelport_connection<sender_connection, data_type>;
+
+    public:
+        sender_connection(sender_type* s, parcelset::locality const& there,
+            std::shared_ptr<channel> ch, parcelset::parcelport* pp)
+          : state_(initialized)
+          , sender_(s)
+          , channel_(HPX_MOVE(ch))
+          , offset_(0)
+          , chunks_idx_(0)
+          , pp_(pp)
+          , there_(there)
+        {
+        }
+
+        parcelset::locality const& destination() const noexcept
+        {
+            return there_;
+        }
+
+        constexpr void verify_(
+            parcelset::locality const& /* parcel_locality_id */) const noexcept
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(
+            Handler&& handler, ParcelPostprocess&& parcel_postprocess)
+        {
+            HPX_ASSERT(!handler_);
+            HPX_ASSERT(!postprocess_handler_);
+            HPX_ASSERT(!buffer_.data_.empty());
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            buffer_.data_point_.time_ =
+                hpx::chrono::high_resolution_clock::now();
+#endif
+            offset_ = 0;
+            chunks_idx_ = 0;
+            header_ = header(buffer_);
+
+            state_ = initialized;
+
+            handler_ = HPX_FORWARD(Handler, handler);
+
+            if (!send())
+            {
+                postprocess_handler_ =
+                    HPX_FORWARD(ParcelPostprocess, parcel_postprocess);
+                add_connection(sender_, shared_from_this());
+            }
+            else
+            {
+                HPX_ASSERT(!handler_);
+                error_code ec;
+                parcel_postprocess(ec, there_, shared_from_this());
+            }
+        }
+
+        // Write as much of the message as fits into the ring, returns true
+        // once the whole message has been written.
+        bool send()
+        {
+            switch (state_)
+            {
+            case initialized:
+                if (!channel_->try_acquire())
+                {
+                    return false;
+                }
+                state_ = acquired_channel;
+                [[fallthrough]];
+
+            case acquired_channel:
+                if (!write(&header_, sizeof(header_)))
+                {
+                    return false;
+                }
+                state_ = sent_header;
+                [[fallthrough]];
+
+            case sent_header:
+                if (header_.num_chunks().first != 0 &&
+                    !write(buffer_.transmission_chunks_.data(),
+                        buffer_.transmission_chunks_.size() *
+                            sizeof(transmission_chunk_type)))
+                {
+                    return false;
+                }
+                state_ = sent_transmission_chunks;
+                [[fallthrough]];
+
+            case sent_transmission_chunks:
+                if (!write(buffer_.data_.data(), buffer_.data_.size()))
+                {
+                    return false;
+                }
+                state_ = sent_data;
+                [[fallthrough]];
+
+            case sent_data:
+                if (!send_chunks())
+                {
+                    return false;
+                }
+                state_ = sent_chunks;
+                [[fallthrough]];
+
+            case sent_chunks:
+                return done();
+
+            default:
+                HPX_ASSERT(false);
+            }
+            return false;
+        }
+
+        hpx::move_only_function<void(error_code const&,
+            parcelset::locality const&, std::shared_ptr<sender_connection>)>
+            postprocess_handler_;
+
+    private:
+        // The zero-copy chunks are streamed through the ring as well, the
+        // receiver copies them directly into the chunks of its parcel buffer.
+        bool send_chunks()
+        {
+            while (chunks_idx_ < buffer_.chunks_.size())
+            {
+                serialization::serialization_chunk& c =
+                    buffer_.chunks_[chunks_idx_];
+                if (c.type_ == serialization::chunk_type::chunk_type_pointer &&
+                    !write(c.data_.cpos_, c.size_))
+                {
+                    return false;
+                }
+                ++chunks_idx_;
+            }
+            return true;
+        }
+
+        // Write the remainder of the given part of the message, returns true
+        // if the part has been written completely
+        bool write(void const* data, std::size_t size) noexcept
+        {
+            HPX_ASSERT(offset_ <= size);
+            offset_ += channel_->ring().write(
+                static_cast<char const*>(data) + offset_, size - offset_);
+            if (offset_ != size)
+            {
+                return false;
+            }
+            offset_ = 0;
+            return true;
+        }
+
+        bool done()
+        {
+            channel_->release();
+
+            error_code ec(throwmode::lightweight);
+            handler_(ec);
+            handler_.reset();
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            buffer_.data_point_.time_ =
+                hpx::chrono::high_resolution_clock::now() -
+                buffer_.data_point_.time_;
+            pp_->add_sent_data(buffer_.data_point_);
+#else
+            HPX_UNUSED(pp_);
+#endif
+            buffer_.clear();
+
+            state_ = initialized;
+
+            return true;
+        }
+
+        connection_state state_;
+        sender_type* sender_;
+        std::shared_ptr<channel> channel_;
+        hpx::move_only_function<void(error_code const&)> handler_;
+
+        header header_;
+
+        std::size_t offset_;
+        std::size_t chunks_idx_;
+
+        parcelset::parcelport* pp_;
+
+        parcelset::locality there_;
+    };
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
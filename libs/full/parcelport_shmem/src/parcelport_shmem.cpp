@@ -0,0 +1,363 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/execution_base.hpp>
+#include <hpx/modules/functional.hpp>
+#include <hpx/modules/preprocessor.hpp>
+#include <hpx/modules/runtime_configuration.hpp>
+#include <hpx/modules/runtime_local.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/util.hpp>
+#include <hpx/plugin/traits/plugin_config_data.hpp>
+
+#include <hpx/command_line_handling/command_line_handling.hpp>
+#include <hpx/parcelport_shmem/channel.hpp>
+#include <hpx/parcelport_shmem/locality.hpp>
+#include <hpx/parcelport_shmem/receiver.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+#include <hpx/parcelport_shmem/sender.hpp>
+#include <hpx/parcelset/parcelport_impl.hpp>
+#include <hpx/parcelset_base/locality.hpp>
+#include <hpx/plugin_factories/parcelport_factory.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <limits.h>
+#include <unistd.h>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx::parcelset {
+
+    namespace policies::shmem {
+        class HPX_EXPORT parcelport;
+    }    // namespace policies::shmem
+
+    template <>
+    struct connection_handler_traits<policies::shmem::parcelport>
+    {
+        using connection_type = policies::shmem::sender_connection;
+        using send_early_parcel = std::false_type;
+        using do_background_work = std::true_type;
+        using send_immediate_parcels = std::false_type;
+
+        static constexpr const char* type() noexcept
+        {
+            return "shmem";
+        }
+
+        static constexpr const char* pool_name() noexcept
+        {
+            return "parcel-pool-shmem";
+        }
+
+        static constexpr const char* pool_name_postfix() noexcept
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies::shmem {
+
+        void add_connection(
+            sender* s, std::shared_ptr<sender_connection> const& ptr)
+        {
+            s->add(ptr);
+        }
+
+        // The shared memory parcelport is used for all destinations running
+        // on the same host (and sharing /dev/shm with this locality). It
+        // never bootstraps the application, parcels to other hosts are sent
+        // through the parcelports with lower priority.
+        class HPX_EXPORT parcelport : public parcelport_impl<parcelport>
+        {
+            using base_type = parcelport_impl<parcelport>;
+
+            static std::string host_name()
+            {
+                char name[HOST_NAME_MAX + 1] = {};
+                if (::gethostname(name, sizeof(name) - 1) != 0)
+                {
+                    return "localhost";
+                }
+                return name;
+            }
+
+            static std::int32_t pid() noexcept
+            {
+                return static_cast<std::int32_t>(::getpid());
+            }
+
+            static parcelset::locality here()
+            {
+                return parcelset::locality(locality(host_name(), pid()));
+            }
+
+            static std::size_t num_rings(util::runtime_configuration const& ini)
+            {
+                return hpx::util::get_entry_as<std::size_t>(ini,
+                    "hpx.parcel.shmem.num_rings", HPX_PARCEL_SHMEM_NUM_RINGS);
+            }
+
+            static std::size_t ring_size(util::runtime_configuration const& ini)
+            {
+                return hpx::util::get_entry_as<std::size_t>(ini,
+                    "hpx.parcel.shmem.ring_size", HPX_PARCEL_SHMEM_RING_SIZE);
+            }
+
+            static std::size_t background_threads(
+                util::runtime_configuration const& ini)
+            {
+                return hpx::util::get_entry_as<std::size_t>(ini,
+                    "hpx.parcel.shmem.background_threads",
+                    HPX_HAVE_PARCELPORT_SHMEM_BACKGROUND_THREADS);
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                threads::policies::callback_notifier const& notifier)
+              : base_type(ini, here(), notifier)
+              , host_(host_name())
+              , stopped_(false)
+              , segment_(pid(), num_rings(ini), ring_size(ini))
+              , receiver_(*this, segment_)
+              , background_threads_(background_threads(ini))
+            {
+            }
+
+            // Start the handling of connections.
+            bool do_run()
+            {
+                for (std::size_t i = 0; i != io_service_pool_.size(); ++i)
+                {
+                    io_service_pool_.get_io_service(int(i)).post(
+                        hpx::bind(&parcelport::io_service_work, this));
+                }
+                return true;
+            }
+
+            // Stop the handling of connections.
+            void do_stop()
+            {
+                while (do_background_work(0, parcelport_background_mode_all))
+                {
+                    if (threads::get_self_ptr())
+                        hpx::this_thread::suspend(
+                            hpx::threads::thread_schedule_state::pending,
+                            "shmem::parcelport::do_stop");
+                }
+                stopped_ = true;
+
+                std::unique_lock l(channels_mtx_);
+                channels_.clear();
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const override
+            {
+                return host_name();
+            }
+
+            // Only destinations on the same host whose segment could be
+            // attached to are reachable through this parcelport.
+            bool can_connect(parcelset::locality const& dest, bool) override
+            {
+                locality const& l = dest.get<locality>();
+                if (l.host() != host_ || l.pid() == pid())
+                {
+                    return false;
+                }
+                return get_channel(l.pid()) != nullptr;
+            }
+
+            std::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                std::shared_ptr<channel> ch =
+                    get_channel(l.get<locality>().pid());
+                if (!ch)
+                {
+                    HPX_THROWS_IF(ec, network_error,
+                        "shmem::parcelport::create_connection",
+                        "could not connect to the shared memory segment of {}",
+                        l);
+                    return std::shared_ptr<sender_connection>();
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+
+                return sender_.create_connection(l, HPX_MOVE(ch), this);
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const&) const override
+            {
+                // this parcelport is never used for bootstrapping
+                return parcelset::locality(locality());
+            }
+
+            parcelset::locality create_locality() const override
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(
+                std::size_t num_thread, parcelport_background_mode mode)
+            {
+                if (stopped_ || num_thread >= background_threads_)
+                {
+                    return false;
+                }
+
+                bool has_work = false;
+                if (mode & parcelport_background_mode_send)
+                {
+                    has_work = sender_.background_work();
+                }
+                if (mode & parcelport_background_mode_receive)
+                {
+                    has_work =
+                        receiver_.background_work(num_thread) || has_work;
+                }
+                return has_work;
+            }
+
+        private:
+            // Return the channel to the locality with the given process id,
+            // attaches to its segment and claims a ring on first use. Returns
+            // an empty pointer if the destination is not reachable through
+            // shared memory (the failure is remembered as well).
+            std::shared_ptr<channel> get_channel(std::int32_t dest)
+            {
+                {
+                    std::unique_lock l(channels_mtx_);
+                    auto it = channels_.find(dest);
+                    if (it != channels_.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                std::shared_ptr<channel> ch;
+                if (!stopped_)
+                {
+                    error_code ec(throwmode::lightweight);
+                    auto s = std::make_shared<segment>(dest, ec);
+                    if (!ec)
+                    {
+                        ring_buffer ring = s->claim_ring(pid());
+                        if (ring)
+                        {
+                            ch = std::make_shared<channel>(HPX_MOVE(s), ring);
+                        }
+                    }
+                }
+
+                // another thread might have connected concurrently
+                std::unique_lock l(channels_mtx_);
+                return channels_.emplace(dest, HPX_MOVE(ch)).first->second;
+            }
+
+            void io_service_work()
+            {
+                std::size_t k = 0;
+
+                // We only execute work on the IO service while HPX is starting
+                while (hpx::is_starting())
+                {
+                    bool has_work = sender_.background_work();
+                    has_work = receiver_.background_work() || has_work;
+                    if (has_work)
+                    {
+                        k = 0;
+                    }
+                    else
+                    {
+                        ++k;
+                        util::detail::yield_k(k,
+                            "hpx::parcelset::policies::shmem::parcelport::"
+                            "io_service_work");
+                    }
+                }
+            }
+
+            std::string const host_;
+            std::atomic<bool> stopped_;
+
+            segment segment_;
+            sender sender_;
+            receiver<parcelport> receiver_;
+
+            hpx::spinlock channels_mtx_;
+            std::map<std::int32_t, std::shared_ptr<channel>> channels_;
+
+            std::size_t background_threads_;
+        };
+    }    // namespace policies::shmem
+}    // namespace hpx::parcelset
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx::traits {
+
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shmem]
+    //      ...
+    //      priority = 200
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shmem::parcelport>
+    {
+        // the shared memory parcelport takes precedence over all other
+        // parcelports for the destinations it can reach
+        static constexpr char const* priority() noexcept
+        {
+            return "200";
+        }
+
+        static constexpr void init(
+            int*, char***, util::command_line_handling&) noexcept
+        {
+        }
+
+        static constexpr void destroy() noexcept {}
+
+        static constexpr char const* call() noexcept
+        {
+            return
+                // number of rings in the segment of each locality, this limits
+                // the number of localities sending parcels to it
+                "num_rings = ${HPX_PARCEL_SHMEM_NUM_RINGS:" HPX_PP_STRINGIZE(
+                    HPX_PARCEL_SHMEM_NUM_RINGS) "}\n"
+                // size of each ring in bytes, must be a power of two
+                "ring_size = ${HPX_PARCEL_SHMEM_RING_SIZE:" HPX_PP_STRINGIZE(
+                    HPX_PARCEL_SHMEM_RING_SIZE) "}\n"
+                // number of cores that do background work, default: all
+                "background_threads = "
+                "${HPX_HAVE_PARCELPORT_SHMEM_BACKGROUND_THREADS:-1}\n";
+        }
+    };
+}    // namespace hpx::traits
+
+HPX_REGISTER_PARCELPORT(hpx::parcelset::policies::shmem::parcelport, shmem)
+
+#endif
@@ -0,0 +1,280 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/assert.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/format.hpp>
+
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hpx::parcelset::policies::shmem {
+
+    namespace {
+
+        // The segment header is followed by the ring control blocks and the
+        // (page aligned) data areas of all rings.
+        struct segment_header
+        {
+            std::uint64_t magic_;
+            std::uint64_t num_rings_;
+            std::uint64_t ring_size_;
+
+            // set once the segment has been fully initialized
+            std::atomic<std::uint32_t> ready_;
+        };
+
+        constexpr std::uint64_t segment_magic = 0x687078736d656d31ULL;
+        constexpr std::size_t page_size = 4096;
+
+        constexpr std::size_t align_up(std::size_t size) noexcept
+        {
+            return (size + page_size - 1) & ~(page_size - 1);
+        }
+
+        constexpr std::size_t controls_offset() noexcept
+        {
+            return align_up(sizeof(segment_header));
+        }
+
+        constexpr std::size_t data_offset(std::size_t num_rings) noexcept
+        {
+            return align_up(
+                controls_offset() + num_rings * sizeof(ring_control));
+        }
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    segment::segment(
+        std::int32_t pid, std::size_t num_rings, std::size_t ring_size)
+      : name_(name(pid))
+      , owner_(true)
+      , base_(nullptr)
+      , num_rings_(num_rings)
+      , ring_size_(ring_size)
+    {
+        if (num_rings_ == 0 || ring_size_ < page_size ||
+            (ring_size_ & (ring_size_ - 1)) != 0)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "shmem::segment::segment",
+                "invalid shared memory parcelport configuration: the number "
+                "of rings ({}) must be positive and the ring size ({}) must "
+                "be a power of two of at least {} bytes",
+                num_rings_, ring_size_, page_size);
+        }
+
+        // remove a stale segment left behind by a previous process which had
+        // the same process id
+        ::shm_unlink(name_.c_str());
+
+        int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "could not create shared memory segment {}: {}", name_,
+                std::strerror(errno));
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(mapping_size())) == -1)
+        {
+            int const error = errno;
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "could not resize shared memory segment {} to {} bytes: {}",
+                name_, mapping_size(), std::strerror(error));
+        }
+
+        void* base = ::mmap(nullptr, mapping_size(), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            int const error = errno;
+            ::shm_unlink(name_.c_str());
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "could not map shared memory segment {}: {}", name_,
+                std::strerror(error));
+        }
+        base_ = static_cast<char*>(base);
+
+        segment_header* header = new (base_) segment_header;
+        header->magic_ = segment_magic;
+        header->num_rings_ = num_rings_;
+        header->ring_size_ = ring_size_;
+
+        for (std::size_t i = 0; i != num_rings_; ++i)
+        {
+            new (base_ + controls_offset() + i * sizeof(ring_control))
+                ring_control;
+        }
+
+        header->ready_.store(1, std::memory_order_release);
+    }
+
+    segment::segment(std::int32_t pid, error_code& ec)
+      : name_(name(pid))
+      , owner_(false)
+      , base_(nullptr)
+      , num_rings_(0)
+      , ring_size_(0)
+    {
+        int fd = ::shm_open(name_.c_str(), O_RDWR, 0600);
+        if (fd == -1)
+        {
+            HPX_THROWS_IF(ec, network_error, "shmem::segment::segment",
+                "could not open shared memory segment {}: {}", name_,
+                std::strerror(errno));
+            return;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1 ||
+            static_cast<std::size_t>(st.st_size) < data_offset(0))
+        {
+            ::close(fd);
+            HPX_THROWS_IF(ec, network_error, "shmem::segment::segment",
+                "shared memory segment {} is not accessible or too small",
+                name_);
+            return;
+        }
+
+        std::size_t const size = static_cast<std::size_t>(st.st_size);
+        void* base =
+            ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            HPX_THROWS_IF(ec, network_error, "shmem::segment::segment",
+                "could not map shared memory segment {}: {}", name_,
+                std::strerror(errno));
+            return;
+        }
+
+        segment_header const* header = static_cast<segment_header*>(base);
+        if (header->ready_.load(std::memory_order_acquire) != 1 ||
+            header->magic_ != segment_magic)
+        {
+            ::munmap(base, size);
+            HPX_THROWS_IF(ec, network_error, "shmem::segment::segment",
+                "shared memory segment {} was not initialized by HPX", name_);
+            return;
+        }
+
+        num_rings_ = static_cast<std::size_t>(header->num_rings_);
+        ring_size_ = static_cast<std::size_t>(header->ring_size_);
+        if (mapping_size() != size)
+        {
+            ::munmap(base, size);
+            HPX_THROWS_IF(ec, network_error, "shmem::segment::segment",
+                "shared memory segment {} has an unexpected size", name_);
+            return;
+        }
+
+        base_ = static_cast<char*>(base);
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    segment::~segment()
+    {
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, mapping_size());
+        }
+
+        // existing mappings stay valid after the object has been removed
+        if (owner_)
+        {
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    ring_buffer segment::get_ring(std::size_t index) const noexcept
+    {
+        HPX_ASSERT(base_ != nullptr && index < num_rings_);
+        char* control =
+            base_ + controls_offset() + index * sizeof(ring_control);
+        return ring_buffer(reinterpret_cast<ring_control*>(control),
+            base_ + data_offset(num_rings_) + index * ring_size_, ring_size_);
+    }
+
+    ring_buffer segment::claim_ring(std::int32_t pid) const noexcept
+    {
+        HPX_ASSERT(pid != 0);
+        for (std::size_t i = 0; i != num_rings_; ++i)
+        {
+            ring_buffer ring = get_ring(i);
+            std::atomic<std::int32_t>& owner = ring.control()->owner_.data_;
+
+            std::int32_t expected = 0;
+            if (owner.load(std::memory_order_relaxed) == 0 &&
+                owner.compare_exchange_strong(expected, pid,
+                    std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return ring;
+            }
+        }
+        return ring_buffer();
+    }
+
+    void segment::release_ring(ring_buffer const& ring) noexcept
+    {
+        HPX_ASSERT(ring);
+        ring.control()->closing_.data_.store(1, std::memory_order_release);
+    }
+
+    bool segment::is_abandoned(ring_buffer const& ring) noexcept
+    {
+        HPX_ASSERT(ring);
+        std::int32_t const pid =
+            ring.control()->owner_.data_.load(std::memory_order_acquire);
+
+        // a process id may be reused, the ring is reclaimed only after the
+        // new process has terminated as well
+        return pid > 0 && ::kill(pid, 0) == -1 && errno == ESRCH;
+    }
+
+    void segment::free_ring(ring_buffer& ring) noexcept
+    {
+        HPX_ASSERT(ring);
+        ring_control* control = ring.control();
+        ring.reset();
+        control->closing_.data_.store(0, std::memory_order_relaxed);
+        control->owner_.data_.store(0, std::memory_order_release);
+    }
+
+    std::string segment::name(std::int32_t pid)
+    {
+        return hpx::util::format("/hpx.shmem.{}", pid);
+    }
+
+    std::size_t segment::mapping_size() const noexcept
+    {
+        return data_offset(num_rings_) + num_rings_ * ring_size_;
+    }
+}    // namespace hpx::parcelset::policies::shmem
+
+#endif
@@ -0,0 +1,112 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that parcels of any size are exchanged between two localities running
+// on the same host, and that they are sent through the shared memory
+// parcelport if it has been selected (hpxrun.py -p shmem).
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using hpx::parcelset::policies::shmem::segment;
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> echo(std::vector<char> const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo, shmem_echo_action)
+
+std::int32_t get_pid()
+{
+    return static_cast<std::int32_t>(::getpid());
+}
+HPX_PLAIN_ACTION(get_pid, shmem_get_pid_action)
+
+///////////////////////////////////////////////////////////////////////////////
+void test_echo(hpx::id_type const& dest)
+{
+    // the larger messages do not fit into a ring and use zero-copy chunks
+    for (std::size_t size : {std::size_t(0), std::size_t(16),
+             std::size_t(4096), std::size_t(1024 * 1024),
+             std::size_t(16 * 1024 * 1024)})
+    {
+        std::vector<char> data(size);
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            data[i] = static_cast<char>(i % 251);
+        }
+        HPX_TEST(shmem_echo_action()(dest, data) == data);
+    }
+}
+
+// The parcels to the destination went through shared memory if this locality
+// has claimed one of the rings of the destination's segment.
+void test_ring_claimed(hpx::id_type const& dest)
+{
+    std::int32_t const pid = shmem_get_pid_action()(dest);
+
+    hpx::error_code ec(hpx::throwmode::lightweight);
+    segment s(pid, ec);
+    HPX_TEST(!ec);
+    if (ec)
+    {
+        return;
+    }
+
+    std::size_t num_claimed = 0;
+    for (std::size_t i = 0; i != s.num_rings(); ++i)
+    {
+        if (s.get_ring(i).control()->owner_.data_.load() == get_pid())
+        {
+            ++num_claimed;
+        }
+    }
+    HPX_TEST_EQ(num_claimed, std::size_t(1));
+}
+
+int hpx_main()
+{
+    // the parcelport with the highest priority is used for all parcels
+    bool const use_shmem =
+        hpx::get_config_entry("hpx.parcel.shmem.enable", "0") == "1" &&
+        std::stoi(hpx::get_config_entry("hpx.parcel.shmem.priority", "0")) >
+            std::stoi(hpx::get_config_entry("hpx.parcel.tcp.priority", "0"));
+
+    for (hpx::id_type const& dest : hpx::find_remote_localities())
+    {
+        test_echo(dest);
+        if (use_shmem)
+        {
+            test_ring_claimed(dest);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
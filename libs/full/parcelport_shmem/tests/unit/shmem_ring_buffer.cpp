@@ -0,0 +1,194 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test the shared memory segments and the single-producer/single-consumer ring
+// buffers used by the shared memory parcelport, including the reclamation of
+// rings abandoned by terminated writers.
+
+#include <hpx/hpx_main.hpp>
+
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelport_shmem/ring_buffer.hpp>
+#include <hpx/parcelport_shmem/segment.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using hpx::parcelset::policies::shmem::ring_buffer;
+using hpx::parcelset::policies::shmem::segment;
+
+constexpr std::size_t num_rings = 4;
+constexpr std::size_t ring_size = 4096;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_segment(std::int32_t pid)
+{
+    segment receiver(pid, num_rings, ring_size);
+    HPX_TEST(receiver);
+
+    hpx::error_code ec(hpx::throwmode::lightweight);
+    segment sender(pid, ec);
+    HPX_TEST(!ec);
+    HPX_TEST(sender);
+    HPX_TEST_EQ(sender.num_rings(), num_rings);
+    HPX_TEST_EQ(sender.ring_size(), ring_size);
+
+    // all rings can be claimed exactly once
+    std::vector<ring_buffer> rings;
+    for (std::size_t i = 0; i != num_rings; ++i)
+    {
+        ring_buffer ring = sender.claim_ring(pid);
+        HPX_TEST(ring);
+        rings.push_back(ring);
+    }
+    HPX_TEST(!sender.claim_ring(pid));
+
+    // data written through the sender's mapping is visible to the receiver
+    int const value = 42;
+    HPX_TEST_EQ(rings[1].write(&value, sizeof(value)), sizeof(value));
+
+    ring_buffer ring = receiver.get_ring(1);
+    int result = 0;
+    HPX_TEST_EQ(ring.read(&result, sizeof(result)), sizeof(result));
+    HPX_TEST_EQ(result, value);
+    HPX_TEST(ring.empty());
+
+    // a released ring is handed back to the reader
+    segment::release_ring(rings[1]);
+    HPX_TEST_EQ(ring.control()->closing_.data_.load(), 1);
+}
+
+// A ring owned by a process which terminated without releasing it can be
+// reclaimed by the reader.
+void test_abandoned_ring(std::int32_t pid)
+{
+    pid_t const child = ::fork();
+    if (child == 0)
+    {
+        ::_exit(0);
+    }
+    HPX_TEST_LT(0, child);
+    ::waitpid(child, nullptr, 0);
+
+    segment s(pid, 2, ring_size);
+
+    ring_buffer live = s.claim_ring(static_cast<std::int32_t>(::getpid()));
+    HPX_TEST(!segment::is_abandoned(live));
+
+    ring_buffer abandoned = s.claim_ring(static_cast<std::int32_t>(child));
+    HPX_TEST(abandoned);
+    int const value = 42;
+    HPX_TEST_EQ(abandoned.write(&value, sizeof(value)), sizeof(value));
+    HPX_TEST(!s.claim_ring(static_cast<std::int32_t>(::getpid())));
+
+    ring_buffer reader = s.get_ring(1);
+    HPX_TEST(segment::is_abandoned(reader));
+    segment::free_ring(reader);
+    HPX_TEST(reader.empty());
+    HPX_TEST(!segment::is_abandoned(reader));
+
+    HPX_TEST(s.claim_ring(static_cast<std::int32_t>(::getpid())));
+}
+
+void test_missing_segment()
+{
+    hpx::error_code ec(hpx::throwmode::lightweight);
+    segment s(std::int32_t(-2), ec);
+    HPX_TEST(ec);
+    HPX_TEST(!s);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_wrap_around(std::int32_t pid)
+{
+    segment s(pid, 1, ring_size);
+    ring_buffer writer = s.claim_ring(pid);
+    ring_buffer reader = s.get_ring(0);
+
+    // a full ring does not accept any more data
+    std::vector<char> data(ring_size + 100, 'x');
+    HPX_TEST_EQ(writer.write(data.data(), data.size()), ring_size);
+    HPX_TEST_EQ(writer.write(data.data(), 1), std::size_t(0));
+
+    std::vector<char> buffer(ring_size);
+    HPX_TEST_EQ(reader.read(buffer.data(), 100), std::size_t(100));
+
+    // this write wraps around the end of the data area
+    std::vector<char> pattern(100);
+    for (std::size_t i = 0; i != pattern.size(); ++i)
+    {
+        pattern[i] = static_cast<char>(i);
+    }
+    HPX_TEST_EQ(writer.write(pattern.data(), pattern.size()), pattern.size());
+
+    HPX_TEST_EQ(reader.read(buffer.data(), ring_size - 100), ring_size - 100);
+    HPX_TEST_EQ(reader.read(buffer.data(), ring_size), pattern.size());
+    for (std::size_t i = 0; i != pattern.size(); ++i)
+    {
+        HPX_TEST_EQ(buffer[i], pattern[i]);
+    }
+    HPX_TEST(reader.empty());
+}
+
+void test_concurrent_streaming(std::int32_t pid)
+{
+    segment s(pid, 1, ring_size);
+    ring_buffer writer = s.claim_ring(pid);
+    ring_buffer reader = s.get_ring(0);
+
+    constexpr std::uint64_t count = 1000000;
+
+    std::thread producer([&]() {
+        std::uint64_t i = 0;
+        while (i != count)
+        {
+            if (writer.write(&i, sizeof(i)) == sizeof(i))
+            {
+                ++i;
+            }
+        }
+    });
+
+    // values are received completely and in order
+    std::uint64_t expected = 0;
+    while (expected != count)
+    {
+        std::uint64_t value = 0;
+        std::size_t received = 0;
+        while (received != sizeof(value))
+        {
+            received += reader.read(
+                reinterpret_cast<char*>(&value) + received,
+                sizeof(value) - received);
+        }
+        HPX_TEST_EQ(value, expected);
+        ++expected;
+    }
+
+    producer.join();
+    HPX_TEST(reader.empty());
+}
+
+int main()
+{
+    // use a segment name which can not clash with a running parcelport
+    std::int32_t const pid = -static_cast<std::int32_t>(::getpid());
+
+    test_segment(pid);
+    test_missing_segment();
+    test_abandoned_ring(pid);
+    test_wrap_around(pid);
+    test_concurrent_streaming(pid);
+
+    return hpx::util::report_errors();
+}
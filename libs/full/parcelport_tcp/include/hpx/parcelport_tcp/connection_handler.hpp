@@ -13,6 +13,7 @@
 #include <hpx/config.hpp>
 
 #if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
 #include <hpx/parcelport_tcp/locality.hpp>
 #include <hpx/parcelport_tcp/sender.hpp>
 #include <hpx/parcelset/parcelport_impl.hpp>
@@ -44,7 +45,13 @@ namespace hpx::parcelset {
     {
         using connection_type = policies::tcp::sender;
         using send_early_parcel = std::true_type;
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        // the completions of the io_uring operations are dispatched by the
+        // background work of the worker threads
+        using do_background_work = std::true_type;
+#else
         using do_background_work = std::false_type;
+#endif
         using send_immediate_parcels = std::false_type;
 
         static constexpr const char* type() noexcept
@@ -105,12 +112,25 @@ namespace hpx::parcelset {
 
             parcelset::locality create_locality() const;
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            bool background_work(
+                std::size_t num_thread, parcelport_background_mode mode);
+#endif
+
         private:
             void handle_accept(std::error_code const& e,
                 std::shared_ptr<receiver> receiver_conn);
             void handle_read_completion(std::error_code const& e,
                 std::shared_ptr<receiver> receiver_conn);
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            void io_service_work(std::size_t i);
+
+            // The io_uring instance used for all connections, empty if the
+            // connections are driven by asio.
+            std::unique_ptr<io_uring_service> uring_;
+#endif
+
             /// Acceptor used to listen for incoming connections.
             asio::ip::tcp::acceptor* acceptor_;
 
@@ -0,0 +1,182 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP) &&        \
+    defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/synchronization.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace hpx::parcelset::policies::tcp {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Base class of all operations submitted to the io_uring_service. The
+    // address of the operation is used as the user data of the submission,
+    // it has to stay valid until its final completion has been handled.
+    struct io_uring_operation
+    {
+        virtual ~io_uring_operation() = default;
+
+        // Called for each completion of the operation, res is the result of
+        // the operation (a negative errno value on failure) and flags are the
+        // flags of the completion queue entry.
+        virtual void complete(int res, std::uint32_t flags) = 0;
+    };
+
+    // An operation invoking a member function of a connection. The operation
+    // keeps the connection alive until its final completion has been handled.
+    template <typename Connection,
+        void (Connection::*F)(int res, std::uint32_t flags)>
+    struct io_uring_member_operation final : io_uring_operation
+    {
+        void complete(int res, std::uint32_t flags) override
+        {
+            if (flags & IORING_CQE_F_MORE)
+            {
+                (keep_alive_.get()->*F)(res, flags);
+                return;
+            }
+
+            // the connection may re-submit this operation from the handler
+            std::shared_ptr<Connection> c = HPX_MOVE(keep_alive_);
+            (c.get()->*F)(res, flags);
+        }
+
+        std::shared_ptr<Connection> keep_alive_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A minimal io_uring instance driven through the raw system calls.
+    //
+    // Operations are only queued by the functions submitting them, all
+    // queued operations are handed to the kernel with a single system call
+    // by the next invocation of poll() (or if the submission queue is full).
+    // poll() also dispatches all available completions, it is invoked from
+    // the background work of the HPX worker threads.
+    //
+    // Receive operations select their buffers from a ring of receive buffers
+    // which is registered with the kernel once. The handler of a receive
+    // completion has to recycle the buffer it was given. Receives are
+    // multishot operations if the kernel supports those (Linux 6.0 and
+    // newer), this is probed for when the instance is created.
+    class HPX_EXPORT io_uring_service
+    {
+    public:
+        io_uring_service(std::uint32_t entries, std::uint32_t num_buffers,
+            std::uint32_t buffer_size, bool multishot = true,
+            error_code& ec = throws);
+        ~io_uring_service();
+
+        io_uring_service(io_uring_service const&) = delete;
+        io_uring_service(io_uring_service&&) = delete;
+        io_uring_service& operator=(io_uring_service const&) = delete;
+        io_uring_service& operator=(io_uring_service&&) = delete;
+
+        explicit operator bool() const noexcept
+        {
+            return ring_fd_ != -1;
+        }
+
+        std::uint32_t buffer_size() const noexcept
+        {
+            return buffer_size_;
+        }
+
+        // Return whether receives are multishot operations
+        bool has_multishot_recv() const noexcept
+        {
+            return multishot_;
+        }
+
+        // Queue a gather-write of the given message, the message and the
+        // buffers it refers to have to stay valid until the completion
+        void async_sendmsg(int fd, msghdr const* msg, io_uring_operation* op);
+
+        // Queue a scatter-read filling all buffers of the given message
+        void async_recvmsg(int fd, msghdr* msg, io_uring_operation* op);
+
+        // Queue a write of the given buffer
+        void async_send(int fd, void const* data, std::size_t size,
+            io_uring_operation* op);
+
+        // Queue a receive, each completion carries the index of the receive
+        // buffer holding the data (see buffer()). The receive stays active
+        // as long as its completions have IORING_CQE_F_MORE set, which is
+        // never the case without multishot support.
+        void async_recv(int fd, io_uring_operation* op);
+
+        // Queue the cancellation of the given operation
+        void async_cancel(io_uring_operation* op);
+
+        // Access the receive buffer selected by the given completion
+        char const* buffer(std::uint32_t flags) const noexcept;
+
+        // Hand the receive buffer selected by the given completion back to
+        // the kernel, must be called from the completion handler
+        void recycle_buffer(std::uint32_t flags) noexcept;
+
+        // Submit all queued operations and dispatch all available
+        // completions. Returns whether any completion was dispatched.
+        bool poll();
+
+    private:
+        io_uring_sqe* get_sqe(io_uring_operation* op, std::uint8_t opcode,
+            int fd) noexcept;
+        void commit_sqe() noexcept;
+        void prep_recv(int fd, io_uring_operation* op, bool multishot) noexcept;
+        bool probe_multishot_recv() noexcept;
+        void submit_locked() noexcept;
+        void add_buffer(std::uint16_t bid) noexcept;
+        void close() noexcept;
+
+        int ring_fd_;
+        std::uint32_t num_buffers_;
+        std::uint32_t buffer_size_;
+        bool multishot_;
+
+        // the submission queue, protected by sq_mtx_
+        hpx::spinlock sq_mtx_;
+        std::uint32_t* sq_khead_;
+        std::uint32_t* sq_ktail_;
+        std::uint32_t* sq_kflags_;
+        std::uint32_t sq_mask_;
+        std::uint32_t sq_entries_;
+        std::uint32_t sq_tail_;
+        io_uring_sqe* sqes_;
+
+        // the completion queue, protected by cq_mtx_
+        hpx::spinlock cq_mtx_;
+        std::uint32_t* cq_khead_;
+        std::uint32_t* cq_ktail_;
+        std::uint32_t cq_mask_;
+        io_uring_cqe* cqes_;
+
+        // the ring of registered receive buffers, modified by completion
+        // handlers only (while cq_mtx_ is held)
+        io_uring_buf* buf_ring_;
+        char* buffers_;
+
+        void* sq_ring_;
+        std::size_t sq_ring_size_;
+        void* cq_ring_;
+        std::size_t cq_ring_size_;
+        std::size_t sqes_size_;
+    };
+}    // namespace hpx::parcelset::policies::tcp
+
+#endif
@@ -20,6 +20,7 @@
 #include <hpx/modules/functional.hpp>
 #include <hpx/modules/timing.hpp>
 
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
 #include <hpx/parcelset/decode_parcels.hpp>
 #include <hpx/parcelset/parcelport_connection.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
@@ -38,14 +39,22 @@
 #undef VT1
 #undef VT2
 
+#include <algorithm>
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <system_error>
 #include <utility>
 #include <vector>
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
 namespace hpx::parcelset::policies::tcp {
 
     class connection_handler;
@@ -56,13 +65,26 @@ namespace hpx::parcelset::policies::tcp {
     {
     public:
         receiver(asio::io_context& io_service, std::uint64_t max_inbound_size,
-            connection_handler& parcelport)
+            connection_handler& parcelport
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            ,
+            io_uring_service* uring = nullptr
+#endif
+            )
           : socket_(io_service)
           , max_inbound_size_(max_inbound_size)
           , ack_(0)
           , parcelport_(parcelport)
           , mtx_()
           , operation_in_flight_(0)
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+          , uring_(uring)
+          , uring_state_(uring_read_header)
+          , target_idx_(0)
+          , armed_(false)
+          , direct_(false)
+          , failed_(false)
+#endif
         {
         }
 
@@ -83,6 +105,29 @@ namespace hpx::parcelset::policies::tcp {
         {
             HPX_ASSERT(buffer_.data_.empty());
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            if (uring_ != nullptr)
+            {
+                // all messages are received by a single multishot receive
+                // operation (or by a receive operation which is re-armed
+                // after each completion), the handler is invoked after each
+                // message
+                uring_handler_ = HPX_MOVE(handler);
+                begin_message_uring();
+
+                armed_ = true;
+                if (!submit_uring(recv_op_, [&](int fd) {
+                        uring_->async_recv(fd, &recv_op_);
+                    }))
+                {
+                    armed_ = false;
+                    fail_uring(asio::error::make_error_code(
+                        asio::error::not_connected));
+                }
+                return;
+            }
+#endif
+
             // Store the time of the begin of the read operation
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
             parcelset::data_point& data = buffer_.data_point_;
@@ -130,6 +175,33 @@ namespace hpx::parcelset::policies::tcp {
 
         void shutdown()
         {
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            if (uring_ != nullptr)
+            {
+                {
+                    // pending operations hold on to the socket, they are
+                    // completed once it has been shut down
+                    std::lock_guard lk(mtx_);
+                    if (socket_.is_open())
+                    {
+                        std::error_code ec;
+                        socket_.shutdown(
+                            asio::ip::tcp::socket::shutdown_both, ec);
+                        socket_.close(ec);
+                    }
+                }
+
+                // the completions are dispatched by the background work,
+                // make progress here as well
+                hpx::util::yield_while(
+                    [this]() {
+                        uring_->poll();
+                        return operation_in_flight_ != 0;
+                    },
+                    "tcp::receiver::shutdown");
+                return;
+            }
+#endif
             std::lock_guard lk(mtx_);
 
             // gracefully and portably shutdown the socket
@@ -206,7 +278,7 @@ namespace hpx::parcelset::policies::tcp {
                         chunks.size() * sizeof(transmission_chunk_type)));
 
                     // add main buffer holding data which was serialized normally
-                    buffer_.data_.resize(
+                    parcelport_.get_buffer_pool().resize(buffer_.data_,
                         static_cast<std::size_t>(inbound_size));
                     buffers.push_back(asio::buffer(buffer_.data_));
 
@@ -216,7 +288,7 @@ namespace hpx::parcelset::policies::tcp {
                 else
                 {
                     // add main buffer holding data which was serialized normally
-                    buffer_.data_.resize(
+                    parcelport_.get_buffer_pool().resize(buffer_.data_,
                         static_cast<std::size_t>(inbound_size));
                     buffers.push_back(asio::buffer(buffer_.data_));
 
@@ -276,7 +348,8 @@ namespace hpx::parcelset::policies::tcp {
                 {
                     std::size_t chunk_size = static_cast<std::size_t>(
                         buffer_.transmission_chunks_[i].second);
-                    buffer_.chunks_[i].resize(chunk_size);
+                    parcelport_.get_buffer_pool().resize(
+                        buffer_.chunks_[i], chunk_size);
                     buffers.push_back(
                         asio::buffer(buffer_.chunks_[i].data(), chunk_size));
                 }
@@ -376,6 +449,352 @@ namespace hpx::parcelset::policies::tcp {
             }
         }
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        enum uring_state
+        {
+            uring_read_header,
+            uring_read_data,
+            uring_read_chunks
+        };
+
+        // Submit the given operation if the socket is still open
+        template <typename Operation, typename F>
+        bool submit_uring(Operation& op, F&& f)
+        {
+            std::lock_guard lk(mtx_);
+            if (!socket_.is_open())
+            {
+                return false;
+            }
+            op.keep_alive_ = shared_from_this();
+            f(socket_.native_handle());
+            return true;
+        }
+
+        void begin_message_uring()
+        {
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            parcelset::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.serialization_time_ = 0;
+            data.bytes_ = 0;
+            data.num_parcels_ = 0;
+#endif
+            uring_state_ = uring_read_header;
+            targets_.clear();
+            targets_.push_back(iovec{&buffer_.size_, sizeof(buffer_.size_)});
+            targets_.push_back(
+                iovec{&buffer_.data_size_, sizeof(buffer_.data_size_)});
+            targets_.push_back(
+                iovec{&buffer_.num_chunks_, sizeof(buffer_.num_chunks_)});
+            target_idx_ = 0;
+        }
+
+        // Number of bytes still missing for the current part of the message
+        std::size_t remaining_uring() const noexcept
+        {
+            std::size_t size = 0;
+            for (std::size_t i = target_idx_; i != targets_.size(); ++i)
+            {
+                size += targets_[i].iov_len;
+            }
+            return size;
+        }
+
+        // Skip all filled buffers, set up the buffers for the next part of
+        // the message once the current part has been received completely.
+        void advance_uring()
+        {
+            while (!failed_)
+            {
+                while (target_idx_ != targets_.size() &&
+                    targets_[target_idx_].iov_len == 0)
+                {
+                    ++target_idx_;
+                }
+                if (target_idx_ != targets_.size())
+                {
+                    return;
+                }
+                next_part_uring();
+            }
+        }
+
+        void next_part_uring()
+        {
+            std::size_t const num_zero_copy_chunks = static_cast<std::size_t>(
+                static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+            targets_.clear();
+            target_idx_ = 0;
+
+            switch (uring_state_)
+            {
+            case uring_read_header:
+            {
+                if (buffer_.size_ > max_inbound_size_)
+                {
+                    // report this problem back to the handler
+                    fail_uring(asio::error::make_error_code(
+                        asio::error::operation_not_supported));
+                    return;
+                }
+                ++operation_in_flight_;
+
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+                buffer_.data_point_.bytes_ =
+                    static_cast<std::size_t>(buffer_.size_);
+#endif
+                if (num_zero_copy_chunks != 0)
+                {
+                    using transmission_chunk_type =
+                        parcel_buffer_type::transmission_chunk_type;
+
+                    std::vector<transmission_chunk_type>& chunks =
+                        buffer_.transmission_chunks_;
+
+                    chunks.resize(num_zero_copy_chunks +
+                        static_cast<std::size_t>(static_cast<std::uint32_t>(
+                            buffer_.num_chunks_.second)));
+                    targets_.push_back(iovec{chunks.data(),
+                        chunks.size() * sizeof(transmission_chunk_type)});
+                }
+
+                parcelport_.get_buffer_pool().resize(
+                    buffer_.data_, static_cast<std::size_t>(buffer_.size_));
+                targets_.push_back(
+                    iovec{buffer_.data_.data(), buffer_.data_.size()});
+
+                uring_state_ = uring_read_data;
+                break;
+            }
+
+            case uring_read_data:
+                if (num_zero_copy_chunks != 0)
+                {
+                    // receive the zero-copy chunks directly into
+                    // appropriately sized chunk buffers
+                    buffer_.chunks_.resize(num_zero_copy_chunks);
+                    for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+                    {
+                        std::vector<char>& chunk = buffer_.chunks_[i];
+                        parcelport_.get_buffer_pool().resize(chunk,
+                            static_cast<std::size_t>(
+                                buffer_.transmission_chunks_[i].second));
+                        targets_.push_back(iovec{chunk.data(), chunk.size()});
+                    }
+
+                    uring_state_ = uring_read_chunks;
+                    break;
+                }
+                [[fallthrough]];
+
+            case uring_read_chunks:
+                message_complete_uring();
+                return;
+
+            default:
+                HPX_ASSERT(false);
+                break;
+            }
+
+            // large parts of the message are received without copying them
+            // from the receive buffers
+            if (armed_ && !direct_ &&
+                remaining_uring() >= direct_threshold_uring())
+            {
+                direct_ = true;
+                uring_->async_cancel(&recv_op_);
+            }
+        }
+
+        std::size_t direct_threshold_uring() const noexcept
+        {
+            return 4 * std::size_t(uring_->buffer_size());
+        }
+
+        void message_complete_uring()
+        {
+#if defined(HPX_HAVE_PARCELPORT_COUNTERS)
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+#endif
+            // decode the received parcels.
+            decode_parcels(parcelport_, HPX_MOVE(buffer_), std::size_t(-1));
+            buffer_ = parcel_buffer_type();
+
+            // now send acknowledgment byte
+            ack_ = true;
+            if (!submit_uring(send_ack_op_, [&](int fd) {
+                    uring_->async_send(fd, &ack_, sizeof(ack_), &send_ack_op_);
+                }))
+            {
+                fail_uring(
+                    asio::error::make_error_code(asio::error::not_connected));
+                return;
+            }
+
+            begin_message_uring();
+        }
+
+        // Continue receiving after the receive operation has been disarmed
+        // or after a direct receive has completed.
+        void continue_read_uring()
+        {
+            if (failed_)
+            {
+                return;
+            }
+
+            std::size_t const remaining = remaining_uring();
+            if (uring_state_ != uring_read_header && remaining != 0 &&
+                (direct_ || remaining >= direct_threshold_uring()))
+            {
+                direct_ = true;
+
+                std::memset(&msg_, 0, sizeof(msg_));
+                msg_.msg_iov = &targets_[target_idx_];
+                msg_.msg_iovlen = targets_.size() - target_idx_;
+                if (!submit_uring(recv_direct_op_, [&](int fd) {
+                        uring_->async_recvmsg(fd, &msg_, &recv_direct_op_);
+                    }))
+                {
+                    fail_uring(asio::error::make_error_code(
+                        asio::error::not_connected));
+                }
+                return;
+            }
+
+            direct_ = false;
+            armed_ = true;
+            if (!submit_uring(recv_op_, [&](int fd) {
+                    uring_->async_recv(fd, &recv_op_);
+                }))
+            {
+                armed_ = false;
+                fail_uring(
+                    asio::error::make_error_code(asio::error::not_connected));
+            }
+        }
+
+        // Report an error to the handler, stop receiving afterwards
+        void fail_uring(std::error_code const& e)
+        {
+            if (failed_)
+            {
+                return;
+            }
+            failed_ = true;
+
+            if (uring_state_ != uring_read_header)
+            {
+                --operation_in_flight_;
+            }
+            if (armed_)
+            {
+                uring_->async_cancel(&recv_op_);
+            }
+
+            hpx::move_only_function<void(std::error_code const&)> handler;
+            std::swap(handler, uring_handler_);
+            if (handler)
+            {
+                handler(e);
+            }
+        }
+
+        static std::error_code make_error_code_uring(int res)
+        {
+            if (res == 0)
+            {
+                return asio::error::make_error_code(asio::error::eof);
+            }
+            return std::error_code(-res, std::system_category());
+        }
+
+        // Handle a completion of the receive operation
+        void handle_recv_uring(int res, std::uint32_t flags)
+        {
+            if (flags & IORING_CQE_F_BUFFER)
+            {
+                char const* data = uring_->buffer(flags);
+                std::size_t size = res > 0 ? static_cast<std::size_t>(res) : 0;
+                while (size != 0 && !failed_)
+                {
+                    iovec& target = targets_[target_idx_];
+                    std::size_t const count = (std::min)(size, target.iov_len);
+                    std::memcpy(target.iov_base, data, count);
+                    target.iov_base =
+                        static_cast<char*>(target.iov_base) + count;
+                    target.iov_len -= count;
+                    data += count;
+                    size -= count;
+                    advance_uring();
+                }
+                uring_->recycle_buffer(flags);
+            }
+
+            if (flags & IORING_CQE_F_MORE)
+            {
+                return;
+            }
+
+            // the receive operation has been disarmed, it is re-armed if it
+            // received data (without multishot support), ran out of buffers,
+            // or has been cancelled deliberately
+            armed_ = false;
+            if (res <= 0 && res != -ENOBUFS && res != -ECANCELED)
+            {
+                fail_uring(make_error_code_uring(res));
+                return;
+            }
+            continue_read_uring();
+        }
+
+        // Handle the completion of a direct receive operation
+        void handle_recv_direct_uring(int res, std::uint32_t /* flags */)
+        {
+            if (res <= 0)
+            {
+                fail_uring(make_error_code_uring(res));
+                return;
+            }
+
+            // the data has been placed into the buffers already
+            std::size_t size = static_cast<std::size_t>(res);
+            for (std::size_t i = target_idx_; i != targets_.size() && size != 0;
+                 ++i)
+            {
+                iovec& target = targets_[i];
+                std::size_t const count = (std::min)(size, target.iov_len);
+                target.iov_base = static_cast<char*>(target.iov_base) + count;
+                target.iov_len -= count;
+                size -= count;
+            }
+            advance_uring();
+            continue_read_uring();
+        }
+
+        // Handle the completion of sending the acknowledgment byte
+        void handle_send_ack_uring(int res, std::uint32_t /* flags */)
+        {
+            HPX_ASSERT(operation_in_flight_ != 0);
+            --operation_in_flight_;
+
+            if (res <= 0)
+            {
+                fail_uring(make_error_code_uring(res));
+                return;
+            }
+
+            // Inform caller that data has been received ok.
+            if (uring_handler_)
+            {
+                uring_handler_(std::error_code());
+            }
+        }
+#endif
+
         // Socket for the parcelport_connection.
         asio::ip::tcp::socket socket_;
 
@@ -392,6 +811,29 @@ namespace hpx::parcelset::policies::tcp {
 #endif
         hpx::spinlock mtx_;
         hpx::util::atomic_count operation_in_flight_;
+
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        io_uring_service* uring_;
+        hpx::move_only_function<void(std::error_code const&)> uring_handler_;
+
+        // the buffers receiving the current part of the message
+        uring_state uring_state_;
+        std::vector<iovec> targets_;
+        std::size_t target_idx_;
+        msghdr msg_;
+
+        bool armed_;     // the receive operation is active
+        bool direct_;    // receive directly into targets_
+        bool failed_;
+
+        io_uring_member_operation<receiver, &receiver::handle_recv_uring>
+            recv_op_;
+        io_uring_member_operation<receiver,
+            &receiver::handle_recv_direct_uring>
+            recv_direct_op_;
+        io_uring_member_operation<receiver, &receiver::handle_send_ack_uring>
+            send_ack_op_;
+#endif
     };
 }    // namespace hpx::parcelset::policies::tcp
 
@@ -19,6 +19,7 @@
 #include <hpx/modules/threading_base.hpp>
 #include <hpx/modules/timing.hpp>
 
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
 #include <hpx/parcelport_tcp/locality.hpp>
 #include <hpx/parcelset/parcelport_connection.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
@@ -41,11 +42,18 @@
 #undef VT2
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <system_error>
 #include <utility>
 #include <vector>
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
 namespace hpx::parcelset::policies::tcp {
 
     class sender
@@ -57,12 +65,20 @@ namespace hpx::parcelset::policies::tcp {
     public:
         // Construct a sending parcelport_connection with the given io_context.
         sender(asio::io_context& io_service,
-            parcelset::locality const& locality_id, parcelset::parcelport* pp)
+            parcelset::locality const& locality_id, parcelset::parcelport* pp
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            ,
+            io_uring_service* uring = nullptr
+#endif
+            )
           : socket_(io_service)
           , ack_(0)
           , there_(locality_id)
 #if defined(HPX_HAVE_PARCELPORT_COUNTERS)
           , pp_(pp)
+#endif
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+          , uring_(uring)
 #endif
         {
 #if not defined(HPX_HAVE_PARCELPORT_COUNTERS)
@@ -179,6 +195,21 @@ namespace hpx::parcelset::policies::tcp {
                 buffers.push_back(asio::buffer(buffer_.data_));
             }
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            if (uring_ != nullptr)
+            {
+                // the whole message is written by a single (batched)
+                // submission, which is completed by the background work
+                iovecs_.clear();
+                for (asio::const_buffer const& b : buffers)
+                {
+                    iovecs_.push_back(
+                        iovec{const_cast<void*>(b.data()), b.size()});
+                }
+                async_write_uring();
+                return;
+            }
+#endif
             // this additional wrapping of the handler into a bind object is
             // needed to keep  this parcelport_connection object alive for the
             // whole write operation
@@ -248,6 +279,15 @@ namespace hpx::parcelset::policies::tcp {
             socket_.set_option(quickack);
 #endif
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            if (uring_ != nullptr)
+            {
+                read_ack_op_.keep_alive_ = shared_from_this();
+                uring_->async_recvmsg(
+                    socket_.native_handle(), &ack_msg_, &read_ack_op_);
+                return;
+            }
+#endif
             void (sender::*f)(std::error_code const&) =
                 &sender::handle_read_ack;
 
@@ -272,6 +312,68 @@ namespace hpx::parcelset::policies::tcp {
             postprocess_handler(e, there_, shared_from_this());
         }
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        void async_write_uring()
+        {
+            std::memset(&msg_, 0, sizeof(msg_));
+            msg_.msg_iov = iovecs_.data();
+            msg_.msg_iovlen = iovecs_.size();
+
+            write_op_.keep_alive_ = shared_from_this();
+            uring_->async_sendmsg(socket_.native_handle(), &msg_, &write_op_);
+        }
+
+        void handle_write_uring(int res, std::uint32_t /* flags */)
+        {
+            if (res < 0)
+            {
+                handle_write(
+                    std::error_code(-res, std::system_category()), 0);
+                return;
+            }
+
+            // continue with the remainder of a partially written message
+            std::size_t bytes = static_cast<std::size_t>(res);
+            while (msg_.msg_iovlen != 0 && bytes >= msg_.msg_iov->iov_len)
+            {
+                bytes -= msg_.msg_iov->iov_len;
+                ++msg_.msg_iov;
+                --msg_.msg_iovlen;
+            }
+
+            if (msg_.msg_iovlen != 0)
+            {
+                msg_.msg_iov->iov_base =
+                    static_cast<char*>(msg_.msg_iov->iov_base) + bytes;
+                msg_.msg_iov->iov_len -= bytes;
+
+                write_op_.keep_alive_ = shared_from_this();
+                uring_->async_sendmsg(
+                    socket_.native_handle(), &msg_, &write_op_);
+                return;
+            }
+
+            handle_write(std::error_code(), 0);
+        }
+
+        void handle_read_ack_uring(int res, std::uint32_t /* flags */)
+        {
+            if (res < 0)
+            {
+                handle_read_ack(std::error_code(-res, std::system_category()));
+            }
+            else if (res == 0)
+            {
+                handle_read_ack(
+                    asio::error::make_error_code(asio::error::eof));
+            }
+            else
+            {
+                handle_read_ack(std::error_code());
+            }
+        }
+#endif
+
         // Socket for the parcelport_connection.
         asio::ip::tcp::socket socket_;
 
@@ -290,6 +392,21 @@ namespace hpx::parcelset::policies::tcp {
         hpx::move_only_function<void(std::error_code const&,
             parcelset::locality const&, std::shared_ptr<sender>)>
             postprocess_handler_;
+
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        io_uring_service* uring_;
+
+        std::vector<iovec> iovecs_;
+        msghdr msg_;
+
+        iovec ack_iovec_{&ack_, sizeof(ack_)};
+        msghdr ack_msg_{nullptr, 0, &ack_iovec_, 1, nullptr, 0, 0};
+
+        io_uring_member_operation<sender, &sender::handle_write_uring>
+            write_op_;
+        io_uring_member_operation<sender, &sender::handle_read_ack_uring>
+            read_ack_op_;
+#endif
     };
 }    // namespace hpx::parcelset::policies::tcp
 
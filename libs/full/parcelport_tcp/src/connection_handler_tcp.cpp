@@ -15,10 +15,13 @@
 #include <hpx/modules/asio.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/functional.hpp>
+#include <hpx/modules/logging.hpp>
 #include <hpx/modules/runtime_configuration.hpp>
+#include <hpx/modules/runtime_local.hpp>
 #include <hpx/modules/util.hpp>
 
 #include <hpx/parcelport_tcp/connection_handler.hpp>
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
 #include <hpx/parcelport_tcp/locality.hpp>
 #include <hpx/parcelport_tcp/receiver.hpp>
 #include <hpx/parcelport_tcp/sender.hpp>
@@ -36,6 +39,7 @@
 #include <string>
 #include <system_error>
 #include <thread>
+#include <utility>
 
 namespace hpx::parcelset::policies::tcp {
 
@@ -72,6 +76,35 @@ namespace hpx::parcelset::policies::tcp {
                 "locality type: {}",
                 here_.type());
         }
+
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        if (hpx::util::get_entry_as<int>(ini, "hpx.parcel.tcp.io_uring", 1))
+        {
+            error_code ec(throwmode::lightweight);
+            uring_ = std::make_unique<io_uring_service>(
+                hpx::util::get_entry_as<std::uint32_t>(ini,
+                    "hpx.parcel.tcp.io_uring_entries",
+                    HPX_PARCEL_TCP_IO_URING_ENTRIES),
+                hpx::util::get_entry_as<std::uint32_t>(ini,
+                    "hpx.parcel.tcp.io_uring_buffers",
+                    HPX_PARCEL_TCP_IO_URING_BUFFERS),
+                hpx::util::get_entry_as<std::uint32_t>(ini,
+                    "hpx.parcel.tcp.io_uring_buffer_size",
+                    HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE),
+                hpx::util::get_entry_as<int>(
+                    ini, "hpx.parcel.tcp.io_uring_multishot", 1) != 0,
+                ec);
+
+            // fall back to asio if io_uring is not available at runtime
+            if (ec)
+            {
+                LPT_(warning).format("tcp::connection_handler: using asio "
+                                     "instead of io_uring: {}",
+                    ec.get_message());
+                uring_.reset();
+            }
+        }
+#endif
     }
 
     connection_handler::~connection_handler()
@@ -86,6 +119,17 @@ namespace hpx::parcelset::policies::tcp {
         if (nullptr == acceptor_)
             acceptor_ = new tcp::acceptor(io_service);
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        if (uring_)
+        {
+            for (std::size_t i = 0; i != io_service_pool_.size(); ++i)
+            {
+                io_service_pool_.get_io_service(int(i)).post(hpx::bind(
+                    &connection_handler::io_service_work, this, i));
+            }
+        }
+#endif
+
         // initialize network
         std::size_t tried = 0;
         exception_list errors;
@@ -97,7 +141,12 @@ namespace hpx::parcelset::policies::tcp {
             try
             {
                 std::shared_ptr<receiver> receiver_conn(new receiver(
-                    io_service, get_max_inbound_message_size(), *this));
+                    io_service, get_max_inbound_message_size(), *this
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+                    ,
+                    uring_.get()
+#endif
+                        ));
 
                 tcp::endpoint ep = *it;
                 acceptor_->open(ep.protocol());
@@ -128,17 +177,22 @@ namespace hpx::parcelset::policies::tcp {
     void connection_handler::do_stop()
     {
         {
-            // cancel all pending read operations, close those sockets
-            std::lock_guard<hpx::spinlock> l(connections_mtx_);
-            for (std::shared_ptr<receiver> const& c : accepted_connections_)
+            // cancel all pending read operations, close those sockets (the
+            // lock is not held while doing so as the read handlers remove
+            // their connection from the list of accepted connections)
+            accepted_connections_set connections;
             {
-                c->shutdown();
-            }
-
-            accepted_connections_.clear();
+                std::lock_guard<hpx::spinlock> l(connections_mtx_);
+                std::swap(connections, accepted_connections_);
 #if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
-            write_connections_.clear();
+                write_connections_.clear();
 #endif
+            }
+
+            for (std::shared_ptr<receiver> const& c : connections)
+            {
+                c->shutdown();
+            }
         }
         if (acceptor_ != nullptr)
         {
@@ -156,8 +210,13 @@ namespace hpx::parcelset::policies::tcp {
 
         // The parcel gets serialized inside the connection constructor, no
         // need to keep the original parcel alive after this call returned.
-        std::shared_ptr<sender> sender_connection(
-            new sender(io_service, l, this));
+        std::shared_ptr<sender> sender_connection(new sender(io_service, l,
+            this
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            ,
+            uring_.get()
+#endif
+            ));
 
         // Connect to the target locality, retry if needed
         std::error_code error = asio::error::try_again;
@@ -276,6 +335,27 @@ namespace hpx::parcelset::policies::tcp {
         return parcelset::locality(locality());
     }
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+    bool connection_handler::background_work(
+        std::size_t /* num_thread */, parcelport_background_mode /* mode */)
+    {
+        return uring_ && uring_->poll();
+    }
+
+    void connection_handler::io_service_work(std::size_t i)
+    {
+        // We only dispatch the completions on the IO service while HPX is
+        // starting, the handler is re-posted to allow for other handlers
+        // (e.g. accepting connections) to run in between.
+        if (hpx::is_starting())
+        {
+            uring_->poll();
+            io_service_pool_.get_io_service(int(i)).post(
+                hpx::bind(&connection_handler::io_service_work, this, i));
+        }
+    }
+#endif
+
     // accepted new incoming connection
     void connection_handler::handle_accept(
         std::error_code const& e, std::shared_ptr<receiver> receiver_conn)
@@ -286,8 +366,13 @@ namespace hpx::parcelset::policies::tcp {
             std::shared_ptr<receiver> c(receiver_conn);
 
             asio::io_context& io_service = io_service_pool_.get_io_service();
-            receiver_conn.reset(new receiver(
-                io_service, get_max_inbound_message_size(), *this));
+            receiver_conn.reset(new receiver(io_service,
+                get_max_inbound_message_size(), *this
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+                ,
+                uring_.get()
+#endif
+                ));
             acceptor_->async_accept(receiver_conn->socket(),
                 hpx::bind(&connection_handler::handle_accept, this,
                     placeholders::_1, receiver_conn));
@@ -0,0 +1,536 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP) &&        \
+    defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/assert.hpp>
+#include <hpx/lock_registration/detail/register_locks.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/logging.hpp>
+
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace hpx::parcelset::policies::tcp {
+
+    namespace {
+
+        // the buffer group of the registered receive buffers
+        constexpr std::uint16_t buffer_group = 0;
+
+        int io_uring_setup(std::uint32_t entries, io_uring_params* p) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+        }
+
+        int io_uring_enter(int fd, std::uint32_t to_submit,
+            std::uint32_t min_complete, std::uint32_t flags) noexcept
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd,
+                to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        int io_uring_register(int fd, std::uint32_t opcode, void const* arg,
+            std::uint32_t nr_args) noexcept
+        {
+            return static_cast<int>(
+                ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+        }
+
+        // The ring indices are shared with the kernel
+        template <typename T>
+        T load_acquire(T const* p) noexcept
+        {
+            return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+        }
+
+        template <typename T>
+        void store_release(T* p, T value) noexcept
+        {
+            __atomic_store_n(p, value, __ATOMIC_RELEASE);
+        }
+
+        template <typename T>
+        T* at(void* base, std::uint32_t offset) noexcept
+        {
+            return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+        }
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    io_uring_service::io_uring_service(std::uint32_t entries,
+        std::uint32_t num_buffers, std::uint32_t buffer_size, bool multishot,
+        error_code& ec)
+      : ring_fd_(-1)
+      , num_buffers_(num_buffers)
+      , buffer_size_(buffer_size)
+      , multishot_(false)
+      , sq_khead_(nullptr)
+      , sq_ktail_(nullptr)
+      , sq_kflags_(nullptr)
+      , sq_mask_(0)
+      , sq_entries_(0)
+      , sq_tail_(0)
+      , sqes_(nullptr)
+      , cq_khead_(nullptr)
+      , cq_ktail_(nullptr)
+      , cq_mask_(0)
+      , cqes_(nullptr)
+      , buf_ring_(nullptr)
+      , buffers_(nullptr)
+      , sq_ring_(MAP_FAILED)
+      , sq_ring_size_(0)
+      , cq_ring_(MAP_FAILED)
+      , cq_ring_size_(0)
+      , sqes_size_(0)
+    {
+        if (entries == 0 || num_buffers_ == 0 || num_buffers_ > 32768 ||
+            (num_buffers_ & (num_buffers_ - 1)) != 0 || buffer_size_ == 0)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "tcp::io_uring_service::io_uring_service",
+                "invalid io_uring configuration: the number of entries ({}) "
+                "must be positive, the number of buffers ({}) must be a "
+                "power of two not larger than 32768, and the buffer size "
+                "({}) must be positive",
+                entries, num_buffers_, buffer_size_);
+            return;
+        }
+
+        // The completion queue is made large enough to hold the completions
+        // of (multishot) receives in addition to a full submission queue.
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+        p.cq_entries = 4 * entries;
+
+        int fd = io_uring_setup(entries, &p);
+        if (fd < 0)
+        {
+            HPX_THROWS_IF(ec, network_error,
+                "tcp::io_uring_service::io_uring_service",
+                "could not create io_uring instance: {}", std::strerror(errno));
+            return;
+        }
+        ring_fd_ = fd;
+
+        sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(std::uint32_t);
+        cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            sq_ring_size_ = (std::max)(sq_ring_size_, cq_ring_size_);
+            cq_ring_size_ = sq_ring_size_;
+        }
+
+        sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ != MAP_FAILED)
+        {
+            if (p.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                cq_ring_ = sq_ring_;
+            }
+            else
+            {
+                cq_ring_ = ::mmap(nullptr, cq_ring_size_,
+                    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd_, IORING_OFF_CQ_RING);
+            }
+        }
+
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = MAP_FAILED;
+        if (cq_ring_ != MAP_FAILED)
+        {
+            sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+        }
+
+        if (sqes == MAP_FAILED)
+        {
+            int const error = errno;
+            close();
+            HPX_THROWS_IF(ec, network_error,
+                "tcp::io_uring_service::io_uring_service",
+                "could not map io_uring queues: {}", std::strerror(error));
+            return;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        sq_khead_ = at<std::uint32_t>(sq_ring_, p.sq_off.head);
+        sq_ktail_ = at<std::uint32_t>(sq_ring_, p.sq_off.tail);
+        sq_kflags_ = at<std::uint32_t>(sq_ring_, p.sq_off.flags);
+        sq_mask_ = *at<std::uint32_t>(sq_ring_, p.sq_off.ring_mask);
+        sq_entries_ = p.sq_entries;
+        sq_tail_ = *sq_ktail_;
+
+        // submission queue entries are used in order
+        std::uint32_t* array = at<std::uint32_t>(sq_ring_, p.sq_off.array);
+        for (std::uint32_t i = 0; i != sq_entries_; ++i)
+        {
+            array[i] = i;
+        }
+
+        cq_khead_ = at<std::uint32_t>(cq_ring_, p.cq_off.head);
+        cq_ktail_ = at<std::uint32_t>(cq_ring_, p.cq_off.tail);
+        cq_mask_ = *at<std::uint32_t>(cq_ring_, p.cq_off.ring_mask);
+        cqes_ = at<io_uring_cqe>(cq_ring_, p.cq_off.cqes);
+
+        // create and register the ring of receive buffers
+        void* buf_ring = ::mmap(nullptr, num_buffers_ * sizeof(io_uring_buf),
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        void* buffers = MAP_FAILED;
+        if (buf_ring != MAP_FAILED)
+        {
+            buf_ring_ = static_cast<io_uring_buf*>(buf_ring);
+            buffers = ::mmap(nullptr, std::size_t(num_buffers_) * buffer_size_,
+                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+
+        int result = -1;
+        if (buffers != MAP_FAILED)
+        {
+            buffers_ = static_cast<char*>(buffers);
+
+            io_uring_buf_reg reg;
+            std::memset(&reg, 0, sizeof(reg));
+            reg.ring_addr = reinterpret_cast<std::uint64_t>(buf_ring_);
+            reg.ring_entries = num_buffers_;
+            reg.bgid = buffer_group;
+            result = io_uring_register(
+                ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1);
+        }
+
+        if (result < 0)
+        {
+            int const error = errno;
+            close();
+            HPX_THROWS_IF(ec, network_error,
+                "tcp::io_uring_service::io_uring_service",
+                "could not register io_uring receive buffers: {}",
+                std::strerror(error));
+            return;
+        }
+
+        for (std::uint32_t i = 0; i != num_buffers_; ++i)
+        {
+            add_buffer(static_cast<std::uint16_t>(i));
+        }
+
+        // Older kernels reject multishot receives, each receive is re-armed
+        // after its completion in this case.
+        multishot_ = multishot && probe_multishot_recv();
+        if (!multishot_)
+        {
+            LPT_(info).format("tcp::io_uring_service: multishot receive "
+                              "operations are not used");
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    io_uring_service::~io_uring_service()
+    {
+        close();
+    }
+
+    void io_uring_service::close() noexcept
+    {
+        if (buffers_ != nullptr)
+        {
+            ::munmap(buffers_, std::size_t(num_buffers_) * buffer_size_);
+            buffers_ = nullptr;
+        }
+        if (buf_ring_ != nullptr)
+        {
+            ::munmap(buf_ring_, num_buffers_ * sizeof(io_uring_buf));
+            buf_ring_ = nullptr;
+        }
+        if (sqes_ != nullptr)
+        {
+            ::munmap(sqes_, sqes_size_);
+            sqes_ = nullptr;
+        }
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+        {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        cq_ring_ = MAP_FAILED;
+        if (sq_ring_ != MAP_FAILED)
+        {
+            ::munmap(sq_ring_, sq_ring_size_);
+            sq_ring_ = MAP_FAILED;
+        }
+        if (ring_fd_ != -1)
+        {
+            ::close(ring_fd_);
+            ring_fd_ = -1;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void io_uring_service::async_sendmsg(
+        int fd, msghdr const* msg, io_uring_operation* op)
+    {
+        std::lock_guard l(sq_mtx_);
+        io_uring_sqe* sqe = get_sqe(op, IORING_OP_SENDMSG, fd);
+        sqe->addr = reinterpret_cast<std::uint64_t>(msg);
+        sqe->len = 1;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        commit_sqe();
+    }
+
+    void io_uring_service::async_recvmsg(
+        int fd, msghdr* msg, io_uring_operation* op)
+    {
+        std::lock_guard l(sq_mtx_);
+        io_uring_sqe* sqe = get_sqe(op, IORING_OP_RECVMSG, fd);
+        sqe->addr = reinterpret_cast<std::uint64_t>(msg);
+        sqe->len = 1;
+        sqe->msg_flags = MSG_WAITALL;
+        commit_sqe();
+    }
+
+    void io_uring_service::async_send(
+        int fd, void const* data, std::size_t size, io_uring_operation* op)
+    {
+        std::lock_guard l(sq_mtx_);
+        io_uring_sqe* sqe = get_sqe(op, IORING_OP_SEND, fd);
+        sqe->addr = reinterpret_cast<std::uint64_t>(data);
+        sqe->len = static_cast<std::uint32_t>(size);
+        sqe->msg_flags = MSG_NOSIGNAL;
+        commit_sqe();
+    }
+
+    void io_uring_service::async_recv(int fd, io_uring_operation* op)
+    {
+        std::lock_guard l(sq_mtx_);
+        prep_recv(fd, op, multishot_);
+    }
+
+    void io_uring_service::prep_recv(
+        int fd, io_uring_operation* op, bool multishot) noexcept
+    {
+        io_uring_sqe* sqe = get_sqe(op, IORING_OP_RECV, fd);
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->ioprio = multishot ? IORING_RECV_MULTISHOT : 0;
+        sqe->buf_group = buffer_group;
+        commit_sqe();
+    }
+
+    void io_uring_service::async_cancel(io_uring_operation* op)
+    {
+        std::lock_guard l(sq_mtx_);
+
+        // the completion of the cancellation itself is not reported
+        io_uring_sqe* sqe = get_sqe(nullptr, IORING_OP_ASYNC_CANCEL, -1);
+        sqe->addr = reinterpret_cast<std::uint64_t>(op);
+        commit_sqe();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    char const* io_uring_service::buffer(std::uint32_t flags) const noexcept
+    {
+        HPX_ASSERT(flags & IORING_CQE_F_BUFFER);
+        std::size_t const bid = flags >> IORING_CQE_BUFFER_SHIFT;
+        return buffers_ + bid * buffer_size_;
+    }
+
+    void io_uring_service::recycle_buffer(std::uint32_t flags) noexcept
+    {
+        HPX_ASSERT(flags & IORING_CQE_F_BUFFER);
+        add_buffer(
+            static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT));
+    }
+
+    void io_uring_service::add_buffer(std::uint16_t bid) noexcept
+    {
+        // The tail of the ring overlays the reserved field of its first
+        // entry (io_uring_buf_ring is not used as its flexible array member
+        // is placed differently by C++ compilers).
+        std::uint16_t* tail_ptr = &buf_ring_[0].resv;
+        std::uint16_t const tail = *tail_ptr;
+
+        io_uring_buf& buf = buf_ring_[tail & (num_buffers_ - 1)];
+        buf.addr = reinterpret_cast<std::uint64_t>(
+            buffers_ + std::size_t(bid) * buffer_size_);
+        buf.len = buffer_size_;
+        buf.bid = bid;
+
+        store_release(tail_ptr, static_cast<std::uint16_t>(tail + 1));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool io_uring_service::poll()
+    {
+        {
+            std::unique_lock l(sq_mtx_, std::try_to_lock);
+            if (l.owns_lock())
+            {
+                submit_locked();
+            }
+        }
+
+        std::unique_lock l(cq_mtx_, std::try_to_lock);
+        if (!l.owns_lock())
+        {
+            return false;
+        }
+
+        // The lock is held while the completion handlers are invoked, which
+        // may decode parcels and run their actions directly (those might
+        // suspend). Other threads do not wait for the lock, they skip polling.
+        util::ignore_while_checking il(&l);
+        HPX_UNUSED(il);
+
+        // move completions which did not fit into the completion queue
+        if (load_acquire(sq_kflags_) & IORING_SQ_CQ_OVERFLOW)
+        {
+            io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+        }
+
+        bool has_work = false;
+        std::uint32_t head = *cq_khead_;
+        while (head != load_acquire(cq_ktail_))
+        {
+            io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+            auto* op = reinterpret_cast<io_uring_operation*>(cqe.user_data);
+            int const res = cqe.res;
+            std::uint32_t const flags = cqe.flags;
+
+            // hand the entry back to the kernel before invoking the handler
+            store_release(cq_khead_, ++head);
+
+            if (op != nullptr)
+            {
+                op->complete(res, flags);
+            }
+            has_work = true;
+        }
+        return has_work;
+    }
+
+    io_uring_sqe* io_uring_service::get_sqe(
+        io_uring_operation* op, std::uint8_t opcode, int fd) noexcept
+    {
+        // make room if the submission queue is full
+        while (sq_tail_ - load_acquire(sq_khead_) == sq_entries_)
+        {
+            submit_locked();
+        }
+
+        io_uring_sqe* sqe = &sqes_[sq_tail_ & sq_mask_];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+        return sqe;
+    }
+
+    void io_uring_service::commit_sqe() noexcept
+    {
+        // the entry is made visible to the kernel only after it has been
+        // filled completely
+        store_release(sq_ktail_, ++sq_tail_);
+    }
+
+    // Submit a multishot receive for a socket which has data available
+    // already. Kernels supporting multishot receives keep the operation
+    // active after the first completion, older kernels reject it.
+    bool io_uring_service::probe_multishot_recv() noexcept
+    {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        {
+            return false;
+        }
+
+        bool supported = false;
+        char const data = 0;
+        if (::send(fds[1], &data, 1, MSG_NOSIGNAL) == 1)
+        {
+            {
+                std::lock_guard l(sq_mtx_);
+                prep_recv(fds[0], nullptr, true);
+                submit_locked();
+            }
+
+            // the probe ends with the first completion not having
+            // IORING_CQE_F_MORE set, shutting down the socket terminates
+            // an active multishot receive
+            bool done = false;
+            while (!done)
+            {
+                int const result =
+                    io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+                if (result < 0 && errno != EINTR)
+                {
+                    supported = false;
+                    break;
+                }
+
+                std::uint32_t head = *cq_khead_;
+                while (head != load_acquire(cq_ktail_))
+                {
+                    io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+                    if (cqe.flags & IORING_CQE_F_BUFFER)
+                    {
+                        recycle_buffer(cqe.flags);
+                    }
+                    if (cqe.flags & IORING_CQE_F_MORE)
+                    {
+                        supported = true;
+                        ::shutdown(fds[1], SHUT_WR);
+                    }
+                    else
+                    {
+                        done = true;
+                    }
+                    store_release(cq_khead_, ++head);
+                }
+            }
+        }
+
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return supported;
+    }
+
+    void io_uring_service::submit_locked() noexcept
+    {
+        std::uint32_t const pending = sq_tail_ - load_acquire(sq_khead_);
+        if (pending == 0)
+        {
+            return;
+        }
+
+        if (io_uring_enter(ring_fd_, pending, 0, 0) < 0 && errno != EINTR &&
+            errno != EAGAIN && errno != EBUSY)
+        {
+            LPT_(error).format(
+                "tcp::io_uring_service: submitting operations failed: {}",
+                std::strerror(errno));
+        }
+    }
+}    // namespace hpx::parcelset::policies::tcp
+
+#endif
@@ -7,6 +7,7 @@
 #include <hpx/config.hpp>
 
 #if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/modules/preprocessor.hpp>
 #include <hpx/plugin/traits/plugin_config_data.hpp>
 
 #include <hpx/parcelport_tcp/connection_handler.hpp>
@@ -39,7 +40,23 @@ namespace hpx::traits {
 
         static constexpr char const* call() noexcept
         {
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            return
+                // use io_uring instead of asio for all connections
+                "io_uring = ${HPX_PARCEL_TCP_IO_URING:1}\n"
+                // use multishot receives if supported by the kernel
+                "io_uring_multishot = ${HPX_PARCEL_TCP_IO_URING_MULTISHOT:1}\n"
+                // number of submission queue entries
+                "io_uring_entries = ${HPX_PARCEL_TCP_IO_URING_ENTRIES:"
+                HPX_PP_STRINGIZE(HPX_PARCEL_TCP_IO_URING_ENTRIES) "}\n"
+                // number and size of the registered receive buffers
+                "io_uring_buffers = ${HPX_PARCEL_TCP_IO_URING_BUFFERS:"
+                HPX_PP_STRINGIZE(HPX_PARCEL_TCP_IO_URING_BUFFERS) "}\n"
+                "io_uring_buffer_size = ${HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE:"
+                HPX_PP_STRINGIZE(HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE) "}\n";
+#else
             return "";
+#endif
         }
     };
 }    // namespace hpx::traits
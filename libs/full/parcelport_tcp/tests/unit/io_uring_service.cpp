@@ -0,0 +1,180 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test the io_uring instance used by the TCP parcelport with and without
+// multishot receive operations.
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/hpx_main.hpp>
+
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelport_tcp/io_uring_service.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using hpx::parcelset::policies::tcp::io_uring_operation;
+using hpx::parcelset::policies::tcp::io_uring_service;
+
+constexpr std::uint32_t buffer_size = 64;
+
+///////////////////////////////////////////////////////////////////////////////
+struct send_operation : io_uring_operation
+{
+    void complete(int res, std::uint32_t flags) override
+    {
+        HPX_TEST(!(flags & IORING_CQE_F_MORE));
+        result_ = res;
+        done_ = true;
+    }
+
+    int result_ = 0;
+    bool done_ = false;
+};
+
+struct recv_operation : io_uring_operation
+{
+    explicit recv_operation(io_uring_service& service)
+      : service_(service)
+    {
+    }
+
+    void complete(int res, std::uint32_t flags) override
+    {
+        ++completions_;
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            HPX_TEST_LT(0, res);
+            HPX_TEST_LTE(res, static_cast<int>(buffer_size));
+            data_.append(service_.buffer(flags), static_cast<std::size_t>(res));
+            service_.recycle_buffer(flags);
+        }
+
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            armed_ = false;
+            result_ = res;
+        }
+    }
+
+    io_uring_service& service_;
+    std::string data_;
+    std::size_t completions_ = 0;
+    int result_ = 0;
+    bool armed_ = false;
+};
+
+template <typename F>
+bool poll_until(io_uring_service& service, F&& f)
+{
+    auto const timeout =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!f())
+    {
+        if (std::chrono::steady_clock::now() > timeout)
+        {
+            return false;
+        }
+        if (!service.poll())
+        {
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_send_recv(io_uring_service& service)
+{
+    int fds[2];
+    HPX_TEST_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    std::string message;
+    for (std::size_t i = 0; i != 100 * buffer_size + 17; ++i)
+    {
+        message.push_back(static_cast<char>('a' + i % 26));
+    }
+
+    recv_operation recv_op(service);
+    recv_op.armed_ = true;
+    service.async_recv(fds[0], &recv_op);
+
+    send_operation send_op;
+    service.async_send(fds[1], message.data(), message.size(), &send_op);
+
+    // the receive has to be re-armed after each completion if it is not a
+    // multishot operation
+    HPX_TEST(poll_until(service, [&]() {
+        if (!recv_op.armed_ && recv_op.data_.size() != message.size())
+        {
+            HPX_TEST(recv_op.result_ > 0 || recv_op.result_ == -ENOBUFS);
+            recv_op.armed_ = true;
+            service.async_recv(fds[0], &recv_op);
+        }
+        return send_op.done_ && recv_op.data_.size() == message.size();
+    }));
+
+    HPX_TEST_EQ(send_op.result_, static_cast<int>(message.size()));
+    HPX_TEST(recv_op.data_ == message);
+    HPX_TEST_LTE(message.size() / buffer_size, recv_op.completions_);
+
+    // an active receive is completed once the peer has shut down the socket
+    if (!recv_op.armed_)
+    {
+        recv_op.armed_ = true;
+        service.async_recv(fds[0], &recv_op);
+    }
+    ::shutdown(fds[1], SHUT_WR);
+
+    HPX_TEST(poll_until(service, [&]() { return !recv_op.armed_; }));
+    HPX_TEST_EQ(recv_op.result_, 0);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+int main()
+{
+    for (bool multishot : {true, false})
+    {
+        hpx::error_code ec(hpx::throwmode::lightweight);
+        io_uring_service service(64, 8, buffer_size, multishot, ec);
+        if (ec)
+        {
+            // the parcelport falls back to asio in this case
+            std::cout << "io_uring is not available: " << ec.get_message()
+                      << std::endl;
+            return hpx::util::report_errors();
+        }
+
+        if (multishot)
+        {
+            std::cout << "multishot receives are "
+                      << (service.has_multishot_recv() ? "" : "not ")
+                      << "supported" << std::endl;
+        }
+        else
+        {
+            HPX_TEST(!service.has_multishot_recv());
+        }
+
+        test_send_recv(service);
+    }
+
+    return hpx::util::report_errors();
+}
+#endif
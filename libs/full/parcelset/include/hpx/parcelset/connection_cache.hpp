@@ -62,11 +62,17 @@ namespace hpx { namespace util {
         using cache_type = std::map<key_type, cache_value_type>;
         using size_type = typename cache_type::size_type;
 
-        connection_cache(
-            size_type max_connections, size_type max_connections_per_locality)
-          : max_connections_(max_connections < 2 ? 2 : max_connections)
-          , max_connections_per_locality_(max_connections_per_locality < 2 ?
-                    2 :
+        // The limits are raised to min_connections_per_locality if they are
+        // smaller.
+        connection_cache(size_type max_connections,
+            size_type max_connections_per_locality,
+            size_type min_connections_per_locality = 2)
+          : max_connections_(max_connections < min_connections_per_locality ?
+                    min_connections_per_locality :
+                    max_connections)
+          , max_connections_per_locality_(
+                max_connections_per_locality < min_connections_per_locality ?
+                    min_connections_per_locality :
                     max_connections_per_locality)
           , connections_(0)
           , shutting_down_(false)
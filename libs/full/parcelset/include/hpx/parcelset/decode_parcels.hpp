@@ -20,6 +20,7 @@
 
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/naming_base/id_type.hpp>
+#include <hpx/parcelset_base/detail/buffer_pool.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
 #include <hpx/parcelset_base/detail/parcel_route_handler.hpp>
 #include <hpx/parcelset_base/parcel_interface.hpp>
@@ -33,6 +34,7 @@
 #include <exception>
 #include <functional>
 #include <system_error>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -315,6 +317,26 @@ namespace hpx::parcelset {
             LPT_(error).format("decode_message: caught unknown exception.");
             hpx::report_error(std::current_exception());
         }
+
+        // all parcels have been de-serialized (which copies the data out of
+        // the zero-copy chunks), recycle the data buffers
+        using data_type = std::decay_t<decltype(buffer.data_)>;
+        if constexpr (std::is_same_v<data_type,
+                          parcelset::detail::buffer_pool::buffer_type>)
+        {
+            pp.get_buffer_pool().release(HPX_MOVE(buffer.data_));
+        }
+
+        using chunk_type =
+            typename std::decay_t<decltype(buffer.chunks_)>::value_type;
+        if constexpr (std::is_same_v<chunk_type,
+                          parcelset::detail::buffer_pool::buffer_type>)
+        {
+            for (auto& chunk : buffer.chunks_)
+            {
+                pp.get_buffer_pool().release(HPX_MOVE(chunk));
+            }
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
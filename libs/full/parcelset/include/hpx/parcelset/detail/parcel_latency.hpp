@@ -0,0 +1,158 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+#include <hpx/parcelset_base/parcel_interface.hpp>
+#include <hpx/threading_base/detail/latency_histogram.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx::parcelset::detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The intervals between the stages of a parcel for which the parcel
+    // latency statistics are collected. The transfer and total intervals span
+    // two localities and are meaningful only if the clocks of the involved
+    // nodes are synchronized.
+    enum class parcel_latency_interval : std::uint8_t
+    {
+        put = 0,         // created -> enqueued
+        queue = 1,       // enqueued -> serialized
+        send = 2,        // serialized -> written
+        transfer = 3,    // serialized -> received
+        decode = 4,      // received -> deserialized
+        schedule = 5,    // deserialized -> scheduled
+        start = 6,       // scheduled -> started
+        total = 7        // created -> started
+    };
+
+    inline constexpr std::size_t num_parcel_latency_intervals = 8;
+
+    HPX_EXPORT char const* get_parcel_latency_interval_name(
+        parcel_latency_interval interval) noexcept;
+
+    using parcel_timestamps = std::array<std::int64_t, num_parcel_stages>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Collects per-action histograms of the time spent by parcels between
+    // their stages and optionally writes the timestamps of all parcels to a
+    // trace file (hpx.parcel.latency_trace_file).
+    //
+    // The data is sharded by the recording (worker) thread, a parcel locks
+    // its (mostly uncontended) shard only and looks up the action by the
+    // address of its name. The trace records are buffered per shard and
+    // written to the file in batches, outside of the shard lock.
+    class HPX_EXPORT parcel_latency_statistics
+    {
+    public:
+        using histogram_type = threads::detail::latency_histogram;
+
+        parcel_latency_statistics();
+        ~parcel_latency_statistics();
+
+        parcel_latency_statistics(parcel_latency_statistics const&) = delete;
+        parcel_latency_statistics& operator=(
+            parcel_latency_statistics const&) = delete;
+
+        static parcel_latency_statistics& get();
+
+        // Record the intervals measured on the sending locality, invoked
+        // after the message containing the parcel was written.
+        void parcel_sent(parcel const& p, std::int64_t written);
+
+        // Record the intervals measured on the receiving locality, invoked
+        // when the action of the parcel starts executing.
+        void parcel_started(char const* action_name,
+            naming::gid_type const& parcel_id, std::uint32_t source_locality,
+            parcel_timestamps const& timestamps);
+
+        // Return the histogram (histogram_type::bucket_count values) for the
+        // given interval, accumulated over all actions if the action name is
+        // empty.
+        std::vector<std::int64_t> get_histogram(
+            parcel_latency_interval interval, std::string const& action,
+            bool reset);
+
+        // Write all buffered trace records to the trace file
+        void flush_trace();
+
+    private:
+        struct histograms
+        {
+            histogram_type histograms_[num_parcel_latency_intervals];
+        };
+
+        struct trace_record
+        {
+            char const* event;
+            char const* action_name;
+            naming::gid_type parcel_id;
+            std::uint32_t locality;
+            parcel_timestamps timestamps;
+        };
+
+        struct shard_data
+        {
+            hpx::spinlock mtx_;
+
+            // action names are static strings, they are identified by their
+            // address
+            std::unordered_map<char const*, std::unique_ptr<histograms>>
+                actions_;
+
+            std::vector<trace_record> trace_;
+        };
+        using shard = util::cache_aligned_data_derived<shard_data>;
+
+        static constexpr std::size_t num_shards = 16;
+        static constexpr std::size_t trace_buffer_size = 1024;
+
+        static std::size_t get_shard_index() noexcept;
+
+        void record(char const* event, char const* action_name,
+            naming::gid_type const& parcel_id, std::uint32_t locality,
+            parcel_timestamps const& timestamps,
+            parcel_latency_interval first, parcel_latency_interval last);
+
+        bool init_trace();
+        void write_trace(std::vector<trace_record> const& records);
+
+        shard shards_[num_shards];
+
+        // the trace file is opened on first use
+        enum class trace_state : std::uint8_t
+        {
+            unknown,
+            enabled,
+            disabled
+        };
+
+        hpx::spinlock trace_mtx_;
+        std::atomic<trace_state> trace_state_;
+        std::ofstream trace_;
+    };
+}    // namespace hpx::parcelset::detail
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
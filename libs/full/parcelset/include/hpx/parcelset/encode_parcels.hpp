@@ -37,6 +37,7 @@
 #include <memory>
 #include <string>
 #include <system_error>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -190,6 +191,19 @@ namespace hpx::parcelset {
                     num_chunks += ps[parcels_sent].num_chunks();
                 }
 
+                using data_type = std::decay_t<decltype(buffer.data_)>;
+                if constexpr (std::is_same_v<data_type,
+                                  detail::buffer_pool::buffer_type>)
+                {
+                    // replace a buffer which is too small by a pooled one
+                    if (buffer.data_.capacity() < arg_size)
+                    {
+                        detail::buffer_pool& pool = pp.get_buffer_pool();
+                        pool.release(std::exchange(
+                            buffer.data_, pool.get(arg_size)));
+                    }
+                }
+
                 buffer.data_.reserve(arg_size);
                 buffer.chunks_.reserve(num_chunks);
 
@@ -52,6 +52,7 @@ namespace hpx::parcelset::detail {
         naming::gid_type parcel_id_;
         double start_time_;
         double creation_time_;
+        std::int64_t timestamps_[num_parcel_stages];
 #endif
 
         bool has_continuation_;
@@ -138,6 +139,9 @@ namespace hpx::parcelset::detail {
         // generate unique parcel id
         naming::gid_type const& parcel_id() const override;
         naming::gid_type& parcel_id() override;
+
+        std::int64_t timestamp(parcel_stage stage) const override;
+        void set_timestamp(parcel_stage stage, std::int64_t time) override;
 #endif
 
     private:
@@ -151,6 +155,11 @@ namespace hpx::parcelset::detail {
 
         std::pair<naming::address_type, naming::component_type> determine_lva();
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        void schedule_thread(naming::address_type lva,
+            naming::component_type comptype, std::size_t num_thread);
+#endif
+
         detail::parcel_data data_;
         std::unique_ptr<actions::base_action> action_;
 
@@ -393,6 +393,11 @@ namespace hpx::parcelset {
         std::int64_t get_connection_cache_statistics(std::string const& pp_type,
             parcelport::connection_cache_statistics_type stat_type, bool) const;
 
+        // connection cache statistics of the given traffic class only
+        std::int64_t get_traffic_class_connection_cache_statistics(
+            std::string const& pp_type, parcelport::traffic_class tc,
+            parcelport::connection_cache_statistics_type stat_type, bool) const;
+
         void list_parcelports(std::ostringstream& strm) const;
         void list_parcelport(std::ostringstream& strm,
             std::string const& ppname, int priority, bool bootstrap) const;
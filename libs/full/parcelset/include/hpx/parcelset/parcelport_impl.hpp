@@ -24,6 +24,7 @@
 #include <hpx/modules/threading.hpp>
 #include <hpx/modules/type_support.hpp>
 #include <hpx/modules/util.hpp>
+#include <hpx/naming_base/naming_base.hpp>
 #include <hpx/util/from_string.hpp>
 
 #include <hpx/parcelset/connection_cache.hpp>
@@ -32,6 +33,7 @@
 #include <hpx/parcelset/encode_parcels.hpp>
 #include <hpx/parcelset_base/parcelport.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -58,6 +60,8 @@ namespace hpx::parcelset {
     {
         using connection = typename connection_handler_traits<
             ConnectionHandler>::connection_type;
+        using connection_cache_type =
+            util::connection_cache<connection, locality>;
 
     public:
         static const char* connection_handler_type()
@@ -140,6 +144,8 @@ namespace hpx::parcelset {
                 pool_name_postfix())
           , connection_cache_(
                 max_connections(ini), max_connections_per_loc(ini))
+          , large_message_connection_cache_(max_connections(ini),
+                this->get_large_message_lanes(), 1)
           , archive_flags_(0)
           , operations_in_flight_(0)
           , num_thread_(0)
@@ -180,6 +186,7 @@ namespace hpx::parcelset {
         ~parcelport_impl() override
         {
             connection_cache_.clear();
+            large_message_connection_cache_.clear();
         }
 
         bool can_bootstrap() const override
@@ -210,6 +217,12 @@ namespace hpx::parcelset {
             // empty
             hpx::util::yield_while(
                 [this]() {
+                    // The HPX worker threads (and their background work) might
+                    // have been stopped already, make progress ourselves.
+                    if (threads::get_self_ptr() == nullptr)
+                    {
+                        do_background_work(0, parcelport_background_mode_all);
+                    }
                     return operations_in_flight_ != 0 ||
                         get_pending_parcels_count(false) != 0;
                 },
@@ -223,11 +236,13 @@ namespace hpx::parcelset {
             if (blocking)
             {
                 connection_cache_.shutdown();
+                large_message_connection_cache_.shutdown();
                 connection_handler().do_stop();
                 io_service_pool_.wait();
                 io_service_pool_.stop();
                 io_service_pool_.join();
                 connection_cache_.clear();
+                large_message_connection_cache_.clear();
                 io_service_pool_.clear();
             }
             else
@@ -257,8 +272,8 @@ namespace hpx::parcelset {
                     else
                     {
                         // enqueue the outgoing parcel ...
-                        enqueue_parcel(dest, HPX_MOVE(p), HPX_MOVE(f));
-                        get_connection_and_send_parcels(dest);
+                        get_connection_and_send_parcels(
+                            enqueue_parcel(dest, HPX_MOVE(p), HPX_MOVE(f)));
                     }
                 });
         }
@@ -299,10 +314,8 @@ namespace hpx::parcelset {
                     }
                     else
                     {
-                        enqueue_parcels(
+                        enqueue_and_send_parcels(
                             dest, HPX_MOVE(parcels), HPX_MOVE(handlers));
-
-                        get_connection_and_send_parcels(dest);
                     }
                 });
         }
@@ -362,6 +375,7 @@ namespace hpx::parcelset {
             }
 
             connection_cache_.clear(loc);
+            large_message_connection_cache_.clear(loc);
         }
 
         void remove_from_connection_cache(locality const& loc) override
@@ -400,22 +414,32 @@ namespace hpx::parcelset {
         std::int64_t get_connection_cache_statistics(
             connection_cache_statistics_type t, bool reset) override
         {
+            return get_connection_cache_statistics(
+                       t, traffic_class_small, reset) +
+                get_connection_cache_statistics(t, traffic_class_large, reset);
+        }
+
+        std::int64_t get_connection_cache_statistics(
+            connection_cache_statistics_type t, traffic_class tc,
+            bool reset) override
+        {
+            connection_cache_type& cache = get_connection_cache(tc);
             switch (t)
             {
             case connection_cache_insertions:
-                return connection_cache_.get_cache_insertions(reset);
+                return cache.get_cache_insertions(reset);
 
             case connection_cache_evictions:
-                return connection_cache_.get_cache_evictions(reset);
+                return cache.get_cache_evictions(reset);
 
             case connection_cache_hits:
-                return connection_cache_.get_cache_hits(reset);
+                return cache.get_cache_hits(reset);
 
             case connection_cache_misses:
-                return connection_cache_.get_cache_misses(reset);
+                return cache.get_cache_misses(reset);
 
             case connection_cache_reclaims:
-                return connection_cache_.get_cache_reclaims(reset);
+                return cache.get_cache_reclaims(reset);
 
             default:
                 break;
@@ -472,6 +496,28 @@ namespace hpx::parcelset {
             }
         }
 
+        // Parcelports sending parcels immediately don't maintain
+        // connections, they send all parcels alike.
+        traffic_class get_traffic_class_impl(parcel const& p) const
+        {
+            if constexpr (connection_handler_traits<
+                              ConnectionHandler>::send_immediate_parcels::value)
+            {
+                HPX_UNUSED(p);
+                return traffic_class_small;
+            }
+            else
+            {
+                return this->get_traffic_class(p);
+            }
+        }
+
+        connection_cache_type& get_connection_cache(std::size_t tc) noexcept
+        {
+            return tc == traffic_class_large ? large_message_connection_cache_ :
+                                               connection_cache_;
+        }
+
         bool can_send_immediate_impl()
         {
             if constexpr (connection_handler_traits<
@@ -508,7 +554,9 @@ namespace hpx::parcelset {
                         HPX_ASSERT(ps == nullptr);
                         HPX_ASSERT(num_parcels == 0u);
 
-                        if (!dequeue_parcels(dest_, parcels, handlers))
+                        detail::pending_parcels_queue* q =
+                            pending_parcels_.find(dest_, traffic_class_small);
+                        if (q == nullptr || !q->pop_all(parcels, handlers))
                         {
                             // Give this connection back to the connection handler as
                             // we couldn't dequeue parcels.
@@ -568,8 +616,8 @@ namespace hpx::parcelset {
 
     private:
         ///////////////////////////////////////////////////////////////////////
-        std::shared_ptr<connection> get_connection(
-            locality const& l, bool /* force */, error_code& ec)
+        std::shared_ptr<connection> get_connection(locality const& l,
+            std::size_t tc, bool /* force */, error_code& ec)
         {
             // Request new connection from connection cache.
             std::shared_ptr<connection> sender_connection;
@@ -582,7 +630,8 @@ namespace hpx::parcelset {
             else
             {
                 // Get a connection or reserve space for a new connection.
-                if (!connection_cache_.get_or_reserve(l, sender_connection))
+                if (!get_connection_cache(tc).get_or_reserve(
+                        l, sender_connection))
                 {
                     // If no slot is available it's not a problem as the parcel
                     // will be sent out whenever the next connection is returned
@@ -606,107 +655,72 @@ namespace hpx::parcelset {
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void enqueue_parcel(
+        detail::pending_parcels_queue& enqueue_parcel(
             locality const& locality_id, parcel&& p, write_handler_type&& f)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock l(mtx_);
-
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking il(&l);
-            HPX_UNUSED(il);
+            detail::pending_parcels_queue& q = pending_parcels_.get(locality_id,
+                get_traffic_class_impl(p), p.destination_locality_id());
+            q.push(HPX_MOVE(p), HPX_MOVE(f));
+            return q;
+        }
 
-            mapped_type& e = pending_parcels_[locality_id];
-            hpx::get<0>(e).push_back(HPX_MOVE(p));
-            hpx::get<1>(e).push_back(HPX_MOVE(f));
+        detail::pending_parcels_queue& enqueue_parcels(
+            locality const& locality_id, std::vector<parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers,
+            traffic_class tc = traffic_class_small)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            detail::pending_parcels_queue& q =
+                pending_parcels_.get(locality_id, tc,
+                    parcels.empty() ? naming::invalid_locality_id :
+                                      parcels[0].destination_locality_id());
+            q.push(HPX_MOVE(parcels), HPX_MOVE(handlers));
+            return q;
         }
 
-        void enqueue_parcels(locality const& locality_id,
+        // Enqueue the given parcels with the queues of their traffic classes
+        // and send them.
+        void enqueue_and_send_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock l(mtx_);
-
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking il(&l);
-            HPX_UNUSED(il);
-
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-            if (hpx::get<0>(e).empty())
+            traffic_class const tc = parcels.empty() ?
+                traffic_class_small :
+                get_traffic_class_impl(parcels[0]);
+
+            auto const it =
+                std::find_if(parcels.begin(), parcels.end(),
+                    [&](parcel const& p) {
+                        return get_traffic_class_impl(p) != tc;
+                    });
+            if (it == parcels.end())
             {
-                HPX_ASSERT(hpx::get<1>(e).empty());
-                std::swap(hpx::get<0>(e), parcels);
-                std::swap(hpx::get<1>(e), handlers);
+                get_connection_and_send_parcels(enqueue_parcels(
+                    locality_id, HPX_MOVE(parcels), HPX_MOVE(handlers), tc));
+                return;
             }
-            else
-            {
-                HPX_ASSERT(hpx::get<0>(e).size() == hpx::get<1>(e).size());
-                std::size_t new_size = hpx::get<0>(e).size() + parcels.size();
-                hpx::get<0>(e).reserve(new_size);
 
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(hpx::get<0>(e)));
-                hpx::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(hpx::get<1>(e)));
+            // the parcels have to be sent separately
+            std::vector<parcel> class_parcels[num_traffic_classes];
+            std::vector<write_handler_type> class_handlers[num_traffic_classes];
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                traffic_class const c = get_traffic_class_impl(parcels[i]);
+                class_parcels[c].push_back(HPX_MOVE(parcels[i]));
+                class_handlers[c].push_back(HPX_MOVE(handlers[i]));
             }
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
-        }
-
-        bool dequeue_parcels(locality const& locality_id,
-            std::vector<parcel>& parcels,
-            std::vector<write_handler_type>& handlers)
-        {
-            using iterator = pending_parcels_map::iterator;
-
+            for (std::size_t c = 0; c != num_traffic_classes; ++c)
             {
-                std::unique_lock l(mtx_, std::try_to_lock);
-                if (!l.owns_lock())
-                    return false;
-
-                iterator it = pending_parcels_.find(locality_id);
-
-                // do nothing if parcels have already been picked up by
-                // another thread
-                if (it != pending_parcels_.end() &&
-                    !hpx::get<0>(it->second).empty())
-                {
-                    HPX_ASSERT(it->first == locality_id);
-                    HPX_ASSERT(handlers.size() == 0);
-                    HPX_ASSERT(handlers.size() == parcels.size());
-                    std::swap(parcels, hpx::get<0>(it->second));
-                    HPX_ASSERT(hpx::get<0>(it->second).size() == 0);
-                    std::swap(handlers, hpx::get<1>(it->second));
-                    HPX_ASSERT(handlers.size() == parcels.size());
-
-                    HPX_ASSERT(!handlers.empty());
-                }
-                else
+                if (!class_parcels[c].empty())
                 {
-                    HPX_ASSERT(hpx::get<1>(it->second).empty());
-                    return false;
+                    get_connection_and_send_parcels(enqueue_parcels(locality_id,
+                        HPX_MOVE(class_parcels[c]), HPX_MOVE(class_handlers[c]),
+                        static_cast<traffic_class>(c)));
                 }
-
-                parcel_destinations_.erase(locality_id);
-
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
-
-                return true;
             }
         }
 
@@ -714,69 +728,49 @@ namespace hpx::parcelset {
         bool dequeue_parcel(
             locality& dest, parcel& p, write_handler_type& handler)
         {
-            std::unique_lock l(mtx_, std::try_to_lock);
-            if (!l.owns_lock())
-                return false;
+            bool result = false;
+            pending_parcels_.for_each_pending(
+                [&](detail::pending_parcels_queue& q) {
+                    std::vector<parcel> parcels;
+                    std::vector<write_handler_type> handlers;
+                    if (result || !q.pop_all(parcels, handlers))
+                    {
+                        return;
+                    }
 
-            for (auto& pending : pending_parcels_)
-            {
-                auto& parcels = hpx::get<0>(pending.second);
-                if (!parcels.empty())
-                {
-                    auto& handlers = hpx::get<1>(pending.second);
-                    dest = pending.first;
+                    dest = q.destination();
                     p = HPX_MOVE(parcels.back());
                     parcels.pop_back();
                     handler = HPX_MOVE(handlers.back());
                     handlers.pop_back();
 
-                    if (parcels.empty())
-                    {
-                        pending_parcels_.erase(dest);
-                    }
-                    return true;
-                }
-            }
-            return false;
+                    // give back the remaining parcels
+                    q.push(HPX_MOVE(parcels), HPX_MOVE(handlers));
+                    result = true;
+                });
+            return result;
         }
 
         bool trigger_pending_work()
         {
-            if (0 == num_parcel_destinations_.load(std::memory_order_relaxed))
+            if (!pending_parcels_.has_pending())
                 return true;
 
-            std::vector<locality> destinations;
-
-            {
-                std::unique_lock l(mtx_, std::try_to_lock);
-                if (l.owns_lock())
-                {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
-                    {
-                        destinations.push_back(loc);
-                    }
-                }
-            }
-
-            // Create new HPX threads which send the parcels that are still
-            // pending.
-            for (locality const& loc : destinations)
-            {
-                get_connection_and_send_parcels(loc);
-            }
+            // Send the parcels that are still pending.
+            pending_parcels_.for_each_pending(
+                [this](detail::pending_parcels_queue& q) {
+                    get_connection_and_send_parcels(q);
+                });
 
             return true;
         }
 
     private:
         ///////////////////////////////////////////////////////////////////////
-        void get_connection_and_send_parcels(
-            locality const& locality_id, bool /* background */ = false)
+        void get_connection_and_send_parcels(detail::pending_parcels_queue& q)
         {
+            locality const& locality_id = q.destination();
+            std::size_t const tc = q.traffic_class();
             if constexpr (connection_handler_traits<
                               ConnectionHandler>::send_immediate_parcels::value)
             {
@@ -790,7 +784,7 @@ namespace hpx::parcelset {
 
             error_code ec;
             std::shared_ptr<connection> sender_connection =
-                get_connection(locality_id, force_connection, ec);
+                get_connection(locality_id, tc, force_connection, ec);
 
             if (!sender_connection)
             {
@@ -805,18 +799,19 @@ namespace hpx::parcelset {
             std::vector<parcel> parcels;
             std::vector<write_handler_type> handlers;
 
-            if (!dequeue_parcels(locality_id, parcels, handlers))
+            if (!q.pop_all(parcels, handlers))
             {
                 // Give this connection back to the cache as we couldn't dequeue
                 // parcels.
-                connection_cache_.reclaim(locality_id, sender_connection);
+                get_connection_cache(tc).reclaim(
+                    locality_id, sender_connection);
 
                 return;
             }
 
             // send parcels if they didn't get sent by another connection
-            send_pending_parcels(locality_id, sender_connection,
-                HPX_MOVE(parcels), HPX_MOVE(handlers));
+            send_pending_parcels(
+                q, sender_connection, HPX_MOVE(parcels), HPX_MOVE(handlers));
 
             // We yield here for a short amount of time to give another
             // HPX thread the chance to put a subsequent parcel which
@@ -824,8 +819,8 @@ namespace hpx::parcelset {
             //             hpx::execution_base::this_thread::yield();
         }
 
-        void send_pending_parcels_trampoline(std::error_code const& ec,
-            locality const& locality_id,
+        void send_pending_parcels_trampoline(detail::pending_parcels_queue* q,
+            std::error_code const& ec, locality const& locality_id,
             std::shared_ptr<connection> sender_connection)
         {
             HPX_ASSERT(operations_in_flight_ != 0);
@@ -834,37 +829,31 @@ namespace hpx::parcelset {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             sender_connection->set_state(connection::state_scheduled_thread);
 #endif
+            connection_cache_type& cache =
+                get_connection_cache(q->traffic_class());
             if (!ec)
             {
                 // Give this connection back to the cache as it's not
                 // needed anymore.
-                connection_cache_.reclaim(locality_id, sender_connection);
+                cache.reclaim(locality_id, sender_connection);
             }
             else
             {
                 // remove this connection from cache
-                connection_cache_.clear(locality_id, sender_connection);
+                cache.clear(locality_id, sender_connection);
             }
 
+            // HPX_ASSERT(locality_id == sender_connection->destination());
+            if (q->empty())
             {
-                std::lock_guard l(mtx_);
-
-                // HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it =
-                    pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() ||
-                    hpx::get<0>(it->second).empty())
-                {
-                    return;
-                }
+                return;
             }
 
-            // Create a new HPX thread which sends parcels that are still
-            // pending.
-            get_connection_and_send_parcels(locality_id);
+            // Send the parcels that are still pending.
+            get_connection_and_send_parcels(*q);
         }
 
-        void send_pending_parcels(parcelset::locality const& parcel_locality_id,
+        void send_pending_parcels(detail::pending_parcels_queue& q,
             std::shared_ptr<connection> sender_connection,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
@@ -876,7 +865,7 @@ namespace hpx::parcelset {
 #if defined(HPX_DEBUG)
             // verify the connection points to the right destination
             // HPX_ASSERT(parcel_locality_id == sender_connection->destination());
-            sender_connection->verify_(parcel_locality_id);
+            sender_connection->verify_(q.destination());
 #endif
             // encode the parcels
             std::size_t num_parcels = encode_parcels(*this, &parcels[0],
@@ -893,7 +882,7 @@ namespace hpx::parcelset {
                     call_for_each(HPX_MOVE(handlers), HPX_MOVE(parcels)),
                     hpx::bind_front(
                         &parcelport_impl::send_pending_parcels_trampoline,
-                        this));
+                        this, &q));
             }
             else
             {
@@ -920,15 +909,14 @@ namespace hpx::parcelset {
                         HPX_MOVE(handled_handlers), HPX_MOVE(handled_parcels)),
                     hpx::bind_front(
                         &parcelport_impl::send_pending_parcels_trampoline,
-                        this));
+                        this, &q));
 
                 // give back unhandled parcels
                 parcels.erase(parcels.begin(), parcels.begin() + num_parcels);
                 handlers.erase(
                     handlers.begin(), handlers.begin() + num_parcels);
 
-                enqueue_parcels(
-                    parcel_locality_id, HPX_MOVE(parcels), HPX_MOVE(handlers));
+                q.push(HPX_MOVE(parcels), HPX_MOVE(handlers));
             }
 
             hpx::execution_base::this_thread::yield();
@@ -944,8 +932,10 @@ namespace hpx::parcelset {
         /// The pool of io_service objects used to perform asynchronous operations.
         util::io_service_pool io_service_pool_;
 
-        /// The connection cache for sending connections
-        util::connection_cache<connection, locality> connection_cache_;
+        /// The connection caches for sending connections, separate
+        /// connections are used for sending large parcels
+        connection_cache_type connection_cache_;
+        connection_cache_type large_message_connection_cache_;
 
         using mutex_type = hpx::spinlock;
 
@@ -0,0 +1,294 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/assert.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/runtime_local.hpp>
+#include <hpx/modules/synchronization.hpp>
+
+#include <hpx/components_base/agas_interface.hpp>
+#include <hpx/naming_base/gid_type.hpp>
+#include <hpx/parcelset/detail/parcel_latency.hpp>
+#include <hpx/parcelset_base/parcel_interface.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::detail {
+
+    namespace {
+
+        struct interval_data
+        {
+            char const* name;
+            parcel_stage from;
+            parcel_stage to;
+        };
+
+        constexpr interval_data intervals[num_parcel_latency_intervals] = {
+            {"put", parcel_stage::created, parcel_stage::enqueued},
+            {"queue", parcel_stage::enqueued, parcel_stage::serialized},
+            {"send", parcel_stage::serialized, parcel_stage::written},
+            {"transfer", parcel_stage::serialized, parcel_stage::received},
+            {"decode", parcel_stage::received, parcel_stage::deserialized},
+            {"schedule", parcel_stage::deserialized, parcel_stage::scheduled},
+            {"start", parcel_stage::scheduled, parcel_stage::started},
+            {"total", parcel_stage::created, parcel_stage::started}};
+
+        constexpr std::size_t index(parcel_stage stage) noexcept
+        {
+            return static_cast<std::size_t>(stage);
+        }
+
+        constexpr std::size_t index(parcel_latency_interval interval) noexcept
+        {
+            return static_cast<std::size_t>(interval);
+        }
+    }    // namespace
+
+    char const* get_parcel_latency_interval_name(
+        parcel_latency_interval interval) noexcept
+    {
+        HPX_ASSERT(index(interval) < num_parcel_latency_intervals);
+        return intervals[index(interval)].name;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    parcel_latency_statistics::parcel_latency_statistics()
+      : trace_state_(trace_state::unknown)
+    {
+    }
+
+    parcel_latency_statistics::~parcel_latency_statistics()
+    {
+        flush_trace();
+    }
+
+    parcel_latency_statistics& parcel_latency_statistics::get()
+    {
+        static parcel_latency_statistics statistics;
+        return statistics;
+    }
+
+    std::size_t parcel_latency_statistics::get_shard_index() noexcept
+    {
+        // parcels are sent and received on worker threads as well as on the
+        // threads of the parcelports
+        std::size_t const num_thread = hpx::get_worker_thread_num();
+        if (num_thread != std::size_t(-1))
+        {
+            return num_thread % num_shards;
+        }
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) %
+            num_shards;
+    }
+
+    void parcel_latency_statistics::parcel_sent(
+        parcel const& p, std::int64_t written)
+    {
+        parcel_timestamps timestamps;
+        for (std::size_t i = 0; i != num_parcel_stages; ++i)
+        {
+            timestamps[i] = p.timestamp(static_cast<parcel_stage>(i));
+        }
+        timestamps[index(parcel_stage::written)] = written;
+
+        record("sent", p.get_action_name(), p.parcel_id(),
+            p.destination_locality_id(), timestamps,
+            parcel_latency_interval::put, parcel_latency_interval::send);
+    }
+
+    void parcel_latency_statistics::parcel_started(char const* action_name,
+        naming::gid_type const& parcel_id, std::uint32_t source_locality,
+        parcel_timestamps const& timestamps)
+    {
+        record("received", action_name, parcel_id, source_locality,
+            timestamps, parcel_latency_interval::transfer,
+            parcel_latency_interval::total);
+    }
+
+    std::vector<std::int64_t> parcel_latency_statistics::get_histogram(
+        parcel_latency_interval interval, std::string const& action,
+        bool reset)
+    {
+        std::vector<std::int64_t> counts(histogram_type::bucket_count, 0);
+        for (shard& s : shards_)
+        {
+            std::lock_guard<hpx::spinlock> l(s.mtx_);
+            for (auto const& p : s.actions_)
+            {
+                if (action.empty() || action == p.first)
+                {
+                    p.second->histograms_[index(interval)].get_counts(
+                        counts, reset);
+                }
+            }
+        }
+        return counts;
+    }
+
+    void parcel_latency_statistics::flush_trace()
+    {
+        if (trace_state_.load(std::memory_order_acquire) !=
+            trace_state::enabled)
+        {
+            return;
+        }
+
+        for (shard& s : shards_)
+        {
+            std::vector<trace_record> records;
+            {
+                std::lock_guard<hpx::spinlock> l(s.mtx_);
+                records.swap(s.trace_);
+            }
+            write_trace(records);
+        }
+
+        std::lock_guard<hpx::spinlock> l(trace_mtx_);
+        trace_.flush();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void parcel_latency_statistics::record(char const* event,
+        char const* action_name, naming::gid_type const& parcel_id,
+        std::uint32_t locality, parcel_timestamps const& timestamps,
+        parcel_latency_interval first, parcel_latency_interval last)
+    {
+        if (action_name == nullptr)
+        {
+            action_name = "<unknown>";
+        }
+
+        trace_state const state = trace_state_.load(std::memory_order_acquire);
+        bool const tracing = state == trace_state::enabled ||
+            (state == trace_state::unknown && init_trace());
+
+        // a full trace buffer is written after the shard was unlocked
+        std::vector<trace_record> records;
+
+        {
+            shard& s = shards_[get_shard_index()];
+            std::lock_guard<hpx::spinlock> l(s.mtx_);
+
+            std::unique_ptr<histograms>& action = s.actions_[action_name];
+            if (!action)
+            {
+                action = std::make_unique<histograms>();
+            }
+
+            for (std::size_t i = index(first); i <= index(last); ++i)
+            {
+                // ignore intervals for which not both timestamps are known
+                std::int64_t const from = timestamps[index(intervals[i].from)];
+                std::int64_t const to = timestamps[index(intervals[i].to)];
+                if (from == 0 || to == 0)
+                {
+                    continue;
+                }
+
+                // clocks of different nodes may not be synchronized
+                action->histograms_[i].record(
+                    to > from ? static_cast<std::uint64_t>(to - from) : 0);
+            }
+
+            if (tracing)
+            {
+                if (s.trace_.empty())
+                {
+                    s.trace_.reserve(trace_buffer_size);
+                }
+                s.trace_.push_back(trace_record{
+                    event, action_name, parcel_id, locality, timestamps});
+
+                if (s.trace_.size() >= trace_buffer_size)
+                {
+                    records.swap(s.trace_);
+                }
+            }
+        }
+
+        if (!records.empty())
+        {
+            write_trace(records);
+        }
+    }
+
+    bool parcel_latency_statistics::init_trace()
+    {
+        std::lock_guard<hpx::spinlock> l(trace_mtx_);
+
+        trace_state state = trace_state_.load(std::memory_order_relaxed);
+        if (state != trace_state::unknown)
+        {
+            return state == trace_state::enabled;
+        }
+
+        state = trace_state::disabled;
+
+        std::string const filename =
+            get_config_entry("hpx.parcel.latency_trace_file", "");
+        if (!filename.empty())
+        {
+            // every locality writes its own file
+            error_code ec(throwmode::lightweight);
+            trace_.open(
+                filename + "." + std::to_string(agas::get_locality_id(ec)));
+            if (trace_.is_open())
+            {
+                trace_ << "event,parcel_id,action,locality";
+                for (std::size_t i = 0; i != num_parcel_stages; ++i)
+                {
+                    static char const* const stage_names[num_parcel_stages] =
+                        {"created", "enqueued", "serialized", "written",
+                            "received", "deserialized", "scheduled",
+                            "started"};
+                    trace_ << ',' << stage_names[i];
+                }
+                trace_ << '\n';
+                state = trace_state::enabled;
+            }
+        }
+
+        trace_state_.store(state, std::memory_order_release);
+        return state == trace_state::enabled;
+    }
+
+    void parcel_latency_statistics::write_trace(
+        std::vector<trace_record> const& records)
+    {
+        if (records.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<hpx::spinlock> l(trace_mtx_);
+        for (trace_record const& r : records)
+        {
+            trace_ << r.event << ',' << r.parcel_id << ",\"" << r.action_name
+                   << "\"," << r.locality;
+            for (std::int64_t timestamp : r.timestamps)
+            {
+                trace_ << ',' << timestamp;
+            }
+            trace_ << '\n';
+        }
+    }
+}    // namespace hpx::parcelset::detail
+
+#endif
@@ -17,17 +17,21 @@
 #include <hpx/modules/threading_base.hpp>
 #include <hpx/modules/timing.hpp>
 
+#include <hpx/actions/thread_start_hook.hpp>
 #include <hpx/actions/transfer_action.hpp>
 #include <hpx/actions_base/detail/action_factory.hpp>
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/components_base/component_type.hpp>
 #include <hpx/naming/detail/preprocess_gid_types.hpp>
+#include <hpx/parcelset/detail/parcel_latency.hpp>
 #include <hpx/parcelset/parcel.hpp>
 #include <hpx/parcelset/parcelhandler.hpp>
 #include <hpx/parcelset_base/parcel_interface.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -42,10 +46,14 @@ namespace hpx::parcelset::detail {
 #if defined(HPX_HAVE_PARCEL_PROFILING)
       , start_time_(0)
       , creation_time_(chrono::high_resolution_timer::now())
-
+      , timestamps_()
 #endif
       , has_continuation_(false)
     {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        timestamps_[static_cast<std::size_t>(parcel_stage::created)] =
+            chrono::high_resolution_clock::now();
+#endif
     }
 
     parcel_data::parcel_data(
@@ -56,9 +64,14 @@ namespace hpx::parcelset::detail {
 #if defined(HPX_HAVE_PARCEL_PROFILING)
       , start_time_(0)
       , creation_time_(chrono::high_resolution_timer::now())
+      , timestamps_()
 #endif
       , has_continuation_(has_continuation)
     {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        timestamps_[static_cast<std::size_t>(parcel_stage::created)] =
+            chrono::high_resolution_clock::now();
+#endif
     }
 
     parcel_data::parcel_data(parcel_data&& rhs) noexcept
@@ -72,6 +85,10 @@ namespace hpx::parcelset::detail {
 #endif
       , has_continuation_(rhs.has_continuation_)
     {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        std::copy(std::begin(rhs.timestamps_), std::end(rhs.timestamps_),
+            std::begin(timestamps_));
+#endif
         rhs.source_id_ = naming::invalid_gid;
         rhs.dest_ = naming::invalid_gid;
         rhs.addr_ = naming::address();
@@ -80,6 +97,7 @@ namespace hpx::parcelset::detail {
         rhs.parcel_id_ = naming::invalid_gid;
         rhs.start_time_ = 0;
         rhs.creation_time_ = 0;
+        std::fill(std::begin(rhs.timestamps_), std::end(rhs.timestamps_), 0);
 #endif
     }
 
@@ -92,6 +110,8 @@ namespace hpx::parcelset::detail {
         parcel_id_ = HPX_MOVE(rhs.parcel_id_);
         start_time_ = rhs.start_time_;
         creation_time_ = rhs.creation_time_;
+        std::copy(std::begin(rhs.timestamps_), std::end(rhs.timestamps_),
+            std::begin(timestamps_));
 #endif
         has_continuation_ = rhs.has_continuation_;
 
@@ -102,6 +122,7 @@ namespace hpx::parcelset::detail {
         rhs.parcel_id_ = naming::invalid_gid;
         rhs.start_time_ = 0;
         rhs.creation_time_ = 0;
+        std::fill(std::begin(rhs.timestamps_), std::end(rhs.timestamps_), 0);
 #endif
         return *this;
     }
@@ -116,6 +137,10 @@ namespace hpx::parcelset::detail {
         ar >> parcel_id_;
         ar >> start_time_;
         ar >> creation_time_;
+        for (std::int64_t& timestamp : timestamps_)
+        {
+            ar >> timestamp;
+        }
 #endif
 
         ar >> has_continuation_;
@@ -131,6 +156,14 @@ namespace hpx::parcelset::detail {
         ar << parcel_id_;
         ar << start_time_;
         ar << creation_time_;
+
+        // the parcel is being serialized into a message right now
+        timestamps_[static_cast<std::size_t>(parcel_stage::serialized)] =
+            chrono::high_resolution_clock::now();
+        for (std::int64_t const timestamp : timestamps_)
+        {
+            ar << timestamp;
+        }
 #endif
 
         ar << has_continuation_;
@@ -324,6 +357,16 @@ namespace hpx::parcelset::detail {
     {
         return data_.parcel_id_;
     }
+
+    std::int64_t parcel::timestamp(parcel_stage stage) const
+    {
+        return data_.timestamps_[static_cast<std::size_t>(stage)];
+    }
+
+    void parcel::set_timestamp(parcel_stage stage, std::int64_t time)
+    {
+        data_.timestamps_[static_cast<std::size_t>(stage)] = time;
+    }
 #endif
 
 #if defined(HPX_HAVE_NETWORKING)
@@ -438,7 +481,13 @@ namespace hpx::parcelset::detail {
     bool parcel::load_schedule(serialization::input_archive& ar,
         std::size_t num_thread, bool& deferred_schedule)
     {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        std::int64_t const received = chrono::high_resolution_clock::now();
         load_data(ar);
+        set_timestamp(parcel_stage::received, received);
+#else
+        load_data(ar);
+#endif
 
         // make sure this parcel destination matches the proper locality
         HPX_ASSERT(destination_locality() == data_.addr_.locality_);
@@ -455,9 +504,31 @@ namespace hpx::parcelset::detail {
             return true;
         }
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        // load the action separately from scheduling it, this allows to
+        // measure the time spent in between (same as what load_schedule does)
+        action_->load(ar);
+        set_timestamp(
+            parcel_stage::deserialized, chrono::high_resolution_clock::now());
+
+        if (deferred_schedule)
+        {
+            // direct actions of all but the last parcel of a message are
+            // scheduled later on
+            if (action_->get_action_type() ==
+                actions::action_flavor::direct_action)
+            {
+                return false;
+            }
+            deferred_schedule = false;
+        }
+
+        schedule_thread(p.first, p.second, num_thread);
+#else
         // continuation support, this is handled in the transfer action
         action_->load_schedule(ar, HPX_MOVE(data_.dest_), p.first, p.second,
             num_thread, deferred_schedule);
+#endif
 
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         static util::itt::event parcel_recv("recv_parcel");
@@ -491,13 +562,65 @@ namespace hpx::parcelset::detail {
             return true;
         }
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        schedule_thread(p.first, p.second, num_thread);
+#else
         // dispatch action, register work item either with or without
         // continuation support, this is handled in the transfer action
         action_->schedule_thread(
             HPX_MOVE(data_.dest_), p.first, p.second, num_thread);
+#endif
         return false;
     }
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+    void parcel::schedule_thread(naming::address_type lva,
+        naming::component_type comptype, std::size_t num_thread)
+    {
+        std::int64_t const scheduled = chrono::high_resolution_clock::now();
+        set_timestamp(parcel_stage::scheduled, scheduled);
+
+        // the latencies are recorded once the action starts executing
+        bool const is_direct_action = action_->get_action_type() ==
+            actions::action_flavor::direct_action;
+
+        parcel_timestamps timestamps;
+        std::copy(std::begin(data_.timestamps_), std::end(data_.timestamps_),
+            timestamps.begin());
+
+        actions::detail::thread_start_hook_type hook =
+            [action_name = get_action_name(), parcel_id = data_.parcel_id_,
+                source_locality =
+                    naming::get_locality_id_from_gid(data_.source_id_),
+                timestamps](std::int64_t started) mutable {
+                timestamps[static_cast<std::size_t>(parcel_stage::started)] =
+                    started;
+                parcel_latency_statistics::get().parcel_started(
+                    action_name, parcel_id, source_locality, timestamps);
+            };
+
+        if (!is_direct_action)
+        {
+            actions::detail::set_thread_start_hook(HPX_MOVE(hook));
+        }
+
+        // dispatch action, register work item either with or without
+        // continuation support, this is handled in the transfer action
+        action_->schedule_thread(
+            HPX_MOVE(data_.dest_), lva, comptype, num_thread);
+
+        // the action was executed directly if the hook was not consumed
+        if (!is_direct_action)
+        {
+            hook = actions::detail::take_thread_start_hook();
+        }
+        if (!hook.empty())
+        {
+            hook(scheduled);
+        }
+    }
+#endif
+
     void parcel::load_data(serialization::input_archive& ar)
     {
         using hpx::actions::detail::action_registry;
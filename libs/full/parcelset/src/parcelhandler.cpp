@@ -26,12 +26,14 @@
 #include <hpx/modules/thread_support.hpp>
 #include <hpx/modules/threading_base.hpp>
 #include <hpx/modules/threadmanager.hpp>
+#include <hpx/modules/timing.hpp>
 #include <hpx/modules/type_support.hpp>
 #include <hpx/modules/util.hpp>
 #include <hpx/util/from_string.hpp>
 
 #include <hpx/components_base/agas_interface.hpp>
 #include <hpx/naming_base/gid_type.hpp>
+#include <hpx/parcelset/detail/parcel_latency.hpp>
 #include <hpx/parcelset/message_handler_fwd.hpp>
 #include <hpx/parcelset/parcelhandler.hpp>
 #include <hpx/parcelset/static_parcelports.hpp>
@@ -408,6 +410,10 @@ namespace hpx::parcelset {
 
         // release all message handlers
         handlers_.clear();
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        detail::parcel_latency_statistics::get().flush_trace();
+#endif
     }
 
     bool parcelhandler::get_raw_remote_localities(
@@ -511,6 +517,14 @@ namespace hpx::parcelset {
                 hpx::detail::dijkstra_make_black();
             }
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+            if (!ec)
+            {
+                parcel_latency_statistics::get().parcel_sent(
+                    p, hpx::chrono::high_resolution_clock::now());
+            }
+#endif
+
             // invoke the original handler
             f(ec, p);
 
@@ -1256,6 +1270,17 @@ namespace hpx::parcelset {
         return pp ? pp->get_connection_cache_statistics(stat_type, reset) : 0;
     }
 
+    std::int64_t parcelhandler::get_traffic_class_connection_cache_statistics(
+        std::string const& pp_type, parcelport::traffic_class tc,
+        parcelport::connection_cache_statistics_type stat_type,
+        bool reset) const
+    {
+        error_code ec(throwmode::lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_connection_cache_statistics(stat_type, tc, reset) :
+                    0;
+    }
+
     std::vector<plugins::parcelport_factory_base*>&
     parcelhandler::get_parcelport_factories()
     {
@@ -1329,6 +1354,16 @@ namespace hpx::parcelset {
                 HPX_ZERO_COPY_SERIALIZATION_THRESHOLD) "}");
         ini_defs.emplace_back("max_background_threads = "
                               "${HPX_PARCEL_MAX_BACKGROUND_THREADS:-1}");
+        ini_defs.emplace_back(
+            "buffer_pool_size = ${HPX_PARCEL_BUFFER_POOL_SIZE:16}");
+        ini_defs.emplace_back("large_message_threshold = "
+                              "${HPX_PARCEL_LARGE_MESSAGE_THRESHOLD:65536}");
+        ini_defs.emplace_back(
+            "large_message_lanes = ${HPX_PARCEL_LARGE_MESSAGE_LANES:2}");
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        ini_defs.emplace_back(
+            "latency_trace_file = ${HPX_PARCEL_LATENCY_TRACE_FILE:}");
+#endif
 
         for (plugins::parcelport_factory_base* f :
             parcelhandler::get_parcelport_factories())
@@ -1351,6 +1386,8 @@ namespace hpx::parcelset {
 #if defined(HPX_HAVE_PARCEL_PROFILING)
         // set the current local time for this locality
         p.set_start_time(hpx::chrono::high_resolution_timer::now());
+        p.set_timestamp(
+            parcel_stage::enqueued, hpx::chrono::high_resolution_clock::now());
 
         if (!p.parcel_id())
         {
@@ -0,0 +1,140 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the parcel latency histograms count the parcels sent between two
+// localities and that the latency trace is written on shutdown.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE) && defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t num_parcels = 100;
+char const* const trace_file = "parcel_latency_test.csv";
+
+std::uint32_t locality_id = 0;
+
+int echo(int i)
+{
+    return i;
+}
+HPX_PLAIN_ACTION(echo, parcel_latency_echo_action)
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::int64_t> get_histogram(std::string const& name)
+{
+    hpx::performance_counters::performance_counter counter(name);
+    return counter
+        .get_counter_values_array(hpx::launch::sync, false)
+        .values_;
+}
+
+std::int64_t get_total(std::vector<std::int64_t> const& values)
+{
+    std::int64_t total = 0;
+    for (std::size_t i = 3; i < values.size(); ++i)
+    {
+        total += values[i];
+    }
+    return total;
+}
+
+void test_histograms(hpx::id_type const& dest, std::uint32_t dest_id)
+{
+    for (std::size_t i = 0; i != num_parcels; ++i)
+    {
+        HPX_TEST_EQ(parcel_latency_echo_action()(dest, int(i)), int(i));
+    }
+
+    // send completion is reported asynchronously, wait for all of it
+    std::string const send_latency = "/parcels{locality#" +
+        std::to_string(locality_id) + "/total}/time/send-latency-histogram";
+
+    std::vector<std::int64_t> values = get_histogram(send_latency);
+    for (int i = 0; i != 100 && get_total(values) < std::int64_t(num_parcels);
+         ++i)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        values = get_histogram(send_latency);
+    }
+
+    // default layout: [0, 1000000) in 20 buckets of 50000ns
+    HPX_TEST_EQ(values.size(), std::size_t(23));
+    HPX_TEST_EQ(values[0], std::int64_t(0));
+    HPX_TEST_EQ(values[1], std::int64_t(1000000));
+    HPX_TEST_EQ(values[2], std::int64_t(50000));
+    HPX_TEST_LTE(std::int64_t(num_parcels), get_total(values));
+
+    // the receiving locality records the decode latency per action
+    values = get_histogram("/parcels{locality#" + std::to_string(dest_id) +
+        "/total}/time/decode-latency-histogram@" +
+        hpx::actions::detail::get_action_name<parcel_latency_echo_action>() +
+        ",0,10000000,10");
+
+    HPX_TEST_EQ(values.size(), std::size_t(13));
+    HPX_TEST_EQ(values[1], std::int64_t(10000000));
+    HPX_TEST_EQ(values[2], std::int64_t(1000000));
+    HPX_TEST_LTE(std::int64_t(num_parcels), get_total(values));
+
+    // bad parameters are rejected
+    HPX_TEST_THROW(get_histogram(send_latency + "@,1000,10"), hpx::exception);
+}
+
+int hpx_main()
+{
+    locality_id = hpx::get_locality_id();
+
+    for (hpx::id_type const& dest : hpx::find_remote_localities())
+    {
+        test_histograms(dest, hpx::naming::get_locality_id_from_id(dest));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::init_params init_args;
+    init_args.cfg = {
+        std::string("hpx.parcel.latency_trace_file!=") + trace_file};
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    // every locality has written its trace when the parcel handler stopped
+    std::string const filename =
+        std::string(trace_file) + "." + std::to_string(locality_id);
+    {
+        std::ifstream trace(filename);
+        HPX_TEST(trace.is_open());
+
+        std::string line;
+        std::size_t num_lines = 0;
+        while (std::getline(trace, line))
+        {
+            ++num_lines;
+        }
+
+        // header plus at least one record per echo parcel
+        HPX_TEST_LT(num_parcels, num_lines);
+    }
+    std::remove(filename.c_str());
+
+    return hpx::util::report_errors();
+}
+#endif
@@ -0,0 +1,204 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that small and large parcels sent concurrently to the same
+// destination (and hence using different traffic classes) are all delivered,
+// and that the large parcels are sent through their own connections.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const small_size = 16;
+std::size_t const large_size = 128 * 1024;
+std::size_t const numparcels_default = 16;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Action, typename T>
+hpx::parcelset::parcel generate_parcel(
+    hpx::id_type const& dest_id, hpx::id_type const& cont, T&& data)
+{
+    hpx::naming::address addr;
+    hpx::naming::gid_type dest = dest_id.get_gid();
+    hpx::parcelset::parcel p(hpx::parcelset::detail::create_parcel::call(
+        std::move(dest), std::move(addr),
+        hpx::actions::typed_continuation<std::size_t>(cont), Action(),
+        hpx::threads::thread_priority::normal, std::forward<T>(data)));
+
+    p.set_source_id(hpx::find_here());
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t receive_data(std::vector<char> const& data)
+{
+    return data.size();
+}
+HPX_PLAIN_ACTION(receive_data)
+
+void test_concurrent_sends(hpx::id_type const& id)
+{
+    std::vector<hpx::future<std::size_t>> small_results;
+    std::vector<hpx::future<std::size_t>> large_results;
+
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        large_results.push_back(hpx::async(
+            receive_data_action(), id, std::vector<char>(large_size)));
+
+        for (std::size_t j = 0; j != 4; ++j)
+        {
+            small_results.push_back(hpx::async(
+                receive_data_action(), id, std::vector<char>(small_size)));
+        }
+    }
+
+    for (hpx::future<std::size_t>& f : small_results)
+    {
+        HPX_TEST_EQ(f.get(), small_size);
+    }
+    for (hpx::future<std::size_t>& f : large_results)
+    {
+        HPX_TEST_EQ(f.get(), large_size);
+    }
+}
+
+void test_mixed_parcels(hpx::id_type const& id)
+{
+    std::vector<hpx::future<std::size_t>> results;
+    std::vector<std::size_t> expected;
+
+    // create parcels of both traffic classes to be sent at once
+    std::vector<hpx::parcelset::parcel> parcels;
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        std::size_t const size = (i % 3 == 0) ? large_size : small_size;
+
+        hpx::distributed::promise<std::size_t> p;
+        results.push_back(p.get_future());
+        expected.push_back(size);
+
+        parcels.push_back(generate_parcel<receive_data_action>(
+            id, p.get_id(), std::vector<char>(size)));
+    }
+
+    hpx::get_runtime_distributed().get_parcel_handler().put_parcels(
+        std::move(parcels));
+
+    for (std::size_t i = 0; i != results.size(); ++i)
+    {
+        HPX_TEST_EQ(results[i].get(), expected[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+using hpx::parcelset::parcelport;
+
+std::int64_t get_statistics(std::string const& pp_type,
+    parcelport::traffic_class tc,
+    parcelport::connection_cache_statistics_type stat_type)
+{
+    return hpx::get_runtime_distributed()
+        .get_parcel_handler()
+        .get_traffic_class_connection_cache_statistics(
+            pp_type, tc, stat_type, false);
+}
+
+// the number of connections handed out by the cache of the traffic class
+std::int64_t get_connections_used(
+    std::string const& pp_type, parcelport::traffic_class tc)
+{
+    return get_statistics(pp_type, tc, parcelport::connection_cache_hits) +
+        get_statistics(pp_type, tc, parcelport::connection_cache_insertions);
+}
+
+void test_large_message_lanes(hpx::id_type const& id)
+{
+    // parcels are sent through the parcelport with the highest priority
+    std::string pp_type;
+    hpx::get_runtime_distributed().get_parcel_handler().enum_parcelports(
+        [&](std::string const& type) {
+            pp_type = type;
+            return false;
+        });
+
+    std::int64_t const small_used =
+        get_connections_used(pp_type, parcelport::traffic_class_small);
+    std::int64_t const large_used =
+        get_connections_used(pp_type, parcelport::traffic_class_large);
+
+    // small parcels never use the connections for large parcels
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        HPX_TEST_EQ(receive_data_action()(id, std::vector<char>(small_size)),
+            small_size);
+    }
+    HPX_TEST_EQ(get_connections_used(pp_type, parcelport::traffic_class_large),
+        large_used);
+
+    // parcelports sending parcels immediately don't cache connections
+    if (get_connections_used(pp_type, parcelport::traffic_class_small) ==
+        small_used)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        HPX_TEST_EQ(receive_data_action()(id, std::vector<char>(large_size)),
+            large_size);
+    }
+    HPX_TEST_LT(large_used,
+        get_connections_used(pp_type, parcelport::traffic_class_large));
+
+    // a single connection is used for the large parcels (see main)
+    HPX_TEST_EQ(get_statistics(pp_type, parcelport::traffic_class_large,
+                    parcelport::connection_cache_insertions),
+        std::int64_t(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        test_concurrent_sends(id);
+        test_mixed_parcels(id);
+        test_large_message_lanes(id);
+    }
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // explicitly disable message handlers (parcel coalescing) and make sure
+    // the large parcels are sent through a separate connection
+    std::vector<std::string> const cfg = {
+#if defined(HPX_HAVE_NETWORKING)
+        "hpx.parcel.message_handlers=0",
+        "hpx.parcel.large_message_threshold=65536",
+        "hpx.parcel.large_message_lanes=1"
+#endif
+    };
+
+    hpx::init_params init_args;
+    init_args.cfg = cfg;
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
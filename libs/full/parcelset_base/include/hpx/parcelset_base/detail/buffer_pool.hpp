@@ -0,0 +1,123 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/modules/synchronization.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx::parcelset::detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A pool of the data buffers used for sending and receiving messages.
+    //
+    // The buffers are kept in size classes of powers of two, new buffers are
+    // allocated with the full capacity of their size class such that they can
+    // be reused for any later message of similar size. Each worker thread has
+    // its own cache of one small buffer per size class in every pool, this
+    // cache is consulted before the shared lists of the pool. Buffers held in
+    // the thread caches count towards the size limit of the pool.
+    class HPX_EXPORT buffer_pool
+    {
+    public:
+        using buffer_type = std::vector<char>;
+
+        // Buffers smaller than this are not worth being pooled, buffers
+        // larger than max_buffer_size are not kept around.
+        static constexpr std::size_t min_buffer_size_log2 = 10;    // 1kB
+        static constexpr std::size_t max_buffer_size_log2 = 24;    // 16MB
+        static constexpr std::size_t max_buffer_size = std::size_t(1)
+            << max_buffer_size_log2;
+
+        // The size of all buffers kept by one pool is limited
+        static constexpr std::size_t max_pooled_bytes = std::size_t(64)
+            << 20;    // 64MB
+
+        // A pool with max_buffers_per_class == 0 is disabled, it allocates a
+        // new buffer for each request
+        explicit buffer_pool(std::size_t max_buffers_per_class = 0);
+
+        buffer_pool(buffer_pool const&) = delete;
+        buffer_pool(buffer_pool&&) = delete;
+        buffer_pool& operator=(buffer_pool const&) = delete;
+        buffer_pool& operator=(buffer_pool&&) = delete;
+
+        bool enabled() const noexcept
+        {
+            return max_buffers_per_class_ != 0;
+        }
+
+        // The number of bytes held by the pool, including the thread caches
+        std::size_t pooled_bytes() const noexcept
+        {
+            return pooled_bytes_.load(std::memory_order_relaxed);
+        }
+
+        // Return an empty buffer with a capacity of at least size bytes
+        buffer_type get(std::size_t size);
+
+        // Hand a buffer back to the pool, it is released if it is not needed
+        void release(buffer_type&& buffer) noexcept;
+
+        // Resize the given buffer, its content is discarded. A buffer is
+        // taken from the pool if the capacity is not sufficient.
+        void resize(buffer_type& buffer, std::size_t size);
+
+    private:
+        static constexpr std::size_t num_size_classes =
+            max_buffer_size_log2 - min_buffer_size_log2 + 1;
+
+        // Only small buffers are cached per thread, those are the ones
+        // dominating message rate bound workloads
+        static constexpr std::size_t max_thread_cached_size_log2 = 16;  // 64kB
+        static constexpr std::size_t num_thread_cached_size_classes =
+            max_thread_cached_size_log2 - min_buffer_size_log2 + 1;
+
+        // Worker threads beyond this number share a cache with another thread
+        static constexpr std::size_t num_thread_caches = 64;
+
+        struct size_class
+        {
+            hpx::spinlock mtx_;
+            std::vector<buffer_type> buffers_;
+        };
+
+        // The lock is uncontended unless two worker threads share the cache,
+        // it is only ever tried.
+        struct thread_cache
+        {
+            hpx::spinlock mtx_;
+            buffer_type buffers_[num_thread_cached_size_classes];
+        };
+
+        using thread_cache_type = hpx::util::cache_aligned_data<thread_cache>;
+
+        // Return the cache of the calling worker thread, nullptr if the
+        // calling thread is not a worker thread
+        thread_cache* get_thread_cache() noexcept;
+
+        // Try to add the given number of bytes to the pooled bytes
+        bool reserve_pooled_bytes(std::size_t bytes) noexcept;
+
+        std::size_t const max_buffers_per_class_;
+        std::atomic<std::size_t> pooled_bytes_;
+        size_class size_classes_[num_size_classes];
+        thread_cache_type thread_caches_[num_thread_caches];
+    };
+}    // namespace hpx::parcelset::detail
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,184 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/modules/synchronization.hpp>
+
+#include <hpx/parcelset_base/locality.hpp>
+#include <hpx/parcelset_base/parcel_interface.hpp>
+#include <hpx/parcelset_base/parcelset_base_fwd.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx::parcelset::detail {
+
+    class HPX_EXPORT pending_parcels_queues;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The parcels of one traffic class waiting to be sent to one
+    // destination. Any number of threads may add parcels concurrently, each
+    // addition is a single atomic operation. The thread owning a connection
+    // to the destination takes all pending parcels at once.
+    class HPX_EXPORT pending_parcels_queue
+    {
+    public:
+        pending_parcels_queue(locality const& dest, std::size_t traffic_class,
+            pending_parcels_queues& queues);
+        ~pending_parcels_queue();
+
+        pending_parcels_queue(pending_parcels_queue const&) = delete;
+        pending_parcels_queue(pending_parcels_queue&&) = delete;
+        pending_parcels_queue& operator=(pending_parcels_queue const&) = delete;
+        pending_parcels_queue& operator=(pending_parcels_queue&&) = delete;
+
+        locality const& destination() const noexcept
+        {
+            return destination_;
+        }
+
+        std::size_t traffic_class() const noexcept
+        {
+            return traffic_class_;
+        }
+
+        void push(parcel&& p, parcel_write_handler_type&& f);
+        void push(std::vector<parcel>&& parcels,
+            std::vector<parcel_write_handler_type>&& handlers);
+
+        // Append all pending parcels (in the order they were added) to the
+        // given vectors, returns false if no parcels were pending.
+        bool pop_all(std::vector<parcel>& parcels,
+            std::vector<parcel_write_handler_type>& handlers);
+
+        bool empty() const noexcept
+        {
+            return head_.load(std::memory_order_relaxed) == nullptr;
+        }
+
+        // The number of pending parcels (approximate while parcels are being
+        // added or taken)
+        std::int64_t size() const noexcept
+        {
+            std::int64_t const size = size_.load(std::memory_order_relaxed);
+            return size < 0 ? 0 : size;
+        }
+
+    private:
+        friend class pending_parcels_queues;
+
+        struct node;
+        void push(node* first, node* last, std::int64_t count) noexcept;
+
+        locality const destination_;
+        std::size_t const traffic_class_;
+        pending_parcels_queues& queues_;
+
+        // the most recently added parcel, the parcels are linked in reverse
+        std::atomic<node*> head_;
+        std::atomic<std::int64_t> size_;
+
+        // the next queue of the list of all queues
+        pending_parcels_queue* next_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The queues of pending parcels of a parcelport, one for each
+    // destination and traffic class. A queue is created when the first parcel
+    // of its traffic class is sent to its destination, it exists until the
+    // parcelport is destroyed. Looking up an existing queue does not acquire
+    // any lock.
+    class HPX_EXPORT pending_parcels_queues
+    {
+    public:
+        pending_parcels_queues();
+        ~pending_parcels_queues();
+
+        pending_parcels_queues(pending_parcels_queues const&) = delete;
+        pending_parcels_queues(pending_parcels_queues&&) = delete;
+        pending_parcels_queues& operator=(
+            pending_parcels_queues const&) = delete;
+        pending_parcels_queues& operator=(pending_parcels_queues&&) = delete;
+
+        // Return the queue of the given destination and traffic class,
+        // create it if needed. The hint selects the bucket the queue is
+        // looked up in, lookups are fastest if all destinations use distinct
+        // hints (the locality id of the destination is used by the
+        // parcelports).
+        pending_parcels_queue& get(locality const& dest,
+            std::size_t traffic_class, std::uint32_t hint);
+
+        // Return the queue of the given destination and traffic class,
+        // nullptr if no such parcels have been sent to it yet
+        pending_parcels_queue* find(
+            locality const& dest, std::size_t traffic_class) const noexcept;
+
+        // Return whether any parcels are pending
+        bool has_pending() const noexcept
+        {
+            return num_pending_destinations_.load(std::memory_order_relaxed) >
+                0;
+        }
+
+        // The number of pending parcels for all destinations
+        std::int64_t size() const noexcept;
+
+        // Invoke f for each queue holding pending parcels
+        template <typename F>
+        void for_each_pending(F&& f)
+        {
+            for (pending_parcels_queue* q =
+                     queues_.load(std::memory_order_acquire);
+                 q != nullptr; q = q->next_)
+            {
+                if (!q->empty())
+                {
+                    f(*q);
+                }
+            }
+        }
+
+    private:
+        friend class pending_parcels_queue;
+
+        static constexpr std::size_t num_buckets = 256;
+
+        // A queue may be referred to from more than one bucket if it was
+        // looked up using different hints.
+        struct entry
+        {
+            pending_parcels_queue* queue_;
+            entry* next_;
+        };
+
+        static pending_parcels_queue* find(entry const* e,
+            locality const& dest, std::size_t traffic_class) noexcept;
+
+        std::atomic<entry*> buckets_[num_buckets];
+        std::atomic<pending_parcels_queue*> queues_;
+
+        // the number of queues holding pending parcels
+        std::atomic<std::int32_t> num_pending_destinations_;
+
+        // serializes the creation of queues and bucket entries, owns those
+        hpx::spinlock mtx_;
+        std::vector<std::unique_ptr<pending_parcels_queue>> owned_queues_;
+        std::vector<std::unique_ptr<entry>> owned_entries_;
+    };
+}    // namespace hpx::parcelset::detail
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
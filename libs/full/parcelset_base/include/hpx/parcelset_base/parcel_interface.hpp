@@ -32,6 +32,29 @@
 
 #include <hpx/config/warnings_prefix.hpp>
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+namespace hpx::parcelset {
+
+    // The stages a parcel passes through on its way from the sending to the
+    // receiving locality. The time a parcel reached each of the stages is
+    // recorded in the parcel. The first four stages are recorded on the
+    // sending locality, the remaining ones on the receiving locality.
+    enum class parcel_stage : std::uint8_t
+    {
+        created = 0,      // the parcel was created
+        enqueued = 1,     // the parcel was handed to the parcel handler
+        serialized = 2,   // the parcel was serialized into a message
+        written = 3,      // the message containing the parcel was sent
+        received = 4,     // the parcel is about to be deserialized
+        deserialized = 5, // the parcel was deserialized
+        scheduled = 6,    // the action was scheduled for execution
+        started = 7       // the action started executing
+    };
+
+    inline constexpr std::size_t num_parcel_stages = 8;
+}    // namespace hpx::parcelset
+#endif
+
 namespace hpx::parcelset::detail {
 
     // abstract base class for parcels
@@ -102,6 +125,9 @@ namespace hpx::parcelset::detail {
 #if defined(HPX_HAVE_PARCEL_PROFILING)
         virtual naming::gid_type const& parcel_id() const = 0;
         virtual naming::gid_type& parcel_id() = 0;
+
+        virtual std::int64_t timestamp(parcel_stage stage) const = 0;
+        virtual void set_timestamp(parcel_stage stage, std::int64_t time) = 0;
 #endif
 
         HPX_SERIALIZATION_SPLIT_MEMBER();
@@ -156,6 +182,10 @@ namespace hpx::parcelset {
 #if defined(HPX_HAVE_PARCEL_PROFILING)
         naming::gid_type const& parcel_id() const;
         naming::gid_type& parcel_id();
+
+        // the time [ns] the parcel reached the given stage, zero if unknown
+        std::int64_t timestamp(parcel_stage stage) const;
+        void set_timestamp(parcel_stage stage, std::int64_t time);
 #endif
 
 #if defined(HPX_HAVE_NETWORKING)
@@ -19,8 +19,10 @@
 #include <hpx/modules/runtime_configuration.hpp>
 #include <hpx/modules/synchronization.hpp>
 
+#include <hpx/parcelset_base/detail/buffer_pool.hpp>
 #include <hpx/parcelset_base/detail/data_point.hpp>
 #include <hpx/parcelset_base/detail/gatherer.hpp>
+#include <hpx/parcelset_base/detail/pending_parcels_queue.hpp>
 #include <hpx/parcelset_base/detail/per_action_data_counter.hpp>
 #include <hpx/parcelset_base/locality.hpp>
 #include <hpx/parcelset_base/parcel_interface.hpp>
@@ -84,6 +86,28 @@ namespace hpx::parcelset {
         // serialize an entity
         std::size_t get_zero_copy_serialization_threshold() const noexcept;
 
+        /// Return the pool of the data buffers used for the messages sent and
+        /// received by this parcelport
+        detail::buffer_pool& get_buffer_pool() noexcept;
+
+        /// Parcels are sent through separate queues and connections depending
+        /// on their traffic class. This way small (latency critical) parcels
+        /// don't have to wait for large transfers to the same destination.
+        enum traffic_class
+        {
+            traffic_class_small = 0,
+            traffic_class_large = 1
+        };
+
+        static constexpr std::size_t num_traffic_classes = 2;
+
+        /// Return the traffic class the given parcel is sent with
+        traffic_class get_traffic_class(parcel const& p) const;
+
+        /// Return the number of connections to each destination which may be
+        /// used for large parcels, zero if all parcels are sent alike
+        std::size_t get_large_message_lanes() const noexcept;
+
         /// Start the parcelport I/O thread pool.
         ///
         /// \param blocking [in] If blocking is set to \a true the routine will
@@ -176,6 +200,11 @@ namespace hpx::parcelset {
         virtual std::int64_t get_connection_cache_statistics(
             connection_cache_statistics_type, bool reset) = 0;
 
+        // retrieve performance counter value for the connections used by the
+        // given traffic class only
+        virtual std::int64_t get_connection_cache_statistics(
+            connection_cache_statistics_type, traffic_class, bool reset) = 0;
+
         /// Return the name of this locality
         virtual std::string get_locality_name() const = 0;
 
@@ -322,15 +351,8 @@ namespace hpx::parcelset {
         // mutex for all of the member data
         mutable hpx::spinlock mtx_;
 
-        // The cache for pending parcels
-        using map_second_type =
-            hpx::tuple<std::vector<parcel>, std::vector<write_handler_type>>;
-        using pending_parcels_map = std::map<locality, map_second_type>;
-        pending_parcels_map pending_parcels_;
-
-        using pending_parcels_destinations = std::set<locality>;
-        pending_parcels_destinations parcel_destinations_;
-        std::atomic<std::uint32_t> num_parcel_destinations_;
+        // The queues of pending parcels, one for each destination
+        detail::pending_parcels_queues pending_parcels_;
 
         // The local locality
         locality here_;
@@ -363,6 +385,13 @@ namespace hpx::parcelset {
         std::string type_;
 
         std::size_t zero_copy_serialization_threshold_;
+
+        /// recycled message data buffers
+        detail::buffer_pool buffer_pool_;
+
+        /// parcels of at least this size are sent as large messages
+        std::size_t const large_message_threshold_;
+        std::size_t const large_message_lanes_;
     };
 }    // namespace hpx::parcelset
 
@@ -0,0 +1,198 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/assert.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <hpx/parcelset_base/detail/buffer_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::detail {
+
+    namespace {
+
+        // the size class a buffer of the given size has to be taken from
+        std::size_t size_class_for_request(std::size_t size) noexcept
+        {
+            std::size_t log2 = buffer_pool::min_buffer_size_log2;
+            while ((std::size_t(1) << log2) < size)
+            {
+                ++log2;
+            }
+            return log2 - buffer_pool::min_buffer_size_log2;
+        }
+
+        // the size class a buffer of the given capacity can be used for
+        std::size_t size_class_for_capacity(std::size_t capacity) noexcept
+        {
+            HPX_ASSERT(capacity >= (std::size_t(1)
+                                       << buffer_pool::min_buffer_size_log2));
+
+            std::size_t log2 = buffer_pool::min_buffer_size_log2;
+            while ((std::size_t(1) << (log2 + 1)) <= capacity)
+            {
+                ++log2;
+            }
+            return log2 - buffer_pool::min_buffer_size_log2;
+        }
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    buffer_pool::buffer_pool(std::size_t max_buffers_per_class)
+      : max_buffers_per_class_(max_buffers_per_class)
+      , pooled_bytes_(0)
+    {
+        // releasing a buffer must not allocate
+        for (size_class& c : size_classes_)
+        {
+            c.buffers_.reserve(max_buffers_per_class_);
+        }
+    }
+
+    buffer_pool::thread_cache* buffer_pool::get_thread_cache() noexcept
+    {
+        std::size_t const num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1))
+        {
+            return nullptr;
+        }
+        return &thread_caches_[num_thread % num_thread_caches].data_;
+    }
+
+    bool buffer_pool::reserve_pooled_bytes(std::size_t bytes) noexcept
+    {
+        std::size_t pooled = pooled_bytes_.load(std::memory_order_relaxed);
+        do
+        {
+            if (pooled + bytes > max_pooled_bytes)
+            {
+                return false;
+            }
+        } while (!pooled_bytes_.compare_exchange_weak(
+            pooled, pooled + bytes, std::memory_order_relaxed));
+        return true;
+    }
+
+    buffer_pool::buffer_type buffer_pool::get(std::size_t size)
+    {
+        buffer_type buffer;
+        if (!enabled() || size > max_buffer_size)
+        {
+            buffer.reserve(size);
+            return buffer;
+        }
+
+        std::size_t const cls = size_class_for_request(size);
+        if (cls < num_thread_cached_size_classes)
+        {
+            thread_cache* cache = get_thread_cache();
+            if (cache != nullptr)
+            {
+                std::unique_lock<hpx::spinlock> l(
+                    cache->mtx_, std::try_to_lock);
+                buffer_type& cached = cache->buffers_[cls];
+                if (l.owns_lock() && cached.capacity() != 0)
+                {
+                    buffer = std::exchange(cached, buffer_type());
+                    l.unlock();
+
+                    pooled_bytes_.fetch_sub(
+                        buffer.capacity(), std::memory_order_relaxed);
+
+                    HPX_ASSERT(buffer.capacity() >= size);
+                    return buffer;
+                }
+            }
+        }
+
+        {
+            size_class& c = size_classes_[cls];
+            std::lock_guard<hpx::spinlock> l(c.mtx_);
+            if (!c.buffers_.empty())
+            {
+                buffer = HPX_MOVE(c.buffers_.back());
+                c.buffers_.pop_back();
+                pooled_bytes_.fetch_sub(
+                    buffer.capacity(), std::memory_order_relaxed);
+
+                HPX_ASSERT(buffer.capacity() >= size);
+                return buffer;
+            }
+        }
+
+        // allocate the full size class
+        buffer.reserve(std::size_t(1) << (cls + min_buffer_size_log2));
+        return buffer;
+    }
+
+    void buffer_pool::release(buffer_type&& buffer) noexcept
+    {
+        std::size_t const capacity = buffer.capacity();
+        if (!enabled() ||
+            capacity < (std::size_t(1) << min_buffer_size_log2) ||
+            capacity > max_buffer_size)
+        {
+            return;
+        }
+
+        buffer.clear();
+
+        std::size_t const cls = size_class_for_capacity(capacity);
+        if (!reserve_pooled_bytes(capacity))
+        {
+            return;
+        }
+
+        if (cls < num_thread_cached_size_classes)
+        {
+            thread_cache* cache = get_thread_cache();
+            if (cache != nullptr)
+            {
+                std::unique_lock<hpx::spinlock> l(
+                    cache->mtx_, std::try_to_lock);
+                buffer_type& cached = cache->buffers_[cls];
+                if (l.owns_lock() && cached.capacity() == 0)
+                {
+                    cached = HPX_MOVE(buffer);
+                    return;
+                }
+            }
+        }
+
+        {
+            size_class& c = size_classes_[cls];
+            std::lock_guard<hpx::spinlock> l(c.mtx_);
+            if (c.buffers_.size() < max_buffers_per_class_)
+            {
+                c.buffers_.push_back(HPX_MOVE(buffer));
+                return;
+            }
+        }
+
+        // the buffer is released
+        pooled_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+    }
+
+    void buffer_pool::resize(buffer_type& buffer, std::size_t size)
+    {
+        if (buffer.capacity() < size && enabled())
+        {
+            buffer_type new_buffer = get(size);
+            release(std::exchange(buffer, HPX_MOVE(new_buffer)));
+        }
+        buffer.resize(size);
+    }
+}    // namespace hpx::parcelset::detail
+
+#endif
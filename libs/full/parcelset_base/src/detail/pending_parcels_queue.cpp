@@ -0,0 +1,255 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/assert.hpp>
+
+#include <hpx/parcelset_base/detail/pending_parcels_queue.hpp>
+#include <hpx/parcelset_base/locality.hpp>
+#include <hpx/parcelset_base/parcel_interface.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx::parcelset::detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct pending_parcels_queue::node
+    {
+        node(parcel&& p, parcel_write_handler_type&& f)
+          : parcel_(HPX_MOVE(p))
+          , handler_(HPX_MOVE(f))
+          , next_(nullptr)
+        {
+        }
+
+        parcel parcel_;
+        parcel_write_handler_type handler_;
+        node* next_;
+    };
+
+    pending_parcels_queue::pending_parcels_queue(locality const& dest,
+        std::size_t traffic_class, pending_parcels_queues& queues)
+      : destination_(dest)
+      , traffic_class_(traffic_class)
+      , queues_(queues)
+      , head_(nullptr)
+      , size_(0)
+      , next_(nullptr)
+    {
+    }
+
+    pending_parcels_queue::~pending_parcels_queue()
+    {
+        node* n = head_.exchange(nullptr, std::memory_order_acquire);
+        while (n != nullptr)
+        {
+            node* next = n->next_;
+            delete n;
+            n = next;
+        }
+    }
+
+    void pending_parcels_queue::push(
+        node* first, node* last, std::int64_t count) noexcept
+    {
+        size_.fetch_add(count, std::memory_order_relaxed);
+
+        node* head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            last->next_ = head;
+        } while (!head_.compare_exchange_weak(head, first,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        // this queue has become non-empty
+        if (head == nullptr)
+        {
+            queues_.num_pending_destinations_.fetch_add(
+                1, std::memory_order_relaxed);
+        }
+    }
+
+    void pending_parcels_queue::push(parcel&& p, parcel_write_handler_type&& f)
+    {
+        node* n = new node(HPX_MOVE(p), HPX_MOVE(f));
+        push(n, n, 1);
+    }
+
+    void pending_parcels_queue::push(std::vector<parcel>&& parcels,
+        std::vector<parcel_write_handler_type>&& handlers)
+    {
+        HPX_ASSERT(parcels.size() == handlers.size());
+        if (parcels.empty())
+        {
+            return;
+        }
+
+        // link the new nodes such that the first parcel ends up last
+        node* first = nullptr;
+        node* last = nullptr;
+        for (std::size_t i = 0; i != parcels.size(); ++i)
+        {
+            node* n = new node(HPX_MOVE(parcels[i]), HPX_MOVE(handlers[i]));
+            n->next_ = first;
+            first = n;
+            if (last == nullptr)
+            {
+                last = n;
+            }
+        }
+
+        push(first, last, static_cast<std::int64_t>(parcels.size()));
+
+        parcels.clear();
+        handlers.clear();
+    }
+
+    bool pending_parcels_queue::pop_all(std::vector<parcel>& parcels,
+        std::vector<parcel_write_handler_type>& handlers)
+    {
+        node* n = head_.exchange(nullptr, std::memory_order_acquire);
+        if (n == nullptr)
+        {
+            return false;
+        }
+
+        queues_.num_pending_destinations_.fetch_sub(
+            1, std::memory_order_relaxed);
+
+        // restore the order the parcels were added in
+        std::int64_t count = 0;
+        node* prev = nullptr;
+        while (n != nullptr)
+        {
+            node* next = n->next_;
+            n->next_ = prev;
+            prev = n;
+            n = next;
+            ++count;
+        }
+
+        size_.fetch_sub(count, std::memory_order_relaxed);
+
+        std::size_t const size =
+            parcels.size() + static_cast<std::size_t>(count);
+        parcels.reserve(size);
+        handlers.reserve(size);
+
+        for (n = prev; n != nullptr;)
+        {
+            node* next = n->next_;
+            parcels.push_back(HPX_MOVE(n->parcel_));
+            handlers.push_back(HPX_MOVE(n->handler_));
+            delete n;
+            n = next;
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pending_parcels_queues::pending_parcels_queues()
+      : queues_(nullptr)
+      , num_pending_destinations_(0)
+    {
+        for (std::atomic<entry*>& bucket : buckets_)
+        {
+            bucket.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    pending_parcels_queues::~pending_parcels_queues() = default;
+
+    pending_parcels_queue* pending_parcels_queues::find(entry const* e,
+        locality const& dest, std::size_t traffic_class) noexcept
+    {
+        for (/**/; e != nullptr; e = e->next_)
+        {
+            if (e->queue_->traffic_class() == traffic_class &&
+                e->queue_->destination() == dest)
+            {
+                return e->queue_;
+            }
+        }
+        return nullptr;
+    }
+
+    pending_parcels_queue& pending_parcels_queues::get(
+        locality const& dest, std::size_t traffic_class, std::uint32_t hint)
+    {
+        std::atomic<entry*>& bucket = buckets_[hint % num_buckets];
+
+        // fast path: the queue is known in this bucket already
+        if (pending_parcels_queue* q =
+                find(bucket.load(std::memory_order_acquire), dest,
+                    traffic_class))
+        {
+            return *q;
+        }
+
+        std::lock_guard l(mtx_);
+
+        if (pending_parcels_queue* q =
+                find(bucket.load(std::memory_order_relaxed), dest,
+                    traffic_class))
+        {
+            return *q;
+        }
+
+        // the queue might have been created using a different hint
+        pending_parcels_queue* q = find(dest, traffic_class);
+        if (q == nullptr)
+        {
+            owned_queues_.push_back(std::make_unique<pending_parcels_queue>(
+                dest, traffic_class, *this));
+            q = owned_queues_.back().get();
+
+            q->next_ = queues_.load(std::memory_order_relaxed);
+            queues_.store(q, std::memory_order_release);
+        }
+
+        owned_entries_.push_back(std::make_unique<entry>(
+            entry{q, bucket.load(std::memory_order_relaxed)}));
+        bucket.store(owned_entries_.back().get(), std::memory_order_release);
+
+        return *q;
+    }
+
+    pending_parcels_queue* pending_parcels_queues::find(
+        locality const& dest, std::size_t traffic_class) const noexcept
+    {
+        for (pending_parcels_queue* q = queues_.load(std::memory_order_acquire);
+             q != nullptr; q = q->next_)
+        {
+            if (q->traffic_class() == traffic_class &&
+                q->destination() == dest)
+            {
+                return q;
+            }
+        }
+        return nullptr;
+    }
+
+    std::int64_t pending_parcels_queues::size() const noexcept
+    {
+        std::int64_t size = 0;
+        for (pending_parcels_queue* q = queues_.load(std::memory_order_acquire);
+             q != nullptr; q = q->next_)
+        {
+            size += q->size();
+        }
+        return size;
+    }
+}    // namespace hpx::parcelset::detail
+
+#endif
@@ -215,6 +215,16 @@ namespace hpx::parcelset {
         return data_->parcel_id();
     }
 
+    std::int64_t parcel::timestamp(parcel_stage stage) const
+    {
+        return data_->timestamp(stage);
+    }
+
+    void parcel::set_timestamp(parcel_stage stage, std::int64_t time)
+    {
+        data_->set_timestamp(stage, time);
+    }
+
     // generate unique parcel id
     naming::gid_type parcel::generate_unique_id(std::uint32_t locality_id)
     {
@@ -35,8 +35,7 @@ namespace hpx::parcelset {
     parcelport::parcelport(util::runtime_configuration const& ini,
         locality const& here, std::string const& type,
         std::size_t zero_copy_serialization_threshold)
-      : num_parcel_destinations_(0)
-      , here_(here)
+      : here_(here)
       , max_inbound_message_size_(ini.get_max_inbound_message_size())
       , max_outbound_message_size_(ini.get_max_outbound_message_size())
       , allow_array_optimizations_(true)
@@ -46,6 +45,12 @@ namespace hpx::parcelset {
             ini, "hpx.parcel." + type + ".priority", 0))
       , type_(type)
       , zero_copy_serialization_threshold_(zero_copy_serialization_threshold)
+      , buffer_pool_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel." + type + ".buffer_pool_size", 16))
+      , large_message_threshold_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel." + type + ".large_message_threshold", 65536))
+      , large_message_lanes_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel." + type + ".large_message_lanes", 2))
     {
         std::string key("hpx.parcel.");
         key += type;
@@ -88,6 +93,40 @@ namespace hpx::parcelset {
         return zero_copy_serialization_threshold_;
     }
 
+    detail::buffer_pool& parcelport::get_buffer_pool() noexcept
+    {
+        return buffer_pool_;
+    }
+
+    parcelport::traffic_class parcelport::get_traffic_class(
+        parcel const& p) const
+    {
+        if (large_message_lanes_ == 0 || large_message_threshold_ == 0 ||
+            p.size() < large_message_threshold_)
+        {
+            return traffic_class_small;
+        }
+
+        // parcels of actions scheduled with a high priority are expected to
+        // be latency critical regardless of their size
+        switch (p.get_thread_priority())
+        {
+        case threads::thread_priority::high:
+        case threads::thread_priority::high_recursive:
+        case threads::thread_priority::boost:
+            return traffic_class_small;
+
+        default:
+            break;
+        }
+        return traffic_class_large;
+    }
+
+    std::size_t parcelport::get_large_message_lanes() const noexcept
+    {
+        return large_message_lanes_;
+    }
+
     locality const& parcelport::here() const noexcept
     {
         return here_;
@@ -325,15 +364,7 @@ namespace hpx::parcelset {
 #endif
     std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
     {
-        std::lock_guard<hpx::spinlock> l(mtx_);
-        std::int64_t count = 0;
-        for (auto&& p : pending_parcels_)
-        {
-            count += hpx::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::get<0>(p.second).size() == hpx::get<1>(p.second).size());
-        }
-        return count;
+        return pending_parcels_.size();
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,161 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test the pool of message buffers used by the parcelports.
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/hpx_main.hpp>
+
+#include <hpx/modules/testing.hpp>
+#include <hpx/parcelset_base/detail/buffer_pool.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+using hpx::parcelset::detail::buffer_pool;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_disabled()
+{
+    buffer_pool pool;
+    HPX_TEST(!pool.enabled());
+
+    buffer_pool::buffer_type buffer = pool.get(100);
+    HPX_TEST(buffer.empty());
+    HPX_TEST_LTE(std::size_t(100), buffer.capacity());
+
+    buffer.resize(4096);
+    pool.release(HPX_MOVE(buffer));
+    HPX_TEST_EQ(pool.pooled_bytes(), std::size_t(0));
+}
+
+void test_size_classes()
+{
+    buffer_pool pool(4);
+
+    // buffers are allocated with the full capacity of their size class
+    HPX_TEST_EQ(pool.get(0).capacity(), std::size_t(1024));
+    HPX_TEST_EQ(pool.get(100).capacity(), std::size_t(1024));
+    HPX_TEST_EQ(pool.get(1025).capacity(), std::size_t(2048));
+    HPX_TEST_EQ(pool.get(buffer_pool::max_buffer_size).capacity(),
+        buffer_pool::max_buffer_size);
+
+    // larger buffers are neither rounded up nor pooled
+    buffer_pool::buffer_type large = pool.get(buffer_pool::max_buffer_size + 1);
+    HPX_TEST_EQ(large.capacity(), buffer_pool::max_buffer_size + 1);
+    pool.release(HPX_MOVE(large));
+    HPX_TEST_EQ(pool.pooled_bytes(), std::size_t(0));
+
+    // buffers are resized to the requested size
+    buffer_pool::buffer_type buffer;
+    pool.resize(buffer, 3000);
+    HPX_TEST_EQ(buffer.size(), std::size_t(3000));
+    HPX_TEST_EQ(buffer.capacity(), std::size_t(4096));
+}
+
+void test_reuse()
+{
+    buffer_pool pool(4);
+
+    // the small buffer is kept in the thread cache, the large one in the
+    // shared lists of the pool, both are accounted for
+    for (std::size_t size : {std::size_t(4096), std::size_t(1024 * 1024)})
+    {
+        buffer_pool::buffer_type buffer = pool.get(size);
+        char const* data = buffer.data();
+
+        pool.release(HPX_MOVE(buffer));
+        HPX_TEST_EQ(pool.pooled_bytes(), size);
+
+        buffer = pool.get(size - 1);
+        HPX_TEST(buffer.data() == data);
+        HPX_TEST_EQ(pool.pooled_bytes(), std::size_t(0));
+
+        // a buffer with sufficient capacity is not exchanged
+        pool.resize(buffer, size);
+        HPX_TEST(buffer.data() == data);
+    }
+}
+
+void test_separate_pools()
+{
+    buffer_pool pool1(4);
+    buffer_pool pool2(4);
+
+    buffer_pool::buffer_type buffer = pool1.get(4096);
+    char const* data = buffer.data();
+    pool1.release(HPX_MOVE(buffer));
+
+    // the thread caches are not shared between pools
+    buffer = pool2.get(4096);
+    HPX_TEST(buffer.data() != data);
+    HPX_TEST_EQ(pool1.pooled_bytes(), std::size_t(4096));
+    HPX_TEST_EQ(pool2.pooled_bytes(), std::size_t(0));
+
+    buffer = pool1.get(4096);
+    HPX_TEST(buffer.data() == data);
+    HPX_TEST_EQ(pool1.pooled_bytes(), std::size_t(0));
+}
+
+void test_limits()
+{
+    // one buffer in the thread cache and one in the shared list
+    {
+        buffer_pool pool(1);
+        for (int i = 0; i != 3; ++i)
+        {
+            pool.release(buffer_pool::buffer_type(4096));
+        }
+        HPX_TEST_EQ(pool.pooled_bytes(), std::size_t(2 * 4096));
+    }
+
+    // threads not managed by HPX use the shared lists only
+    {
+        buffer_pool pool(1);
+        std::thread t([&]() {
+            for (int i = 0; i != 3; ++i)
+            {
+                pool.release(buffer_pool::buffer_type(4096));
+            }
+        });
+        t.join();
+        HPX_TEST_EQ(pool.pooled_bytes(), std::size_t(4096));
+    }
+
+    // the overall size of the pooled buffers is limited
+    {
+        std::size_t const num_buffers =
+            buffer_pool::max_pooled_bytes / buffer_pool::max_buffer_size;
+
+        buffer_pool pool(2 * num_buffers);
+        for (std::size_t i = 0; i != num_buffers + 1; ++i)
+        {
+            pool.release(
+                buffer_pool::buffer_type(buffer_pool::max_buffer_size));
+        }
+        HPX_TEST_EQ(pool.pooled_bytes(), buffer_pool::max_pooled_bytes);
+    }
+}
+
+int main()
+{
+    test_disabled();
+    test_size_classes();
+    test_reuse();
+    test_separate_pools();
+    test_limits();
+
+    return hpx::util::report_errors();
+}
+#else
+int main()
+{
+    return 0;
+}
+#endif
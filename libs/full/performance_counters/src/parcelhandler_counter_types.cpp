@@ -15,11 +15,214 @@
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/performance_counters/parcelhandler_counter_types.hpp>
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+#include <hpx/modules/string_util.hpp>
+#include <hpx/parcelset/detail/parcel_latency.hpp>
+#include <hpx/threading_base/detail/latency_histogram.hpp>
+#include <hpx/util/from_string.hpp>
+#endif
+
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace hpx::performance_counters {
 
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // parcel latency histogram and percentile counter creation function,
+        // the optional action name and the histogram layout or the
+        // percentile are passed as the counter parameters:
+        // /parcels{locality#%d/total}/time/decode-latency-histogram@<action>,0,1000,10
+        // /parcels{locality#%d/total}/time/total-latency-percentile@99,<action>
+        naming::gid_type parcel_latency_counter_creator(
+            parcelset::detail::parcel_latency_interval interval,
+            counter_info const& info, error_code& ec)
+        {
+            // verify the validity of the counter instance name
+            counter_path_elements paths;
+            get_counter_path_elements(info.fullname_, paths, ec);
+            if (ec)
+            {
+                return naming::invalid_gid;
+            }
+
+            if (paths.parentinstance_is_basename_)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "parcel_latency_counter_creator",
+                    "invalid counter instance parent name: {}",
+                    paths.parentinstancename_);
+                return naming::invalid_gid;
+            }
+
+            if (paths.instancename_ != "total" || paths.instanceindex_ != -1)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "parcel_latency_counter_creator",
+                    "invalid counter instance name: {}", paths.instancename_);
+                return naming::invalid_gid;
+            }
+
+            using parcelset::detail::parcel_latency_statistics;
+            using threads::detail::latency_histogram;
+
+            if (info.type_ == counter_type::histogram)
+            {
+                // the action name is followed by the bounds and the number of
+                // buckets of the histogram
+                std::vector<std::string> params;
+                hpx::string_util::split(params, paths.parameters_,
+                    hpx::string_util::is_any_of(","),
+                    hpx::string_util::token_compress_mode::off);
+
+                std::string action;
+                std::int64_t min_boundary = 0;
+                std::int64_t max_boundary = 1000000;    // 1ms
+                std::int64_t num_buckets = 20;
+
+                if (!params.empty())
+                    action = params[0];
+                if (params.size() > 1 && !params[1].empty())
+                    min_boundary =
+                        hpx::util::from_string<std::int64_t>(params[1], -1);
+                if (params.size() > 2 && !params[2].empty())
+                    max_boundary =
+                        hpx::util::from_string<std::int64_t>(params[2], -1);
+                if (params.size() > 3 && !params[3].empty())
+                    num_buckets =
+                        hpx::util::from_string<std::int64_t>(params[3], -1);
+
+                if (min_boundary < 0 || max_boundary <= min_boundary ||
+                    num_buckets <= 0)
+                {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "parcel_latency_counter_creator",
+                        "invalid histogram parameters specified for this "
+                        "counter: {}",
+                        paths.parameters_);
+                    return naming::invalid_gid;
+                }
+
+                hpx::function<std::vector<std::int64_t>(bool)> f =
+                    [interval, action = HPX_MOVE(action), min_boundary,
+                        max_boundary, num_buckets](bool reset) {
+                        return latency_histogram::get_linear_histogram(
+                            parcel_latency_statistics::get().get_histogram(
+                                interval, action, reset),
+                            min_boundary, max_boundary, num_buckets);
+                    };
+                return create_raw_counter(info, HPX_MOVE(f), ec);
+            }
+
+            // the requested percentile is followed by the action name
+            double percentile = 50.0;
+            std::string action;
+            if (!paths.parameters_.empty())
+            {
+                std::string::size_type const p = paths.parameters_.find(',');
+                if (p != std::string::npos)
+                {
+                    action = paths.parameters_.substr(p + 1);
+                }
+
+                percentile = hpx::util::from_string<double>(
+                    paths.parameters_.substr(0, p), -1.0);
+                if (percentile <= 0.0 || percentile > 100.0)
+                {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "parcel_latency_counter_creator",
+                        "invalid percentile specified for this counter: {}",
+                        paths.parameters_);
+                    return naming::invalid_gid;
+                }
+            }
+
+            hpx::function<std::int64_t(bool)> f =
+                [interval, action = HPX_MOVE(action), percentile](bool reset) {
+                    return latency_histogram::get_percentile(
+                        parcel_latency_statistics::get().get_histogram(
+                            interval, action, reset),
+                        percentile);
+                };
+            return create_raw_counter(info, HPX_MOVE(f), ec);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void register_parcel_latency_counter_types()
+        {
+            using parcelset::detail::get_parcel_latency_interval_name;
+            using parcelset::detail::num_parcel_latency_intervals;
+            using parcelset::detail::parcel_latency_interval;
+
+            // the stages each of the intervals spans
+            char const* const descriptions[num_parcel_latency_intervals] = {
+                "the creation of parcels and their hand-over to the "
+                "parcel handler",
+                "the hand-over of parcels to the parcel handler and "
+                "their serialization",
+                "the serialization of parcels and the completion of "
+                "sending the message containing them",
+                "the serialization of parcels and the start of their "
+                "deserialization on the receiving locality (requires "
+                "synchronized clocks)",
+                "the start and the end of the deserialization of "
+                "received parcels",
+                "the deserialization of received parcels and the "
+                "scheduling of their actions",
+                "the scheduling of the actions of received parcels and "
+                "the start of their execution",
+                "the creation of parcels and the start of the execution "
+                "of their actions on the receiving locality (requires "
+                "synchronized clocks)"};
+
+            std::vector<generic_counter_type_data> counter_types;
+            counter_types.reserve(2 * num_parcel_latency_intervals);
+
+            for (std::size_t i = 0; i != num_parcel_latency_intervals; ++i)
+            {
+                auto const interval = static_cast<parcel_latency_interval>(i);
+                char const* name = get_parcel_latency_interval_name(interval);
+
+                counter_types.push_back(generic_counter_type_data{
+                    hpx::util::format(
+                        "/parcels/time/{}-latency-histogram", name),
+                    counter_type::histogram,
+                    hpx::util::format(
+                        "returns a histogram of the time between {} for "
+                        "the action given as the counter parameter "
+                        "(default: all actions) on the referenced locality "
+                        "(the action name may be followed by the lower and "
+                        "upper bound and the number of buckets, default: "
+                        "0,1000000,20)",
+                        descriptions[i]),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind_front(&parcel_latency_counter_creator, interval),
+                    &locality_counter_discoverer, "ns"});
+
+                counter_types.push_back(generic_counter_type_data{
+                    hpx::util::format(
+                        "/parcels/time/{}-latency-percentile", name),
+                    counter_type::raw,
+                    hpx::util::format(
+                        "returns the given percentile (passed as the "
+                        "counter parameter, default: 50, optionally "
+                        "followed by an action name) of the time between "
+                        "{} on the referenced locality",
+                        descriptions[i]),
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    hpx::bind_front(&parcel_latency_counter_creator, interval),
+                    &locality_counter_discoverer, "ns"});
+            }
+
+            install_counter_types(counter_types.data(), counter_types.size());
+        }
+    }    // namespace detail
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     void register_parcelhandler_counter_types(
         parcelset::parcelhandler& ph, std::string const& pp_type)
@@ -644,6 +847,10 @@ namespace hpx::performance_counters {
 
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types) / sizeof(counter_types[0]));
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        detail::register_parcel_latency_counter_types();
+#endif
     }
 }    // namespace hpx::performance_counters
 
@@ -12,7 +12,10 @@
 #include <hpx/assert.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/functional/bind_front.hpp>
+#include <hpx/futures/detail/future_data.hpp>
+#include <hpx/coroutines/detail/stack_arena.hpp>
 #include <hpx/modules/errors.hpp>
+#include <hpx/modules/string_util.hpp>
 #include <hpx/modules/threadmanager.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
@@ -20,10 +23,14 @@
 #include <hpx/performance_counters/threadmanager_counter_types.hpp>
 #include <hpx/runtime_local/thread_pool_helpers.hpp>
 #include <hpx/schedulers/maintain_queue_wait_times.hpp>
+#include <hpx/threading_base/detail/latency_histogram.hpp>
+#include <hpx/util/from_string.hpp>
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace performance_counters { namespace detail {
@@ -178,6 +185,15 @@ namespace hpx { namespace performance_counters { namespace detail {
         return naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////
+    // continuation placement counter creation function
+    // /threads{locality#%d/total}/count/continuation-placements
+    naming::gid_type continuation_placement_counter_creator(
+        std::int64_t (*func)(bool), counter_info const& info, error_code& ec)
+    {
+        return locality_raw_counter_creator(info, func, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////
     // locality/pool/worker-thread counter creation function with no total
     // /threads{locality#%d/worker-thread#%d}/idle-loop-count/instantaneous
@@ -245,6 +261,140 @@ namespace hpx { namespace performance_counters { namespace detail {
         return naming::invalid_gid;
     }
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    ///////////////////////////////////////////////////////////////////////
+    // latency histogram and percentile counter creation function
+    // /threads{locality#%d/total}/time/creation-latency-histogram@0,1000,10
+    // /threads{locality#%d/worker-thread#%d}/time/resume-latency-percentile@99
+    naming::gid_type latency_histogram_counter_creator(
+        threads::threadmanager* tm, threads::thread_latency which,
+        counter_info const& info, error_code& ec)
+    {
+        // verify the validity of the counter instance name
+        counter_path_elements paths;
+        get_counter_path_elements(info.fullname_, paths, ec);
+        if (ec)
+        {
+            return naming::invalid_gid;
+        }
+
+        if (paths.parentinstance_is_basename_)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "latency_histogram_counter_creator",
+                "invalid counter instance parent name: {}",
+                paths.parentinstancename_);
+            return naming::invalid_gid;
+        }
+
+        hpx::function<std::vector<std::int64_t>(bool)> counts;
+
+        threads::thread_pool_base& pool = tm->default_pool();
+        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        {
+            // overall counter
+            counts = hpx::bind_front(
+                &threads::threadmanager::get_latency_histogram, tm, which);
+        }
+        else if (paths.instancename_ == "pool" && paths.instanceindex_ >= 0 &&
+            std::size_t(paths.instanceindex_) <
+                hpx::resource::get_num_thread_pools())
+        {
+            // specific for given pool counter
+            counts = hpx::bind_front(
+                &threads::thread_pool_base::get_latency_histogram,
+                &hpx::resource::get_thread_pool(paths.instanceindex_), which,
+                static_cast<std::size_t>(paths.subinstanceindex_));
+        }
+        else if (paths.instancename_ == "worker-thread" &&
+            paths.instanceindex_ >= 0 &&
+            std::size_t(paths.instanceindex_) < pool.get_os_thread_count())
+        {
+            // specific counter from default pool
+            counts = hpx::bind_front(
+                &threads::thread_pool_base::get_latency_histogram, &pool,
+                which, static_cast<std::size_t>(paths.instanceindex_));
+        }
+        else
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "latency_histogram_counter_creator",
+                "invalid counter instance name: {}", paths.instancename_);
+            return naming::invalid_gid;
+        }
+
+        using detail::create_raw_counter;
+        using threads::detail::latency_histogram;
+
+        if (info.type_ == counter_type::histogram)
+        {
+            // the bounds and the number of buckets of the histogram are
+            // passed as the counter parameters
+            std::vector<std::string> params;
+            hpx::string_util::split(params, paths.parameters_,
+                hpx::string_util::is_any_of(","),
+                hpx::string_util::token_compress_mode::off);
+
+            std::int64_t min_boundary = 0;
+            std::int64_t max_boundary = 1000000;    // 1ms
+            std::int64_t num_buckets = 20;
+
+            if (!params.empty() && !params[0].empty())
+                min_boundary =
+                    hpx::util::from_string<std::int64_t>(params[0], -1);
+            if (params.size() > 1 && !params[1].empty())
+                max_boundary =
+                    hpx::util::from_string<std::int64_t>(params[1], -1);
+            if (params.size() > 2 && !params[2].empty())
+                num_buckets =
+                    hpx::util::from_string<std::int64_t>(params[2], -1);
+
+            if (min_boundary < 0 || max_boundary <= min_boundary ||
+                num_buckets <= 0)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "latency_histogram_counter_creator",
+                    "invalid histogram parameters specified for this "
+                    "counter: {}",
+                    paths.parameters_);
+                return naming::invalid_gid;
+            }
+
+            hpx::function<std::vector<std::int64_t>(bool)> f =
+                [counts = HPX_MOVE(counts), min_boundary, max_boundary,
+                    num_buckets](bool reset) {
+                    return latency_histogram::get_linear_histogram(
+                        counts(reset), min_boundary, max_boundary,
+                        num_buckets);
+                };
+            return create_raw_counter(info, HPX_MOVE(f), ec);
+        }
+
+        // the requested percentile is passed as the counter parameter
+        double percentile = 50.0;
+        if (!paths.parameters_.empty())
+        {
+            percentile =
+                hpx::util::from_string<double>(paths.parameters_, -1.0);
+            if (percentile <= 0.0 || percentile > 100.0)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "latency_histogram_counter_creator",
+                    "invalid percentile specified for this counter: {}",
+                    paths.parameters_);
+                return naming::invalid_gid;
+            }
+        }
+
+        hpx::function<std::int64_t(bool)> f =
+            [counts = HPX_MOVE(counts), percentile](bool reset) {
+                return latency_histogram::get_percentile(
+                    counts(reset), percentile);
+            };
+        return create_raw_counter(info, HPX_MOVE(f), ec);
+    }
+#endif
+
     ///////////////////////////////////////////////////////////////////////
     bool locality_allocator_counter_discoverer(counter_info const& info,
         discover_counter_func const& f, discover_counters_mode mode,
@@ -411,6 +561,18 @@ namespace hpx { namespace performance_counters { namespace detail {
                 hpx::bind_front(&threads::coroutine_type::impl_type::
                                     get_stack_unbind_count),
                 hpx::function<std::uint64_t(bool)>(), "", 0},
+#endif
+#if !defined(HPX_WINDOWS)
+            // /threads{locality#%d/total}/stacks/committed-bytes
+            {"stacks/committed-bytes",
+                hpx::bind_front(&threads::coroutines::detail::posix::
+                                    get_stack_bytes_committed),
+                hpx::function<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/stacks/resident-bytes
+            {"stacks/resident-bytes",
+                hpx::bind_front(&threads::coroutines::detail::posix::
+                                    get_stack_bytes_resident),
+                hpx::function<std::uint64_t(bool)>(), "", 0},
 #endif
         };
         std::size_t const data_size = sizeof(data) / sizeof(data[0]);
@@ -697,12 +859,123 @@ namespace hpx { namespace performance_counters {
                 "operations performed for the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &locality_counter_discoverer, ""},
+#endif
+#if !defined(HPX_WINDOWS)
+            {"/threads/stacks/committed-bytes", counter_type::raw,
+                "returns the number of bytes of address space reserved for "
+                "HPX-thread stacks (including guard pages) for the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &locality_counter_discoverer, "bytes"},
+            {"/threads/stacks/resident-bytes", counter_type::raw,
+                "returns the number of bytes of HPX-thread stack memory which "
+                "may be backed by physical memory for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &locality_counter_discoverer, "bytes"},
 #endif
             {"/threads/count/objects", counter_type::monotonically_increasing,
                 "returns the overall number of created HPX-thread objects for "
                 "the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &detail::locality_allocator_counter_discoverer, ""},
+#endif
+            {"/threads/count/missed-deadlines",
+                counter_type::monotonically_increasing,
+                "returns the number of HPX-threads which were scheduled by the "
+                "referenced worker-thread on the referenced locality only "
+                "after their deadline had passed",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::locality_pool_thread_counter_creator,
+                    &tm, &threads::threadmanager::get_num_missed_deadlines,
+                    &threads::thread_pool_base::get_num_missed_deadlines),
+                &locality_pool_thread_counter_discoverer, ""},
+            {"/threads/count/continuation-placements",
+                counter_type::monotonically_increasing,
+                "returns the number of asynchronous future continuations which "
+                "were placed on the worker-thread that has made their future "
+                "ready for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::continuation_placement_counter_creator,
+                    &lcos::detail::get_continuation_placement_count),
+                &locality_counter_discoverer, ""},
+            {"/threads/count/continuation-placement-hits",
+                counter_type::monotonically_increasing,
+                "returns the number of placed asynchronous future continuations "
+                "which were executed by the worker-thread they were placed on "
+                "for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::continuation_placement_counter_creator,
+                    &lcos::detail::get_continuation_placement_hit_count),
+                &locality_counter_discoverer, ""},
+            {"/threads/continuation-placement-hit-rate", counter_type::raw,
+                "returns the ratio of placed asynchronous future continuations "
+                "which were executed by the worker-thread they were placed on "
+                "for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::continuation_placement_counter_creator,
+                    &lcos::detail::get_continuation_placement_hit_rate),
+                &locality_counter_discoverer, "0.01%"},
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            {"/threads/time/creation-latency-histogram",
+                counter_type::histogram,
+                "returns a histogram of the time between the creation of "
+                "HPX-threads and the start of their first execution for the "
+                "referenced worker-thread on the referenced locality (the "
+                "counter parameters are the lower and upper bound and the "
+                "number of buckets, default: 0,1000000,20)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::creation),
+                &locality_pool_thread_counter_discoverer, "ns"},
+            {"/threads/time/creation-latency-percentile", counter_type::raw,
+                "returns the given percentile (passed as the counter "
+                "parameter, default: 50) of the time between the creation of "
+                "HPX-threads and the start of their first execution for the "
+                "referenced worker-thread on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::creation),
+                &locality_pool_thread_counter_discoverer, "ns"},
+            {"/threads/time/resume-latency-histogram", counter_type::histogram,
+                "returns a histogram of the time between HPX-threads becoming "
+                "pending again after a suspension (or after yielding) and the "
+                "start of their next execution for the referenced "
+                "worker-thread on the referenced locality (the counter "
+                "parameters are the lower and upper bound and the number of "
+                "buckets, default: 0,1000000,20)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::resume),
+                &locality_pool_thread_counter_discoverer, "ns"},
+            {"/threads/time/resume-latency-percentile", counter_type::raw,
+                "returns the given percentile (passed as the counter "
+                "parameter, default: 50) of the time between HPX-threads "
+                "becoming pending again after a suspension (or after "
+                "yielding) and the start of their next execution for the "
+                "referenced worker-thread on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::resume),
+                &locality_pool_thread_counter_discoverer, "ns"},
+            {"/threads/time/phase-duration-histogram", counter_type::histogram,
+                "returns a histogram of the duration of the execution phases "
+                "of HPX-threads for the referenced worker-thread on the "
+                "referenced locality (the counter parameters are the lower "
+                "and upper bound and the number of buckets, default: "
+                "0,1000000,20)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::phase),
+                &locality_pool_thread_counter_discoverer, "ns"},
+            {"/threads/time/phase-duration-percentile", counter_type::raw,
+                "returns the given percentile (passed as the counter "
+                "parameter, default: 50) of the duration of the execution "
+                "phases of HPX-threads for the referenced worker-thread on "
+                "the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                hpx::bind_front(&detail::latency_histogram_counter_creator,
+                    &tm, threads::thread_latency::phase),
+                &locality_pool_thread_counter_discoverer, "ns"},
 #endif
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
             {"/threads/count/pending-misses",
@@ -39,6 +39,12 @@ char const* const locality_pool_thread_counter_names[] =
     "/threads/count/instantaneous/suspended",
     "/threads/count/instantaneous/terminated",
     "/threads/count/instantaneous/staged",
+    "/threads/count/missed-deadlines",
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+    "/threads/time/creation-latency-percentile",
+    "/threads/time/resume-latency-percentile",
+    "/threads/time/phase-duration-percentile",
+#endif
 #ifdef HPX_HAVE_THREAD_CUMULATIVE_COUNTS
     "/threads/count/cumulative",
     "/threads/count/cumulative-phases",
@@ -82,7 +88,14 @@ char const* const locality_counter_names[] = {
 #if !defined(HPX_WINDOWS) && !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
     "/threads/count/stack-unbinds",
 #endif
+#if !defined(HPX_WINDOWS)
+    "/threads/stacks/committed-bytes",
+    "/threads/stacks/resident-bytes",
+#endif
 #endif
+    "/threads/count/continuation-placements",
+    "/threads/count/continuation-placement-hits",
+    "/threads/continuation-placement-hit-rate",
     "/scheduler/utilization/instantaneous", nullptr};
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,85 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the layout of the values returned by the histogram counters: the
+// lower and upper bound and the size of the buckets followed by the counts of
+// all buckets.
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_histogram(std::string const& name, std::int64_t lower,
+    std::int64_t upper, std::int64_t bucket_size, std::size_t num_buckets)
+{
+    hpx::performance_counters::performance_counter c(name);
+
+    // make sure some values are recorded
+    std::vector<hpx::future<void>> futures;
+    for (int i = 0; i != 100; ++i)
+    {
+        futures.push_back(hpx::async([]() {}));
+    }
+    hpx::wait_all(futures);
+
+    auto values = c.get_counter_values_array(hpx::launch::sync, false);
+
+    HPX_TEST_EQ(values.values_.size(), num_buckets + 3);
+    HPX_TEST_EQ(values.values_[0], lower);
+    HPX_TEST_EQ(values.values_[1], upper);
+    HPX_TEST_EQ(values.values_[2], bucket_size);
+
+    std::int64_t total = 0;
+    for (std::size_t i = 3; i != values.values_.size(); ++i)
+    {
+        HPX_TEST_LTE(std::int64_t(0), values.values_[i]);
+        total += values.values_[i];
+    }
+    HPX_TEST_LTE(std::int64_t(100), total);
+}
+
+int hpx_main()
+{
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    test_histogram("/threads{locality#0/total}/time/phase-duration-histogram",
+        0, 1000000, 50000, 20);
+    test_histogram(
+        "/threads{locality#0/total}/time/creation-latency-histogram@1000,"
+        "101000,100",
+        1000, 101000, 1000, 100);
+
+    // the upper bound is rounded up to a multiple of the bucket size
+    test_histogram(
+        "/threads{locality#0/worker-thread#0}/time/phase-duration-histogram@"
+        "0,1000,3",
+        0, 1002, 334, 3);
+
+    HPX_TEST_THROW(hpx::performance_counters::performance_counter(
+                       "/threads{locality#0/total}/time/"
+                       "phase-duration-histogram@1000,10")
+                       .get_counter_values_array(hpx::launch::sync, false),
+        hpx::exception);
+#endif
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
+#endif
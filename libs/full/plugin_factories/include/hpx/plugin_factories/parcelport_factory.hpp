@@ -122,6 +122,18 @@ namespace hpx::plugins {
                 name_uc +
                 "_ASYNC_SERIALIZATION:"
                 "$[hpx.parcel.async_serialization]}");
+            fillini.emplace_back("buffer_pool_size = ${HPX_PARCEL_" +
+                name_uc +
+                "_BUFFER_POOL_SIZE:"
+                "$[hpx.parcel.buffer_pool_size]}");
+            fillini.emplace_back("large_message_threshold = ${HPX_PARCEL_" +
+                name_uc +
+                "_LARGE_MESSAGE_THRESHOLD:"
+                "$[hpx.parcel.large_message_threshold]}");
+            fillini.emplace_back("large_message_lanes = ${HPX_PARCEL_" +
+                name_uc +
+                "_LARGE_MESSAGE_LANES:"
+                "$[hpx.parcel.large_message_lanes]}");
             fillini.emplace_back("priority = ${HPX_PARCEL_" + name_uc +
                 "_PRIORITY:" +
                 traits::plugin_config_data<Parcelport>::priority() + "}");
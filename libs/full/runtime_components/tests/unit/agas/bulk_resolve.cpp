@@ -0,0 +1,80 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::component_base<test_server>
+{
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server)
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t num_objects = 16;
+
+void test_bulk_resolve()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // interleave the objects living on the different localities
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != num_objects; ++i)
+    {
+        for (hpx::id_type const& locality : localities)
+        {
+            ids.push_back(hpx::new_<test_server>(locality).get());
+        }
+    }
+
+    // the addresses are returned in the order of the given ids
+    std::vector<hpx::naming::address> addrs = hpx::agas::resolve(ids).get();
+    HPX_TEST_EQ(addrs.size(), ids.size());
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        hpx::id_type const& locality = localities[i % localities.size()];
+        HPX_TEST_EQ(hpx::naming::get_locality_id_from_gid(addrs[i].locality_),
+            hpx::naming::get_locality_id_from_id(locality));
+
+        hpx::naming::address addr = hpx::agas::resolve(ids[i]).get();
+        HPX_TEST_EQ(addrs[i].locality_, addr.locality_);
+        HPX_TEST_EQ(addrs[i].address_, addr.address_);
+        HPX_TEST_EQ(addrs[i].type_, addr.type_);
+    }
+
+    // resolving again is served from the local cache
+    addrs = hpx::agas::resolve(ids).get();
+    HPX_TEST_EQ(addrs.size(), ids.size());
+
+    // resolving nothing yields no addresses
+    HPX_TEST(hpx::agas::resolve(std::vector<hpx::id_type>()).get().empty());
+}
+
+int hpx_main()
+{
+    test_bulk_resolve();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
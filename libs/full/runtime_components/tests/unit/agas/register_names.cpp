@@ -0,0 +1,127 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::component_base<test_server>
+{
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server)
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t num_names = 32;
+
+void test_register_names()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::vector<std::string> names;
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        names.push_back("/register_names_test/" + std::to_string(i));
+        ids.push_back(
+            hpx::new_<test_server>(localities[i % localities.size()]).get());
+    }
+
+    // all names are managed by the symbol namespace instances they hash to
+    std::vector<bool> registered =
+        hpx::agas::register_names(names, ids).get();
+    HPX_TEST_EQ(registered.size(), num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST(registered[i]);
+        HPX_TEST_EQ(
+            hpx::agas::resolve_name(hpx::launch::sync, names[i]), ids[i]);
+    }
+
+    // binding the names to different ids fails for each of them
+    std::vector<hpx::id_type> other_ids(ids.begin() + 1, ids.end());
+    other_ids.push_back(ids.front());
+
+    registered = hpx::agas::register_names(names, other_ids).get();
+    HPX_TEST_EQ(registered.size(), num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST(!registered[i]);
+    }
+
+    // the ids are returned in the order of the given names
+    std::vector<hpx::id_type> unregistered =
+        hpx::agas::unregister_names(names).get();
+    HPX_TEST_EQ(unregistered.size(), num_names);
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(unregistered[i], ids[i]);
+        HPX_TEST_EQ(hpx::agas::resolve_name(hpx::launch::sync, names[i]),
+            hpx::invalid_id);
+    }
+
+    // unregistering unknown names yields invalid ids
+    unregistered = hpx::agas::unregister_names(names).get();
+    HPX_TEST_EQ(unregistered.size(), num_names);
+    for (hpx::id_type const& id : unregistered)
+    {
+        HPX_TEST_EQ(id, hpx::invalid_id);
+    }
+}
+
+void test_prefix_event()
+{
+    char const* prefix = "/prefix_event_test/";
+
+    hpx::id_type id = hpx::new_<test_server>(hpx::find_here()).get();
+
+    // the watch is triggered by the first name registered with the prefix
+    hpx::future<hpx::id_type> f =
+        hpx::agas::on_symbol_namespace_prefix_event(prefix, false);
+
+    HPX_TEST(hpx::agas::register_name(
+        hpx::launch::sync, "/prefix_event_other/0", id));
+    HPX_TEST(!f.is_ready());
+
+    std::string const name = std::string(prefix) + "0";
+    HPX_TEST(hpx::agas::register_name(hpx::launch::sync, name, id));
+    HPX_TEST_EQ(f.get(), id);
+
+    // past events are reported if requested
+    f = hpx::agas::on_symbol_namespace_prefix_event(prefix, true);
+    HPX_TEST_EQ(f.get(), id);
+
+    HPX_TEST_EQ(hpx::agas::unregister_name(hpx::launch::sync, name), id);
+    HPX_TEST_EQ(hpx::agas::unregister_name(
+                    hpx::launch::sync, "/prefix_event_other/0"),
+        id);
+}
+
+int hpx_main()
+{
+    test_register_names();
+    test_prefix_event();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
+#endif
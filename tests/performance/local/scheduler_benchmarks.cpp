@@ -0,0 +1,571 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark driver runs a matrix of workloads against the schedulers
+// (and thread queue back-ends) available in this build of HPX, for a list of
+// numbers of worker threads. The HPX runtime is restarted for each scheduler
+// and number of worker threads. For every combination, the throughput (tasks
+// per second) and the percentiles of the latency between spawning a task and
+// the start of its execution are reported in CSV or JSON format.
+//
+// The workloads are:
+//
+//   spawn-tree:  a binary tree of tasks, each node spawns two children and
+//                waits for them (--tree-depth)
+//   fan-out:     a single task spawns --tasks empty tasks and waits for all of
+//                them
+//   timed:       a single task spawns --tasks tasks busy waiting for
+//                --task-duration nanoseconds each
+//   suspension:  a single task spawns --tasks tasks each suspending (yielding)
+//                --suspensions times
+//   stealing:    like timed, however all tasks are placed on the queue of the
+//                first worker thread which forces the other worker threads to
+//                steal them
+//
+// Example:
+//
+//   scheduler_benchmarks_test --schedulers=local-priority-fifo,shared-priority
+//       --threads=1,2,4 --workloads=fan-out,stealing --format=json
+//       --output=results.json
+//
+// Note: specifying --hpx:threads overrides the numbers of worker threads given
+// by --threads, the reported number of threads always reflects the actual
+// number of worker threads used.
+
+#include <hpx/local/chrono.hpp>
+#include <hpx/local/execution.hpp>
+#include <hpx/local/future.hpp>
+#include <hpx/local/init.hpp>
+#include <hpx/local/thread.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/program_options.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/topology.hpp>
+#include <hpx/string_util/classification.hpp>
+#include <hpx/string_util/split.hpp>
+#include <hpx/version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "worker_timed.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+struct scheduler_info
+{
+    char const* name;             // value passed to --hpx:queuing
+    char const* queue_backend;    // queue back-end used by the scheduler
+};
+
+scheduler_info const all_schedulers[] = {
+    {"local", "lockfree_fifo"},
+    {"local-priority-fifo", "lockfree_fifo"},
+    {"local-priority-lifo", "lockfree_lifo"},
+    {"static", "lockfree_fifo"},
+    {"static-priority", "lockfree_fifo"},
+#if defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
+    {"abp-priority-fifo", "lockfree_fifo"},
+    {"abp-priority-lifo", "lockfree_lifo"},
+#endif
+    {"shared-priority", "concurrentqueue_fifo"},
+    {"local-chase-lev", "lockfree_chase_lev"},
+    {"local-priority-chase-lev", "lockfree_chase_lev"},
+};
+
+char const* const all_workloads[] = {
+    "spawn-tree", "fan-out", "timed", "suspension", "stealing"};
+
+///////////////////////////////////////////////////////////////////////////////
+struct benchmark_options
+{
+    std::uint64_t tasks;
+    std::uint64_t tree_depth;
+    std::uint64_t task_duration;
+    std::uint64_t suspensions;
+    std::uint64_t repetitions;
+    std::uint64_t warmup;
+};
+
+struct benchmark_result
+{
+    std::string scheduler;
+    std::string queue_backend;
+    std::size_t threads;
+    std::string workload;
+    std::uint64_t tasks;
+    std::uint64_t repetitions;
+    double time_median;    // [s]
+    double time_min;       // [s]
+    double throughput;     // [tasks/s]
+    std::uint64_t latency_p50;    // [ns]
+    std::uint64_t latency_p90;
+    std::uint64_t latency_p99;
+    std::uint64_t latency_max;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Collects the latencies between spawning a task and the start of its
+// execution
+class latency_recorder
+{
+public:
+    explicit latency_recorder(std::uint64_t tasks)
+      : latencies_(tasks, 0)
+      , next_(0)
+    {
+    }
+
+    void record(std::uint64_t spawned)
+    {
+        std::uint64_t const now = hpx::chrono::high_resolution_clock::now();
+        std::size_t const i = next_.fetch_add(1, std::memory_order_relaxed);
+        HPX_ASSERT(i < latencies_.size());
+        latencies_[i] = now - spawned;
+    }
+
+    void append_to(std::vector<std::uint64_t>& latencies) const
+    {
+        latencies.insert(latencies.end(), latencies_.begin(),
+            latencies_.begin() + next_.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::vector<std::uint64_t> latencies_;
+    std::atomic<std::size_t> next_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void spawn_tree(
+    latency_recorder& recorder, std::uint64_t spawned, std::uint64_t depth)
+{
+    recorder.record(spawned);
+    if (depth == 0)
+    {
+        return;
+    }
+
+    std::uint64_t const now = hpx::chrono::high_resolution_clock::now();
+    hpx::future<void> left = hpx::async(
+        &spawn_tree, std::ref(recorder), now, depth - std::uint64_t(1));
+    hpx::future<void> right = hpx::async(
+        &spawn_tree, std::ref(recorder), now, depth - std::uint64_t(1));
+
+    left.get();
+    right.get();
+}
+
+std::uint64_t run_spawn_tree(
+    latency_recorder& recorder, benchmark_options const& opts)
+{
+    hpx::async(&spawn_tree, std::ref(recorder),
+        hpx::chrono::high_resolution_clock::now(), opts.tree_depth)
+        .get();
+    return (std::uint64_t(2) << opts.tree_depth) - 1;
+}
+
+std::uint64_t run_fan_out(
+    latency_recorder& recorder, benchmark_options const& opts)
+{
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(opts.tasks);
+
+    for (std::uint64_t i = 0; i != opts.tasks; ++i)
+    {
+        std::uint64_t const spawned = hpx::chrono::high_resolution_clock::now();
+        futures.push_back(
+            hpx::async([&recorder, spawned]() { recorder.record(spawned); }));
+    }
+
+    hpx::wait_all(futures);
+    return opts.tasks;
+}
+
+std::uint64_t run_timed(latency_recorder& recorder,
+    benchmark_options const& opts, hpx::execution::parallel_executor exec)
+{
+    hpx::latch l(static_cast<std::ptrdiff_t>(opts.tasks + 1));
+
+    for (std::uint64_t i = 0; i != opts.tasks; ++i)
+    {
+        hpx::apply(exec,
+            [&recorder, &l, &opts,
+                spawned = hpx::chrono::high_resolution_clock::now()]() {
+                recorder.record(spawned);
+                worker_timed(opts.task_duration);
+                l.count_down(1);
+            });
+    }
+
+    l.arrive_and_wait();
+    return opts.tasks;
+}
+
+std::uint64_t run_suspension(
+    latency_recorder& recorder, benchmark_options const& opts)
+{
+    hpx::latch l(static_cast<std::ptrdiff_t>(opts.tasks + 1));
+
+    for (std::uint64_t i = 0; i != opts.tasks; ++i)
+    {
+        hpx::apply([&recorder, &l, &opts,
+                      spawned = hpx::chrono::high_resolution_clock::now()]() {
+            recorder.record(spawned);
+            for (std::uint64_t j = 0; j != opts.suspensions; ++j)
+            {
+                hpx::this_thread::yield();
+            }
+            l.count_down(1);
+        });
+    }
+
+    l.arrive_and_wait();
+    return opts.tasks;
+}
+
+std::uint64_t run_workload(std::string const& workload,
+    latency_recorder& recorder, benchmark_options const& opts)
+{
+    if (workload == "spawn-tree")
+    {
+        return run_spawn_tree(recorder, opts);
+    }
+    if (workload == "fan-out")
+    {
+        return run_fan_out(recorder, opts);
+    }
+    if (workload == "timed")
+    {
+        return run_timed(recorder, opts, hpx::execution::parallel_executor());
+    }
+    if (workload == "suspension")
+    {
+        return run_suspension(recorder, opts);
+    }
+
+    HPX_ASSERT(workload == "stealing");
+
+    return run_timed(recorder, opts,
+        hpx::execution::experimental::with_hint(
+            hpx::execution::parallel_executor(),
+            hpx::threads::thread_schedule_hint(std::int16_t(0))));
+}
+
+std::uint64_t get_num_tasks(
+    std::string const& workload, benchmark_options const& opts)
+{
+    if (workload == "spawn-tree")
+    {
+        return (std::uint64_t(2) << opts.tree_depth) - 1;
+    }
+    return opts.tasks;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t get_percentile(
+    std::vector<std::uint64_t>& latencies, double percentile)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+
+    std::size_t const n = static_cast<std::size_t>(
+        percentile / 100.0 * static_cast<double>(latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + n, latencies.end());
+    return latencies[n];
+}
+
+benchmark_result run_benchmark(scheduler_info const& scheduler,
+    std::string const& workload, benchmark_options const& opts)
+{
+    std::uint64_t const tasks = get_num_tasks(workload, opts);
+
+    std::vector<double> times;
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(tasks * opts.repetitions);
+
+    for (std::uint64_t i = 0; i != opts.warmup + opts.repetitions; ++i)
+    {
+        latency_recorder recorder(tasks);
+
+        hpx::chrono::high_resolution_timer t;
+        run_workload(workload, recorder, opts);
+        double const elapsed = t.elapsed();
+
+        if (i >= opts.warmup)
+        {
+            times.push_back(elapsed);
+            recorder.append_to(latencies);
+        }
+    }
+
+    std::sort(times.begin(), times.end());
+    double const time_median = times[times.size() / 2];
+
+    benchmark_result result;
+    result.scheduler = scheduler.name;
+    result.queue_backend = scheduler.queue_backend;
+    result.threads = hpx::get_num_worker_threads();
+    result.workload = workload;
+    result.tasks = tasks;
+    result.repetitions = opts.repetitions;
+    result.time_median = time_median;
+    result.time_min = times.front();
+    result.throughput =
+        time_median > 0.0 ? static_cast<double>(tasks) / time_median : 0.0;
+    result.latency_p50 = get_percentile(latencies, 50.0);
+    result.latency_p90 = get_percentile(latencies, 90.0);
+    result.latency_p99 = get_percentile(latencies, 99.0);
+    result.latency_max = get_percentile(latencies, 100.0);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void print_csv(std::ostream& os, std::vector<benchmark_result> const& results)
+{
+    os << "scheduler,queue_backend,threads,workload,tasks,repetitions,"
+          "time_median_s,time_min_s,throughput_tasks_per_s,latency_p50_ns,"
+          "latency_p90_ns,latency_p99_ns,latency_max_ns\n";
+
+    for (benchmark_result const& r : results)
+    {
+        hpx::util::format_to(os,
+            "{},{},{},{},{},{},{:.9f},{:.9f},{:.1f},{},{},{},{}\n",
+            r.scheduler, r.queue_backend, r.threads, r.workload, r.tasks,
+            r.repetitions, r.time_median, r.time_min, r.throughput,
+            r.latency_p50, r.latency_p90, r.latency_p99, r.latency_max);
+    }
+}
+
+void print_json(std::ostream& os, std::vector<benchmark_result> const& results)
+{
+    hpx::util::format_to(os, "{{\n  \"hpx_version\": \"{}\",\n",
+        hpx::full_version_as_string());
+    os << "  \"results\": [";
+
+    char const* separator = "\n";
+    for (benchmark_result const& r : results)
+    {
+        hpx::util::format_to(os,
+            "{}    {{\"scheduler\": \"{}\", \"queue_backend\": \"{}\", "
+            "\"threads\": {}, \"workload\": \"{}\", \"tasks\": {}, "
+            "\"repetitions\": {}, \"time_median_s\": {:.9f}, "
+            "\"time_min_s\": {:.9f}, \"throughput_tasks_per_s\": {:.1f}, "
+            "\"latency_p50_ns\": {}, \"latency_p90_ns\": {}, "
+            "\"latency_p99_ns\": {}, \"latency_max_ns\": {}}}",
+            separator, r.scheduler, r.queue_backend, r.threads, r.workload,
+            r.tasks, r.repetitions, r.time_median, r.time_min, r.throughput,
+            r.latency_p50, r.latency_p90, r.latency_p99, r.latency_max);
+        separator = ",\n";
+    }
+    os << "\n  ]\n}\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> split_list(std::string const& list)
+{
+    std::vector<std::string> entries;
+    hpx::string_util::split(entries, list, hpx::string_util::is_any_of(","),
+        hpx::string_util::token_compress_mode::on);
+
+    entries.erase(
+        std::remove(entries.begin(), entries.end(), std::string()),
+        entries.end());
+    return entries;
+}
+
+// Return 1, 2, 4, ... up to (and including) the number of cores
+std::vector<std::size_t> default_thread_counts()
+{
+    std::size_t const cores = hpx::threads::hardware_concurrency();
+
+    std::vector<std::size_t> counts;
+    for (std::size_t i = 1; i < cores; i *= 2)
+    {
+        counts.push_back(i);
+    }
+    counts.push_back(cores);
+    return counts;
+}
+
+int main(int argc, char* argv[])
+{
+    using hpx::program_options::value;
+
+    hpx::program_options::options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    desc_commandline.add_options()
+        ("schedulers", value<std::string>()->default_value("all"),
+         "comma separated list of schedulers to benchmark (default: all)")
+        ("threads", value<std::string>()->default_value("all"),
+         "comma separated list of numbers of worker threads to use "
+         "(default: powers of two up to the number of cores)")
+        ("workloads", value<std::string>()->default_value("all"),
+         "comma separated list of workloads to run, any of spawn-tree, "
+         "fan-out, timed, suspension, stealing (default: all)")
+        ("tasks", value<std::uint64_t>()->default_value(100000),
+         "number of tasks to spawn for the fan-out, timed, suspension, and "
+         "stealing workloads (default: 100000)")
+        ("tree-depth", value<std::uint64_t>()->default_value(15),
+         "depth of the tree for the spawn-tree workload (default: 15)")
+        ("task-duration", value<std::uint64_t>()->default_value(1000),
+         "duration of the tasks of the timed and stealing workloads in "
+         "nanoseconds (default: 1000)")
+        ("suspensions", value<std::uint64_t>()->default_value(10),
+         "number of times each task of the suspension workload suspends "
+         "(default: 10)")
+        ("repetitions", value<std::uint64_t>()->default_value(5),
+         "number of measured repetitions of each workload (default: 5)")
+        ("warmup", value<std::uint64_t>()->default_value(1),
+         "number of unmeasured repetitions of each workload (default: 1)")
+        ("format", value<std::string>()->default_value("csv"),
+         "output format, csv or json (default: csv)")
+        ("output", value<std::string>(),
+         "name of the file to write the results to (default: standard "
+         "output)")
+        ;
+    // clang-format on
+
+    hpx::program_options::variables_map vm;
+    hpx::program_options::store(
+        hpx::program_options::command_line_parser(argc, argv)
+            .allow_unregistered()
+            .options(desc_commandline)
+            .run(),
+        vm);
+    hpx::program_options::notify(vm);
+
+    benchmark_options opts;
+    opts.tasks = vm["tasks"].as<std::uint64_t>();
+    opts.tree_depth = vm["tree-depth"].as<std::uint64_t>();
+    opts.task_duration = vm["task-duration"].as<std::uint64_t>();
+    opts.suspensions = vm["suspensions"].as<std::uint64_t>();
+    opts.repetitions = (std::max)(vm["repetitions"].as<std::uint64_t>(),
+        std::uint64_t(1));
+    opts.warmup = vm["warmup"].as<std::uint64_t>();
+
+    std::string const format = vm["format"].as<std::string>();
+    if (format != "csv" && format != "json")
+    {
+        std::cerr << "scheduler_benchmarks: invalid output format: " << format
+                  << "\n";
+        return -1;
+    }
+
+    // select the schedulers to benchmark
+    std::vector<scheduler_info> schedulers;
+    std::string const scheduler_list = vm["schedulers"].as<std::string>();
+    if (scheduler_list == "all")
+    {
+        schedulers.assign(std::begin(all_schedulers), std::end(all_schedulers));
+    }
+    else
+    {
+        for (std::string const& name : split_list(scheduler_list))
+        {
+            auto it = std::find_if(std::begin(all_schedulers),
+                std::end(all_schedulers), [&](scheduler_info const& s) {
+                    return name == s.name;
+                });
+            if (it == std::end(all_schedulers))
+            {
+                std::cerr << "scheduler_benchmarks: unknown or unavailable "
+                             "scheduler: "
+                          << name << "\n";
+                return -1;
+            }
+            schedulers.push_back(*it);
+        }
+    }
+
+    // select the numbers of worker threads to use
+    std::vector<std::size_t> thread_counts;
+    std::string const thread_list = vm["threads"].as<std::string>();
+    if (thread_list == "all")
+    {
+        thread_counts = default_thread_counts();
+    }
+    else
+    {
+        for (std::string const& count : split_list(thread_list))
+        {
+            thread_counts.push_back(std::stoul(count));
+        }
+    }
+
+    // select the workloads to run
+    std::vector<std::string> workloads;
+    std::string const workload_list = vm["workloads"].as<std::string>();
+    if (workload_list == "all")
+    {
+        workloads.assign(std::begin(all_workloads), std::end(all_workloads));
+    }
+    else
+    {
+        workloads = split_list(workload_list);
+        for (std::string const& workload : workloads)
+        {
+            if (std::find(std::begin(all_workloads), std::end(all_workloads),
+                    workload) == std::end(all_workloads))
+            {
+                std::cerr << "scheduler_benchmarks: unknown workload: "
+                          << workload << "\n";
+                return -1;
+            }
+        }
+    }
+
+    // run the matrix, restarting the runtime for each scheduler and number
+    // of worker threads
+    std::vector<benchmark_result> results;
+    for (scheduler_info const& scheduler : schedulers)
+    {
+        for (std::size_t threads : thread_counts)
+        {
+            hpx::local::init_params init_args;
+            init_args.desc_cmdline = desc_commandline;
+            init_args.cfg = {
+                std::string("hpx.scheduler=") + scheduler.name,
+                "hpx.os_threads=" + std::to_string(threads),
+            };
+
+            auto hpx_main = [&](hpx::program_options::variables_map&) {
+                for (std::string const& workload : workloads)
+                {
+                    results.push_back(
+                        run_benchmark(scheduler, workload, opts));
+                }
+                return hpx::local::finalize();
+            };
+
+            HPX_TEST_EQ(hpx::local::init(hpx_main, argc, argv, init_args), 0);
+        }
+    }
+
+    if (vm.count("output"))
+    {
+        std::ofstream os(vm["output"].as<std::string>());
+        format == "json" ? print_json(os, results) : print_csv(os, results);
+    }
+    else
+    {
+        format == "json" ? print_json(std::cout, results) :
+                           print_csv(std::cout, results);
+    }
+
+    return hpx::util::report_errors();
+}
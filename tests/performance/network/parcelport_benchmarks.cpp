@@ -0,0 +1,628 @@
+//  Copyright (c) 2022 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark driver measures the performance of the parcel layer in the
+// style of the OSU micro-benchmarks. It runs over whatever parcelport is
+// selected for the application (use --hpx:ini=hpx.parcel.<type>.enable=1 to
+// choose one) and needs at least two localities, which may run on the same
+// host (TCP loopback or MPI). All benchmarks are driven from locality 0, the
+// results are reported in CSV or JSON format for each message size.
+//
+// The benchmarks are:
+//
+//   latency:        ping-pong between locality 0 and 1, reports the one-way
+//                   latency (half of the round trip time)
+//   bandwidth:      locality 0 sends --window messages to locality 1 and
+//                   waits for them to be received, repeatedly
+//   bibandwidth:    like bandwidth, however both localities send at the same
+//                   time
+//   message-rate:   --senders HPX threads on locality 0 stream messages to
+//                   locality 1 concurrently
+//   multi-pair:     the first half of the localities stream messages to the
+//                   second half, for 1, 2, 4, ... pairs of localities
+//
+// Every benchmark is run with plain actions and, if requested with
+// --coalescing=on or --coalescing=both, with actions using parcel coalescing.
+// The thresholds influencing the parcel layer (coalescing parameters, zero
+// copy serialization threshold) are reported with every result. Running the
+// benchmarks with different settings for those allows to evaluate their
+// effect, e.g.:
+//
+//   parcelport_benchmarks_test --hpx:localities=2 --coalescing=both
+//       --hpx:ini=hpx.parcel.zero_copy_serialization_threshold=4096
+//       --format=json --output=results.json
+
+#include <hpx/config.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parcelset.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/serialization.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/string_util/classification.hpp>
+#include <hpx/string_util/split.hpp>
+#include <hpx/version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using buffer_type = hpx::serialization::serialize_buffer<char>;
+
+// the number of messages received for each stream on this locality
+constexpr std::size_t max_streams = 256;
+std::array<std::atomic<std::uint64_t>, max_streams> received_messages;
+
+///////////////////////////////////////////////////////////////////////////////
+// actions invoked on the receiving locality
+buffer_type echo(buffer_type const& buffer)
+{
+    return buffer;
+}
+HPX_PLAIN_ACTION(echo, echo_action)
+
+buffer_type echo_coalesced(buffer_type const& buffer)
+{
+    return buffer;
+}
+HPX_PLAIN_ACTION(echo_coalesced, echo_coalesced_action)
+HPX_ACTION_USES_MESSAGE_COALESCING_NOTHROW(echo_coalesced_action,
+    "echo_coalesced_action", std::size_t(-1), std::size_t(-1))
+
+void receive(std::uint32_t stream, buffer_type const&)
+{
+    received_messages[stream].fetch_add(1, std::memory_order_relaxed);
+}
+HPX_PLAIN_ACTION(receive, receive_action)
+
+void receive_coalesced(std::uint32_t stream, buffer_type const&)
+{
+    received_messages[stream].fetch_add(1, std::memory_order_relaxed);
+}
+HPX_PLAIN_ACTION(receive_coalesced, receive_coalesced_action)
+HPX_ACTION_USES_MESSAGE_COALESCING_NOTHROW(receive_coalesced_action,
+    "receive_coalesced_action", std::size_t(-1), std::size_t(-1))
+
+void reset_stream(std::uint32_t stream)
+{
+    received_messages[stream].store(0, std::memory_order_relaxed);
+}
+HPX_PLAIN_ACTION(reset_stream, reset_stream_action)
+
+void wait_for_messages(std::uint32_t stream, std::uint64_t count)
+{
+    hpx::util::yield_while([&]() {
+        return received_messages[stream].load(std::memory_order_relaxed) <
+            count;
+    });
+}
+HPX_PLAIN_ACTION(wait_for_messages, wait_for_messages_action)
+
+///////////////////////////////////////////////////////////////////////////////
+// Send 'iterations' windows of 'window' messages of the given size to the
+// target, waiting for each window to be received before sending the next.
+// Returns the elapsed time in seconds.
+double stream_messages(hpx::id_type const& target, std::uint32_t stream,
+    std::size_t size, std::size_t window, std::size_t iterations,
+    std::size_t warmup, bool coalescing)
+{
+    std::vector<char> data(size, 'x');
+    buffer_type buffer(data.data(), size, buffer_type::reference);
+
+    hpx::async<reset_stream_action>(target, stream).get();
+
+    std::uint64_t sent = 0;
+    auto run = [&](std::size_t count) {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            for (std::size_t j = 0; j != window; ++j)
+            {
+                if (coalescing)
+                {
+                    hpx::apply<receive_coalesced_action>(
+                        target, stream, buffer);
+                }
+                else
+                {
+                    hpx::apply<receive_action>(target, stream, buffer);
+                }
+            }
+            sent += window;
+            hpx::async<wait_for_messages_action>(target, stream, sent).get();
+        }
+    };
+
+    run(warmup);
+
+    hpx::chrono::high_resolution_timer t;
+    run(iterations);
+    return t.elapsed();
+}
+HPX_PLAIN_ACTION(stream_messages, stream_messages_action)
+
+///////////////////////////////////////////////////////////////////////////////
+struct benchmark_options
+{
+    std::size_t iterations;
+    std::size_t warmup;
+    std::size_t window;
+    std::size_t senders;
+    std::size_t large_message_size;
+};
+
+struct benchmark_result
+{
+    std::string benchmark;
+    bool coalescing;
+    std::size_t pairs;
+    std::size_t senders;
+    std::size_t size;
+    std::size_t iterations;
+    std::size_t window;
+    double latency_us;
+    double bandwidth_mb_s;
+    double messages_per_s;
+};
+
+// large messages are sent fewer times
+std::size_t get_iterations(std::size_t iterations, std::size_t size,
+    benchmark_options const& opts)
+{
+    if (size > opts.large_message_size)
+    {
+        return (std::max)(iterations / 10, std::size_t(1));
+    }
+    return iterations;
+}
+
+benchmark_result make_result(std::string benchmark, bool coalescing,
+    std::size_t pairs, std::size_t senders, std::size_t size,
+    std::size_t iterations, std::size_t window, double elapsed)
+{
+    double const messages =
+        static_cast<double>(pairs * senders * iterations * window);
+
+    benchmark_result result;
+    result.benchmark = HPX_MOVE(benchmark);
+    result.coalescing = coalescing;
+    result.pairs = pairs;
+    result.senders = senders;
+    result.size = size;
+    result.iterations = iterations;
+    result.window = window;
+    result.latency_us = 0.0;
+    result.bandwidth_mb_s =
+        elapsed > 0.0 ? messages * size / elapsed / 1e6 : 0.0;
+    result.messages_per_s = elapsed > 0.0 ? messages / elapsed : 0.0;
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+benchmark_result run_latency(hpx::id_type const& target, std::size_t size,
+    bool coalescing, benchmark_options const& opts)
+{
+    std::vector<char> data(size, 'x');
+    buffer_type buffer(data.data(), size, buffer_type::reference);
+
+    auto run = [&](std::size_t count) {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            buffer_type result = coalescing ?
+                hpx::async<echo_coalesced_action>(target, buffer).get() :
+                hpx::async<echo_action>(target, buffer).get();
+            HPX_TEST_EQ(result.size(), size);
+        }
+    };
+
+    std::size_t const iterations =
+        get_iterations(opts.iterations, size, opts);
+
+    run(opts.warmup);
+
+    hpx::chrono::high_resolution_timer t;
+    run(iterations);
+    double const elapsed = t.elapsed();
+
+    // both directions carry the message
+    benchmark_result result = make_result(
+        "latency", coalescing, 1, 1, size, 2 * iterations, 1, elapsed);
+    result.iterations = iterations;
+    result.latency_us = elapsed * 1e6 / (2 * iterations);
+    return result;
+}
+
+benchmark_result run_bandwidth(hpx::id_type const& target, std::size_t size,
+    bool coalescing, benchmark_options const& opts)
+{
+    std::size_t const iterations =
+        get_iterations(opts.iterations, size, opts);
+
+    double const elapsed = stream_messages(target, 0, size, opts.window,
+        iterations, opts.warmup, coalescing);
+
+    return make_result("bandwidth", coalescing, 1, 1, size, iterations,
+        opts.window, elapsed);
+}
+
+benchmark_result run_bibandwidth(hpx::id_type const& target, std::size_t size,
+    bool coalescing, benchmark_options const& opts)
+{
+    std::size_t const iterations =
+        get_iterations(opts.iterations, size, opts);
+
+    hpx::chrono::high_resolution_timer t;
+
+    hpx::future<double> remote = hpx::async<stream_messages_action>(target,
+        hpx::find_here(), 0, size, opts.window, iterations, opts.warmup,
+        coalescing);
+    stream_messages(
+        target, 0, size, opts.window, iterations, opts.warmup, coalescing);
+    remote.get();
+
+    double const elapsed = t.elapsed();
+
+    // the warmup iterations are included in the measured time
+    return make_result("bibandwidth", coalescing, 1, 2, size,
+        iterations + opts.warmup, opts.window, elapsed);
+}
+
+benchmark_result run_message_rate(hpx::id_type const& target,
+    std::size_t size, bool coalescing, benchmark_options const& opts)
+{
+    std::size_t const iterations =
+        get_iterations(opts.iterations, size, opts);
+
+    std::vector<hpx::future<double>> senders;
+    senders.reserve(opts.senders);
+    for (std::size_t i = 0; i != opts.senders; ++i)
+    {
+        senders.push_back(hpx::async(&stream_messages, target,
+            static_cast<std::uint32_t>(i), size, opts.window, iterations,
+            opts.warmup, coalescing));
+    }
+
+    double elapsed = 0.0;
+    for (hpx::future<double>& f : senders)
+    {
+        elapsed = (std::max)(elapsed, f.get());
+    }
+
+    return make_result("message-rate", coalescing, 1, opts.senders, size,
+        iterations, opts.window, elapsed);
+}
+
+// the first half of the localities send to the second half
+std::vector<benchmark_result> run_multi_pair(std::size_t size,
+    bool coalescing, benchmark_options const& opts)
+{
+    std::size_t const max_pairs =
+        hpx::get_num_localities(hpx::launch::sync) / 2;
+    std::size_t const iterations =
+        get_iterations(opts.iterations, size, opts);
+
+    std::vector<benchmark_result> results;
+    for (std::size_t pairs = 1; pairs <= max_pairs; pairs *= 2)
+    {
+        std::vector<hpx::future<double>> senders;
+        senders.reserve(pairs);
+        for (std::size_t i = 0; i != pairs; ++i)
+        {
+            hpx::id_type const sender = hpx::naming::get_id_from_locality_id(
+                static_cast<std::uint32_t>(i));
+            hpx::id_type const receiver =
+                hpx::naming::get_id_from_locality_id(
+                    static_cast<std::uint32_t>(i + max_pairs));
+
+            senders.push_back(hpx::async<stream_messages_action>(sender,
+                receiver, 0, size, opts.window, iterations, opts.warmup,
+                coalescing));
+        }
+
+        double elapsed = 0.0;
+        for (hpx::future<double>& f : senders)
+        {
+            elapsed = (std::max)(elapsed, f.get());
+        }
+
+        results.push_back(make_result("multi-pair", coalescing, pairs, 1,
+            size, iterations, opts.window, elapsed));
+    }
+    return results;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct configuration
+{
+    std::string parcelport;
+    std::string zero_copy_threshold;
+    std::string coalescing_num_messages;
+    std::string coalescing_interval;
+};
+
+configuration get_configuration()
+{
+    configuration cfg;
+
+    // the parcelport with the highest priority is used for all messages
+    hpx::get_runtime_distributed().get_parcel_handler().enum_parcelports(
+        [&](std::string const& type) {
+            cfg.parcelport = type;
+            return false;
+        });
+
+    cfg.zero_copy_threshold = hpx::get_config_entry(
+        "hpx.parcel.zero_copy_serialization_threshold", "");
+    cfg.coalescing_num_messages = hpx::get_config_entry(
+        "hpx.plugins.coalescing_message_handler.num_messages", "");
+    cfg.coalescing_interval = hpx::get_config_entry(
+        "hpx.plugins.coalescing_message_handler.interval", "");
+    return cfg;
+}
+
+void print_csv(std::ostream& os, configuration const& cfg,
+    std::vector<benchmark_result> const& results)
+{
+    os << "benchmark,parcelport,coalescing,coalescing_num_messages,"
+          "coalescing_interval_us,zero_copy_threshold,pairs,senders,"
+          "size_bytes,iterations,window,latency_us,bandwidth_mb_per_s,"
+          "messages_per_s\n";
+
+    for (benchmark_result const& r : results)
+    {
+        hpx::util::format_to(os,
+            "{},{},{},{},{},{},{},{},{},{},{},{:.3f},{:.3f},{:.1f}\n",
+            r.benchmark, cfg.parcelport, r.coalescing ? "on" : "off",
+            cfg.coalescing_num_messages, cfg.coalescing_interval,
+            cfg.zero_copy_threshold, r.pairs, r.senders, r.size,
+            r.iterations, r.window, r.latency_us, r.bandwidth_mb_s,
+            r.messages_per_s);
+    }
+}
+
+void print_json(std::ostream& os, configuration const& cfg,
+    std::vector<benchmark_result> const& results)
+{
+    hpx::util::format_to(os,
+        "{{\n  \"hpx_version\": \"{}\",\n  \"parcelport\": \"{}\",\n"
+        "  \"localities\": {},\n  \"coalescing_num_messages\": \"{}\",\n"
+        "  \"coalescing_interval_us\": \"{}\",\n"
+        "  \"zero_copy_threshold\": \"{}\",\n",
+        hpx::full_version_as_string(), cfg.parcelport,
+        hpx::get_num_localities(hpx::launch::sync),
+        cfg.coalescing_num_messages, cfg.coalescing_interval,
+        cfg.zero_copy_threshold);
+    os << "  \"results\": [";
+
+    char const* separator = "\n";
+    for (benchmark_result const& r : results)
+    {
+        hpx::util::format_to(os,
+            "{}    {{\"benchmark\": \"{}\", \"coalescing\": {}, "
+            "\"pairs\": {}, \"senders\": {}, \"size_bytes\": {}, "
+            "\"iterations\": {}, \"window\": {}, \"latency_us\": {:.3f}, "
+            "\"bandwidth_mb_per_s\": {:.3f}, \"messages_per_s\": {:.1f}}}",
+            separator, r.benchmark, r.coalescing ? "true" : "false", r.pairs,
+            r.senders, r.size, r.iterations, r.window, r.latency_us,
+            r.bandwidth_mb_s, r.messages_per_s);
+        separator = ",\n";
+    }
+    os << "\n  ]\n}\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const all_benchmarks[] = {
+    "latency", "bandwidth", "bibandwidth", "message-rate", "multi-pair"};
+
+std::vector<std::string> split_list(std::string const& list)
+{
+    std::vector<std::string> entries;
+    hpx::string_util::split(entries, list, hpx::string_util::is_any_of(","),
+        hpx::string_util::token_compress_mode::on);
+
+    entries.erase(
+        std::remove(entries.begin(), entries.end(), std::string()),
+        entries.end());
+    return entries;
+}
+
+// Return 1, 2, 4, ... up to (and including) the given maximum size
+std::vector<std::size_t> get_message_sizes(
+    std::size_t min_size, std::size_t max_size)
+{
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = (std::max)(min_size, std::size_t(1));
+         size <= max_size; size *= 2)
+    {
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    if (hpx::get_num_localities(hpx::launch::sync) < 2)
+    {
+        std::cerr << "parcelport_benchmarks: this benchmark needs at least "
+                     "two localities\n";
+        return hpx::finalize();
+    }
+
+    benchmark_options opts;
+    opts.iterations =
+        (std::max)(vm["iterations"].as<std::size_t>(), std::size_t(1));
+    opts.warmup = vm["warmup"].as<std::size_t>();
+    opts.window =
+        (std::max)(vm["window"].as<std::size_t>(), std::size_t(1));
+    opts.senders = (std::min)(
+        (std::max)(vm["senders"].as<std::size_t>(), std::size_t(1)),
+        max_streams);
+    opts.large_message_size = vm["large-message-size"].as<std::size_t>();
+
+    std::vector<std::size_t> const sizes =
+        get_message_sizes(vm["min-size"].as<std::size_t>(),
+            vm["max-size"].as<std::size_t>());
+
+    std::string const format = vm["format"].as<std::string>();
+    if (format != "csv" && format != "json")
+    {
+        std::cerr << "parcelport_benchmarks: invalid output format: "
+                  << format << "\n";
+        return hpx::finalize();
+    }
+
+    std::vector<bool> coalescing_modes;
+    std::string const coalescing = vm["coalescing"].as<std::string>();
+    if (coalescing == "off" || coalescing == "both")
+    {
+        coalescing_modes.push_back(false);
+    }
+    if (coalescing == "on" || coalescing == "both")
+    {
+        coalescing_modes.push_back(true);
+    }
+    if (coalescing_modes.empty())
+    {
+        std::cerr << "parcelport_benchmarks: invalid coalescing mode: "
+                  << coalescing << "\n";
+        return hpx::finalize();
+    }
+
+    std::vector<std::string> benchmarks;
+    std::string const benchmark_list = vm["benchmarks"].as<std::string>();
+    if (benchmark_list == "all")
+    {
+        benchmarks.assign(std::begin(all_benchmarks), std::end(all_benchmarks));
+    }
+    else
+    {
+        benchmarks = split_list(benchmark_list);
+        for (std::string const& benchmark : benchmarks)
+        {
+            if (std::find(std::begin(all_benchmarks), std::end(all_benchmarks),
+                    benchmark) == std::end(all_benchmarks))
+            {
+                std::cerr << "parcelport_benchmarks: unknown benchmark: "
+                          << benchmark << "\n";
+                return hpx::finalize();
+            }
+        }
+    }
+
+    hpx::id_type const target = hpx::naming::get_id_from_locality_id(1);
+
+    std::vector<benchmark_result> results;
+    for (std::string const& benchmark : benchmarks)
+    {
+        for (bool coalesce : coalescing_modes)
+        {
+            for (std::size_t size : sizes)
+            {
+                if (benchmark == "latency")
+                {
+                    results.push_back(
+                        run_latency(target, size, coalesce, opts));
+                }
+                else if (benchmark == "bandwidth")
+                {
+                    results.push_back(
+                        run_bandwidth(target, size, coalesce, opts));
+                }
+                else if (benchmark == "bibandwidth")
+                {
+                    results.push_back(
+                        run_bibandwidth(target, size, coalesce, opts));
+                }
+                else if (benchmark == "message-rate")
+                {
+                    results.push_back(
+                        run_message_rate(target, size, coalesce, opts));
+                }
+                else
+                {
+                    std::vector<benchmark_result> pairs =
+                        run_multi_pair(size, coalesce, opts);
+                    results.insert(results.end(), pairs.begin(), pairs.end());
+                }
+            }
+        }
+    }
+
+    configuration const cfg = get_configuration();
+    if (vm.count("output"))
+    {
+        std::ofstream os(vm["output"].as<std::string>());
+        format == "json" ? print_json(os, cfg, results) :
+                           print_csv(os, cfg, results);
+    }
+    else
+    {
+        format == "json" ? print_json(std::cout, cfg, results) :
+                           print_csv(std::cout, cfg, results);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using hpx::program_options::value;
+
+    hpx::program_options::options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    desc_commandline.add_options()
+        ("benchmarks", value<std::string>()->default_value("all"),
+         "comma separated list of benchmarks to run, any of latency, "
+         "bandwidth, bibandwidth, message-rate, multi-pair (default: all)")
+        ("min-size", value<std::size_t>()->default_value(1),
+         "smallest message size in bytes (default: 1)")
+        ("max-size", value<std::size_t>()->default_value(4194304),
+         "largest message size in bytes, the sizes are doubled starting "
+         "at --min-size (default: 4194304)")
+        ("iterations", value<std::size_t>()->default_value(1000),
+         "number of measured iterations for each message size (default: "
+         "1000)")
+        ("warmup", value<std::size_t>()->default_value(100),
+         "number of unmeasured iterations for each message size (default: "
+         "100)")
+        ("large-message-size", value<std::size_t>()->default_value(65536),
+         "messages larger than this are sent for a tenth of the iterations "
+         "only (default: 65536)")
+        ("window", value<std::size_t>()->default_value(64),
+         "number of messages sent before waiting for them to be received "
+         "(default: 64)")
+        ("senders", value<std::size_t>()->default_value(8),
+         "number of concurrent senders for the message-rate benchmark "
+         "(default: 8)")
+        ("coalescing", value<std::string>()->default_value("off"),
+         "use actions with parcel coalescing, on, off, or both (default: "
+         "off)")
+        ("format", value<std::string>()->default_value("csv"),
+         "output format, csv or json (default: csv)")
+        ("output", value<std::string>(),
+         "name of the file to write the results to (default: standard "
+         "output)")
+        ;
+    // clang-format on
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+    return hpx::util::report_errors();
+}
+#endif